@@ -26,5 +26,7 @@ class JPetAnalysisTools
 {
 public:
   static std::vector<JPetHit> getHitsOrderedByTime(const std::vector<JPetHit>& hits);
+  static std::vector<JPetHit> getHitsOrderedByTime(std::vector<JPetHit>&& hits);
+  static void sortHitsByTime(std::vector<JPetHit>& hits);
 };
 #endif /* !JPETANALYSISTOOLS_H */
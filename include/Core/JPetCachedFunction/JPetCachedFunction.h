@@ -16,6 +16,7 @@
 #ifndef JPETCACHEDFUNCTION_H
 #define JPETCACHEDFUNCTION_H
 
+#include <cstddef>
 #include <vector>
 #include <string>
 
@@ -48,6 +49,9 @@ struct JPetCachedFunctionParams {
  * The classes JPetCachedFunction1D and JPetCachedFunction2D correspond to  func(x,p0,p1,...) 
  * and func(x,y, p0,p1, ...) implementations.
  * Base class JPetCachedFunction is not ment to be created separately.
+ * By default the value of the nearest lower sampling point is returned, the linear (1D)
+ * and bilinear (2D) interpolation between sampling points can be switched on with
+ * setInterpolation(true). Values outside of the range are equal to 0.
  * 
  */
 class JPetCachedFunction
@@ -58,10 +62,14 @@ protected:
 public:
   JPetCachedFunctionParams getParams() const;
   std::vector<double> getValues() const;
+  const std::vector<double>& getValuesRef() const;
+  void setInterpolation(bool interpolate);
+  bool isInterpolation() const;
 
 protected:
   std::vector<double> fValues; /// Lookup table containg the function values.
   JPetCachedFunctionParams fParams;  /// Parameters describing the function.
+  bool fInterpolation = false; /// If true the values between the sampling points are interpolated.
 };
 
 
@@ -74,10 +82,13 @@ class JPetCachedFunction1D: public JPetCachedFunction
 public:
   explicit JPetCachedFunction1D(const JPetCachedFunctionParams& params, const Range& range);
   double operator()(double x) const;
+  void evaluate(const double* xs, double* out, std::size_t n) const;
+  std::vector<double> evaluate(const std::vector<double>& xs) const;
   Range getRange() const;
 
 protected:
   int xValueToIndex(double x) const;
+  double interpolate(double x) const;
 
 private:
   Range fRange;
@@ -93,10 +104,13 @@ class JPetCachedFunction2D: public JPetCachedFunction
 public:
   JPetCachedFunction2D(const JPetCachedFunctionParams& params, const Range& xRange, const Range& yRange);
   double operator()(double x, double y) const;
+  void evaluate(const double* xs, const double* ys, double* out, std::size_t n) const;
+  std::vector<double> evaluate(const std::vector<double>& xs, const std::vector<double>& ys) const;
   std::pair<Range, Range> getRange() const;
 
 protected:
   int xyValueToIndex(double x, double y) const;
+  double interpolate(double x, double y) const;
 
 private:
   std::pair<Range, Range> fRange;
@@ -24,9 +24,13 @@
 class JPetData: public JPetDataInterface
 {
 public:
-  explicit JPetData(TObject& event);
+  explicit JPetData(TObject& event, long long entryNumber = -1, bool isLastEntry = false);
   TObject& getEvent() const;
+  long long getEntryNumber() const;
+  bool isLastEntry() const;
 protected:
   TObject& fEvent;
+  long long fEntryNumber = -1; /// Number of the entry in the input file, -1 if unknown.
+  bool fIsLastEntry = false; /// No following entry is processed by the task after this one.
 };
 #endif /* !JPETDATA_H */
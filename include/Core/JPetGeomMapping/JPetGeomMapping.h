@@ -30,10 +30,33 @@
  * Created mapping is to be used in the analyses for application of various
  * parameters i.e. from calibrations. In general, use only for measurements
  * conducted with the Big Barrel detector.
+ *
+ * Apart from the maps keyed by the layer radius and the slot theta, the constructor
+ * fills flat tables indexed by the barrel slot ID, the scintillator ID and the
+ * (layer, slot, side, threshold) tuple, so that the geometry of a slot and the TOMB
+ * channel number can be obtained in constant time. The object is not modified after
+ * the construction, so one instance can be shared by many threads.
  */
 class JPetGeomMapping : public JPetGeomMappingInterface
 {
 public:
+  /**
+   * @brief Precomputed geometry of a single barrel slot.
+   *
+   * Theta is given in degrees as in the parameter bank, x and y are the
+   * coordinates of the slot centre: radius * cos(theta), radius * sin(theta).
+   */
+  struct SlotGeometry
+  {
+    int layer = -1;
+    int slot = -1;
+    double x = 0.;
+    double y = 0.;
+    double theta = 0.;
+    double radius = 0.;
+    bool isValid() const { return layer > 0; }
+  };
+
   explicit JPetGeomMapping(const JPetParamBank &paramBank);
   virtual ~JPetGeomMapping();
   virtual size_t getLayersCount() const override;
@@ -49,16 +72,27 @@ public:
   int getTOMB(int layerNr, int slotNr, const JPetPM::Side &side, int threshold) const;
   double getRadiusOfLayer(int layer) const;
   size_t calcDeltaID(const JPetBarrelSlot &slot1, const JPetBarrelSlot &slot2) const;
+  const SlotGeometry *getSlotGeometry(int barrelSlotID) const;
+  const SlotGeometry *getScinGeometry(int scinID) const;
   static const size_t kBadLayerNumber;
   static const size_t kBadSlotNumber;
 
 private:
   std::map<std::tuple<int, int, JPetPM::Side, int>, int> getTOMBMap(
     const JPetParamBank &bank) const;
+  void fillGeometryTables(const JPetParamBank &bank);
+  void fillTOMBTable();
+  const SlotGeometry *findSlotGeometry(const JPetBarrelSlot &slot) const;
   std::map<std::tuple<int, int, JPetPM::Side, int>, int> fTOMBs;
   std::vector<std::map<double, int>> fThetaToSlot;
   std::vector<int> fNumberOfSlotsInLayer;
   std::map<double, int> fRadiusToLayer;
+  std::vector<double> fLayerRadii; /// Radius of the layer with the number i + 1.
+  std::vector<SlotGeometry> fSlotGeometries; /// Geometry indexed by the barrel slot ID.
+  std::vector<SlotGeometry> fScinGeometries; /// Geometry of the slot indexed by the scintillator ID.
+  std::vector<int> fTOMBTable; /// Flat TOMB array, -1 for the tuples without a channel.
+  int fMaxSlotsInLayer = 0;
+  int fMaxThreshold = -1;
 };
 
 #endif /* !JPETGEOMMAPPING_H */
@@ -0,0 +1,122 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitColumns.h
+ */
+
+#ifndef JPETHITCOLUMNS_H
+#define JPETHITCOLUMNS_H
+
+#include "./JPetHit/JPetHit.h"
+#include "./JPetPhysSignal/JPetPhysSignal.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <string>
+#include <vector>
+
+class TTree;
+
+/**
+ * @brief Column-wise (split) storage of the time windows of JPetHit objects in a tree.
+ *
+ * Each tree entry is one time window. Instead of a single branch with the whole
+ * JPetTimeWindow, every field of the hits is kept in its own branch holding
+ * a vector with one value per hit: hit_time, hit_timeDiff, hit_energy, hit_posX,
+ * hit_posY, hit_posZ, hit_scinID, hit_barrelSlotID and, optionally, the full
+ * signals of both sides in hit_signalA and hit_signalB, with hit_signalFlags
+ * telling which of them are set in the hit (kSignalASet, kSignalBSet). The number of hits
+ * is stored in the hit_count branch. The branches are grouped in columns
+ * (Column enum), which can be selected separately for writing and for reading,
+ * so a task using only e.g. the time and energy does not decompress the signals.
+ * The quality fields, the reconstruction flag and the MC index are not stored.
+ */
+class JPetHitColumns
+{
+public:
+  enum Column : unsigned int
+  {
+    kTime = 1u << 0,
+    kEnergy = 1u << 1,
+    kPosition = 1u << 2,
+    kScinID = 1u << 3,
+    kSignals = 1u << 4,
+    kBasic = kTime | kEnergy | kPosition | kScinID,
+    kAll = kBasic | kSignals
+  };
+  enum SignalFlag : unsigned char
+  {
+    kSignalASet = 1u << 0,
+    kSignalBSet = 1u << 1
+  };
+  static const std::string kCountBranchName;
+
+  JPetHitColumns() {}
+  JPetHitColumns(const JPetHitColumns&) = delete;
+  JPetHitColumns& operator=(const JPetHitColumns&) = delete;
+
+  static bool isColumnarTree(TTree& tree);
+  static unsigned int parseColumns(const std::vector<std::string>& names);
+
+  bool createBranches(TTree& tree, unsigned int columns);
+  unsigned int setBranchAddresses(TTree& tree, unsigned int columns);
+  unsigned int getColumns() const;
+  void fill(const JPetTimeWindow& window);
+  void fillTimeWindow(JPetTimeWindow& window) const;
+  void clear();
+  std::size_t size() const;
+
+  const std::vector<float>& getTimes() const;
+  const std::vector<float>& getTimeDiffs() const;
+  const std::vector<float>& getEnergies() const;
+  const std::vector<float>& getPosX() const;
+  const std::vector<float>& getPosY() const;
+  const std::vector<float>& getPosZ() const;
+  const std::vector<int>& getScinIDs() const;
+  const std::vector<int>& getBarrelSlotIDs() const;
+  const std::vector<JPetPhysSignal>& getSignalsA() const;
+  const std::vector<JPetPhysSignal>& getSignalsB() const;
+  const std::vector<unsigned char>& getSignalFlags() const;
+
+private:
+  template <typename Operation>
+  unsigned int forEachBranch(unsigned int columns, Operation operation);
+  bool hasConsistentSizes() const;
+
+  /// Columns bound to the tree, i.e. written or read
+  unsigned int fColumns = 0;
+  int fCount = 0;
+  std::vector<float> fTime;
+  std::vector<float> fTimeDiff;
+  std::vector<float> fEnergy;
+  std::vector<float> fPosX;
+  std::vector<float> fPosY;
+  std::vector<float> fPosZ;
+  std::vector<int> fScinID;
+  std::vector<int> fBarrelSlotID;
+  std::vector<JPetPhysSignal> fSignalA;
+  std::vector<JPetPhysSignal> fSignalB;
+  std::vector<unsigned char> fSignalFlags;
+
+  /// Addresses of the vectors, the tree keeps the addresses of these pointers
+  std::vector<float>* fTimePtr = &fTime;
+  std::vector<float>* fTimeDiffPtr = &fTimeDiff;
+  std::vector<float>* fEnergyPtr = &fEnergy;
+  std::vector<float>* fPosXPtr = &fPosX;
+  std::vector<float>* fPosYPtr = &fPosY;
+  std::vector<float>* fPosZPtr = &fPosZ;
+  std::vector<int>* fScinIDPtr = &fScinID;
+  std::vector<int>* fBarrelSlotIDPtr = &fBarrelSlotID;
+  std::vector<JPetPhysSignal>* fSignalAPtr = &fSignalA;
+  std::vector<JPetPhysSignal>* fSignalBPtr = &fSignalB;
+  std::vector<unsigned char>* fSignalFlagsPtr = &fSignalFlags;
+};
+
+#endif /* !JPETHITCOLUMNS_H */
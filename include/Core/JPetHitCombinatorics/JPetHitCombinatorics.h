@@ -0,0 +1,109 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitCombinatorics.h
+ */
+
+#ifndef JPETHITCOMBINATORICS_H
+#define JPETHITCOMBINATORICS_H
+
+#include "./JPetEvent/JPetEvent.h"
+#include "./JPetGeomMapping/JPetGeomMapping.h"
+#include "./JPetHit/JPetHit.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Generation of the 2 gamma (pairs) and 3 gamma (triplets) candidates from the hits.
+ *
+ * A candidate is a set of hits, in which every two hits fulfill the cuts:
+ * each hit has the energy within [minEnergy, maxEnergy] and a barrel slot known to the mapping,
+ * the time difference of every two hits is not larger than maxTimeDiff and, for the hits
+ * in the same layer, the difference of the slot numbers (delta ID, calculated as in
+ * JPetGeomMapping::calcDeltaID) is within [minDeltaID, maxDeltaID]. Hits from different
+ * layers are combined only if sameLayerOnly is not set.
+ *
+ * Instead of checking all the combinations, the hits are filtered by energy and geometry first,
+ * bucketed by layer (if sameLayerOnly is set) and ordered by time, so that only the hits
+ * within maxTimeDiff from each other are compared. The delta ID and time cuts are checked
+ * for every pair before a triplet containing it is considered. The candidates are returned
+ * as the indices of the hits in the given vector, in the ascending order of the hit times,
+ * so no JPetHit is copied. The order of the candidates in the output is not specified.
+ *
+ * findPairsNaive and findTripletsNaive check all the combinations of the hits
+ * and give the same candidates, they are kept as the reference implementation.
+ */
+class JPetHitCombinatorics
+{
+public:
+  using Pair = std::array<std::uint32_t, 2>;
+  using Triplet = std::array<std::uint32_t, 3>;
+
+  struct Cuts
+  {
+    /// Maximal time difference of two hits of a candidate in [ps]
+    double maxTimeDiff = std::numeric_limits<double>::max();
+    int minDeltaID = 0;
+    int maxDeltaID = std::numeric_limits<int>::max();
+    bool sameLayerOnly = false;
+    double minEnergy = std::numeric_limits<double>::lowest();
+    double maxEnergy = std::numeric_limits<double>::max();
+  };
+
+  explicit JPetHitCombinatorics(const JPetGeomMapping& mapping);
+  JPetHitCombinatorics(const JPetGeomMapping& mapping, const Cuts& cuts);
+
+  void setCuts(const Cuts& cuts);
+  const Cuts& getCuts() const;
+
+  std::size_t findPairs(const std::vector<JPetHit>& hits, std::vector<Pair>& pairs);
+  std::size_t findPairs(const JPetEvent& event, std::vector<Pair>& pairs);
+  std::size_t findTriplets(const std::vector<JPetHit>& hits, std::vector<Triplet>& triplets);
+  std::size_t findTriplets(const JPetEvent& event, std::vector<Triplet>& triplets);
+
+  std::size_t findPairsNaive(const std::vector<JPetHit>& hits, std::vector<Pair>& pairs) const;
+  std::size_t findTripletsNaive(const std::vector<JPetHit>& hits, std::vector<Triplet>& triplets) const;
+
+  bool isAccepted(const JPetHit& hit) const;
+  bool areCompatible(const JPetHit& hit1, const JPetHit& hit2) const;
+
+private:
+  /// Hit passing the single hit cuts, with its geometry taken from the mapping
+  struct Candidate
+  {
+    float time = 0.f;
+    int layer = -1;
+    int slot = -1;
+    std::uint32_t index = 0;
+  };
+
+  bool fillCandidate(const JPetHit& hit, std::uint32_t index, Candidate& candidate) const;
+  bool areCompatible(const Candidate& first, const Candidate& second) const;
+  int calcDeltaID(const Candidate& first, const Candidate& second) const;
+  void collectCandidates(const std::vector<JPetHit>& hits);
+  template <typename Visitor>
+  void forEachTimeWindow(Visitor visitor) const;
+
+  const JPetGeomMapping& fMapping;
+  Cuts fCuts;
+  /// Number of slots in the layer with the number i + 1
+  std::vector<int> fLayersSizes;
+
+  /// Candidates ordered by layer (if sameLayerOnly is set) and time, kept to avoid allocations
+  std::vector<Candidate> fCandidates;
+  /// Indices of the candidates following the current one and compatible with it
+  std::vector<std::uint32_t> fNeighbours;
+};
+
+#endif /* !JPETHITCOMBINATORICS_H */
@@ -16,6 +16,7 @@
 #ifndef JPETMANAGER_H
 #define JPETMANAGER_H
 
+#include "JPetOptionsGenerator/JPetOptionsGenerator.h"
 #include "JPetTaskFactory/JPetTaskFactory.h"
 #include <boost/any.hpp>
 #include <map>
@@ -28,6 +29,8 @@
  * which is responsible for parsing the command line arguments,
  * registering processing tasks, and sending it to JPetTaskExecutor,
  * which executes the chain of registered tasks.
+ * If threads are enabled, the input files are processed by a bounded pool of
+ * workers (see --maxThreads and --largestFileFirst options).
  *
  */
 class JPetManager
@@ -132,6 +135,17 @@ private:
    **/
   void checkDisableLogRotation(const std::map<std::string, boost::any>& opts);
 
+  /**
+   * @brief Processes the input files with at most maxThreads chains executed at the same time.
+   *
+   * Executors are created only when a worker takes the job, so the number of
+   * simultaneously existing parameter banks and open files is bounded as well.
+   * The inputDataSeq identifiers follow the order of the options, independently
+   * of the order of execution. Errors are logged, but do not stop the other files.
+   **/
+  void processInWorkerPool(const jpet_task_factory::TaskGeneratorChain& chainOfTasks, const JPetOptionsGenerator::OptsForFiles& options,
+                           const std::map<std::string, boost::any>& allValidatedOptions);
+
   JPetManager();
   bool fThreadsEnabled = false;
   jpet_task_factory::JPetTaskFactory fTaskFactory;
@@ -0,0 +1,100 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetPrefetchReader.h
+ */
+
+#ifndef JPETPREFETCHREADER_H
+#define JPETPREFETCHREADER_H
+
+#include "./JPetReader/JPetReader.h"
+#include <TNamed.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Reader decoding the next entries of the tree in a background thread.
+ *
+ * The entries are read into a ring of objects allocated once per opened file,
+ * so the current entry can be processed while the next ones are decompressed.
+ * At most entriesToPrefetch entries are read ahead of the current one.
+ * Reading is sequential: nextEntry() takes the already decoded entry, while
+ * nthEntry(), firstEntry() and lastEntry() restart the prefetching from the
+ * requested entry.
+ *
+ * The stall time (time spent waiting in nextEntry() for the background thread)
+ * and the average number of entries ready at the time of taking the next one
+ * can be used to choose entriesToPrefetch.
+ *
+ * The trees with the hit columns (see JPetHitColumns) are read without prefetching.
+ */
+class JPetPrefetchReader : public JPetReader
+{
+public:
+  static const std::size_t kDefaultEntriesToPrefetch;
+
+  explicit JPetPrefetchReader(std::size_t entriesToPrefetch = kDefaultEntriesToPrefetch);
+  JPetPrefetchReader(const char* p_filename, const char* treeName = "T", std::size_t entriesToPrefetch = kDefaultEntriesToPrefetch);
+  virtual ~JPetPrefetchReader();
+  virtual JPetReaderInterface::MyEvent& getCurrentEntry() override;
+  virtual bool nextEntry() override;
+  virtual bool firstEntry() override;
+  virtual bool lastEntry() override;
+  virtual bool nthEntry(long long n) override;
+  virtual void closeFile() override;
+  virtual TObject* getObjectFromFile(const char* name) override;
+  void setLastEntryToRead(long long lastEntry);
+  std::size_t getEntriesToPrefetch() const;
+  std::size_t getQueueDepth() const;
+  double getAverageQueueDepth() const;
+  double getStallTimeInSeconds() const;
+  long long getNumberOfStalls() const;
+
+private:
+  struct Slot
+  {
+    TObject* entry = nullptr;
+    bool isValid = false;
+  };
+
+  bool allocateSlots();
+  void deleteSlots();
+  void startPrefetching(long long firstEntry);
+  void stopPrefetching();
+  void prefetch();
+  bool takeNextSlot();
+
+  std::size_t fEntriesToPrefetch = 1;
+  std::vector<Slot> fSlots;
+  std::size_t fCurrentSlot = 0;
+  std::size_t fReady = 0;
+  bool fHasCurrent = false;
+  long long fNextEntryToRead = 0;
+  long long fLastEntryToRead = -1;
+  bool fProducerDone = true;
+  bool fStopRequested = false;
+  std::thread fPrefetchThread;
+  mutable std::mutex fMutex;
+  std::mutex fFileMutex;
+  std::condition_variable fSlotReady;
+  std::condition_variable fSlotFree;
+  TNamed fEmptyEntry{"Empty event", "Empty event"};
+
+  double fStallTime = 0.0;
+  long long fNumberOfStalls = 0;
+  long long fNumberOfTakes = 0;
+  long long fSumOfQueueDepths = 0;
+};
+
+#endif /* !JPETPREFETCHREADER_H */
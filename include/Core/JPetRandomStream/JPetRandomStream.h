@@ -0,0 +1,54 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRandomStream.h
+ */
+
+#ifndef JPETRANDOMSTREAM_H
+#define JPETRANDOMSTREAM_H
+
+#include <TRandom.h>
+
+/**
+ * @brief Counter-based random number generator giving independent reproducible streams.
+ *
+ * The n-th number of the stream is computed directly from the stream key and n,
+ * so the generator has no state other than the counter. The key is derived from
+ * the seed, the index of the processed file and the index of the event, so the numbers
+ * drawn for a given event do not depend on which thread processes it and in which order.
+ * The class can be used wherever TRandom is expected (e.g. Gaus(), Exp()).
+ */
+class JPetRandomStream : public TRandom
+{
+public:
+  explicit JPetRandomStream(ULong64_t seed = 0, ULong64_t fileIndex = 0, ULong64_t eventIndex = 0);
+  void setStream(ULong64_t seed, ULong64_t fileIndex, ULong64_t eventIndex);
+  void setEventIndex(ULong64_t eventIndex);
+  ULong64_t getCounter() const;
+
+  using TRandom::Rndm;
+  Double_t Rndm() override;
+  void RndmArray(Int_t n, Float_t* array) override;
+  void RndmArray(Int_t n, Double_t* array) override;
+  void SetSeed(ULong_t seed = 0) override;
+  UInt_t GetSeed() const override;
+
+  static ULong64_t deriveKey(ULong64_t seed, ULong64_t fileIndex, ULong64_t eventIndex);
+
+private:
+  ULong64_t fSeed = 0;
+  ULong64_t fFileIndex = 0;
+  ULong64_t fKey = 0;
+  ULong64_t fCounter = 0;
+};
+
+#endif /* !JPETRANDOMSTREAM_H */
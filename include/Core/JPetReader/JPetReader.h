@@ -16,12 +16,14 @@
 #ifndef JPETREADER_H
 #define JPETREADER_H
 
+#include "./JPetHitColumns/JPetHitColumns.h"
 #include "./JPetReaderInterface/JPetReaderInterface.h"
 #include "./JPetTreeHeader/JPetTreeHeader.h"
 #include "./JPetLoggerInclude.h"
 #include <TBranch.h>
 #include <TFile.h>
 #include <TTree.h>
+#include <memory>
 #include <vector>
 
 #ifndef __CINT__
@@ -36,6 +38,10 @@ class boost::noncopyable;
  *
  * All objects inheriting from JPetAnalysisModule should use this class
  * in order to access and read data from ROOT files.
+ *
+ * The trees with the hit windows written column-wise (see JPetHitColumns) are
+ * read column by column: only the columns set with setHitColumns() are read
+ * and the current entry is a JPetTimeWindow with the hits built from them.
  * @todo Add the correct file to 'file_with_no_jpettreeheader' test and
  * see TTree GetEntry method, add test of file with no JPetTreeHeader
  */
@@ -59,18 +65,26 @@ public:
   JPetTreeHeader* getHeaderClone() const;
   virtual TObject* getObjectFromFile(const char* name);
   virtual bool isOpen() const;
+  void setHitColumns(unsigned int columns);
+  bool isHitColumnar() const;
+  const JPetHitColumns* getHitColumns() const;
 
 protected:
   virtual bool openFile(const char* filename);
   virtual bool loadData(const char* treename = "T");
   bool loadCurrentEntry();
   inline bool isCorrectTreeEntryCode (int entryCode) const;
+  void bindHitColumns();
 
   TBranch* fBranch = nullptr;
   TObject* fEntry = nullptr;
   TTree* fTree = nullptr;
   TFile* fFile = nullptr;
   long long fCurrentEntryNumber = -1;
+  unsigned int fHitColumnsToRead = JPetHitColumns::kAll;
+  /// Set only for the trees with the hit columns, the tree keeps the addresses of the columns
+  std::unique_ptr<JPetHitColumns> fHitColumns;
+  std::unique_ptr<JPetTimeWindow> fHitWindow;
 };
 
 #endif /* !JPETREADER_H */
@@ -26,9 +26,14 @@
 #include <TGraph.h>
 #include <TClass.h>
 #include <TEfficiency.h>
+#include <algorithm>
+#include <cassert>
 #include <string>
 #include <map>
+#include <memory>
 #include <set>
+#include <type_traits>
+#include <vector>
 
 class doubleCheck
 {
@@ -39,6 +44,29 @@ public:
   doubleCheck(double newValue) {value=newValue; isChanged=true;}
 };
 
+/**
+ * @brief Typed handle to a histogram stored in JPetStatistics.
+ *
+ * The handle is obtained once, e.g. just after booking the histogram, with
+ * JPetStatistics::getHistoHandle. Filling through the handle accesses the histogram
+ * directly, without the name lookup and type checks done by fillHistogram;
+ * only filling through an empty handle is reported as an error.
+ * The handle does not own the histogram and is valid as long as the statistics object.
+ */
+template <typename T>
+class HistoHandle
+{
+public:
+  HistoHandle() {}
+  explicit HistoHandle(T* histo) : fHisto(histo) {}
+  T* get() const { return fHisto; }
+  T* operator->() const { return fHisto; }
+  explicit operator bool() const { return fHisto != nullptr; }
+
+private:
+  T* fHisto = nullptr;
+};
+
 /**
  * @brief Cointainer class for processing statistics
  *
@@ -77,6 +105,102 @@ public:
   void createCounter(const char* name);
   double& getCounter(const char* name);
   void writeError(const char* nameOfHistogram, const char* messageEnd );
+  void merge(const JPetStatistics& other);
+  void merge(const std::vector<const JPetStatistics*>& others);
+
+  /**
+   * @brief Finds the histogram once and returns the handle used for filling it.
+   * The handle is empty if there is no object with this name or it is not of type T.
+   */
+  template <typename T>
+  HistoHandle<T> getHistoHandle(const char* name)
+  {
+    TObject* object = fStats.FindObject(name);
+    if (!object) {
+      writeError(name, " does not exist");
+      return HistoHandle<T>();
+    }
+    auto histo = dynamic_cast<T*>(object);
+    if (!histo) {
+      writeError(name, (" is not of the requested type " + std::string(T::Class_Name())).c_str());
+    }
+    return HistoHandle<T>(histo);
+  }
+
+  /// Arguments are passed to T::Fill, so for 1D histograms the second one is the weight.
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, double x)
+  {
+    if (!isFillable(handle)) {
+      return;
+    }
+    handle->Fill(x);
+  }
+
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, double x, double y)
+  {
+    if (!isFillable(handle)) {
+      return;
+    }
+    handle->Fill(x, y);
+  }
+
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, double x, double y, double z)
+  {
+    if (!isFillable(handle)) {
+      return;
+    }
+    handle->Fill(x, y, z);
+  }
+
+  /// Fills a 1D histogram with n values at once.
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, const double* x, std::size_t n)
+  {
+    static_assert(!std::is_base_of<TH2, T>::value && !std::is_base_of<TH3, T>::value, "batch fill of x values requires 1D histogram");
+    if (!isFillable(handle)) {
+      return;
+    }
+    handle->FillN(static_cast<Int_t>(n), x, nullptr);
+  }
+
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, const std::vector<double>& x)
+  {
+    fill(handle, x.data(), x.size());
+  }
+
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, const std::vector<float>& x)
+  {
+    if (!isFillable(handle)) {
+      return;
+    }
+    static_assert(!std::is_base_of<TH2, T>::value && !std::is_base_of<TH3, T>::value, "batch fill of x values requires 1D histogram");
+    for (auto value : x) {
+      handle->Fill(value);
+    }
+  }
+
+  /// Fills a 2D histogram with n (x, y) pairs at once.
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, const double* x, const double* y, std::size_t n)
+  {
+    static_assert(std::is_base_of<TH2, T>::value, "batch fill of (x, y) pairs requires 2D histogram");
+    if (!isFillable(handle)) {
+      return;
+    }
+    handle->FillN(static_cast<Int_t>(n), x, y, nullptr);
+  }
+
+  template <typename T>
+  void fill(const HistoHandle<T>& handle, const std::vector<double>& x, const std::vector<double>& y)
+  {
+    assert(x.size() == y.size());
+    fill(handle, x.data(), y.data(), std::min(x.size(), y.size()));
+  }
 
   template <typename T>
   T* getObject(const char* name)
@@ -93,7 +217,41 @@ public:
   ClassDef(JPetStatistics, 5);
 
 protected:
+  /// An empty handle, e.g. of a missing histogram, is reported instead of being dereferenced.
+  template <typename T>
+  static bool isFillable(const HistoHandle<T>& handle)
+  {
+    if (!handle) {
+      ERROR("Filling through an empty histogram handle, see getHistoHandle.");
+      return false;
+    }
+    return true;
+  }
+
   THashTable fStats;
   std::map<TString, double> fCounters;
 };
+
+/**
+ * @brief Set of private statistics containers (shards) of the threads filling the same statistics.
+ *
+ * The copy constructor of JPetStatistics shares the stored objects, so it must not be
+ * used to give each thread its own statistics. Instead, every thread gets an empty shard,
+ * books its own copies of the histograms and counters in it and fills them without any locks.
+ * When all threads are finished, the shards are merged into the master statistics once,
+ * always in the order of their creation, so the result does not depend on thread timing.
+ */
+class JPetStatisticsShards
+{
+public:
+  explicit JPetStatisticsShards(JPetStatistics& master);
+  JPetStatistics& createShard();
+  JPetStatistics& getShard(std::size_t index);
+  std::size_t getNumberOfShards() const;
+  void mergeIntoMaster();
+
+private:
+  JPetStatistics& fMaster;
+  std::vector<std::unique_ptr<JPetStatistics>> fShards;
+};
 #endif /* !_JPET_STATISTICS_H_ */
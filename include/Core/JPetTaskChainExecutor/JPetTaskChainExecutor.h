@@ -20,6 +20,7 @@
 #include <TThread.h>
 #include <functional> // for TaskGenerator declaration
 #include <vector> // for TaskGeneratorChain declaration
+#include <string>
 #include "./JPetParams/JPetParams.h"
 #include "./JPetTaskInterface/JPetTaskInterface.h"
 #include "./JPetTimer/JPetTimer.h"
@@ -32,6 +33,17 @@ using TaskGeneratorChain = std::vector<TaskGenerator>;
  *
  * JPetTaskChainExecutor generates the previously registered chain of tasks.
  * One chain can be run as a thread independently.
+ *
+ * With the pipelinedProcessing option, the consecutive JPetTaskIOLoopPerSubTask
+ * tasks with a single subtask are run at the same time, each in its own thread,
+ * and connected with bounded in-memory queues of time windows. The size of
+ * the queues can be set with the JPetTaskChainExecutor_PipelineQueueSize_int
+ * user option. The names of the tasks listed in the
+ * JPetTaskChainExecutor_SkipOutputEventsOfTasks_std::vector<std::string> user option
+ * do not save their time windows in the intermediate files.
+ *
+ * The index of the processed input file is added to the options of the tasks
+ * as the JPetTaskChainExecutor_FileIndex_int option.
  */
 class JPetTaskChainExecutor
 {
@@ -40,8 +52,18 @@ public :
   TThread* run();
   virtual ~JPetTaskChainExecutor();
   bool process(); /// Method to be called directly only in case of non-thread running;
+
+  static const std::string kPipelineQueueSizeKey;
+  static const std::string kSkipOutputEventsKey;
+  static const std::string kFileIndexKey;
+
 private:
+  using TaskIterator = std::list<std::unique_ptr<JPetTaskInterface> >::iterator;
+
   static void* processProxy(void*);
+  bool processTask(JPetTaskInterface& task, JPetParams& controlParams, JPetTimer& timer);
+  bool processPipeline(TaskIterator first, TaskIterator last, JPetParams& controlParams, JPetTimer& timer);
+  TaskIterator findPipelineEnd(TaskIterator first);
 
   int fInputSeqId = -1;
   std::list<std::unique_ptr<JPetTaskInterface> > fTasks;
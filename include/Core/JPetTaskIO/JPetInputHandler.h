@@ -28,13 +28,28 @@ struct EntryRange {
   long long currentEntry = -1ll;
 };
 
+/**
+ * @brief Helper class handling the input operations performed by JPetReader.
+ *
+ * If the JPetInputHandler_PrefetchEntries_int option is set to a positive number,
+ * the entries are read by JPetPrefetchReader, which decodes the given number
+ * of entries in advance in a background thread.
+ *
+ * From the trees with the hit columns only the columns set with setHitColumns()
+ * are read, unless the JPetInputHandler_HitColumns_std::vector<std::string> option
+ * lists the columns (see JPetHitColumns::parseColumns).
+ */
 class JPetInputHandler
 {
 
 public:
+  static const std::string kPrefetchEntriesKey;
+  static const std::string kHitColumnsKey;
+
   JPetInputHandler();
 
   bool openInput(const char* inputFileName, const JPetParams& params);
+  void setHitColumns(unsigned int columns);
   void closeInput();
   bool setEntryRange(const jpet_options_tools::OptsStrAny& options);
   EntryRange getEntryRange() const;
@@ -55,6 +70,7 @@ private:
   JPetInputHandler(const JPetInputHandler&);
   void operator=(const JPetInputHandler&);
   EntryRange fEntryRange;
+  unsigned int fHitColumns = JPetHitColumns::kAll;
 
 };
 #endif /*  !JPETINPUTHANDLER_H */
@@ -25,6 +25,8 @@
 
 class JPetTreeHeader;
 class JPetTaskInterface;
+class JPetTimeWindow;
+class JPetUserTask;
 
 /**
  * @brief Helper class handles the output operation performed by JPetWriter
@@ -33,14 +35,33 @@ class JPetTaskInterface;
 class JPetOutputHandler
 {
 public:
+  /**
+   * User option key: number of time windows which can wait for the I/O thread.
+   * If greater than 0, the time windows are written asynchronously.
+   */
+  static const std::string kAsyncWindowsKey;
+
+  /**
+   * User option key: columns in which the time windows of hits are written (see JPetHitColumns::parseColumns).
+   * If set, the hits are written column-wise instead of as JPetTimeWindow objects.
+   */
+  static const std::string kHitColumnsKey;
+
   JPetOutputHandler(); 
   explicit JPetOutputHandler(const char* outputFilename);
 
-  void saveOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
-  void saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
+  void saveOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters = true);
+  void saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters = true);
   bool writeEventToFile(JPetTaskInterface* task);
+  bool writeTimeWindow(const JPetTimeWindow& window);
+  bool writeTimeWindow(std::unique_ptr<JPetTimeWindow> window);
+  void enableAsyncWriting(std::size_t maxPendingWindows);
+  void setHitColumns(unsigned int columns);
+  static bool copyEventToSave(JPetTaskInterface* task, std::unique_ptr<JPetTimeWindow>& copy);
 
 protected:
+  bool handOverOutputEvents(JPetUserTask* task);
+
   JPetWriter fWriter;
 
 private:
@@ -24,6 +24,7 @@
 #include "./JPetTaskIO/JPetInputHandler.h"
 #include "./JPetTaskIO/JPetOutputHandler.h"
 #include "./JPetTaskInterface/JPetTaskInterface.h"
+#include "./JPetTimeWindowQueue/JPetTimeWindowQueue.h"
 #include <memory>
 #include <string>
 
@@ -48,6 +49,13 @@ struct TaskIOFileInfo
  * @brief Class representing computing task with input/output operations.
  * It is not meant to be used directly, rather used as specialized classes
  * that must provide an implementation of the method run().
+ *
+ * In the pipelined processing the consecutive tasks are connected with queues:
+ * the task with the input queue takes the time windows from the queue
+ * instead of reading its input file, the task with the output queue passes
+ * the copies of its output to the queue. Saving of the output events
+ * to the file is optional then, the statistics, header and parameters are
+ * always saved.
  */
 class JPetTaskIO : public JPetTask
 {
@@ -64,6 +72,12 @@ public:
   JPetParams getParams() const;
   bool isOutput() const;
   bool isInput() const;
+  JPetParams getOutputParams() const;
+  const JPetTreeHeader* getHeader() const;
+  void connectInputQueue(std::shared_ptr<JPetTimeWindowQueue> queue, const JPetTreeHeader* inputHeader);
+  void connectOutputQueue(std::shared_ptr<JPetTimeWindowQueue> queue);
+  void setSaveOutputEvents(bool save);
+  bool isSaveOutputEvents() const;
 
 protected:
   virtual std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(const jpet_options_tools::OptsStrAny options) const;
@@ -72,6 +86,8 @@ protected:
   const JPetParamBank& getParamBank();
   JPetParamManager& getParamManager();
   std::string getFirstSubTaskName() const;
+  unsigned int getRequiredHitColumns() const;
+  bool writeOutputEvents(JPetTaskInterface* task);
   TaskIOFileInfo fTaskInfo;
   bool fIsOutput = true;
   bool fIsInput = true;
@@ -82,6 +98,10 @@ protected:
   std::unique_ptr<JPetOutputHandler> fOutputHandler{nullptr};
   std::unique_ptr<JPetInputHandler> fInputHandler{nullptr};
   JPetProgressBarManager fProgressBar;
+  std::shared_ptr<JPetTimeWindowQueue> fInputQueue{nullptr};
+  std::shared_ptr<JPetTimeWindowQueue> fOutputQueue{nullptr};
+  const JPetTreeHeader* fInputHeader{nullptr};
+  bool fSaveOutputEvents = true;
 
 private:
   JPetTaskIO(const JPetTaskIO&);
@@ -27,6 +27,8 @@
  * the subtasks are reading the events from those files.
  *
  * This class only overrides the "run" method of its base JPetTaskIO.
+ * If the input queue is connected (pipelined processing), the single subtask
+ * processes the time windows taken from the queue.
  */
 class JPetTaskIOLoopPerSubTask : public JPetTaskIO
 {
@@ -34,5 +36,8 @@ public:
   JPetTaskIOLoopPerSubTask(const char* name = "", const char* in_file_type = "", const char* out_file_type = "");
   virtual bool run(const JPetDataInterface& inData) override;
   virtual ~JPetTaskIOLoopPerSubTask();
+
+protected:
+  bool processEventsFromQueue(JPetTaskInterface* task);
 };
 #endif /*  !JPETTASKIOLOOPPERSUBTASK_H */
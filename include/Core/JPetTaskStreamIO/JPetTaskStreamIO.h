@@ -17,6 +17,10 @@
 #define JPETTASKSTREAMIO_H
 
 #include "./JPetTaskIO/JPetTaskIO.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 /**
  * @brief Class representing a stream of computing tasks (subtasks),
@@ -26,15 +30,38 @@
  * in the stream.
  *
  * This class only overrides the "run" method of its base JPetTaskIO.
+ *
+ * If the option JPetTaskStreamIO_NumberOfWorkers_int is set to N > 1,
+ * the subtasks were added with addSubTaskGenerator and all of them declare
+ * JPetUserTask::isEntryIndependent, the entry range is split across N workers.
+ * Every worker has its own reader of the input file, its own copy of the subtask
+ * chain and its own statistics shards. The processed events are written in the
+ * input order and the shards are merged into the statistics of the main chain
+ * before its subtasks are terminated. Otherwise, e.g. if any subtask keeps a state
+ * between the entries, the events are processed serially.
  */
 class JPetTaskStreamIO : public JPetTaskIO
 {
 public:
+  using SubTaskGenerator = std::function<std::unique_ptr<JPetTaskInterface>()>;
+
+  static const std::string kNumberOfWorkersKey;
+
   JPetTaskStreamIO(const char* name = "", const char* in_file_type = "", const char* out_file_type = "");
   virtual bool run(const JPetDataInterface& inData) override;
   virtual ~JPetTaskStreamIO();
 
+  void addSubTaskGenerator(SubTaskGenerator generator);
+  int getNumberOfWorkers() const;
+
 protected:
+  virtual bool createInputObjects(const char* inputFilename) override;
+  bool processEvents();
+  bool processEventsInParallel(int numberOfWorkers);
+  bool areSubTasksEntryIndependent() const;
+
 private:
+  std::vector<SubTaskGenerator> fSubTaskGenerators;
+  std::string fInputFileName;
 };
 #endif /* !JPETTASKSTREAMIO_H */
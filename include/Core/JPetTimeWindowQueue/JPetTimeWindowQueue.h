@@ -0,0 +1,56 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTimeWindowQueue.h
+ */
+
+#ifndef JPETTIMEWINDOWQUEUE_H
+#define JPETTIMEWINDOWQUEUE_H
+
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Bounded queue of time windows passed between two tasks running in separate threads.
+ *
+ * The producer blocks if the queue is full, the consumer blocks if the queue is empty.
+ * The producer calls close() after the last window. Any side can call abort()
+ * to unblock the other one, e.g. after an error.
+ */
+class JPetTimeWindowQueue
+{
+public:
+  explicit JPetTimeWindowQueue(std::size_t capacity);
+  bool push(std::unique_ptr<JPetTimeWindow> window);
+  bool pop(std::unique_ptr<JPetTimeWindow>& window);
+  void close();
+  void abort();
+  bool isAborted() const;
+  std::size_t getCapacity() const;
+
+private:
+  JPetTimeWindowQueue(const JPetTimeWindowQueue&);
+  void operator=(const JPetTimeWindowQueue&);
+
+  std::size_t fCapacity = 1;
+  std::deque<std::unique_ptr<JPetTimeWindow>> fWindows;
+  bool fClosed = false;
+  bool fAborted = false;
+  mutable std::mutex fMutex;
+  std::condition_variable fNotEmpty;
+  std::condition_variable fNotFull;
+};
+
+#endif /* !JPETTIMEWINDOWQUEUE_H */
@@ -16,6 +16,7 @@
 #ifndef JPETUSERTASK_H
 #define JPETUSERTASK_H
 #include "JPetTask/JPetTask.h"
+#include "JPetHitColumns/JPetHitColumns.h"
 #include "JPetParams/JPetParams.h"
 #include "JPetStatistics/JPetStatistics.h"
 #include "JPetTimeWindowMC/JPetTimeWindowMC.h"
@@ -54,6 +55,11 @@ public:
   jpet_options_tools::OptsStrAny getOptions() const;
   virtual JPetTimeWindow* getOutputEvents();
   JPetTimeWindow* getInputEvents();
+  JPetTimeWindow* swapOutputEvents(JPetTimeWindow* replacement);
+  long long getEntryNumber() const;
+  bool isLastEntry() const;
+  virtual unsigned int getRequiredHitColumns() const;
+  virtual bool isEntryIndependent() const;
 
 protected:
   virtual bool init() = 0; /// should be implemented in descendent class
@@ -63,6 +69,8 @@ protected:
   void clearOutputEvents();  /// It clears the JPetTimeWindow array assigned  to fOutputEvents.
 
   TObject* fEvent = 0;
+  long long fEntryNumber = -1; /// Number of the input file entry of fEvent, -1 if unknown.
+  bool fIsLastEntry = false; /// No following entry is processed after fEvent, see JPetData::isLastEntry.
   JPetStatistics* fStatistics = 0;
   JPetParams fParams;
   JPetTimeWindow* fOutputEvents = 0;
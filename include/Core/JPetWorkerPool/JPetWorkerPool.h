@@ -0,0 +1,50 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWorkerPool.h
+ */
+
+#ifndef JPETWORKERPOOL_H
+#define JPETWORKERPOOL_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Pool of a limited number of threads executing a queue of jobs.
+ *
+ * Jobs are started in the order in which they were added, each free thread
+ * takes the next job from the queue. At most maxThreads jobs run at the same time,
+ * so e.g. the number of simultaneously open files and parameter banks is bounded
+ * independently of the number of jobs.
+ */
+class JPetWorkerPool
+{
+public:
+  using Job = std::function<bool()>;
+
+  explicit JPetWorkerPool(unsigned int maxThreads);
+  void addJob(Job job);
+  bool run();
+  unsigned int getMaxThreads() const;
+  std::size_t getNumberOfJobs() const;
+  static unsigned int getDefaultMaxThreads();
+
+private:
+  JPetWorkerPool(const JPetWorkerPool&);
+  void operator=(const JPetWorkerPool&);
+
+  unsigned int fMaxThreads = 1;
+  std::vector<Job> fJobs;
+};
+
+#endif /* !JPETWORKERPOOL_H */
@@ -29,6 +29,7 @@ class boost::noncopyable;
 #include "JPetEvent/JPetEvent.h"
 #include "JPetFEB/JPetFEB.h"
 #include "JPetHit/JPetHit.h"
+#include "JPetHitColumns/JPetHitColumns.h"
 #include "JPetLOR/JPetLOR.h"
 #include "JPetLoggerInclude.h"
 #include "JPetMCRecoHit/JPetMCRecoHit.h"
@@ -44,7 +45,12 @@ class boost::noncopyable;
 #include <TFile.h>
 #include <TList.h>
 #include <TTree.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 /**
@@ -52,6 +58,16 @@ class boost::noncopyable;
  *
  * All objects inheriting from JPetAnalysisModule should use this class
  * in order to access and write to ROOT files.
+ *
+ * In the asynchronous mode the time windows are filled into the tree
+ * (and compressed) by a dedicated I/O thread. The writing thread hands over
+ * the filled time window and continues; if the I/O thread falls behind by more
+ * than the given number of windows, the writing thread waits. The written windows
+ * are cleared and can be taken back for reuse. Any other write operation and
+ * closeFile() wait until all pending windows are saved.
+ *
+ * If the hit columns are set, the time windows of JPetHit objects are written
+ * column-wise (see JPetHitColumns) instead of as a single JPetTimeWindow branch.
  * @todo Extract consts because it should be common both for Writer and Reader.
  */
 class JPetWriter : private boost::noncopyable
@@ -67,14 +83,33 @@ public:
    */
   static const long long kTreeBufferSize;
 
+  /**
+   * Default number of time windows waiting for the I/O thread in the asynchronous mode.
+   */
+  static const std::size_t kDefaultPendingWindows;
+
   JPetWriter(const char* p_fileName);
   virtual ~JPetWriter(void);
   void closeFile();
   template <class T>
   bool write(const T& obj);
+  bool write(const JPetTimeWindow& obj);
+  bool write(std::unique_ptr<JPetTimeWindow> window);
   void writeHeader(TObject* header);
   void writeCollection(const TCollection* hash, const char* dirname, const char* subdirname = "");
-  int writeObject(const TObject* obj, const char* name) { return fFile->WriteTObject(obj, name); }
+  int writeObject(const TObject* obj, const char* name)
+  {
+    waitForPendingWindows();
+    return fFile->WriteTObject(obj, name);
+  }
+  void enableAsyncWriting(std::size_t maxPendingWindows = kDefaultPendingWindows);
+  bool isAsync() const;
+  void waitForPendingWindows();
+  std::unique_ptr<JPetTimeWindow> takeRecycledWindow(const std::string& eventType);
+  double getBackpressureTimeInSeconds() const;
+  long long getNumberOfBackpressureWaits() const;
+  void setHitColumns(unsigned int columns);
+  unsigned int getHitColumns() const;
   virtual bool isOpen() const
   {
     if (fFile)
@@ -84,39 +119,54 @@ public:
   }
 
 protected:
+  void stopAsyncWriting();
+  void writePendingWindows();
+  bool fillTree(void* entry, const char* name, const char* className);
+  bool fillTimeWindow(const JPetTimeWindow& window);
+  bool fillHitColumns(const JPetTimeWindow& window);
+  bool isWrittenInColumns(const JPetTimeWindow& window) const;
+
   std::string fFileName;
   TFile* fFile;
   bool fIsBranchCreated;
   TTree* fTree;
   TList fTList;
+  /// Object pointed by the branch, the tree keeps the address of this pointer.
+  void* fBranchEntry = nullptr;
+  std::mutex fTreeMutex;
+  /// Columns of the hit windows to write, 0 means that the windows are written as objects
+  unsigned int fHitColumnsToWrite = 0;
+  /// Created with the branches of the first hit window written column-wise
+  std::unique_ptr<JPetHitColumns> fHitColumns;
+
+  std::thread fIOThread;
+  mutable std::mutex fAsyncMutex;
+  std::condition_variable fWindowPending;
+  std::condition_variable fWindowWritten;
+  std::deque<std::unique_ptr<JPetTimeWindow>> fPendingWindows;
+  std::vector<std::unique_ptr<JPetTimeWindow>> fRecycledWindows;
+  std::size_t fMaxPendingWindows = 0;
+  std::size_t fWindowsInProgress = 0;
+  bool fStopIOThread = false;
+  bool fAsyncWriteFailed = false;
+  double fBackpressureTime = 0.0;
+  long long fNumberOfBackpressureWaits = 0;
 };
 
 template <class T>
 bool JPetWriter::write(const T& obj)
 {
   DEBUG("JPetWriter");
-  if (!fFile->IsOpen())
+  if (!fFile || !fFile->IsOpen())
   {
     ERROR("Could not write to file. Have you closed it already?");
     return false;
   }
-  assert(fFile);
-  DEBUG("cd");
-  // http://root.cern.ch/drupal/content/current-director
-  fFile->cd();
-  DEBUG("filler");
+  /// Keeps the order of the entries if some time windows are still waiting for the I/O thread.
+  waitForPendingWindows();
   T* filler = const_cast<T*>(&obj);
   assert(filler);
-  if (!fIsBranchCreated)
-  {
-    DEBUG("Branch name:" + std::string(filler->GetName()));
-    assert(fTree);
-    fTree->Branch(filler->GetName(), filler->GetName(), &filler);
-    fIsBranchCreated = true;
-  }
-  DEBUG("fTree->Fill()");
-  fTree->Fill();
-  return true;
+  return fillTree(filler, filler->GetName(), filler->GetName());
 }
 
 #endif /* !JPETWRITER_H */
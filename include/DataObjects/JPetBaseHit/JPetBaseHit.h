@@ -16,10 +16,10 @@
 #ifndef JPETBASEHIT_H
 #define JPETBASEHIT_H
 
+#include "JPetParamBank/JPetParamRef.h"
 #include "JPetScin/JPetScin.h"
 
 #include <TObject.h>
-#include <TRef.h>
 #include <TVector3.h>
 
 /**
@@ -58,8 +58,9 @@ protected:
   double fTime = 0.0;
   double fEnergy = 0.0;
   TVector3 fPos;
-  TRef fScin = nullptr;
+  JPetParamRef fScin = nullptr;
+  int fScinID = -1;
 
-  ClassDef(JPetBaseHit, 1);
+  ClassDef(JPetBaseHit, 3);
 };
 #endif /* !JPETBASEHIT_H */
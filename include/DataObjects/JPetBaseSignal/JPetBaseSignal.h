@@ -19,15 +19,15 @@
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
 #include "./JPetSigCh/JPetSigCh.h"
 #include "./JPetPM/JPetPM.h"
+#include "./JPetParamBank/JPetParamRef.h"
 #include <TObject.h>
-#include <TRef.h>
 
 /**
  * @brief Base class for all signal data classes
  *
  * Class provides basic construction and methods for more specific Signal classes,
  * such as Raw and Physical Signals. A signal have to assigned to a Barrel Slot
- * and a PhotoMultiplier.
+ * and a PhotoMultiplier, which are referenced as described in JPetParamRefResolver.
  */
 class JPetBaseSignal: public TObject
 {
@@ -37,6 +37,10 @@ public:
   JPetBaseSignal();
   explicit JPetBaseSignal(bool isNull);
   virtual ~JPetBaseSignal();
+  JPetBaseSignal(const JPetBaseSignal&) = default;
+  JPetBaseSignal(JPetBaseSignal&& other) noexcept;
+  JPetBaseSignal& operator=(const JPetBaseSignal&) = default;
+  JPetBaseSignal& operator=(JPetBaseSignal&& other) noexcept;
   void setRecoFlag(JPetBaseSignal::RecoFlag flag);
   JPetBaseSignal::RecoFlag getRecoFlag() const;
   bool isNullObject() const;
@@ -45,37 +49,31 @@ public:
   /**
    * @brief Set the reference to the PhotoMultiplier parametric object
    */
-  inline void setPM(const JPetPM & pm) {
-    fPM = const_cast<JPetPM*>(&pm);
-  }
+  void setPM(const JPetPM & pm);
 
   /**
    * @brief Set the reference to the BarrelSlot parametric object
    */
-  inline void setBarrelSlot(const JPetBarrelSlot & bs) {
-    fBarrelSlot = const_cast<JPetBarrelSlot*>(&bs);
-  }
+  void setBarrelSlot(const JPetBarrelSlot & bs);
 
   /**
    * @brief Obtain a reference to the PhotoMultiplier parametric object
    */
-  inline const JPetPM & getPM() const {
-    return (JPetPM&) *fPM.GetObject();
-  }
+  const JPetPM & getPM() const;
 
   /**
    * @brief Obtain a reference to the BarrelSlot parametric object related
    */
-  inline const JPetBarrelSlot & getBarrelSlot() const {
-    return (JPetBarrelSlot&) *fBarrelSlot.GetObject();
-  }
+  const JPetBarrelSlot & getBarrelSlot() const;
 
   void Clear(Option_t * opt = "");
 
 private:
-  TRef fPM;
-  TRef fBarrelSlot;
+  JPetParamRef fPM;
+  JPetParamRef fBarrelSlot;
   RecoFlag fFlag = JPetBaseSignal::Unknown;
+  int fPMID = -1;
+  int fBarrelSlotID = -1;
 
 protected:
   #ifndef __CINT__
@@ -84,7 +82,7 @@ protected:
   bool fIsNullObject;
   #endif
 
-  ClassDef(JPetBaseSignal, 5);
+  ClassDef(JPetBaseSignal, 7);
 
 };
 #endif /* !JPETBASESIGNAL_H */
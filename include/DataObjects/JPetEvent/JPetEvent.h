@@ -19,6 +19,7 @@
 #include "./JPetEventType/JPetEventType.h"
 #include "./JPetHit/JPetHit.h"
 #include <TObject.h>
+#include <utility>
 #include <vector>
 
 /**
@@ -30,7 +31,10 @@
  * in the ascending time order. This behaviour can be turned off by
  * the orderedByTime flag. Also, when using addHit method the order
  * is NOT guaranteed anymore. It is the users responsibility to sort it in
- * (or not) during the reconstrution/analysis procedures.
+ * (or not) during the reconstrution/analysis procedures, e.g. with sortHitsByTime().
+ * The hits can be moved into the event (constructor, setHits and addHit taking
+ * rvalues) or constructed in place with emplaceHit; reserveHits and Clear,
+ * which keeps the allocated memory, allow to reuse one event without reallocations.
  * The JPetEvent can be flagged with a type (JPetEventType enum),
  * that corresponds to the category of physical process e.g. 2, 3 gamma decay.
  * A given type can be a logical combination of several types by using
@@ -49,11 +53,30 @@ public:
   JPetEvent(const std::vector<JPetHit>& hits,
             JPetEventType eventType = JPetEventType::kUnknown,
             bool orderedByTime = true);
+  JPetEvent(std::vector<JPetHit>&& hits,
+            JPetEventType eventType = JPetEventType::kUnknown,
+            bool orderedByTime = true);
   JPetEvent::RecoFlag getRecoFlag() const;
   const std::vector<JPetHit>& getHits() const;
   void setRecoFlag(JPetEvent::RecoFlag flag);
   void setHits(const std::vector<JPetHit>& hits, bool orderedByTime = true);
+  void setHits(std::vector<JPetHit>&& hits, bool orderedByTime = true);
   void addHit(const JPetHit& hit);
+  void addHit(JPetHit&& hit);
+
+  /**
+   * Constructing the hit in place at the end of the event, this method does not sort
+   * nor order added hits by time.
+   */
+  template <typename... Args>
+  JPetHit& emplaceHit(Args&&... args)
+  {
+    fHits.emplace_back(std::forward<Args>(args)...);
+    return fHits.back();
+  }
+
+  void reserveHits(std::size_t numberOfHits);
+  void sortHitsByTime();
   JPetEventType getEventType() const;
   void setEventType(JPetEventType type);
   void addEventType(JPetEventType type);
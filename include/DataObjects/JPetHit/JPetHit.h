@@ -18,12 +18,13 @@
 
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
 #include "./JPetPhysSignal/JPetPhysSignal.h"
+#include "./JPetParamBank/JPetParamRef.h"
 #include "./JPetScin/JPetScin.h"
 #include "TVector3.h"
 #include "TObject.h"
 #include <cstddef>
+#include <type_traits>
 #include <utility>
-#include <TRef.h>
 
 class JPetBarrelSlot;
 class JPetPhysSignal;
@@ -49,6 +50,10 @@ public:
           TVector3& Position, JPetPhysSignal& SignalA, JPetPhysSignal& SignalB,
           JPetBarrelSlot& BarrelSlot, JPetScin& Scintillator);
   virtual ~JPetHit();
+  JPetHit(const JPetHit&) = default;
+  JPetHit(JPetHit&& other) noexcept;
+  JPetHit& operator=(const JPetHit&) = default;
+  JPetHit& operator=(JPetHit&& other) noexcept;
   JPetHit::RecoFlag getRecoFlag() const;
   float getEnergy() const;
   float getQualityOfEnergy() const;
@@ -66,6 +71,8 @@ public:
   const JPetPhysSignal& getSignalB() const;
   const JPetScin& getScintillator() const;
   const JPetBarrelSlot& getBarrelSlot() const;
+  int getScintillatorID() const;
+  int getBarrelSlotID() const;
   unsigned int getMCindex() const;
   bool isSignalASet()const;
   bool isSignalBSet()const;
@@ -82,6 +89,8 @@ public:
   void setPos (float x, float y, float z) ;
   void setBarrelSlot( JPetBarrelSlot& bs) ;
   void setScintillator(JPetScin& sc) ;
+  void setBarrelSlotID(int id);
+  void setScintillatorID(int id);
   void setSignals(const JPetPhysSignal& p_sigA, const JPetPhysSignal& p_sigB);
   void setSignalA(const JPetPhysSignal& p_sig);
   void setSignalB(const JPetPhysSignal& p_sig);
@@ -103,11 +112,16 @@ private:
   TVector3 fPos;
   JPetPhysSignal fSignalA;
   JPetPhysSignal fSignalB;
-  TRef fBarrelSlot = NULL;
-  TRef fScintillator = NULL;
+  JPetParamRef fBarrelSlot = NULL;
+  JPetParamRef fScintillator = NULL;
   unsigned int fMCindex = kMCindexError;
+  int fBarrelSlotID = -1;
+  int fScintillatorID = -1;
 
-  ClassDef(JPetHit, 8);
+  ClassDef(JPetHit, 10);
 };
 
+/// The vectors of hits, e.g. in JPetEvent, move the hits instead of copying them only if the move is noexcept
+static_assert(std::is_nothrow_move_constructible<JPetHit>::value, "JPetHit move constructor has to be noexcept");
+
 #endif /* !JPETHIT_H */
@@ -0,0 +1,84 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetIndexedLOR.h
+ */
+
+#ifndef JPETINDEXEDLOR_H
+#define JPETINDEXEDLOR_H
+
+#include "./JPetHit/JPetHit.h"
+#include "./JPetLOR/JPetLOR.h"
+#include "./JPetSlimHit/JPetSlimHit.h"
+#include "./JPetSlimHitWindow/JPetSlimHitWindow.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include "./JPetTypedTimeWindow/JPetTypedTimeWindow.h"
+#include <TObject.h>
+
+/**
+ * @brief Line of Response referring to its hits by their indices in a time window
+ *
+ * Counterpart of JPetLOR, which keeps copies of both hits together with their signals.
+ * This class stores only the indices of the first and second hit in the time window
+ * the LOR was built from and the reconstructed LOR quantities, so creating a LOR
+ * for every candidate pair of hits does not copy any hits. The hits are accessed
+ * by passing the owning window (of JPetHit or JPetSlimHit objects) to the getters;
+ * the user is responsible for using the same window the indices refer to.
+ * toLOR() creates the corresponding JPetLOR for the tasks expecting one.
+ */
+class JPetIndexedLOR : public TObject
+{
+public:
+  static const int kNoHit;
+
+  JPetIndexedLOR();
+  JPetIndexedLOR(float time, float qualityOfTime, int firstHitIndex, int secondHitIndex);
+  virtual ~JPetIndexedLOR();
+
+  JPetLOR::RecoFlag getRecoFlag() const;
+  void setRecoFlag(JPetLOR::RecoFlag flag);
+  float getTime() const;
+  float getQualityOfTime() const;
+  void setTime(const float time);
+  void setQualityOfTime(const float qualityOfTime);
+  float getTimeDiff() const;
+  float getQualityOfTimeDiff() const;
+  void setTimeDiff(const float td);
+  void setQualityOfTimeDiff(const float qtd);
+  int getFirstHitIndex() const;
+  int getSecondHitIndex() const;
+  void setHitIndices(int firstHitIndex, int secondHitIndex);
+  bool isHitSet(const unsigned int index) const;
+  bool refersTo(const JPetTimeWindow& window) const;
+  const JPetHit& getFirstHit(const JPetTimeWindow& hits) const;
+  const JPetHit& getSecondHit(const JPetTimeWindow& hits) const;
+  const JPetHit& getFirstHit(const JPetTypedTimeWindow<JPetHit>& hits) const;
+  const JPetHit& getSecondHit(const JPetTypedTimeWindow<JPetHit>& hits) const;
+  const JPetSlimHit& getFirstHit(const JPetSlimHitWindow& hits) const;
+  const JPetSlimHit& getSecondHit(const JPetSlimHitWindow& hits) const;
+  bool isFromSameBarrelSlot(const JPetTimeWindow& hits) const;
+  bool toLOR(const JPetTimeWindow& hits, JPetLOR& lor) const;
+  void Clear(Option_t* opt = "");
+
+private:
+  float fTime = 0.0f;
+  float fQualityOfTime = 0.0f;
+  float fTimeDiff = 0.0f;
+  float fQualityOfTimeDiff = 0.0f;
+  int fFirstHitIndex = kNoHit;
+  int fSecondHitIndex = kNoHit;
+  JPetLOR::RecoFlag fFlag = JPetLOR::Unknown;
+
+  ClassDef(JPetIndexedLOR, 1);
+};
+
+#endif /* !JPETINDEXEDLOR_H */
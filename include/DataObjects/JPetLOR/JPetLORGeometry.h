@@ -0,0 +1,99 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetLORGeometry.h
+ */
+
+#ifndef JPETLORGEOMETRY_H
+#define JPETLORGEOMETRY_H
+
+#include "./JPetHit/JPetHit.h"
+#include "./JPetLOR/JPetLOR.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <TVector3.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Time of flight, annihilation point and line of response parameters
+ * calculated for many LORs at once.
+ *
+ * The positions [cm] and times [ps] of the first and second hits of the LORs are gathered
+ * into plain float arrays (HitArrays): from the LOR objects, from the hits or, the fastest,
+ * from the arrays of the positions and times of all the hits of a window, e.g. read with
+ * JPetHitColumns. The calculate(first, second, lors) kernel processes them in a loop without
+ * branches, which is vectorized by the compiler, and only the angles are calculated
+ * in a separate scalar loop. The results are stored in the arrays of LORArrays:
+ * - tof: time of flight, i.e. the time of the first hit minus the time of the second one,
+ * - annihilation point: the middle of the LOR shifted by tof * c / 2 towards the first hit
+ *   for negative tof (the first hit registered earlier), and its distance from the scanner centre,
+ * - length of the LOR, its angle in the XY plane in [0, pi) and the signed distance of
+ *   its projection on the XY plane from the scanner axis, i.e. the sinogram coordinates.
+ *
+ * The calculateTOF and calculateAnnihilationPoint functions do the same for a single LOR
+ * using TVector3. The object keeps the arrays between the calls, so it does not allocate
+ * once the largest window was processed.
+ */
+class JPetLORGeometry
+{
+public:
+  /// Speed of light in [cm/ps]
+  static const float kLightVelocity_cm_ps;
+
+  struct HitArrays
+  {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> time;
+    void resize(std::size_t size);
+    void set(std::size_t index, const JPetHit& hit);
+    void set(std::size_t index, const HitArrays& hits, std::size_t hitIndex);
+    std::size_t size() const;
+  };
+
+  struct LORArrays
+  {
+    std::vector<float> tof;
+    std::vector<float> pointX;
+    std::vector<float> pointY;
+    std::vector<float> pointZ;
+    std::vector<float> pointDistance;
+    std::vector<float> length;
+    std::vector<float> angle;
+    std::vector<float> distance;
+    void resize(std::size_t size);
+    std::size_t size() const;
+  };
+
+  static float calculateTOF(const JPetHit& firstHit, const JPetHit& secondHit);
+  static TVector3 calculateAnnihilationPoint(const JPetHit& firstHit, const JPetHit& secondHit);
+  static void calculate(const HitArrays& first, const HitArrays& second, LORArrays& lors);
+
+  const LORArrays& calculate(const std::vector<JPetLOR>& lors);
+  const LORArrays& calculate(const JPetTimeWindow& lors);
+  const LORArrays& calculate(const JPetTimeWindow& hits, const JPetTimeWindow& indexedLORs);
+  const LORArrays& calculate(const std::vector<JPetHit>& hits, const std::vector<std::array<std::uint32_t, 2>>& pairs);
+  const LORArrays& calculate(const HitArrays& hits, const std::vector<std::array<std::uint32_t, 2>>& pairs);
+  const LORArrays& getLORs() const;
+
+private:
+  template <typename HitsGetter>
+  const LORArrays& gatherAndCalculate(std::size_t size, HitsGetter getHits);
+
+  HitArrays fFirstHits;
+  HitArrays fSecondHits;
+  LORArrays fLORs;
+};
+
+#endif /* !JPETLORGEOMETRY_H */
@@ -34,6 +34,10 @@ class JPetPhysSignal: public JPetBaseSignal
 public:
   JPetPhysSignal();
   virtual ~JPetPhysSignal();
+  JPetPhysSignal(const JPetPhysSignal&) = default;
+  JPetPhysSignal(JPetPhysSignal&& other) noexcept;
+  JPetPhysSignal& operator=(const JPetPhysSignal&) = default;
+  JPetPhysSignal& operator=(JPetPhysSignal&& other) noexcept;
   bool isNullObject() const;
   explicit JPetPhysSignal(bool isNull);
 
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <utility>
 #include <vector>
+#include <array>
 #include <map>
 
 /**
@@ -28,18 +29,37 @@
  *
  * The signal consists of two arrays of JPetSigCh objects - time value points
  * probed on the leading and trailing edge.
+ * For the thresholds numbered from 1 to kMaxThresholds, the times and threshold
+ * values are also kept in fixed-size per-threshold arrays, so the queries by the
+ * threshold number (getTime, getTOT, getTimes, ...) do not allocate nor copy the
+ * points. The methods returning maps are kept on top of them for compatibility.
  */
 class JPetRawSignal: public JPetBaseSignal
 {
 public:
   enum PointsSortOrder { ByThrValue, ByThrNum };
+  static const int kMaxThresholds = 4;
+  using ThresholdArray = std::array<float, kMaxThresholds>;
 
   JPetRawSignal(const int points = 4);
   virtual ~JPetRawSignal();
+  JPetRawSignal(const JPetRawSignal&) = default;
+  JPetRawSignal(JPetRawSignal&& other) noexcept;
+  JPetRawSignal& operator=(const JPetRawSignal&) = default;
+  JPetRawSignal& operator=(JPetRawSignal&& other) noexcept;
   int getNumberOfPoints(JPetSigCh::EdgeType edge) const;
   void addPoint(const JPetSigCh& sigch);
   std::vector<JPetSigCh> getPoints(JPetSigCh::EdgeType edge,
     JPetRawSignal::PointsSortOrder order = JPetRawSignal::ByThrValue) const;
+  const std::vector<JPetSigCh>& getPointsRef(JPetSigCh::EdgeType edge) const;
+  const JPetSigCh* getPoint(JPetSigCh::EdgeType edge, int thrNumber) const;
+  bool hasTime(JPetSigCh::EdgeType edge, int thrNumber) const;
+  float getTime(JPetSigCh::EdgeType edge, int thrNumber) const;
+  float getThresholdValue(JPetSigCh::EdgeType edge, int thrNumber) const;
+  float getTOT(int thrNumber) const;
+  const ThresholdArray& getTimes(JPetSigCh::EdgeType edge) const;
+  const ThresholdArray& getThresholdValues(JPetSigCh::EdgeType edge) const;
+  bool hasDoubledThreshold(JPetSigCh::EdgeType edge) const;
   std::map<int, double> getTimesVsThresholdNumber(JPetSigCh::EdgeType edge) const;
   std::map<int, std::pair<float, float>> getTimesVsThresholdValue(JPetSigCh::EdgeType edge) const;
   std::map<int, double> getTOTsVsThresholdValue() const;
@@ -47,9 +67,35 @@ public:
 
   void Clear(Option_t * opt = "");
 
+  /**
+   * @brief Points of one edge indexed by the threshold number (minus one).
+   * Missing entries have the JPetSigCh::kUnset time and the point index -1.
+   * It is public only to be built by the read rule (see LinkDef) from the points read from a file.
+   */
+  struct ThresholdIndex
+  {
+    ThresholdArray fTimes;
+    ThresholdArray fThresholds;
+    std::array<int, kMaxThresholds> fPoints;
+    /// More than one point with the same threshold number
+    bool fDoubled = false;
+    /// Points with threshold number out of [1, kMaxThresholds]
+    bool fOutOfRange = false;
+    ThresholdIndex();
+    void reset();
+    void add(const std::vector<JPetSigCh>& points, std::size_t pointIndex);
+    void build(const std::vector<JPetSigCh>& points);
+  };
+
 private:
+  const std::vector<JPetSigCh>& points(JPetSigCh::EdgeType edge) const;
+  const ThresholdIndex& index(JPetSigCh::EdgeType edge) const;
+
   std::vector<JPetSigCh> fLeadingPoints;
   std::vector<JPetSigCh> fTrailingPoints;
+  /// Updated with every added point and built by the read rule, so the const getters never modify them
+  ThresholdIndex fLeadingIndex; //!
+  ThresholdIndex fTrailingIndex; //!
 
   ClassDef(JPetRawSignal, 7);
 };
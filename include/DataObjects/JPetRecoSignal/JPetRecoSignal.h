@@ -47,6 +47,10 @@ public:
   };
   JPetRecoSignal(const int points = 0);
   virtual ~JPetRecoSignal();
+  JPetRecoSignal(const JPetRecoSignal&) = default;
+  JPetRecoSignal(JPetRecoSignal&& other) noexcept;
+  JPetRecoSignal& operator=(const JPetRecoSignal&) = default;
+  JPetRecoSignal& operator=(JPetRecoSignal&& other) noexcept;
 
   /**
    * Get the shape of the signal as a vector of (time[ps], amplitude[mV]) pairs
@@ -21,16 +21,18 @@
 #include "./JPetFEB/JPetFEB.h"
 #include "./JPetTRB/JPetTRB.h"
 #include "./JPetPM/JPetPM.h"
+#include "./JPetParamBank/JPetParamRef.h"
 #include <TClass.h>
 #include <cassert>
 #include <vector>
-#include <TRef.h>
 
 /**
  * @brief Data class representing a Signal from a single tdc Channel.
  *
  * Represents time of signal from one PMT crossing a certain voltage threshold
  * at either leading or trailing edge of the signal.
+ * The parametric objects are referenced by their IDs and, depending on the mode
+ * of JPetParamRefResolver, also by TRefs.
  */
 class JPetSigCh: public TObject
 {
@@ -75,12 +77,16 @@ private:
   float fThreshold = 0.0f;
   unsigned int fThresholdNumber = 0;
   int fDAQch = -1;
-  TRef fPM = NULL;
-  TRef fFEB = NULL;
-  TRef fTRB = NULL;
-  TRef fTOMBChannel = NULL;
+  JPetParamRef fPM = NULL;
+  JPetParamRef fFEB = NULL;
+  JPetParamRef fTRB = NULL;
+  JPetParamRef fTOMBChannel = NULL;
+  int fPMID = -1;
+  int fFEBID = -1;
+  int fTRBID = -1;
+  int fTOMBChannelID = -1;
 
-  ClassDef(JPetSigCh, 9);
+  ClassDef(JPetSigCh, 11);
 };
 
 #endif /* !JPETSIGCH_H */
@@ -0,0 +1,98 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHit.h
+ */
+
+#ifndef JPETSLIMHIT_H
+#define JPETSLIMHIT_H
+
+#include "./JPetBarrelSlot/JPetBarrelSlot.h"
+#include "./JPetHit/JPetHit.h"
+#include "./JPetScin/JPetScin.h"
+#include "TObject.h"
+#include "TVector3.h"
+
+/**
+ * @brief Compact counterpart of JPetHit, referring to its signals by index.
+ *
+ * The slim hit keeps the same reconstructed quantities as JPetHit (energy [keV],
+ * time [ps], position [cm] and their qualities), but instead of two embedded
+ * JPetPhysSignal objects it stores the indices of the signals in the signal
+ * table of its time window (JPetSlimHitWindow), so each signal is stored once
+ * per window. The scintillator and the barrel slot are referenced by ID and
+ * resolved with the param bank bound by JPetParamRefResolver.
+ */
+class JPetSlimHit : public TObject
+{
+public:
+  static const int kNoSignal;
+
+  JPetSlimHit();
+  JPetSlimHit(const JPetHit& hit, int signalAIndex, int signalBIndex);
+  virtual ~JPetSlimHit();
+  JPetHit::RecoFlag getRecoFlag() const;
+  float getEnergy() const;
+  float getQualityOfEnergy() const;
+  float getTime() const;
+  float getQualityOfTime() const;
+  float getTimeDiff() const;
+  float getQualityOfTimeDiff() const;
+  float getPosX() const;
+  float getPosY() const;
+  float getPosZ() const;
+  TVector3 getPos() const;
+  int getScintillatorID() const;
+  int getBarrelSlotID() const;
+  const JPetScin& getScintillator() const;
+  const JPetBarrelSlot& getBarrelSlot() const;
+  int getSignalAIndex() const;
+  int getSignalBIndex() const;
+  bool isSignalASet() const;
+  bool isSignalBSet() const;
+  unsigned int getMCindex() const;
+  void setRecoFlag(JPetHit::RecoFlag flag);
+  void setEnergy(float energy);
+  void setQualityOfEnergy(float qualityOfEnergy);
+  void setTime(float time);
+  void setQualityOfTime(float qualityOfTime);
+  void setTimeDiff(float timeDiff);
+  void setQualityOfTimeDiff(float qualityOfTimeDiff);
+  void setPos(float x, float y, float z);
+  void setScintillatorID(int id);
+  void setBarrelSlotID(int id);
+  void setSignalIndices(int signalAIndex, int signalBIndex);
+  void setMCindex(unsigned int index);
+  void fillHit(JPetHit& hit) const;
+  void Clear(Option_t* opt = "");
+
+private:
+  JPetHit::RecoFlag fFlag = JPetHit::Unknown;
+  float fEnergy = 0.0f;
+  float fQualityOfEnergy = 0.0f;
+  float fTime = 0.0f;
+  float fQualityOfTime = 0.0f;
+  float fTimeDiff = 0.0f;
+  float fQualityOfTimeDiff = 0.0f;
+  float fPosX = 0.0f;
+  float fPosY = 0.0f;
+  float fPosZ = 0.0f;
+  int fScintillatorID = -1;
+  int fBarrelSlotID = -1;
+  int fSignalAIndex = -1;
+  int fSignalBIndex = -1;
+  unsigned int fMCindex = JPetHit::kMCindexError;
+
+  ClassDef(JPetSlimHit, 1);
+};
+
+#endif /* !JPETSLIMHIT_H */
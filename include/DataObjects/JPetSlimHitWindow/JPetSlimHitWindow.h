@@ -0,0 +1,77 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHitWindow.h
+ */
+
+#ifndef _JPETSLIMHITWINDOW_H_
+#define _JPETSLIMHITWINDOW_H_
+
+#include "./JPetHit/JPetHit.h"
+#include "./JPetPhysSignal/JPetPhysSignal.h"
+#include "./JPetSlimHit/JPetSlimHit.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <TClonesArray.h>
+#include <memory>
+
+/**
+ * @brief Time window of JPetSlimHit objects together with the table of their signals
+ *
+ * The hits are the events of the window and their signals are kept in a separate
+ * table of the window, the hits refer to them by index. The table holds the signals
+ * of each hit, the same signal used by two hits is stored twice. The slim hits keep
+ * the reconstructed values as floats and the parametric objects as IDs, and the events
+ * or LORs built from them do not copy the signals. JPetSlimHitWindowTest reports
+ * the sizes of the files written with both kinds of windows.
+ */
+class JPetSlimHitWindow : public JPetTimeWindow
+{
+public:
+  JPetSlimHitWindow() : JPetTimeWindow("JPetSlimHit"), fSignals("JPetPhysSignal", 4000) {}
+
+  virtual ~JPetSlimHitWindow()
+  {
+    fSignals.Clear("C");
+    fSignalCount = 0;
+  }
+
+  virtual std::unique_ptr<JPetTimeWindow> copy() const;
+
+  int addSignal(const JPetPhysSignal& signal);
+  void addHit(const JPetHit& hit);
+  bool fill(const JPetTimeWindow& hits);
+  std::unique_ptr<JPetTimeWindow> toHitWindow() const;
+  void fillHit(int i, JPetHit& hit) const;
+
+  inline const JPetSlimHit& getHit(int i) const { return getEvent<JPetSlimHit>(i); }
+
+  inline size_t getNumberOfSignals() const { return fSignalCount; }
+
+  const JPetPhysSignal& getSignal(int index) const;
+  const JPetPhysSignal& getSignalA(const JPetSlimHit& hit) const;
+  const JPetPhysSignal& getSignalB(const JPetSlimHit& hit) const;
+
+  virtual void Clear()
+  {
+    JPetTimeWindow::Clear();
+    fSignals.Clear("C");
+    fSignalCount = 0;
+  }
+
+  ClassDef(JPetSlimHitWindow, 1);
+
+private:
+  TClonesArray fSignals;
+  unsigned int fSignalCount = 0;
+};
+
+#endif /* !_JPETSLIMHITWINDOW_H_ */
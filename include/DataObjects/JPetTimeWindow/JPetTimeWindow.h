@@ -21,6 +21,7 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <memory>
 
 /**
  * @brief Container class representing a time window of the DAQ system
@@ -46,6 +47,8 @@ public:
     return fEventCount;
   }
 
+  const char* getEventType() const;
+
   inline const TObject& operator[](int i) const
   {
     return *fEvents[i];
@@ -57,6 +60,15 @@ public:
     return *(dynamic_cast<T*>(fEvents[i]));
   }
 
+  /**
+   * @brief Copy of the window with its dynamic type, made with the copy constructor
+   * instead of streaming the whole window as TObject::Clone() does.
+   */
+  virtual std::unique_ptr<JPetTimeWindow> copy() const
+  {
+    return std::unique_ptr<JPetTimeWindow>(new JPetTimeWindow(*this));
+  }
+
   virtual ~JPetTimeWindow()
   {
     fEvents.Clear("C");
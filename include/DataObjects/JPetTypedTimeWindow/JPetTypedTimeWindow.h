@@ -0,0 +1,140 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedTimeWindow.h
+ */
+
+#ifndef _JPETTYPEDTIMEWINDOW_H_
+#define _JPETTYPEDTIMEWINDOW_H_
+
+#include "./JPetLoggerInclude.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include <TObject.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Time window storing the events of a single type T contiguously
+ *
+ * Counterpart of JPetTimeWindow for the tasks that know the type of the events.
+ * The events are kept in a std::vector<T>, so they are added by copy, move or
+ * in place (emplace) and accessed and iterated over without any casts.
+ * Clear() keeps the allocated capacity, so a window reused for consecutive
+ * time windows of the DAQ system stops allocating after the largest one.
+ *
+ * The windows are written and read by ROOT for the types listed in the LinkDef.
+ * Files with JPetTimeWindow objects stay readable as they are; the events are
+ * moved between the two containers with fill() and toTimeWindow().
+ */
+template <typename T>
+class JPetTypedTimeWindow : public TObject
+{
+public:
+  using value_type = T;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  JPetTypedTimeWindow() {}
+
+  explicit JPetTypedTimeWindow(std::size_t capacity) { fEvents.reserve(capacity); }
+
+  virtual ~JPetTypedTimeWindow() {}
+
+  void add(const T& evt) { fEvents.push_back(evt); }
+
+  void add(T&& evt) { fEvents.push_back(std::move(evt)); }
+
+  /**
+   * @brief Constructs the event in place at the end of the window and returns it.
+   */
+  template <typename... Args>
+  T& emplace(Args&&... args)
+  {
+    fEvents.emplace_back(std::forward<Args>(args)...);
+    return fEvents.back();
+  }
+
+  inline std::size_t getNumberOfEvents() const { return fEvents.size(); }
+
+  inline bool empty() const { return fEvents.empty(); }
+
+  /**
+   * @return name of the class of the events stored in the window.
+   */
+  const char* getEventType() const { return T::Class_Name(); }
+
+  inline const T& operator[](std::size_t i) const { return fEvents[i]; }
+
+  inline T& operator[](std::size_t i) { return fEvents[i]; }
+
+  inline const T& getEvent(std::size_t i) const { return fEvents[i]; }
+
+  inline const std::vector<T>& getEvents() const { return fEvents; }
+
+  inline iterator begin() { return fEvents.begin(); }
+  inline iterator end() { return fEvents.end(); }
+  inline const_iterator begin() const { return fEvents.begin(); }
+  inline const_iterator end() const { return fEvents.end(); }
+
+  void reserve(std::size_t capacity) { fEvents.reserve(capacity); }
+
+  inline std::size_t capacity() const { return fEvents.capacity(); }
+
+  /**
+   * @brief Removes the events keeping the allocated storage.
+   */
+  virtual void Clear(Option_t* = "") { fEvents.clear(); }
+
+  /**
+   * @brief Replaces the content of this window with copies of the events of the given JPetTimeWindow,
+   * e.g. one read from a file written before the typed windows were introduced.
+   * @return false, leaving this window empty, if the window contains events of other type than T.
+   */
+  bool fill(const JPetTimeWindow& window)
+  {
+    fEvents.clear();
+    fEvents.reserve(window.getNumberOfEvents());
+    for (std::size_t i = 0; i < window.getNumberOfEvents(); i++)
+    {
+      auto event = dynamic_cast<const T*>(&window[i]);
+      if (!event)
+      {
+        ERROR(Form("Time window with events of type %s cannot be converted to the window of %s.", window.getEventType(), getEventType()));
+        fEvents.clear();
+        return false;
+      }
+      fEvents.push_back(*event);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Copies the events to a new JPetTimeWindow, e.g. to pass them on to a task expecting one.
+   */
+  std::unique_ptr<JPetTimeWindow> toTimeWindow() const
+  {
+    auto window = std::unique_ptr<JPetTimeWindow>(new JPetTimeWindow(getEventType()));
+    for (const auto& event : fEvents)
+    {
+      window->add<T>(event);
+    }
+    return window;
+  }
+
+  ClassDef(JPetTypedTimeWindow, 1);
+
+private:
+  std::vector<T> fEvents;
+};
+
+#endif /* !_JPETTYPEDTIMEWINDOW_H_ */
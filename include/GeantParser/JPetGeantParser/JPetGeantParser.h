@@ -22,10 +22,12 @@
 #include <JPetHit/JPetHit.h>
 #include <JPetMCDecayTree/JPetMCDecayTree.h>
 #include <JPetMCHit/JPetMCHit.h>
+#include <JPetRandomStream/JPetRandomStream.h>
 #include <JPetSmearingFunctions/JPetSmearingFunctions.h>
 #include <JPetUserTask/JPetUserTask.h>
 #include <functional>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -54,7 +56,7 @@ public:
   unsigned long getOriginalSeed() const;
 
 protected:
-  JPetGeomMapping* fDetectorMap = nullptr;
+  std::unique_ptr<JPetGeomMapping> fDetectorMap;
 
   bool fProcessSingleEventinWindow = false;
   bool fMakeEffiHisto = true;
@@ -67,6 +69,12 @@ protected:
 
   JPetHitExperimentalParametrizer fExperimentalParametrizer;
 
+  /// Random numbers of each event are drawn from its own stream derived from
+  /// the seed, the index of the input file and the entry number of the event.
+  JPetRandomStream fRandomStream;
+  long long fFileIndex = 0;
+  long long fProcessedEvents = 0;
+
   // internal variables
   const std::string kMaxTimeWindowParamKey = "GeantParser_MaxTimeWindow_double";
   const std::string kMinTimeWindowParamKey = "GeantParser_MinTimeWindow_double";
@@ -109,6 +117,26 @@ protected:
   void fillHistoMCGen(JPetMCHit&);
   void fillHistoMCRec(JPetHit&);
 
+  // handles of the basic histograms, resolved once at booking
+  HistoHandle<TH1F> fHHitsPerTimeWindow;
+  HistoHandle<TH1F> fHTimeDiffBwDecays;
+  HistoHandle<TH1F> fHGenHitsZPos;
+  HistoHandle<TH1F> fHGenHitTime;
+  HistoHandle<TH1F> fHGenHitEneDepos;
+  HistoHandle<TH1F> fHGenHitMultiplicity;
+  HistoHandle<TH1F> fHGenLifetime;
+  HistoHandle<TH1F> fHHitsZPos;
+  HistoHandle<TH1F> fHRecHitTime;
+  HistoHandle<TH1F> fHRecHitEneDepos;
+  HistoHandle<TH2F> fHGenHitsXyPos;
+  HistoHandle<TH2F> fHGenXY;
+  HistoHandle<TH2F> fHGenXZ;
+  HistoHandle<TH2F> fHGenYZ;
+  HistoHandle<TH2F> fHGenPromptXY;
+  HistoHandle<TH2F> fHGenPromptXZ;
+  HistoHandle<TH2F> fHGenPromptYZ;
+  HistoHandle<TH2F> fHHitsXyPos;
+
   unsigned long nPromptGen = 0u;
   unsigned long nPromptRec = 0u;
   unsigned long n2gGen = 0u;
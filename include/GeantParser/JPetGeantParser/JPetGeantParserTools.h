@@ -43,17 +43,22 @@ public:
   static JPetMCHit createJPetMCHit(JPetGeantScinHits* geantHit, const JPetParamBank& paramBank);
 
   static JPetHit reconstructHit(JPetMCHit& hit, const JPetParamBank& paramBank, const float timeShift, JPetHitExperimentalParametrizer& parametrizer);
+  static JPetHit reconstructHit(JPetMCHit& hit, const JPetGeomMapping& mapping, const float timeShift, JPetHitExperimentalParametrizer& parametrizer);
 
   static bool isHitReconstructed(JPetHit& hit, const float th);
 
   static void identifyRecoHits(JPetGeantScinHits* geantHit, const JPetHit& hit, bool& isRecPrompt, std::array<bool, 2>& isSaved2g,
                                std::array<bool, 3>& isSaved3g, float& enePrompt, std::array<float, 2>& ene2g, std::array<float, 3>& ene3g);
 
-  static float estimateNextDecayTimeExp(float activityMBq);
-  static std::tuple<std::vector<float>, std::vector<float>> getTimeDistoOfDecays(float activityMBq, float timeWindowMin, float timeWindowMax);
+  static float estimateNextDecayTimeExp(float activityMBq, TRandom* random = gRandom);
+  static std::tuple<std::vector<float>, std::vector<float>> getTimeDistoOfDecays(float activityMBq, float timeWindowMin, float timeWindowMax,
+                                                                               TRandom* random = gRandom);
   static std::pair<float, float> calculateEfficiency(ulong, ulong);
 
   static void setSeedTogRandom(unsigned long seed);
+
+private:
+  static JPetHit smearHit(JPetMCHit& hit, const float timeShift, JPetHitExperimentalParametrizer& parametrizer);
 };
 
 #endif
@@ -17,7 +17,14 @@
 #define JPETSMEARINGFUNCTIONS_H
 
 #include <TF1.h>
+#include <TRandom.h>
+#include <array>
+#include <list>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
  * @brief Helper class to store and handle functions to smear Hit properties from MC simulations.
@@ -31,6 +38,14 @@
  * which the smearing is done).
  * e.g. for gaussian smearing with parameters (mean, sigma)  the limit [low,up] would correspond to
  * randomizing in the range [low + mean, high +mean].
+ *
+ * By default the smearing is done with the fast sampling: the default (gaussian) parametrizations
+ * are sampled directly from the truncated normal distribution, and the custom functions are sampled
+ * from inverse cumulative distribution tables. A table is built for each bin of the default parameters
+ * (scinID, zIn, eneIn, timeIn), see setParameterBinning(), and it is shifted by the smeared value,
+ * so the custom functions are assumed to depend on the smeared value only through (x - mean) within a bin.
+ * At most kMaxInverseCDFTables tables are kept for each function, the least recently used one is replaced.
+ * With the fast sampling disabled, TF1::GetRandom() is called for every hit.
  */
 class JPetHitExperimentalParametrizer
 {
@@ -46,6 +61,14 @@ public:
   using FuncAndParam = std::pair<std::string, std::vector<double>>;
   using SmearingFunctionLimits = std::pair<double, double>;
   using FuncPtr = std::unique_ptr<TF1>;
+  /// Bin widths of the parameters scinID, zIn, eneIn, timeIn used for the inverse cumulative distribution tables.
+  /// Parameter with the width equal or smaller than 0 is not binned and is set to 0 while building the table.
+  using ParameterBinning = std::array<double, 4>;
+
+  static const ParameterBinning kDefaultParameterBinning;
+  static const int kCDFPoints;
+  static const int kInverseCDFPoints;
+  static const std::size_t kMaxInverseCDFTables;
 
   JPetHitExperimentalParametrizer();
   JPetHitExperimentalParametrizer(JPetHitExperimentalParametrizer const&) = delete;
@@ -79,9 +102,52 @@ public:
 
   void setSmearingFunctionLimits(const std::vector<std::pair<double, double>>& limits);
 
+  void setFastSampling(bool fastSampling);
+  bool isFastSampling() const;
+  void setParameterBinning(SmearingType type, const ParameterBinning& binning);
+  ParameterBinning getParameterBinning(SmearingType type) const;
+
+  /// The generator is not owned, if it is not set, gRandom is used.
+  void setRandomGenerator(TRandom* random);
+  TRandom* getRandomGenerator() const;
+
 private:
+  using BinKey = std::array<long long, 4>;
+  struct BinKeyHash
+  {
+    std::size_t operator()(const BinKey& key) const;
+  };
+  /// Inverse cumulative distribution tables of the bins, limited to kMaxInverseCDFTables
+  class InverseCDFCache
+  {
+  public:
+    const std::vector<double>* find(const BinKey& key);
+    const std::vector<double>& insert(const BinKey& key, std::vector<double>&& table);
+    void clear();
+
+  private:
+    using Entry = std::pair<BinKey, std::vector<double>>;
+    /// The most recently used table first
+    std::list<Entry> fTables;
+    std::unordered_map<BinKey, std::list<Entry>::iterator, BinKeyHash> fIndex;
+  };
+
+  double sample(SmearingType type, int scinID, double zIn, double eneIn, double timeIn);
+  double sampleWithTF1(SmearingType type, int scinID, double zIn, double eneIn, double timeIn);
+  double getGaussianSigma(SmearingType type, double eneIn) const;
+  double sampleTruncatedGaussian(double mean, double sigma, double low, double high) const;
+  double sampleFromInverseCDF(SmearingType type, int scinID, double zIn, double eneIn, double timeIn);
+  std::vector<double> buildInverseCDF(SmearingType type, const std::array<double, 4>& params) const;
+  void clearInverseCDFTables();
+
   std::map<SmearingType, FuncPtr> fSmearingFunctions;
   std::map<SmearingType, SmearingFunctionLimits> fFunctionLimits{{kTime, {-300, 300}}, {kEnergy, {-100, 100}}, {kZPosition, {-5, 5}}};
+  std::map<SmearingType, bool> fIsDefaultFunction{{kTime, true}, {kEnergy, true}, {kZPosition, true}};
+  std::map<SmearingType, ParameterBinning> fParameterBinning{
+      {kTime, kDefaultParameterBinning}, {kEnergy, kDefaultParameterBinning}, {kZPosition, kDefaultParameterBinning}};
+  std::map<SmearingType, InverseCDFCache> fInverseCDFTables;
+  bool fFastSampling = true;
+  TRandom* fRandom = nullptr;
 };
 
 #endif
@@ -55,6 +55,11 @@ public:
   {
   }
 
+  virtual std::unique_ptr<JPetTimeWindow> copy() const
+  {
+    return std::unique_ptr<JPetTimeWindow>(new JPetTimeWindowMC(*this));
+  }
+
   template<typename T>
   void addMCHit(const T& evt)
   {
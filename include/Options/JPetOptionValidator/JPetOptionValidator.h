@@ -41,6 +41,7 @@ public:
   static bool isLocalDBValid(std::pair<std::string, boost::any> option);
   static bool areFilesValid(std::pair<std::string, boost::any> option);
   static bool isOutputDirectoryValid(std::pair<std::string, boost::any> option);
+  static bool isMaxThreadsValid(std::pair<std::string, boost::any> option);
   static std::map<std::string, boost::any> addNonStandardValidators(const std::map<std::string, boost::any>& optionsMap);
 
   class ManyOptionsWrapper
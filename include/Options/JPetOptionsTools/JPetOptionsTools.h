@@ -53,6 +53,10 @@ long long getTotalEvents(const OptsStrAny& opts);
 int getRunNumber(const OptsStrAny& opts);
 bool isProgressBar(const OptsStrAny& opts);
 bool isDirectProcessing(const OptsStrAny& opts);
+bool isPipelinedProcessing(const OptsStrAny& opts);
+bool isLargestFileFirst(const OptsStrAny& opts);
+bool isIntegerParamRefs(const OptsStrAny& opts);
+int getMaxThreads(const OptsStrAny& opts);
 bool isLocalDB(const OptsStrAny& opts);
 std::string getLocalDB(const OptsStrAny& opts);
 bool isLocalDBCreate(const OptsStrAny& opts);
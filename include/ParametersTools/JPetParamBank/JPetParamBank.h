@@ -30,8 +30,25 @@
 #include "JPetPM/JPetPM.h"
 
 #include <cassert>
+#include <deque>
 #include <map>
+#include <memory>
+#include <vector>
 
+/**
+ * @brief Container of all the parameter objects describing the detector setup.
+ *
+ * The objects added to the bank are stored in the contiguous per-type containers shared
+ * by all the copies of the bank, so copying the bank does not copy the parameter objects.
+ * Apart from the maps ID -> object, dense tables indexed by the ID are kept, so that the
+ * getters of single objects (getPM(id), getScintillator(id), ...) are simple array lookups.
+ *
+ * The getters return non-const references, as before the objects were shared, but a change
+ * made to an object through any copy of the bank is seen by the original and by all the other
+ * copies (the banks handed out by JPetParamManager are shared in the same way). The objects
+ * must not be modified once the bank is filled; to change the parameters, fill a new bank
+ * with the modified objects. The objects added to a copy later are not seen by the original.
+ */
 class JPetParamBank : public TObject {
 public:
   JPetParamBank();
@@ -40,19 +57,21 @@ public:
   ~JPetParamBank();
   bool isDummy() const;
   void clear();
+  void rebuildIndex();
   int getSize(ParamObjectType type) const;
+  static const int kMaxDenseIndex;
 
   /**
    * Adds scintillator to Param Bank. If the scintillator with the same ID
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addScintillator(JPetScin scintillator) {
-    if (fScintillators.insert(std::make_pair(scintillator.getID(), new JPetScin(scintillator))).second == false) {
+    if (!addObject(fScintillators, fScintillatorsIndex, getStorage().fScintillators, scintillator.getID(), scintillator)) {
       WARNING("the scintillator with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetScin*>& getScintillators() const { return fScintillators; }
-  inline JPetScin& getScintillator(int i) const { return *(fScintillators.at(i)); }
+  inline JPetScin& getScintillator(int i) const { return findObject(fScintillators, fScintillatorsIndex, i); }
   inline int getScintillatorsSize() const { return fScintillators.size(); }
 
   /**
@@ -60,12 +79,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addPM(JPetPM pm) {
-    if (fPMs.insert(std::make_pair(pm.getID(), new JPetPM(pm))).second == false) {
+    if (!addObject(fPMs, fPMsIndex, getStorage().fPMs, pm.getID(), pm)) {
       WARNING("the pm with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetPM*>& getPMs() const { return fPMs; }
-  inline JPetPM& getPM(int id) const { return *(fPMs.at(id)); }
+  inline JPetPM& getPM(int id) const { return findObject(fPMs, fPMsIndex, id); }
   int getPMsSize() const { return fPMs.size(); }
 
   /**
@@ -73,12 +92,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addFEB(JPetFEB feb) {
-    if (fFEBs.insert(std::make_pair(feb.getID(), new JPetFEB(feb))).second == false) {
+    if (!addObject(fFEBs, fFEBsIndex, getStorage().fFEBs, feb.getID(), feb)) {
       WARNING("the feb with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetFEB*>& getFEBs() const { return fFEBs; }
-  inline JPetFEB& getFEB(int i) const { return *(fFEBs.at(i)); }
+  inline JPetFEB& getFEB(int i) const { return findObject(fFEBs, fFEBsIndex, i); }
   inline int getFEBsSize() const { return fFEBs.size(); }
 
   /**
@@ -86,12 +105,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addTRB(JPetTRB trb) {
-    if (fTRBs.insert(std::make_pair(trb.getID(), new JPetTRB(trb))).second == false) {
+    if (!addObject(fTRBs, fTRBsIndex, getStorage().fTRBs, trb.getID(), trb)) {
       WARNING("the trb with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetTRB*>& getTRBs() const { return fTRBs; }
-  inline JPetTRB& getTRB(int i) const { return *(fTRBs.at(i)); }
+  inline JPetTRB& getTRB(int i) const { return findObject(fTRBs, fTRBsIndex, i); }
   inline int getTRBsSize() const { return fTRBs.size(); }
 
   /**
@@ -99,12 +118,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addBarrelSlot(JPetBarrelSlot slot) {
-    if (fBarrelSlots.insert(std::make_pair(slot.getID(), new JPetBarrelSlot(slot))).second == false) {
+    if (!addObject(fBarrelSlots, fBarrelSlotsIndex, getStorage().fBarrelSlots, slot.getID(), slot)) {
       WARNING("the barrelslot with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetBarrelSlot*>& getBarrelSlots() const { return fBarrelSlots; }
-  inline JPetBarrelSlot& getBarrelSlot(int i) const { return *(fBarrelSlots.at(i)); }
+  inline JPetBarrelSlot& getBarrelSlot(int i) const { return findObject(fBarrelSlots, fBarrelSlotsIndex, i); }
   inline int getBarrelSlotsSize() const { return fBarrelSlots.size(); }
 
   /**
@@ -112,12 +131,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addLayer(JPetLayer layer) {
-    if (fLayers.insert(std::make_pair(layer.getID(), new JPetLayer(layer))).second == false) {
+    if (!addObject(fLayers, fLayersIndex, getStorage().fLayers, layer.getID(), layer)) {
       WARNING("the layer with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetLayer*>& getLayers() const { return fLayers; }
-  inline JPetLayer& getLayer(int i) const { return *(fLayers.at(i)); }
+  inline JPetLayer& getLayer(int i) const { return findObject(fLayers, fLayersIndex, i); }
   inline int getLayersSize() const { return fLayers.size(); }
 
   /**
@@ -125,12 +144,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addFrame(JPetFrame frame) {
-    if (fFrames.insert(std::make_pair(frame.getID(), new JPetFrame(frame))).second == false) {
+    if (!addObject(fFrames, fFramesIndex, getStorage().fFrames, frame.getID(), frame)) {
       WARNING("the frame with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetFrame*>& getFrames() const { return fFrames; }
-  inline JPetFrame& getFrame(int i) const { return *(fFrames.at(i)); }
+  inline JPetFrame& getFrame(int i) const { return findObject(fFrames, fFramesIndex, i); }
   inline int getFramesSize() const { return fFrames.size(); }
 
   /**
@@ -138,12 +157,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addTOMBChannel(JPetTOMBChannel tombchannel) {
-    if (fTOMBChannels.insert(std::make_pair(tombchannel.getChannel(), new JPetTOMBChannel(tombchannel))).second == false) {
+    if (!addObject(fTOMBChannels, fTOMBChannelsIndex, getStorage().fTOMBChannels, tombchannel.getChannel(), tombchannel)) {
       WARNING("the tombchannel with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetTOMBChannel*>& getTOMBChannels() const { return fTOMBChannels; }
-  inline JPetTOMBChannel& getTOMBChannel(int i) const { return *(fTOMBChannels.at(i)); }
+  inline JPetTOMBChannel& getTOMBChannel(int i) const { return findObject(fTOMBChannels, fTOMBChannelsIndex, i); }
   inline int getTOMBChannelsSize() const { return fTOMBChannels.size(); }
 
   /**
@@ -151,12 +170,12 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addDataSource(JPetDataSource dataSource) {
-    if (fDataSources.insert(std::make_pair(dataSource.getID(), new JPetDataSource(dataSource))).second == false) {
+    if (!addObject(fDataSources, fDataSourcesIndex, getStorage().fDataSources, dataSource.getID(), dataSource)) {
       WARNING("The Data Source with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetDataSource*>& getDataSources() const { return fDataSources; }
-  inline JPetDataSource& getDataSource(int i) const { return *(fDataSources.at(i)); }
+  inline JPetDataSource& getDataSource(int i) const { return findObject(fDataSources, fDataSourcesIndex, i); }
   inline int getDataSourcesSize() const { return fDataSources.size(); }
 
   /**
@@ -164,20 +183,50 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addDataModule(JPetDataModule dataModule) {
-    if (fDataModules.insert(std::make_pair(dataModule.getID(), new JPetDataModule(dataModule))).second == false) {
+    if (!addObject(fDataModules, fDataModulesIndex, getStorage().fDataModules, dataModule.getID(), dataModule)) {
       WARNING("The Data Module with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetDataModule*>& getDataModules() const { return fDataModules; }
-  inline JPetDataModule& getDataModule(int i) const { return *(fDataModules.at(i)); }
+  inline JPetDataModule& getDataModule(int i) const { return findObject(fDataModules, fDataModulesIndex, i); }
   inline int getDataModulesSize() const { return fDataModules.size(); }
 
+  /**
+   * Lookups used to resolve the integer references stored in the data objects (see JPetParamRefResolver).
+   * Unlike the getters above, they do not throw, but return nullptr if there is no object with the given ID.
+   */
+  inline const JPetPM* findPM(int id) const { return findObjectPtr(fPMs, fPMsIndex, id); }
+  inline const JPetFEB* findFEB(int id) const { return findObjectPtr(fFEBs, fFEBsIndex, id); }
+  inline const JPetTRB* findTRB(int id) const { return findObjectPtr(fTRBs, fTRBsIndex, id); }
+  inline const JPetTOMBChannel* findTOMBChannel(int channel) const { return findObjectPtr(fTOMBChannels, fTOMBChannelsIndex, channel); }
+  inline const JPetBarrelSlot* findBarrelSlot(int id) const { return findObjectPtr(fBarrelSlots, fBarrelSlotsIndex, id); }
+  inline const JPetScin* findScintillator(int id) const { return findObjectPtr(fScintillators, fScintillatorsIndex, id); }
+
   Int_t Write(const char* name, Int_t option, Int_t bufsize) const { return TObject::Write(name, option, bufsize); }
 
   Int_t Write(const char* name, Int_t option, Int_t bufsize) { return ((const JPetParamBank*)this)->Write(name, option, bufsize); }
 
 private:
+  /**
+   * Storage owning the objects added to the bank. Deques are used instead of vectors,
+   * because the objects are linked with each other by TRefs, so their addresses must
+   * not change when new objects are added. The storage is shared by the bank copies.
+   */
+  struct Storage {
+    std::deque<JPetTOMBChannel> fTOMBChannels;
+    std::deque<JPetDataSource> fDataSources;
+    std::deque<JPetDataModule> fDataModules;
+    std::deque<JPetBarrelSlot> fBarrelSlots;
+    std::deque<JPetScin> fScintillators;
+    std::deque<JPetLayer> fLayers;
+    std::deque<JPetFrame> fFrames;
+    std::deque<JPetFEB> fFEBs;
+    std::deque<JPetTRB> fTRBs;
+    std::deque<JPetPM> fPMs;
+  };
+
   void operator=(const JPetParamBank&);
+  Storage& getStorage();
   bool fDummy;
 
   std::map<int, JPetTOMBChannel*> fTOMBChannels;
@@ -191,10 +240,67 @@ private:
   std::map<int, JPetTRB*> fTRBs;
   std::map<int, JPetPM*> fPMs;
 
-  template <typename T> void copyMapValues(std::map<int, T*>& target, const std::map<int, T*>& source) {
-    for (auto& c : source) {
-      target[c.first] = new T(*c.second);
+  std::shared_ptr<Storage> fStorage; //!
+  std::vector<JPetTOMBChannel*> fTOMBChannelsIndex; //!
+  std::vector<JPetDataSource*> fDataSourcesIndex; //!
+  std::vector<JPetDataModule*> fDataModulesIndex; //!
+  std::vector<JPetBarrelSlot*> fBarrelSlotsIndex; //!
+  std::vector<JPetScin*> fScintillatorsIndex; //!
+  std::vector<JPetLayer*> fLayersIndex; //!
+  std::vector<JPetFrame*> fFramesIndex; //!
+  std::vector<JPetFEB*> fFEBsIndex; //!
+  std::vector<JPetTRB*> fTRBsIndex; //!
+  std::vector<JPetPM*> fPMsIndex; //!
+
+  /**
+   * Puts the copy of the object to the storage and registers it in the map and the dense index.
+   * Returns false if the object with the same ID is already present.
+   */
+  template <typename T>
+  static bool addObject(std::map<int, T*>& objects, std::vector<T*>& index, std::deque<T>& storage, int id, const T& object) {
+    if (objects.count(id)) {
+      return false;
+    }
+    storage.push_back(object);
+    objects.insert(std::make_pair(id, &storage.back()));
+    addToIndex(index, id, &storage.back());
+    return true;
+  }
+
+  template <typename T> static void addToIndex(std::vector<T*>& index, int id, T* object) {
+    if (id < 0 || id >= kMaxDenseIndex) {
+      return;
+    }
+    if (id >= static_cast<int>(index.size())) {
+      index.resize(id + 1, nullptr);
+    }
+    index[id] = object;
+  }
+
+  template <typename T> static void rebuildIndex(std::vector<T*>& index, const std::map<int, T*>& objects) {
+    index.clear();
+    for (const auto& el : objects) {
+      addToIndex(index, el.first, el.second);
+    }
+  }
+
+  /**
+   * Returns the object with the given ID. The dense index is used if possible, the map otherwise.
+   * Throws std::out_of_range if there is no such object, as std::map::at does.
+   */
+  template <typename T> static T& findObject(const std::map<int, T*>& objects, const std::vector<T*>& index, int id) {
+    if (id >= 0 && id < static_cast<int>(index.size()) && index[id]) {
+      return *index[id];
+    }
+    return *(objects.at(id));
+  }
+
+  template <typename T> static const T* findObjectPtr(const std::map<int, T*>& objects, const std::vector<T*>& index, int id) {
+    if (id >= 0 && id < static_cast<int>(index.size()) && index[id]) {
+      return index[id];
     }
+    auto it = objects.find(id);
+    return it != objects.end() ? it->second : nullptr;
   }
 
   ClassDef(JPetParamBank, 7);
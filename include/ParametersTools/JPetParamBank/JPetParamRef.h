@@ -0,0 +1,50 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamRef.h
+ */
+
+#ifndef JPETPARAMREF_H
+#define JPETPARAMREF_H
+
+#include <TRef.h>
+
+/**
+ * @brief TRef from a data object to a parametric object, written only if it is set.
+ *
+ * A plain TRef is written with the same size whether it is set or not. This reference
+ * is written as a one byte flag, followed by the TRef only if the reference is set,
+ * so the references left unset in the kIntegerID mode of JPetParamRefResolver
+ * do not enlarge the written objects.
+ */
+class JPetParamRef : public TRef
+{
+public:
+  JPetParamRef() {}
+  JPetParamRef(TObject* object) : TRef(object) {}
+  JPetParamRef(const TRef& ref) : TRef(ref) {}
+  JPetParamRef& operator=(TObject* object)
+  {
+    TRef::operator=(object);
+    return *this;
+  }
+  JPetParamRef& operator=(const TRef& ref)
+  {
+    TRef::operator=(ref);
+    return *this;
+  }
+  bool isSet() const { return GetUniqueID() != 0; }
+
+  ClassDef(JPetParamRef, 1);
+};
+
+#endif /* !JPETPARAMREF_H */
@@ -0,0 +1,93 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamRefResolver.h
+ */
+
+#ifndef JPETPARAMREFRESOLVER_H
+#define JPETPARAMREFRESOLVER_H
+
+#include "./JPetParamBank/JPetParamBank.h"
+#include <TRef.h>
+
+/**
+ * @brief Resolves the references from the data objects (JPetSigCh, signals, hits)
+ * to the parametric objects.
+ *
+ * The data objects store the ID of each referenced parametric object and, in the
+ * kTRef mode (default), also a TRef to it. In the kIntegerID mode the TRefs are not
+ * set, so they are written as a single byte (see JPetParamRef), which makes the objects
+ * smaller, and the ROOT process ID table is not used when setting the references.
+ * A set TRef pointing to a loaded object is always used. Otherwise the ID is resolved
+ * with the dense lookup tables of the param bank bound to the current thread, e.g. the
+ * bank read from the same input file; JPetUserTask binds its bank while processing
+ * an event.
+ */
+class JPetParamRefResolver
+{
+public:
+  enum RefMode
+  {
+    kTRef,
+    kIntegerID
+  };
+  static const int kNoID;
+
+  static void setRefMode(RefMode mode);
+  static RefMode getRefMode();
+  static bool isTRefMode();
+
+  static void bind(const JPetParamBank* bank);
+  static const JPetParamBank* getBoundBank();
+
+  /**
+   * @brief Binds the bank to the current thread for the lifetime of the object
+   * and restores the previous binding afterwards.
+   */
+  class Binding
+  {
+  public:
+    explicit Binding(const JPetParamBank* bank);
+    ~Binding();
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+
+  private:
+    const JPetParamBank* fPrevious = nullptr;
+  };
+
+  static const JPetPM* resolvePM(int id, const TRef& ref);
+  static const JPetFEB* resolveFEB(int id, const TRef& ref);
+  static const JPetTRB* resolveTRB(int id, const TRef& ref);
+  static const JPetTOMBChannel* resolveTOMBChannel(int channel, const TRef& ref);
+  static const JPetBarrelSlot* resolveBarrelSlot(int id, const TRef& ref);
+  static const JPetScin* resolveScin(int id, const TRef& ref);
+
+  /**
+   * @brief Sets the reference to the given object: always its ID, and the TRef only in the kTRef mode.
+   */
+  template <typename T>
+  static void setRef(int& id, TRef& ref, const T& object, int objectID)
+  {
+    id = objectID;
+    if (isTRefMode())
+    {
+      ref = const_cast<T*>(&object);
+    }
+    else
+    {
+      ref = nullptr;
+    }
+  }
+};
+
+#endif /* !JPETPARAMREFRESOLVER_H */
@@ -0,0 +1,75 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamAsciiCache.h
+ */
+
+#ifndef JPETPARAMASCIICACHE_H
+#define JPETPARAMASCIICACHE_H
+
+#include "./JPetParamGetter/JPetParamGetter.h"
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Parameter object descriptions of a single run from the local json DB,
+ * indexed by the object type and the object ID.
+ */
+struct JPetParamAsciiRun
+{
+  std::map<ParamObjectType, ParamObjectsDescriptions> fDescriptions;
+};
+
+/**
+ * @brief Process-wide cache of the parsed local json parameter DB files.
+ *
+ * Each file is parsed only once and the content of all its runs is indexed by
+ * the object type and ID. The entries are keyed by the file path, its modification
+ * time and size, and the run ID, so a modified file is parsed again on the next access.
+ * The returned run data are immutable and can be shared by many param getters
+ * and task chain executors, also from different threads.
+ */
+class JPetParamAsciiCache
+{
+public:
+  static JPetParamAsciiCache& getInstance();
+  std::shared_ptr<const JPetParamAsciiRun> getRun(const std::string& filename, const int runID);
+  void invalidate(const std::string& filename);
+  void clear();
+  std::size_t getNumberOfParsings() const;
+  static std::shared_ptr<JPetParamAsciiRun> parseRun(const boost::property_tree::ptree& runContents);
+
+private:
+  struct ParsedFile
+  {
+    std::time_t fModificationTime = 0;
+    std::uintmax_t fSize = 0;
+    std::map<int, std::shared_ptr<const JPetParamAsciiRun>> fRuns;
+  };
+
+  JPetParamAsciiCache() {}
+  JPetParamAsciiCache(const JPetParamAsciiCache&) = delete;
+  JPetParamAsciiCache& operator=(const JPetParamAsciiCache&) = delete;
+  ParsedFile parseFile(const std::string& filename) const;
+  static ParamObjectDescription toDescription(const boost::property_tree::ptree& info);
+
+  mutable std::mutex fMutex;
+  std::map<std::string, ParsedFile> fFiles;
+  std::size_t fNumberOfParsings = 0;
+};
+
+#endif /* !JPETPARAMASCIICACHE_H */
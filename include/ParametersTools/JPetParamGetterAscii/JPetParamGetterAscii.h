@@ -17,10 +17,16 @@
 #define JPETPARAMGETTERASCII_H
 
 #include "./JPetParamGetter/JPetParamGetter.h"
-#include <boost/property_tree/ptree.hpp>
 #include <string>
+#include <memory>
 #include <map>
 
+/**
+ * @brief Param getter reading the parameter objects from the local json DB file.
+ *
+ * The file content is taken from the process-wide JPetParamAsciiCache,
+ * so the same file is parsed only once for all the getters using it.
+ */
 class JPetParamGetterAscii : public JPetParamGetter
 {
 public:
@@ -34,7 +40,7 @@ public:
 private:
   JPetParamGetterAscii(const JPetParamGetterAscii &paramGetterAscii);
   JPetParamGetterAscii& operator=(const JPetParamGetterAscii &paramGetterAscii);
-  ParamObjectDescription toDescription(boost::property_tree::ptree & info);
+  std::shared_ptr<const ParamObjectsDescriptions> getDescriptions(ParamObjectType type, const int runID);
   std::string filename;
 };
 
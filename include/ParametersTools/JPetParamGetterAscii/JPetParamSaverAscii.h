@@ -26,6 +26,7 @@ class JPetParamSaverAscii
 public:
   JPetParamSaverAscii() {}
   void saveParamBank(const JPetParamBank & bank, const int runNumber, const std::string & filename);
+  boost::property_tree::ptree getRunContents(const JPetParamBank & bank);
 
 private:
   JPetParamSaverAscii(const JPetParamSaverAscii &paramSaver);
@@ -0,0 +1,71 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBankRegistry.h
+ */
+
+#ifndef JPETPARAMBANKREGISTRY_H
+#define JPETPARAMBANKREGISTRY_H
+
+#include "./JPetParamBank/JPetParamBank.h"
+#include "./JPetParamGetter/JPetParamConstants.h"
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+/**
+ * @brief Process-wide registry of the parameter banks generated from the local DB.
+ *
+ * A bank is built only once for a given run ID, DB file and set of object types
+ * expected to be missing, and all the param managers (one per task chain executor,
+ * i.e. per input file) obtain a shared, immutable handle to it. The entries are
+ * keyed also by the modification time and size of the DB file, so a modified
+ * file results in a new bank. The banks are kept until they are released,
+ * invalidated or the registry is cleared. The handles already given out stay valid.
+ */
+class JPetParamBankRegistry
+{
+public:
+  using BankBuilder = std::function<std::shared_ptr<JPetParamBank>()>;
+
+  static JPetParamBankRegistry& getInstance();
+  std::shared_ptr<const JPetParamBank> getBank(const int runID, const std::string& dbFile, const std::set<ParamObjectType>& expectMissing,
+                                               const BankBuilder& builder);
+  void release(const int runID, const std::string& dbFile);
+  std::size_t releaseUnused();
+  void invalidate(const std::string& dbFile);
+  void clear();
+  std::size_t getNumberOfBuilds() const;
+  std::size_t getNumberOfBanks() const;
+
+private:
+  using Key = std::tuple<std::string, std::time_t, std::uintmax_t, int, std::set<ParamObjectType>>;
+
+  JPetParamBankRegistry() {}
+  JPetParamBankRegistry(const JPetParamBankRegistry&) = delete;
+  JPetParamBankRegistry& operator=(const JPetParamBankRegistry&) = delete;
+
+  using BankFuture = std::shared_future<std::shared_ptr<const JPetParamBank>>;
+
+  mutable std::mutex fMutex;
+  std::map<Key, BankFuture> fBanks;
+  std::size_t fNumberOfBuilds = 0;
+};
+
+#endif /* !JPETPARAMBANKREGISTRY_H */
@@ -34,6 +34,7 @@
 #include <boost/any.hpp>
 #include <cassert>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <set>
@@ -41,17 +42,17 @@
 class JPetParamManager
 {
 public:
-  explicit JPetParamManager(): fParamGetter(), fBank(0), fIsNullObject(false) {}
+  explicit JPetParamManager(): fParamGetter(), fIsNullObject(false) {}
   explicit JPetParamManager(JPetParamGetter* paramGetter):
-    fParamGetter(paramGetter), fBank(0) , fIsNullObject(false) {}
+    fParamGetter(paramGetter), fIsNullObject(false) {}
   explicit JPetParamManager(JPetParamGetter* paramGetter, const std::set<ParamObjectType>& expectMissing):
-    fParamGetter(paramGetter), fExpectMissing(expectMissing), fBank(0), fIsNullObject(false) {}
+    fParamGetter(paramGetter), fExpectMissing(expectMissing), fIsNullObject(false) {}
 
   /**
    * Special constructor to create NullObject. This object can be returned
    * if JPetParamManager is not created, and the const& is expected to be returned.
    */
-  explicit JPetParamManager(bool isNull): fParamGetter(), fBank(0), fIsNullObject(isNull) {}
+  explicit JPetParamManager(bool isNull): fParamGetter(), fIsNullObject(isNull) {}
   ~JPetParamManager();
 
   /**
@@ -78,15 +79,23 @@ public:
   bool saveParametersToFile(std::string filename);
   void clearParameters();
   const JPetParamBank& getParamBank() const;
+  std::shared_ptr<const JPetParamBank> getSharedParamBank() const;
   inline bool isNullObject() const { return fIsNullObject; }
   inline std::set<ParamObjectType> getExpectMissing() const { return fExpectMissing; }
+  /**
+   * Name of the local DB file the parameters are read from. If set, the banks are
+   * shared through JPetParamBankRegistry by all the managers using the same file.
+   */
+  inline const std::string& getDBSource() const { return fDBSource; }
+  inline void setDBSource(const std::string& dbSource) { fDBSource = dbSource; }
 
 private:
   JPetParamManager(const JPetParamManager&);
   JPetParamManager& operator=(const JPetParamManager&);
   JPetParamGetter* fParamGetter = nullptr;
   std::set<ParamObjectType> fExpectMissing;
-  JPetParamBank* fBank = nullptr;
+  std::string fDBSource;
+  std::shared_ptr<const JPetParamBank> fBank;
   bool fIsNullObject;
 
   std::map<int, JPetTRBFactory> fTRBFactories;
@@ -110,6 +119,7 @@ private:
   JPetTOMBChannelFactory& getTOMBChannelFactory(const int runID);
   JPetDataSourceFactory& getDataSourceFactory(const int runID);
   JPetDataModuleFactory& getDataModuleFactory(const int runID);
+  std::shared_ptr<JPetParamBank> buildParameterBank(const int run);
 };
 
 #endif /* !_J_PET_PARAM_MANAGER_ */
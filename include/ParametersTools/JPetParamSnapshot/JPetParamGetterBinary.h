@@ -0,0 +1,44 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamGetterBinary.h
+ */
+
+#ifndef JPETPARAMGETTERBINARY_H
+#define JPETPARAMGETTERBINARY_H
+
+#include "./JPetParamGetter/JPetParamGetter.h"
+#include "./JPetParamSnapshot/JPetParamSnapshot.h"
+#include <string>
+
+/**
+ * @brief Param getter reading the parameter objects from the binary param snapshot.
+ *
+ * The snapshot file is mapped into memory at the first request.
+ */
+class JPetParamGetterBinary : public JPetParamGetter
+{
+public:
+  explicit JPetParamGetterBinary(const std::string& filename) : fFilename(filename) {}
+  ~JPetParamGetterBinary() {}
+  ParamObjectsDescriptions getAllBasicData(ParamObjectType type, const int runID);
+  ParamRelationalData getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runID);
+
+private:
+  JPetParamGetterBinary(const JPetParamGetterBinary&) = delete;
+  JPetParamGetterBinary& operator=(const JPetParamGetterBinary&) = delete;
+  bool checkRequest(ParamObjectType type, const int runID);
+  std::string fFilename;
+  JPetParamSnapshot fSnapshot;
+};
+
+#endif /* !JPETPARAMGETTERBINARY_H */
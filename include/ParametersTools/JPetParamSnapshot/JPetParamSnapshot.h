@@ -0,0 +1,109 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamSnapshot.h
+ */
+
+#ifndef JPETPARAMSNAPSHOT_H
+#define JPETPARAMSNAPSHOT_H
+
+#include "./JPetParamGetter/JPetParamGetter.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binary, memory-mapped snapshot of the parameters of a single run.
+ *
+ * The snapshot contains the descriptions of all the parameter objects of a run,
+ * including the relations (the "<type>_id" fields), in the same form as the local json DB.
+ * The file is mapped into memory and used directly: the objects of each type are stored
+ * sorted by ID and their fields sorted by name, so a field is found with two binary
+ * searches and returned as a pointer into the mapped file, without any parsing.
+ *
+ * File layout (native byte order, all offsets counted from the beginning of the file):
+ * header, section records (one per object type), object records of all sections,
+ * field records of all objects, and the table of null-terminated strings.
+ *
+ * Snapshots can be created from the local json DB or from the param bank stored
+ * in a ROOT file produced by the previous analysis stage.
+ */
+class JPetParamSnapshot
+{
+public:
+  static const char kMagic[8];
+  static const std::uint32_t kVersion;
+
+  JPetParamSnapshot();
+  explicit JPetParamSnapshot(const std::string& filename);
+  ~JPetParamSnapshot();
+  bool open(const std::string& filename);
+  void close();
+  bool isOpen() const;
+  int getRunID() const;
+  bool hasType(ParamObjectType type) const;
+  std::size_t getNumberOfObjects(ParamObjectType type) const;
+  std::vector<int> getIDs(ParamObjectType type) const;
+  const char* getField(ParamObjectType type, int id, const std::string& key) const;
+  ParamObjectsDescriptions getDescriptions(ParamObjectType type) const;
+
+  static bool isSnapshotFile(const std::string& filename);
+  static bool write(const std::string& filename, const int runID, const std::map<ParamObjectType, ParamObjectsDescriptions>& descriptions);
+  static bool convertFromAscii(const std::string& jsonFile, const int runID, const std::string& snapshotFile);
+  static bool convertFromRootFile(const std::string& rootFile, const int runID, const std::string& snapshotFile);
+
+  struct Header
+  {
+    char fMagic[8];
+    std::uint32_t fVersion;
+    std::uint32_t fByteOrderMark;
+    std::int32_t fRunID;
+    std::uint32_t fNumberOfSections;
+    std::uint64_t fStringsOffset;
+    std::uint64_t fStringsSize;
+  };
+
+  struct SectionRecord
+  {
+    std::int32_t fType;
+    std::uint32_t fNumberOfObjects;
+    std::uint64_t fObjectsOffset;
+  };
+
+  struct ObjectRecord
+  {
+    std::int32_t fID;
+    std::uint32_t fNumberOfFields;
+    std::uint64_t fFieldsOffset;
+  };
+
+  struct FieldRecord
+  {
+    std::uint32_t fKey;
+    std::uint32_t fValue;
+  };
+
+private:
+  JPetParamSnapshot(const JPetParamSnapshot&) = delete;
+  JPetParamSnapshot& operator=(const JPetParamSnapshot&) = delete;
+  bool validate() const;
+  const SectionRecord* findSection(ParamObjectType type) const;
+  const ObjectRecord* findObject(const SectionRecord& section, int id) const;
+  const char* getString(std::uint32_t offset) const;
+
+  const char* fData = nullptr;
+  std::size_t fSize = 0;
+};
+
+#endif /* !JPETPARAMSNAPSHOT_H */
@@ -0,0 +1,101 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEventBuilder.h
+ */
+
+#ifndef JPETEVENTBUILDER_H
+#define JPETEVENTBUILDER_H
+
+#include "./JPetEvent/JPetEvent.h"
+#include "./JPetHit/JPetHit.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Groups the hits of consecutive time windows into events using a coincidence time window.
+ *
+ * The hits are ordered by time with a radix sort of their float times and grouped
+ * in a single sweep: an event starts with the earliest hit not assigned yet and contains
+ * all the following hits registered less than the coincidence window after it.
+ * Events with fewer hits than the minimal multiplicity are skipped and the others
+ * are tagged with a JPetEventType by the classifier, by default according to the
+ * number of hits (classifyByMultiplicity).
+ *
+ * With the carry-over enabled, the hits of the last event of a time window, which could
+ * still be completed by the hits of the next window, are kept and processed together
+ * with the next window; flush() builds the event of the hits left after the last window.
+ * If the hit times are given with respect to the beginning of each time window,
+ * the length of the windows has to be set, the times of the carried hits are then
+ * shifted by it, i.e. they become negative in the next window.
+ *
+ * The builder keeps its buffers between the windows, so it does not allocate
+ * once the largest window was processed. It can be used directly in the user tasks
+ * or through the JPetEventBuilderTask.
+ */
+class JPetEventBuilder
+{
+public:
+  using Classifier = std::function<JPetEventType(const JPetEvent&)>;
+  static const double kDefaultCoincidenceWindow;
+
+  explicit JPetEventBuilder(double coincidenceWindow = kDefaultCoincidenceWindow);
+
+  void setCoincidenceWindow(double coincidenceWindow);
+  double getCoincidenceWindow() const;
+  void setMinimalMultiplicity(std::size_t multiplicity);
+  std::size_t getMinimalMultiplicity() const;
+  void setCarryOver(bool carryOver);
+  bool isCarryOver() const;
+  void setTimeWindowLength(double length);
+  double getTimeWindowLength() const;
+  void setClassifier(const Classifier& classifier);
+
+  std::size_t buildEvents(const JPetTimeWindow& hits, JPetTimeWindow& events);
+  std::size_t buildEvents(const std::vector<JPetHit>& hits, std::vector<JPetEvent>& events);
+  std::size_t flush(JPetTimeWindow& events);
+  std::size_t flush(std::vector<JPetEvent>& events);
+  std::size_t getNumberOfCarriedHits() const;
+  void reset();
+
+  static JPetEventType classifyByMultiplicity(const JPetEvent& event);
+  static void sortByTime(const std::vector<float>& times, std::vector<std::uint32_t>& order, std::vector<std::uint32_t>& keys,
+                         std::vector<std::uint32_t>& buffer);
+
+private:
+  void collectCarriedHits();
+  template <typename Output>
+  std::size_t sweep(bool isLastWindow, Output output);
+  template <typename Output>
+  bool emitEvent(std::size_t begin, std::size_t end, Output output);
+
+  double fCoincidenceWindow = kDefaultCoincidenceWindow;
+  std::size_t fMinimalMultiplicity = 1;
+  bool fCarryOver = true;
+  double fTimeWindowLength = 0.;
+  Classifier fClassifier;
+
+  /// Hits of the processed window, including the carried ones, and their times
+  std::vector<const JPetHit*> fHits;
+  std::vector<float> fTimes;
+  /// Indices of fHits ordered by time and the buffers of the radix sort
+  std::vector<std::uint32_t> fOrder;
+  std::vector<std::uint32_t> fKeys;
+  std::vector<std::uint32_t> fBuffer;
+  std::vector<JPetHit> fCarriedHits;
+  std::vector<JPetHit> fNextCarriedHits;
+  JPetEvent fEvent;
+};
+
+#endif /* !JPETEVENTBUILDER_H */
@@ -0,0 +1,63 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEventBuilderTask.h
+ */
+
+#ifndef JPETEVENTBUILDERTASK_H
+#define JPETEVENTBUILDERTASK_H
+
+#include "JPetEventBuilderTask/JPetEventBuilder.h"
+#include "JPetUserTask/JPetUserTask.h"
+#include <string>
+
+/**
+ * @brief User task grouping the hits of the input time windows into events with JPetEventBuilder
+ *
+ * The output time windows contain JPetEvent objects. The builder is configured with the options:
+ * EventBuilder_CoincidenceWindow_double (in [ps]), EventBuilder_MinimalMultiplicity_int,
+ * EventBuilder_CarryOver_bool and EventBuilder_TimeWindowLength_double (in [ps], for the hit
+ * times given with respect to the beginning of each window), see JPetEventBuilder for details.
+ * The carry-over is enabled by default and then the window length has to be given,
+ * 0 stating that the hit times are absolute.
+ * The hits are carried only between consecutive entries of the input file; if the next
+ * processed entry is not the following one, the event of the carried hits is added to the
+ * output of the processed window. The hits carried after the last entry of the processed
+ * range (see JPetUserTask::isLastEntry) are added to its output as well. Only if the task
+ * is run without the information about the last entry, the hits carried after the last
+ * window are lost, what is reported in terminate().
+ * Since the carried hits connect the consecutive entries, the task is not entry-independent
+ * (see JPetUserTask::isEntryIndependent) and JPetTaskStreamIO runs it serially even if
+ * several workers are requested, so the events crossing the windows are never split.
+ */
+class JPetEventBuilderTask : public JPetUserTask
+{
+public:
+  explicit JPetEventBuilderTask(const char* name = "");
+  virtual ~JPetEventBuilderTask() {}
+  const JPetEventBuilder& getEventBuilder() const;
+
+protected:
+  bool init() override;
+  bool exec() override;
+  bool terminate() override;
+
+  const std::string kCoincidenceWindowParamKey = "EventBuilder_CoincidenceWindow_double";
+  const std::string kMinimalMultiplicityParamKey = "EventBuilder_MinimalMultiplicity_int";
+  const std::string kCarryOverParamKey = "EventBuilder_CarryOver_bool";
+  const std::string kTimeWindowLengthParamKey = "EventBuilder_TimeWindowLength_double";
+
+  JPetEventBuilder fEventBuilder;
+  long long fPreviousEntryNumber = -1;
+};
+
+#endif /* !JPETEVENTBUILDERTASK_H */
@@ -14,6 +14,13 @@
  */
 
 #include "JPetAnalysisTools/JPetAnalysisTools.h"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+bool isEarlier(const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); }
+} // namespace
 
 /**
  * Sorting the input vector of JPetHits by ascending time
@@ -21,6 +28,27 @@
 std::vector<JPetHit> JPetAnalysisTools::getHitsOrderedByTime(const std::vector<JPetHit>& oldHits)
 {
   auto hits(oldHits);
-  std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+  sortHitsByTime(hits);
   return hits;
 }
+
+/**
+ * Sorting the input vector of JPetHits by ascending time without copying the hits,
+ * the vector is taken over and returned.
+ */
+std::vector<JPetHit> JPetAnalysisTools::getHitsOrderedByTime(std::vector<JPetHit>&& hits)
+{
+  sortHitsByTime(hits);
+  return std::move(hits);
+}
+
+/**
+ * Sorting the vector of JPetHits by ascending time in place
+ */
+void JPetAnalysisTools::sortHitsByTime(std::vector<JPetHit>& hits)
+{
+  if (!std::is_sorted(hits.begin(), hits.end(), isEarlier))
+  {
+    std::sort(hits.begin(), hits.end(), isEarlier);
+  }
+}
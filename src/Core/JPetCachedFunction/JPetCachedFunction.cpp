@@ -16,6 +16,7 @@
 #include "JPetCachedFunction/JPetCachedFunction.h"
 #include "JPetLoggerInclude.h"
 #include <TFormula.h>
+#include <algorithm>
 
 namespace  jpet_common_tools
 {
@@ -112,36 +113,200 @@ std::vector<double> JPetCachedFunction::getValues() const
   return fValues;
 }
 
+const std::vector<double>& JPetCachedFunction::getValuesRef() const
+{
+  return fValues;
+}
+
+void JPetCachedFunction::setInterpolation(bool interpolate)
+{
+  fInterpolation = interpolate;
+}
+
+bool JPetCachedFunction::isInterpolation() const
+{
+  return fInterpolation;
+}
 
 double JPetCachedFunction1D::operator()(double x) const
 {
   if ((x < fRange.fMin) || (x > fRange.fMax)) return 0;
+  if (fInterpolation) return interpolate(x);
   int index = xValueToIndex(x);
   assert(index >= 0);
-  assert(((unsigned int) index) < getValues().size());
-  return getValues()[index];
+  assert(((unsigned int) index) < fValues.size());
+  return fValues[index];
 }
 
+/**
+ * Evaluates the function for n arguments from xs and stores the results in out.
+ * The loop body does not branch, so that it can be vectorized by the compiler.
+ * The results are identical to the ones of operator().
+ */
+void JPetCachedFunction1D::evaluate(const double* xs, double* out, std::size_t n) const
+{
+  if (fValues.empty()) {
+    std::fill(out, out + n, 0.);
+    return;
+  }
+  const double* values = fValues.data();
+  const double xMin = fRange.fMin;
+  const double xMax = fRange.fMax;
+  const double step = fStep;
+  const int lastIndex = fRange.fBins - 1;
+  if (fInterpolation) {
+    for (std::size_t i = 0; i < n; i++) {
+      const double x = xs[i];
+      const bool inRange = (x >= xMin) && (x <= xMax);
+      const double position = inRange ? (x - xMin) / step : 0.;
+      const int index = std::min(static_cast<int>(position), lastIndex);
+      const int next = std::min(index + 1, lastIndex);
+      const double value = values[index] + (position - index) * (values[next] - values[index]);
+      out[i] = inRange ? value : 0.;
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const double x = xs[i];
+      const bool inRange = (x >= xMin) && (x <= xMax);
+      const double position = inRange ? (x - xMin) / step : 0.;
+      const int index = std::min(static_cast<int>(position), lastIndex);
+      out[i] = inRange ? values[index] : 0.;
+    }
+  }
+}
+
+std::vector<double> JPetCachedFunction1D::evaluate(const std::vector<double>& xs) const
+{
+  std::vector<double> out(xs.size());
+  evaluate(xs.data(), out.data(), xs.size());
+  return out;
+}
+
+/**
+ * Returns the index of the sampling point not greater than x.
+ * For x equal to the upper edge of the range the last sampling point is returned.
+ */
 int JPetCachedFunction1D::xValueToIndex(double x) const
 {
   assert(fStep > 0.);
-  return (x - fRange.fMin) / fStep;
+  int index = (x - fRange.fMin) / fStep;
+  return std::min(index, fRange.fBins - 1);
 }
 
+/**
+ * Linear interpolation between the two neighbouring sampling points.
+ * Above the last sampling point the last cached value is returned.
+ */
+double JPetCachedFunction1D::interpolate(double x) const
+{
+  double position = (x - fRange.fMin) / fStep;
+  int index = xValueToIndex(x);
+  assert(index >= 0);
+  assert(((unsigned int) index) < fValues.size());
+  int next = std::min(index + 1, fRange.fBins - 1);
+  return fValues[index] + (position - index) * (fValues[next] - fValues[index]);
+}
 
 double JPetCachedFunction2D::operator()(double x, double y) const
 {
   if ((x < fRange.first.fMin) || (x > fRange.first.fMax) || (y < fRange.second.fMin) || (y > fRange.second.fMax)) return 0;
+  if (fInterpolation) return interpolate(x, y);
   auto index = xyValueToIndex(x, y);
   assert(index >= 0);
   assert(((unsigned int) index) < fValues.size());
   return fValues[index];
 }
 
+/**
+ * Evaluates the function for n pairs of arguments (xs[i], ys[i]) and stores the results in out.
+ * The loop body does not branch, so that it can be vectorized by the compiler.
+ * The results are identical to the ones of operator().
+ */
+void JPetCachedFunction2D::evaluate(const double* xs, const double* ys, double* out, std::size_t n) const
+{
+  if (fValues.empty()) {
+    std::fill(out, out + n, 0.);
+    return;
+  }
+  const double* values = fValues.data();
+  const double xMin = fRange.first.fMin;
+  const double xMax = fRange.first.fMax;
+  const double yMin = fRange.second.fMin;
+  const double yMax = fRange.second.fMax;
+  const double stepX = fSteps.first;
+  const double stepY = fSteps.second;
+  const int binsX = fRange.first.fBins;
+  const int lastX = fRange.first.fBins - 1;
+  const int lastY = fRange.second.fBins - 1;
+  if (fInterpolation) {
+    for (std::size_t i = 0; i < n; i++) {
+      const double x = xs[i];
+      const double y = ys[i];
+      const bool inRange = (x >= xMin) && (x <= xMax) && (y >= yMin) && (y <= yMax);
+      const double positionX = inRange ? (x - xMin) / stepX : 0.;
+      const double positionY = inRange ? (y - yMin) / stepY : 0.;
+      const int ix = std::min(static_cast<int>(positionX), lastX);
+      const int iy = std::min(static_cast<int>(positionY), lastY);
+      const int nextX = std::min(ix + 1, lastX);
+      const int nextY = std::min(iy + 1, lastY);
+      const double fx = positionX - ix;
+      const double fy = positionY - iy;
+      const double low = values[ix + iy * binsX] + fx * (values[nextX + iy * binsX] - values[ix + iy * binsX]);
+      const double high = values[ix + nextY * binsX] + fx * (values[nextX + nextY * binsX] - values[ix + nextY * binsX]);
+      out[i] = inRange ? low + fy * (high - low) : 0.;
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const double x = xs[i];
+      const double y = ys[i];
+      const bool inRange = (x >= xMin) && (x <= xMax) && (y >= yMin) && (y <= yMax);
+      const int ix = std::min(static_cast<int>(inRange ? (x - xMin) / stepX : 0.), lastX);
+      const int iy = std::min(static_cast<int>(inRange ? (y - yMin) / stepY : 0.), lastY);
+      out[i] = inRange ? values[ix + iy * binsX] : 0.;
+    }
+  }
+}
+
+std::vector<double> JPetCachedFunction2D::evaluate(const std::vector<double>& xs, const std::vector<double>& ys) const
+{
+  assert(xs.size() == ys.size());
+  std::vector<double> out(xs.size());
+  evaluate(xs.data(), ys.data(), out.data(), xs.size());
+  return out;
+}
+
+/**
+ * Returns the index of the sampling point (ix, iy) not greater than (x, y) in the lookup table.
+ * The x and y bins are computed separately, so that the fractional part of the y position
+ * does not shift the x bin.
+ */
 int JPetCachedFunction2D::xyValueToIndex(double x, double y) const
 {
   assert(fSteps.first > 0. && fSteps.second > 0.);
-  return ((x - fRange.first.fMin) / fSteps.first) + ((y - fRange.second.fMin) / fSteps.second) * fRange.first.fBins;
+  int ix = std::min(static_cast<int>((x - fRange.first.fMin) / fSteps.first), fRange.first.fBins - 1);
+  int iy = std::min(static_cast<int>((y - fRange.second.fMin) / fSteps.second), fRange.second.fBins - 1);
+  return ix + iy * fRange.first.fBins;
+}
+
+/**
+ * Bilinear interpolation between the four neighbouring sampling points.
+ */
+double JPetCachedFunction2D::interpolate(double x, double y) const
+{
+  assert(fSteps.first > 0. && fSteps.second > 0.);
+  const int binsX = fRange.first.fBins;
+  double positionX = (x - fRange.first.fMin) / fSteps.first;
+  double positionY = (y - fRange.second.fMin) / fSteps.second;
+  int ix = std::min(static_cast<int>(positionX), binsX - 1);
+  int iy = std::min(static_cast<int>(positionY), fRange.second.fBins - 1);
+  int nextX = std::min(ix + 1, binsX - 1);
+  int nextY = std::min(iy + 1, fRange.second.fBins - 1);
+  assert(((unsigned int)(nextX + nextY * binsX)) < fValues.size());
+  double fx = positionX - ix;
+  double fy = positionY - iy;
+  double low = fValues[ix + iy * binsX] + fx * (fValues[nextX + iy * binsX] - fValues[ix + iy * binsX]);
+  double high = fValues[ix + nextY * binsX] + fx * (fValues[nextX + nextY * binsX] - fValues[ix + nextY * binsX]);
+  return low + fy * (high - low);
 }
 
 }
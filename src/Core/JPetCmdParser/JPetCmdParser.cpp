@@ -37,7 +37,13 @@ JPetCmdParser::JPetCmdParser() : fOptionsDescriptions("Allowed options")
       "localDBCreate,L", po::value<std::string>(),
       "File name to which the parameter database will be saved.")("userCfg,u", po::value<std::string>(), "Json file with optional user parameters.")(
       "directProcessing,d", po::bool_switch(),
-      "Process directly to the output of last module without creating intermediate files (faster and less storage needed).");
+      "Process directly to the output of last module without creating intermediate files (faster and less storage needed).")(
+      "pipelinedProcessing", po::bool_switch(),
+      "Run the consecutive modules at the same time, passing the time windows in memory instead of reading the intermediate files.")(
+      "maxThreads", po::value<int>(), "Maximal number of input files processed at the same time when threads are enabled.")(
+      "largestFileFirst", po::bool_switch(), "Start the processing of the input files from the largest one when threads are enabled.")(
+      "integerParamRefs", po::bool_switch(),
+      "Store the references to the parametric objects in the output data as integer IDs only, without TRefs (smaller output files).");
 }
 
 /**
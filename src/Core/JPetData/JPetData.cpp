@@ -15,6 +15,17 @@
 
 #include "JPetData/JPetData.h"
 
-JPetData::JPetData(TObject& event) : fEvent(event) {}
+JPetData::JPetData(TObject& event, long long entryNumber, bool isLastEntry) : fEvent(event), fEntryNumber(entryNumber), fIsLastEntry(isLastEntry)
+{
+}
 
 TObject& JPetData::getEvent() const { return fEvent; }
+
+long long JPetData::getEntryNumber() const { return fEntryNumber; }
+
+/**
+ * @brief True for the last entry processed by the task before its terminate(), or before
+ * an entry which does not follow this one in the input file. The tasks keeping the data
+ * between the entries should put them into the output of this entry.
+ */
+bool JPetData::isLastEntry() const { return fIsLastEntry; }
@@ -14,6 +14,9 @@
  */
 
 #include "JPetGeomMapping/JPetGeomMapping.h"
+#include <TMath.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 
@@ -43,6 +46,10 @@ JPetGeomMapping::JPetGeomMapping(const JPetParamBank& paramBank)
   {
     fRadiusToLayer[radius] = layer_counter++;
   }
+  for (const auto& el : fRadiusToLayer)
+  {
+    fLayerRadii.push_back(el.first);
+  }
   for (const auto& slot : paramBank.getBarrelSlots())
   {
     int layer_number = getLayerNumber(slot.second->getLayer());
@@ -61,7 +68,9 @@ JPetGeomMapping::JPetGeomMapping(const JPetParamBank& paramBank)
     }
     layerNumber++;
   }
+  fillGeometryTables(paramBank);
   fTOMBs = getTOMBMap(paramBank);
+  fillTOMBTable();
 }
 
 /**
@@ -131,6 +140,11 @@ size_t JPetGeomMapping::getSlotsCount(const size_t layerNr) const
  */
 size_t JPetGeomMapping::getSlotNumber(const JPetBarrelSlot& slot) const
 {
+  auto geometry = findSlotGeometry(slot);
+  if (geometry)
+  {
+    return geometry->slot;
+  }
   auto layerNr = getLayerNumber(slot.getLayer());
   auto theta = slot.getTheta();
   if ((fNumberOfSlotsInLayer.size() < layerNr) || (layerNr <= 0))
@@ -194,6 +208,13 @@ std::map<std::tuple<int, int, JPetPM::Side, int>, int> JPetGeomMapping::getTOMBM
  */
 int JPetGeomMapping::getTOMB(int layerNr, int barrel_slot_nr, const JPetPM::Side& side, int threshold) const
 {
+  int layersCount = fLayerRadii.size();
+  if (layerNr >= 1 && layerNr <= layersCount && barrel_slot_nr >= 1 && barrel_slot_nr <= fMaxSlotsInLayer && threshold >= 0 &&
+      threshold <= fMaxThreshold && (side == JPetPM::SideA || side == JPetPM::SideB))
+  {
+    auto index = (((layerNr - 1) * fMaxSlotsInLayer + barrel_slot_nr - 1) * 2 + side) * (fMaxThreshold + 1) + threshold;
+    return fTOMBTable[index];
+  }
   auto key = std::make_tuple(layerNr, barrel_slot_nr, side, threshold);
   if (fTOMBs.find(key) == fTOMBs.end())
   {
@@ -210,12 +231,11 @@ int JPetGeomMapping::getTOMB(int layerNr, int barrel_slot_nr, const JPetPM::Side
  */
 double JPetGeomMapping::getRadiusOfLayer(int layer) const
 {
-  for (auto it = fRadiusToLayer.begin(); it != fRadiusToLayer.end(); it++)
+  if (layer < 1 || layer > static_cast<int>(fLayerRadii.size()))
   {
-    if (it->second == layer)
-      return it->first;
+    return 0.;
   }
-  return 0.;
+  return fLayerRadii[layer - 1];
 }
 
 /**
@@ -224,6 +244,17 @@ double JPetGeomMapping::getRadiusOfLayer(int layer) const
  */
 size_t JPetGeomMapping::calcDeltaID(const JPetBarrelSlot& slot1, const JPetBarrelSlot& slot2) const
 {
+  auto geometry1 = findSlotGeometry(slot1);
+  auto geometry2 = findSlotGeometry(slot2);
+  if (geometry1 && geometry2 && geometry1->layer == geometry2->layer)
+  {
+    int delta_ID = abs(geometry1->slot - geometry2->slot);
+    int layer_size = fNumberOfSlotsInLayer[geometry1->layer - 1];
+    int half_layer_size = layer_size / 2;
+    if (delta_ID > half_layer_size)
+      return layer_size - delta_ID;
+    return delta_ID;
+  }
   if (slot1.getLayer().getID() == slot2.getLayer().getID())
   {
     int delta_ID = abs((int)getSlotNumber(slot1) - (int)getSlotNumber(slot2));
@@ -297,3 +328,131 @@ std::map<std::tuple<int, int, JPetPM::Side, int>, int> JPetGeomMapping::getTOMBM
     return result;
   }
 }
+
+/**
+ * Returns the precomputed geometry of the barrel slot with the given ID
+ * or nullptr if the slot is not known to the mapping.
+ */
+const JPetGeomMapping::SlotGeometry* JPetGeomMapping::getSlotGeometry(int barrelSlotID) const
+{
+  if (barrelSlotID < 0 || barrelSlotID >= static_cast<int>(fSlotGeometries.size()) || !fSlotGeometries[barrelSlotID].isValid())
+  {
+    return nullptr;
+  }
+  return &fSlotGeometries[barrelSlotID];
+}
+
+/**
+ * Returns the precomputed geometry of the barrel slot containing the scintillator
+ * with the given ID or nullptr if the scintillator is not known to the mapping.
+ */
+const JPetGeomMapping::SlotGeometry* JPetGeomMapping::getScinGeometry(int scinID) const
+{
+  if (scinID < 0 || scinID >= static_cast<int>(fScinGeometries.size()) || !fScinGeometries[scinID].isValid())
+  {
+    return nullptr;
+  }
+  return &fScinGeometries[scinID];
+}
+
+/**
+ * Private method filling the tables indexed by the barrel slot and the scintillator IDs.
+ * Must be called after the radius and theta maps are filled.
+ */
+void JPetGeomMapping::fillGeometryTables(const JPetParamBank& bank)
+{
+  for (auto count : fNumberOfSlotsInLayer)
+  {
+    fMaxSlotsInLayer = std::max(fMaxSlotsInLayer, count);
+  }
+  int maxSlotID = -1;
+  for (const auto& el : bank.getBarrelSlots())
+  {
+    maxSlotID = std::max(maxSlotID, el.first);
+  }
+  fSlotGeometries.resize(maxSlotID + 1);
+  for (const auto& el : bank.getBarrelSlots())
+  {
+    if (el.first < 0 || !el.second || el.second->getLayer().isNullObject())
+    {
+      continue;
+    }
+    const auto& slot = *el.second;
+    auto layerNr = getLayerNumber(slot.getLayer());
+    auto slotNr = getSlotNumber(slot);
+    if (layerNr == kBadLayerNumber || slotNr == kBadSlotNumber)
+    {
+      continue;
+    }
+    SlotGeometry geometry;
+    geometry.layer = layerNr;
+    geometry.slot = slotNr;
+    geometry.theta = slot.getTheta();
+    geometry.radius = slot.getLayer().getRadius();
+    geometry.x = geometry.radius * std::cos(TMath::DegToRad() * geometry.theta);
+    geometry.y = geometry.radius * std::sin(TMath::DegToRad() * geometry.theta);
+    fSlotGeometries[el.first] = geometry;
+  }
+  int maxScinID = -1;
+  for (const auto& el : bank.getScintillators())
+  {
+    maxScinID = std::max(maxScinID, el.first);
+  }
+  fScinGeometries.resize(maxScinID + 1);
+  for (const auto& el : bank.getScintillators())
+  {
+    if (el.first < 0 || !el.second || el.second->getBarrelSlot().isNullObject())
+    {
+      continue;
+    }
+    auto geometry = getSlotGeometry(el.second->getBarrelSlot().getID());
+    if (geometry)
+    {
+      fScinGeometries[el.first] = *geometry;
+    }
+  }
+}
+
+/**
+ * Private method filling the flat TOMB array based on the TOMB map. The array is indexed by
+ * ((layer - 1) * maxSlots + slot - 1) * 2 + side) * (maxThreshold + 1) + threshold.
+ */
+void JPetGeomMapping::fillTOMBTable()
+{
+  int layersCount = fLayerRadii.size();
+  for (const auto& el : fTOMBs)
+  {
+    fMaxThreshold = std::max(fMaxThreshold, std::get<3>(el.first));
+  }
+  if (fMaxThreshold < 0 || fMaxSlotsInLayer <= 0)
+  {
+    return;
+  }
+  fTOMBTable.assign(layersCount * fMaxSlotsInLayer * 2 * (fMaxThreshold + 1), -1);
+  for (const auto& el : fTOMBs)
+  {
+    int layerNr = std::get<0>(el.first);
+    int slotNr = std::get<1>(el.first);
+    int side = std::get<2>(el.first);
+    int threshold = std::get<3>(el.first);
+    if (layerNr < 1 || layerNr > layersCount || slotNr < 1 || slotNr > fMaxSlotsInLayer || threshold < 0 || side < 0 || side > 1)
+    {
+      continue;
+    }
+    fTOMBTable[(((layerNr - 1) * fMaxSlotsInLayer + slotNr - 1) * 2 + side) * (fMaxThreshold + 1) + threshold] = el.second;
+  }
+}
+
+/**
+ * Private method returning the precomputed geometry of the slot if it matches
+ * the slot from the mapping (the same ID, theta and layer radius), nullptr otherwise.
+ */
+const JPetGeomMapping::SlotGeometry* JPetGeomMapping::findSlotGeometry(const JPetBarrelSlot& slot) const
+{
+  auto geometry = getSlotGeometry(slot.getID());
+  if (!geometry || geometry->theta != slot.getTheta() || slot.getLayer().isNullObject() || geometry->radius != slot.getLayer().getRadius())
+  {
+    return nullptr;
+  }
+  return geometry;
+}
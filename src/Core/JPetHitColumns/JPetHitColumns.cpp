@@ -0,0 +1,305 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitColumns.cpp
+ */
+
+#include "JPetHitColumns/JPetHitColumns.h"
+#include "JPetLoggerInclude.h"
+#include <TTree.h>
+#include <map>
+
+const std::string JPetHitColumns::kCountBranchName = "hit_count";
+
+/**
+ * @return true if the tree was written in the column-wise mode.
+ */
+bool JPetHitColumns::isColumnarTree(TTree& tree) { return tree.GetBranch(kCountBranchName.c_str()) != nullptr; }
+
+/**
+ * @brief Translates the names of the columns (time, energy, position, scinID, signals,
+ * basic and all) given e.g. in the user options to the Column flags. Unknown names are skipped.
+ */
+unsigned int JPetHitColumns::parseColumns(const std::vector<std::string>& names)
+{
+  static const std::map<std::string, unsigned int> kNamesToColumns = {{"time", kTime},       {"energy", kEnergy},   {"position", kPosition},
+                                                                      {"scinID", kScinID},   {"signals", kSignals}, {"basic", kBasic},
+                                                                      {"all", kAll}};
+  unsigned int columns = 0;
+  for (const auto& name : names)
+  {
+    auto it = kNamesToColumns.find(name);
+    if (it == kNamesToColumns.end())
+    {
+      WARNING("Unknown hit column: " + name);
+      continue;
+    }
+    columns |= it->second;
+  }
+  return columns;
+}
+
+/**
+ * @brief Applies the operation to the name and address of each branch of the given columns.
+ * @return columns for which the operation succeeded for all the branches.
+ */
+template <typename Operation>
+unsigned int JPetHitColumns::forEachBranch(unsigned int columns, Operation operation)
+{
+  unsigned int done = 0;
+  if (columns & kTime)
+  {
+    bool isOK = operation("hit_time", &fTimePtr);
+    isOK = operation("hit_timeDiff", &fTimeDiffPtr) && isOK;
+    done |= isOK ? kTime : 0;
+  }
+  if (columns & kEnergy)
+  {
+    done |= operation("hit_energy", &fEnergyPtr) ? kEnergy : 0;
+  }
+  if (columns & kPosition)
+  {
+    bool isOK = operation("hit_posX", &fPosXPtr);
+    isOK = operation("hit_posY", &fPosYPtr) && isOK;
+    isOK = operation("hit_posZ", &fPosZPtr) && isOK;
+    done |= isOK ? kPosition : 0;
+  }
+  if (columns & kScinID)
+  {
+    bool isOK = operation("hit_scinID", &fScinIDPtr);
+    isOK = operation("hit_barrelSlotID", &fBarrelSlotIDPtr) && isOK;
+    done |= isOK ? kScinID : 0;
+  }
+  if (columns & kSignals)
+  {
+    bool isOK = operation("hit_signalA", &fSignalAPtr);
+    isOK = operation("hit_signalB", &fSignalBPtr) && isOK;
+    isOK = operation("hit_signalFlags", &fSignalFlagsPtr) && isOK;
+    done |= isOK ? kSignals : 0;
+  }
+  return done;
+}
+
+/**
+ * @brief Creates the branches of the given columns for writing.
+ */
+bool JPetHitColumns::createBranches(TTree& tree, unsigned int columns)
+{
+  clear();
+  if (!tree.Branch(kCountBranchName.c_str(), &fCount, (kCountBranchName + "/I").c_str()))
+  {
+    ERROR("Could not create the branch with the number of hits.");
+    return false;
+  }
+  fColumns = forEachBranch(columns, [&tree](const char* name, auto address) { return tree.Branch(name, address) != nullptr; });
+  if (fColumns != columns)
+  {
+    ERROR("Could not create the branches of all the hit columns.");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Binds the branches of the given columns for reading. The other hit branches
+ * are disabled, so they are not read from the file at all.
+ * @return columns which will be read, i.e. requested and present in the tree.
+ */
+unsigned int JPetHitColumns::setBranchAddresses(TTree& tree, unsigned int columns)
+{
+  clear();
+  fColumns = 0;
+  if (!isColumnarTree(tree))
+  {
+    ERROR("The tree does not contain the hit columns.");
+    return 0;
+  }
+  tree.SetBranchStatus("hit_*", false);
+  tree.SetBranchStatus(kCountBranchName.c_str(), true);
+  tree.SetBranchAddress(kCountBranchName.c_str(), &fCount);
+  fColumns = forEachBranch(columns, [&tree](const char* name, auto address) {
+    if (!tree.GetBranch(name))
+    {
+      return false;
+    }
+    tree.SetBranchStatus((std::string(name) + "*").c_str(), true);
+    tree.SetBranchAddress(name, address);
+    return true;
+  });
+  if (fColumns != columns)
+  {
+    WARNING("Some of the requested hit columns are not stored in the tree, they will be left unset.");
+  }
+  return fColumns;
+}
+
+unsigned int JPetHitColumns::getColumns() const { return fColumns; }
+
+/**
+ * @brief Takes the values of the bound columns from the hits in the window.
+ */
+void JPetHitColumns::fill(const JPetTimeWindow& window)
+{
+  clear();
+  fCount = window.getNumberOfEvents();
+  for (int i = 0; i < fCount; i++)
+  {
+    const auto& hit = window.getEvent<JPetHit>(i);
+    if (fColumns & kTime)
+    {
+      fTime.push_back(hit.getTime());
+      fTimeDiff.push_back(hit.getTimeDiff());
+    }
+    if (fColumns & kEnergy)
+    {
+      fEnergy.push_back(hit.getEnergy());
+    }
+    if (fColumns & kPosition)
+    {
+      fPosX.push_back(hit.getPosX());
+      fPosY.push_back(hit.getPosY());
+      fPosZ.push_back(hit.getPosZ());
+    }
+    if (fColumns & kScinID)
+    {
+      fScinID.push_back(hit.getScintillatorID());
+      fBarrelSlotID.push_back(hit.getBarrelSlotID());
+    }
+    if (fColumns & kSignals)
+    {
+      fSignalA.push_back(hit.getSignalA());
+      fSignalB.push_back(hit.getSignalB());
+      fSignalFlags.push_back((hit.isSignalASet() ? kSignalASet : 0) | (hit.isSignalBSet() ? kSignalBSet : 0));
+    }
+  }
+}
+
+/**
+ * @brief Fills the window with the hits built from the bound columns,
+ * the fields of the other columns keep their default values.
+ */
+void JPetHitColumns::fillTimeWindow(JPetTimeWindow& window) const
+{
+  window.Clear();
+  if (!hasConsistentSizes())
+  {
+    ERROR("Inconsistent sizes of the hit columns, the time window is left empty.");
+    return;
+  }
+  JPetHit hit;
+  for (int i = 0; i < fCount; i++)
+  {
+    hit.Clear();
+    if (fColumns & kTime)
+    {
+      hit.setTime(fTime[i]);
+      hit.setTimeDiff(fTimeDiff[i]);
+    }
+    if (fColumns & kEnergy)
+    {
+      hit.setEnergy(fEnergy[i]);
+    }
+    if (fColumns & kPosition)
+    {
+      hit.setPos(fPosX[i], fPosY[i], fPosZ[i]);
+    }
+    if (fColumns & kScinID)
+    {
+      hit.setScintillatorID(fScinID[i]);
+      hit.setBarrelSlotID(fBarrelSlotID[i]);
+    }
+    if (fColumns & kSignals)
+    {
+      bool isSignalASet = fSignalFlags[i] & kSignalASet;
+      bool isSignalBSet = fSignalFlags[i] & kSignalBSet;
+      if (isSignalASet && isSignalBSet)
+      {
+        hit.setSignals(fSignalA[i], fSignalB[i]);
+      }
+      else if (isSignalASet)
+      {
+        hit.setSignalA(fSignalA[i]);
+      }
+      else if (isSignalBSet)
+      {
+        hit.setSignalB(fSignalB[i]);
+      }
+    }
+    window.add<JPetHit>(hit);
+  }
+}
+
+bool JPetHitColumns::hasConsistentSizes() const
+{
+  std::size_t count = fCount;
+  if ((fColumns & kTime) && (fTime.size() != count || fTimeDiff.size() != count))
+  {
+    return false;
+  }
+  if ((fColumns & kEnergy) && fEnergy.size() != count)
+  {
+    return false;
+  }
+  if ((fColumns & kPosition) && (fPosX.size() != count || fPosY.size() != count || fPosZ.size() != count))
+  {
+    return false;
+  }
+  if ((fColumns & kScinID) && (fScinID.size() != count || fBarrelSlotID.size() != count))
+  {
+    return false;
+  }
+  if ((fColumns & kSignals) && (fSignalA.size() != count || fSignalB.size() != count || fSignalFlags.size() != count))
+  {
+    return false;
+  }
+  return true;
+}
+
+void JPetHitColumns::clear()
+{
+  fCount = 0;
+  fTime.clear();
+  fTimeDiff.clear();
+  fEnergy.clear();
+  fPosX.clear();
+  fPosY.clear();
+  fPosZ.clear();
+  fScinID.clear();
+  fBarrelSlotID.clear();
+  fSignalA.clear();
+  fSignalB.clear();
+  fSignalFlags.clear();
+}
+
+std::size_t JPetHitColumns::size() const { return fCount; }
+
+const std::vector<float>& JPetHitColumns::getTimes() const { return fTime; }
+
+const std::vector<float>& JPetHitColumns::getTimeDiffs() const { return fTimeDiff; }
+
+const std::vector<float>& JPetHitColumns::getEnergies() const { return fEnergy; }
+
+const std::vector<float>& JPetHitColumns::getPosX() const { return fPosX; }
+
+const std::vector<float>& JPetHitColumns::getPosY() const { return fPosY; }
+
+const std::vector<float>& JPetHitColumns::getPosZ() const { return fPosZ; }
+
+const std::vector<int>& JPetHitColumns::getScinIDs() const { return fScinID; }
+
+const std::vector<int>& JPetHitColumns::getBarrelSlotIDs() const { return fBarrelSlotID; }
+
+const std::vector<JPetPhysSignal>& JPetHitColumns::getSignalsA() const { return fSignalA; }
+
+const std::vector<JPetPhysSignal>& JPetHitColumns::getSignalsB() const { return fSignalB; }
+
+const std::vector<unsigned char>& JPetHitColumns::getSignalFlags() const { return fSignalFlags; }
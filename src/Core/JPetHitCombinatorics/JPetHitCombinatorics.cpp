@@ -0,0 +1,259 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitCombinatorics.cpp
+ */
+
+#include "JPetHitCombinatorics/JPetHitCombinatorics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+JPetHitCombinatorics::JPetHitCombinatorics(const JPetGeomMapping& mapping) : JPetHitCombinatorics(mapping, Cuts()) {}
+
+JPetHitCombinatorics::JPetHitCombinatorics(const JPetGeomMapping& mapping, const Cuts& cuts) : fMapping(mapping), fCuts(cuts)
+{
+  for (auto size : fMapping.getLayersSizes())
+  {
+    fLayersSizes.push_back(size);
+  }
+}
+
+void JPetHitCombinatorics::setCuts(const Cuts& cuts) { fCuts = cuts; }
+
+const JPetHitCombinatorics::Cuts& JPetHitCombinatorics::getCuts() const { return fCuts; }
+
+/**
+ * @brief Finds the pairs of hits fulfilling the cuts.
+ * @param pairs filled with the indices of the hits, the earlier hit first
+ * @return number of the found pairs.
+ */
+std::size_t JPetHitCombinatorics::findPairs(const std::vector<JPetHit>& hits, std::vector<Pair>& pairs)
+{
+  pairs.clear();
+  collectCandidates(hits);
+  forEachTimeWindow([this, &pairs](std::size_t first, std::size_t end) {
+    for (std::size_t j = first + 1; j < end; j++)
+    {
+      if (areCompatible(fCandidates[first], fCandidates[j]))
+      {
+        pairs.push_back({{fCandidates[first].index, fCandidates[j].index}});
+      }
+    }
+  });
+  return pairs.size();
+}
+
+std::size_t JPetHitCombinatorics::findPairs(const JPetEvent& event, std::vector<Pair>& pairs) { return findPairs(event.getHits(), pairs); }
+
+/**
+ * @brief Finds the triplets of hits, in which every pair fulfills the cuts.
+ * @param triplets filled with the indices of the hits, ordered by the hit time
+ * @return number of the found triplets.
+ */
+std::size_t JPetHitCombinatorics::findTriplets(const std::vector<JPetHit>& hits, std::vector<Triplet>& triplets)
+{
+  triplets.clear();
+  collectCandidates(hits);
+  forEachTimeWindow([this, &triplets](std::size_t first, std::size_t end) {
+    fNeighbours.clear();
+    for (std::size_t j = first + 1; j < end; j++)
+    {
+      if (areCompatible(fCandidates[first], fCandidates[j]))
+      {
+        fNeighbours.push_back(j);
+      }
+    }
+    for (std::size_t a = 0; a < fNeighbours.size(); a++)
+    {
+      const auto& second = fCandidates[fNeighbours[a]];
+      for (std::size_t b = a + 1; b < fNeighbours.size(); b++)
+      {
+        const auto& third = fCandidates[fNeighbours[b]];
+        if (areCompatible(second, third))
+        {
+          triplets.push_back({{fCandidates[first].index, second.index, third.index}});
+        }
+      }
+    }
+  });
+  return triplets.size();
+}
+
+std::size_t JPetHitCombinatorics::findTriplets(const JPetEvent& event, std::vector<Triplet>& triplets)
+{
+  return findTriplets(event.getHits(), triplets);
+}
+
+/**
+ * @brief Reference implementation of findPairs checking all the pairs of hits.
+ */
+std::size_t JPetHitCombinatorics::findPairsNaive(const std::vector<JPetHit>& hits, std::vector<Pair>& pairs) const
+{
+  pairs.clear();
+  for (std::uint32_t i = 0; i < hits.size(); i++)
+  {
+    for (std::uint32_t j = i + 1; j < hits.size(); j++)
+    {
+      if (areCompatible(hits[i], hits[j]))
+      {
+        Pair pair = {{i, j}};
+        if (hits[j].getTime() < hits[i].getTime())
+        {
+          std::swap(pair[0], pair[1]);
+        }
+        pairs.push_back(pair);
+      }
+    }
+  }
+  return pairs.size();
+}
+
+/**
+ * @brief Reference implementation of findTriplets checking all the triplets of hits.
+ */
+std::size_t JPetHitCombinatorics::findTripletsNaive(const std::vector<JPetHit>& hits, std::vector<Triplet>& triplets) const
+{
+  triplets.clear();
+  for (std::uint32_t i = 0; i < hits.size(); i++)
+  {
+    for (std::uint32_t j = i + 1; j < hits.size(); j++)
+    {
+      for (std::uint32_t k = j + 1; k < hits.size(); k++)
+      {
+        if (areCompatible(hits[i], hits[j]) && areCompatible(hits[i], hits[k]) && areCompatible(hits[j], hits[k]))
+        {
+          Triplet triplet = {{i, j, k}};
+          std::stable_sort(triplet.begin(), triplet.end(), [&hits](std::uint32_t a, std::uint32_t b) { return hits[a].getTime() < hits[b].getTime(); });
+          triplets.push_back(triplet);
+        }
+      }
+    }
+  }
+  return triplets.size();
+}
+
+/**
+ * @brief Checks the single hit cuts: the energy range and the barrel slot known to the mapping.
+ */
+bool JPetHitCombinatorics::isAccepted(const JPetHit& hit) const
+{
+  Candidate candidate;
+  return fillCandidate(hit, 0, candidate);
+}
+
+/**
+ * @brief Checks if the two hits can belong to the same candidate.
+ */
+bool JPetHitCombinatorics::areCompatible(const JPetHit& hit1, const JPetHit& hit2) const
+{
+  Candidate first, second;
+  return fillCandidate(hit1, 0, first) && fillCandidate(hit2, 0, second) && areCompatible(first, second);
+}
+
+bool JPetHitCombinatorics::fillCandidate(const JPetHit& hit, std::uint32_t index, Candidate& candidate) const
+{
+  if (hit.getEnergy() < fCuts.minEnergy || hit.getEnergy() > fCuts.maxEnergy)
+  {
+    return false;
+  }
+  auto geometry = fMapping.getSlotGeometry(hit.getBarrelSlotID());
+  if (!geometry || !geometry->isValid() || geometry->layer > static_cast<int>(fLayersSizes.size()))
+  {
+    return false;
+  }
+  candidate.time = hit.getTime();
+  candidate.layer = geometry->layer;
+  candidate.slot = geometry->slot;
+  candidate.index = index;
+  return true;
+}
+
+bool JPetHitCombinatorics::areCompatible(const Candidate& first, const Candidate& second) const
+{
+  if (std::fabs(static_cast<double>(second.time) - first.time) > fCuts.maxTimeDiff)
+  {
+    return false;
+  }
+  if (first.layer != second.layer)
+  {
+    return !fCuts.sameLayerOnly;
+  }
+  auto deltaID = calcDeltaID(first, second);
+  return deltaID >= fCuts.minDeltaID && deltaID <= fCuts.maxDeltaID;
+}
+
+/**
+ * Difference of the slot numbers of two candidates in the same layer, at most half of the layer size.
+ */
+int JPetHitCombinatorics::calcDeltaID(const Candidate& first, const Candidate& second) const
+{
+  int deltaID = std::abs(first.slot - second.slot);
+  int layerSize = fLayersSizes[first.layer - 1];
+  return deltaID > layerSize / 2 ? layerSize - deltaID : deltaID;
+}
+
+/**
+ * Collects the hits passing the single hit cuts and orders them by layer
+ * (only if the candidates are limited to a single layer) and time.
+ */
+void JPetHitCombinatorics::collectCandidates(const std::vector<JPetHit>& hits)
+{
+  fCandidates.clear();
+  Candidate candidate;
+  for (std::uint32_t i = 0; i < hits.size(); i++)
+  {
+    if (fillCandidate(hits[i], i, candidate))
+    {
+      fCandidates.push_back(candidate);
+    }
+  }
+  const bool byLayer = fCuts.sameLayerOnly;
+  std::sort(fCandidates.begin(), fCandidates.end(), [byLayer](const Candidate& a, const Candidate& b) {
+    if (byLayer && a.layer != b.layer)
+    {
+      return a.layer < b.layer;
+    }
+    return a.time < b.time || (a.time == b.time && a.index < b.index);
+  });
+}
+
+/**
+ * @brief Calls the visitor for each collected candidate with the range of candidates
+ * which can be combined with it: the candidate itself and the following ones from the same
+ * bucket (layer, if sameLayerOnly is set) registered not later than maxTimeDiff after it.
+ * The end of the range only moves forward, so the sweep is linear apart from the visitor.
+ */
+template <typename Visitor>
+void JPetHitCombinatorics::forEachTimeWindow(Visitor visitor) const
+{
+  const std::size_t size = fCandidates.size();
+  std::size_t bucketEnd = 0;
+  std::size_t end = 0;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    if (i == bucketEnd)
+    {
+      bucketEnd = i + 1;
+      while (bucketEnd < size && (!fCuts.sameLayerOnly || fCandidates[bucketEnd].layer == fCandidates[i].layer))
+      {
+        bucketEnd++;
+      }
+    }
+    end = std::max(end, i + 1);
+    while (end < bucketEnd && static_cast<double>(fCandidates[end].time) - fCandidates[i].time <= fCuts.maxTimeDiff)
+    {
+      end++;
+    }
+    visitor(i, end);
+  }
+}
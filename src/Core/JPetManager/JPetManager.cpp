@@ -19,12 +19,16 @@
 #include "JPetGeantParser/JPetGeantParser.h"
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsGenerator.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
+#include "JPetParamManager/JPetParamBankRegistry.h"
 #include "JPetTaskChainExecutor/JPetTaskChainExecutor.h"
+#include "JPetWorkerPool/JPetWorkerPool.h"
 
-#include <TThread.h>
-#include <cassert>
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include <exception>
 #include <string>
+#include <tuple>
 
 using namespace jpet_options_tools;
 
@@ -52,33 +56,28 @@ void JPetManager::run(int argc, const char** argv)
   JPetManager::registerDefaultTasks();
   useTasksFromUserParams(allValidatedOptions);  // add userTasks registered in userParams to run
   checkDisableLogRotation(allValidatedOptions); // disable log rotation if enabled
+  if (isIntegerParamRefs(allValidatedOptions))
+  {
+    JPetParamRefResolver::setRefMode(JPetParamRefResolver::kIntegerID);
+  }
   auto chainOfTasks = fTaskFactory.createTaskGeneratorChain(allValidatedOptions);
   JPetOptionsGenerator optionsGenerator;
   auto options = optionsGenerator.generateOptionsForTasks(allValidatedOptions, chainOfTasks.size());
 
   INFO("======== Starting processing all tasks: " + JPetCommonTools::getTimeString() + " ========\n");
-  std::vector<TThread*> threads;
-  auto inputDataSeq = 0;
-  /// For every input option, new TaskChainExecutor is created, which creates
-  /// the chain of previously registered tasks. The inputDataSeq is the
-  /// identifier of given chain.
-  for (auto opt : options)
+  if (areThreadsEnabled())
   {
-    auto executor = jpet_common_tools::make_unique<JPetTaskChainExecutor>(chainOfTasks, inputDataSeq, opt.second);
-    if (areThreadsEnabled())
-    {
-      auto thr = executor->run();
-      if (thr)
-      {
-        threads.push_back(thr);
-      }
-      else
-      {
-        ERROR("thread pointer is null");
-      }
-    }
-    else
+    processInWorkerPool(chainOfTasks, options, allValidatedOptions);
+  }
+  else
+  {
+    auto inputDataSeq = 0;
+    /// For every input option, new TaskChainExecutor is created, which creates
+    /// the chain of previously registered tasks. The inputDataSeq is the
+    /// identifier of given chain.
+    for (auto opt : options)
     {
+      auto executor = jpet_common_tools::make_unique<JPetTaskChainExecutor>(chainOfTasks, inputDataSeq, opt.second);
       if (!executor->process())
       {
         ERROR("While running process");
@@ -87,18 +86,53 @@ void JPetManager::run(int argc, const char** argv)
                   << std::endl;
         throw std::runtime_error("Error in executor->process");
       }
+      inputDataSeq++;
     }
+  }
+  /// The banks generated from the local DB are not needed once all the input files are processed
+  JPetParamBankRegistry::getInstance().releaseUnused();
+  INFO("======== Finished processing all tasks: " + JPetCommonTools::getTimeString() + " ========\n");
+}
+
+void JPetManager::processInWorkerPool(const jpet_task_factory::TaskGeneratorChain& chainOfTasks, const JPetOptionsGenerator::OptsForFiles& options,
+                                      const std::map<std::string, boost::any>& allValidatedOptions)
+{
+  using Job = std::tuple<int, std::uintmax_t, const std::map<std::string, boost::any>*>;
+  std::vector<Job> jobs;
+  auto inputDataSeq = 0;
+  for (const auto& opt : options)
+  {
+    boost::system::error_code ec;
+    auto fileSize = boost::filesystem::file_size(getInputFile(opt.second), ec);
+    jobs.emplace_back(inputDataSeq, ec ? 0 : fileSize, &opt.second);
     inputDataSeq++;
   }
-  if (areThreadsEnabled())
+  if (isLargestFileFirst(allValidatedOptions))
   {
-    for (auto thread : threads)
-    {
-      assert(thread);
-      thread->Join();
-    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return std::get<1>(a) > std::get<1>(b); });
+  }
+
+  auto maxThreads = getMaxThreads(allValidatedOptions);
+  JPetWorkerPool pool(maxThreads > 0 ? maxThreads : JPetWorkerPool::getDefaultMaxThreads());
+  INFO("Processing " + std::to_string(jobs.size()) + " input files with at most " + std::to_string(pool.getMaxThreads()) + " threads");
+  for (const auto& job : jobs)
+  {
+    auto seq = std::get<0>(job);
+    auto opts = std::get<2>(job);
+    pool.addJob([&chainOfTasks, seq, opts]() {
+      JPetTaskChainExecutor executor(chainOfTasks, seq, *opts);
+      if (!executor.process())
+      {
+        ERROR("While running process for the input file: " + getInputFile(*opts));
+        return false;
+      }
+      return true;
+    });
+  }
+  if (!pool.run())
+  {
+    ERROR("Processing of at least one input file failed! Check the log!");
   }
-  INFO("======== Finished processing all tasks: " + JPetCommonTools::getTimeString() + " ========\n");
 }
 
 std::pair<bool, std::map<std::string, boost::any>> JPetManager::parseCmdLine(int argc, const char** argv)
@@ -0,0 +1,285 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetPrefetchReader.cpp
+ */
+
+#include "JPetPrefetchReader/JPetPrefetchReader.h"
+#include <TClass.h>
+#include <TROOT.h>
+#include <algorithm>
+#include <chrono>
+
+const std::size_t JPetPrefetchReader::kDefaultEntriesToPrefetch = 4;
+
+JPetPrefetchReader::JPetPrefetchReader(std::size_t entriesToPrefetch) : fEntriesToPrefetch(std::max<std::size_t>(entriesToPrefetch, 1))
+{
+  ROOT::EnableThreadSafety();
+}
+
+JPetPrefetchReader::JPetPrefetchReader(const char* p_filename, const char* treeName, std::size_t entriesToPrefetch)
+    : JPetPrefetchReader(entriesToPrefetch)
+{
+  if (!openFileAndLoadData(p_filename, treeName))
+  {
+    ERROR("error in opening file");
+  }
+}
+
+JPetPrefetchReader::~JPetPrefetchReader() { closeFile(); }
+
+JPetReaderInterface::MyEvent& JPetPrefetchReader::getCurrentEntry()
+{
+  if (isHitColumnar())
+  {
+    return JPetReader::getCurrentEntry();
+  }
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fHasCurrent)
+  {
+    return *fSlots[fCurrentSlot].entry;
+  }
+  ERROR("Could not read the current event");
+  return fEmptyEntry;
+}
+
+bool JPetPrefetchReader::nextEntry()
+{
+  if (isHitColumnar())
+  {
+    return JPetReader::nextEntry();
+  }
+  fCurrentEntryNumber++;
+  return takeNextSlot();
+}
+
+bool JPetPrefetchReader::firstEntry() { return nthEntry(0); }
+
+bool JPetPrefetchReader::lastEntry() { return nthEntry(getNbOfAllEntries() - 1); }
+
+bool JPetPrefetchReader::nthEntry(long long n)
+{
+  if (isHitColumnar())
+  {
+    return JPetReader::nthEntry(n);
+  }
+  fCurrentEntryNumber = n;
+  startPrefetching(n);
+  return takeNextSlot();
+}
+
+void JPetPrefetchReader::closeFile()
+{
+  stopPrefetching();
+  JPetReader::closeFile();
+  /// The slots are deleted after the tree, which keeps their addresses.
+  deleteSlots();
+  fLastEntryToRead = -1;
+}
+
+TObject* JPetPrefetchReader::getObjectFromFile(const char* name)
+{
+  std::lock_guard<std::mutex> fileLock(fFileMutex);
+  return JPetReader::getObjectFromFile(name);
+}
+
+/**
+ * @brief Limits the prefetching to the entries up to lastEntry (inclusive),
+ * e.g. to the end of the range requested by the user. Negative value means the end of the tree.
+ */
+void JPetPrefetchReader::setLastEntryToRead(long long lastEntry)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fLastEntryToRead = lastEntry;
+}
+
+std::size_t JPetPrefetchReader::getEntriesToPrefetch() const { return fEntriesToPrefetch; }
+
+/**
+ * @return number of entries already decoded and waiting to be taken.
+ */
+std::size_t JPetPrefetchReader::getQueueDepth() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fReady;
+}
+
+/**
+ * @return average number of decoded entries waiting at the moment of taking the next entry.
+ * Values close to entriesToPrefetch mean that the ring could be smaller, values close to 0
+ * together with a large stall time mean that reading is the bottleneck.
+ */
+double JPetPrefetchReader::getAverageQueueDepth() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNumberOfTakes > 0 ? static_cast<double>(fSumOfQueueDepths) / fNumberOfTakes : 0.0;
+}
+
+double JPetPrefetchReader::getStallTimeInSeconds() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fStallTime;
+}
+
+long long JPetPrefetchReader::getNumberOfStalls() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNumberOfStalls;
+}
+
+/**
+ * @brief Creates the objects of the branch class, which are reused for all entries.
+ * The objects are owned by the reader, not by the tree.
+ */
+bool JPetPrefetchReader::allocateSlots()
+{
+  if (!fSlots.empty())
+  {
+    return true;
+  }
+  if (!fBranch)
+  {
+    return false;
+  }
+  auto entryClass = TClass::GetClass(fBranch->GetClassName());
+  if (!entryClass)
+  {
+    ERROR(std::string("Unknown class of the branch: ") + fBranch->GetClassName());
+    return false;
+  }
+  /// One slot more than the number of prefetched entries is kept for the current entry.
+  fSlots.resize(fEntriesToPrefetch + 1);
+  for (auto& slot : fSlots)
+  {
+    slot.entry = static_cast<TObject*>(entryClass->DynamicCast(TObject::Class(), entryClass->New()));
+    if (!slot.entry)
+    {
+      ERROR(std::string("Class of the branch does not inherit from TObject: ") + fBranch->GetClassName());
+      deleteSlots();
+      return false;
+    }
+  }
+  return true;
+}
+
+void JPetPrefetchReader::deleteSlots()
+{
+  for (auto& slot : fSlots)
+  {
+    delete slot.entry;
+  }
+  fSlots.clear();
+  fHasCurrent = false;
+  fReady = 0;
+}
+
+void JPetPrefetchReader::startPrefetching(long long firstEntry)
+{
+  stopPrefetching();
+  std::lock_guard<std::mutex> lock(fMutex);
+  fHasCurrent = false;
+  fReady = 0;
+  fCurrentSlot = 0;
+  fNextEntryToRead = firstEntry;
+  fStopRequested = false;
+  fProducerDone = true;
+  if (!fTree || firstEntry < 0 || firstEntry >= getNbOfAllEntries() || !allocateSlots())
+  {
+    return;
+  }
+  /// The first slot to be filled is the one following fCurrentSlot.
+  fCurrentSlot = fSlots.size() - 1;
+  fProducerDone = false;
+  fPrefetchThread = std::thread(&JPetPrefetchReader::prefetch, this);
+}
+
+void JPetPrefetchReader::stopPrefetching()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStopRequested = true;
+  }
+  fSlotFree.notify_all();
+  if (fPrefetchThread.joinable())
+  {
+    fPrefetchThread.join();
+  }
+}
+
+/**
+ * @brief Body of the background thread: reads the consecutive entries into the free slots.
+ */
+void JPetPrefetchReader::prefetch()
+{
+  auto lastEntry = getNbOfAllEntries() - 1;
+  while (true)
+  {
+    std::size_t slot = 0;
+    long long entry = 0;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fSlotFree.wait(lock, [this] { return fStopRequested || fReady < fEntriesToPrefetch; });
+      if (fStopRequested)
+      {
+        break;
+      }
+      entry = fNextEntryToRead;
+      if (entry > lastEntry || (fLastEntryToRead >= 0 && entry > fLastEntryToRead))
+      {
+        break;
+      }
+      slot = (fCurrentSlot + fReady + 1) % fSlots.size();
+    }
+    bool isOK = false;
+    {
+      std::lock_guard<std::mutex> fileLock(fFileMutex);
+      fBranch->SetAddress(&fSlots[slot].entry);
+      /// GetEntry returns 0 if the entry does not exist and -1 in case of I/O error.
+      isOK = fTree->GetEntry(entry) > 0;
+    }
+    std::lock_guard<std::mutex> lock(fMutex);
+    fSlots[slot].isValid = isOK;
+    fNextEntryToRead++;
+    fReady++;
+    fSlotReady.notify_one();
+  }
+  std::lock_guard<std::mutex> lock(fMutex);
+  fProducerDone = true;
+  fSlotReady.notify_all();
+}
+
+/**
+ * @brief Makes the next decoded entry the current one, waiting for the background thread if needed.
+ */
+bool JPetPrefetchReader::takeNextSlot()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  if (fReady == 0 && !fProducerDone)
+  {
+    auto start = std::chrono::steady_clock::now();
+    fSlotReady.wait(lock, [this] { return fReady > 0 || fProducerDone; });
+    fStallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fNumberOfStalls++;
+  }
+  fNumberOfTakes++;
+  fSumOfQueueDepths += fReady;
+  if (fReady == 0)
+  {
+    fHasCurrent = false;
+    return false;
+  }
+  fCurrentSlot = (fCurrentSlot + 1) % fSlots.size();
+  fReady--;
+  fHasCurrent = fSlots[fCurrentSlot].isValid;
+  fSlotFree.notify_one();
+  return fHasCurrent;
+}
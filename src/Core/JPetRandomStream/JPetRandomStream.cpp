@@ -0,0 +1,92 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRandomStream.cpp
+ */
+
+#include "JPetRandomStream/JPetRandomStream.h"
+
+namespace
+{
+/// Finalizer of the SplitMix64 generator, a bijective mixing of 64 bits.
+ULong64_t mix(ULong64_t value)
+{
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+const ULong64_t kGoldenGamma = 0x9e3779b97f4a7c15ULL;
+} // namespace
+
+JPetRandomStream::JPetRandomStream(ULong64_t seed, ULong64_t fileIndex, ULong64_t eventIndex) { setStream(seed, fileIndex, eventIndex); }
+
+/**
+ * @brief Switches to the stream of the given event and starts it from the beginning.
+ */
+void JPetRandomStream::setStream(ULong64_t seed, ULong64_t fileIndex, ULong64_t eventIndex)
+{
+  fSeed = seed;
+  fFileIndex = fileIndex;
+  fKey = deriveKey(seed, fileIndex, eventIndex);
+  fCounter = 0;
+}
+
+void JPetRandomStream::setEventIndex(ULong64_t eventIndex) { setStream(fSeed, fFileIndex, eventIndex); }
+
+/**
+ * @brief Number of values drawn since the stream was set.
+ */
+ULong64_t JPetRandomStream::getCounter() const { return fCounter; }
+
+/**
+ * @return uniformly distributed number from the open interval (0, 1).
+ */
+Double_t JPetRandomStream::Rndm()
+{
+  fCounter++;
+  auto bits = mix(fKey + fCounter * kGoldenGamma);
+  return ((bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+void JPetRandomStream::RndmArray(Int_t n, Float_t* array)
+{
+  for (Int_t i = 0; i < n; i++)
+  {
+    array[i] = static_cast<Float_t>(Rndm());
+  }
+}
+
+void JPetRandomStream::RndmArray(Int_t n, Double_t* array)
+{
+  for (Int_t i = 0; i < n; i++)
+  {
+    array[i] = Rndm();
+  }
+}
+
+/**
+ * @brief Sets the seed keeping the file index, the stream of the event 0 is started.
+ */
+void JPetRandomStream::SetSeed(ULong_t seed) { setStream(seed, fFileIndex, 0); }
+
+UInt_t JPetRandomStream::GetSeed() const { return static_cast<UInt_t>(fSeed); }
+
+/**
+ * @brief Key of the stream, different for every combination of the arguments.
+ */
+ULong64_t JPetRandomStream::deriveKey(ULong64_t seed, ULong64_t fileIndex, ULong64_t eventIndex)
+{
+  auto key = mix(seed + kGoldenGamma);
+  key = mix(key ^ (fileIndex + kGoldenGamma));
+  return mix(key ^ (eventIndex + 2 * kGoldenGamma));
+}
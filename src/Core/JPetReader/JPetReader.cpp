@@ -50,7 +50,7 @@ JPetReader::MyEvent& JPetReader::getCurrentEntry()
   else
   {
     ERROR("Could not read the current event");
-    if (fEntry)
+    if (fEntry && fEntry != fHitWindow.get())
     {
       delete fEntry;
     }
@@ -105,6 +105,9 @@ void JPetReader::closeFile()
   fEntry = 0;
   fTree = 0;
   fCurrentEntryNumber = -1;
+  /// The columns are deleted after the tree, which keeps their addresses.
+  fHitColumns.reset();
+  fHitWindow.reset();
 }
 
 bool JPetReader::openFile(const char* filename)
@@ -137,6 +140,12 @@ bool JPetReader::loadData(const char* treename)
     ERROR("in reading tree");
     return false;
   }
+  if (JPetHitColumns::isColumnarTree(*fTree))
+  {
+    bindHitColumns();
+    firstEntry();
+    return true;
+  }
   TObjArray* arr = fTree->GetListOfBranches();
   fBranch = (TBranch*)(arr->At(0));
   if (!fBranch)
@@ -193,7 +202,15 @@ bool JPetReader::loadCurrentEntry()
   if (fTree)
   {
     int entryCode = fTree->GetEntry(fCurrentEntryNumber);
-    return isCorrectTreeEntryCode(entryCode);
+    if (!isCorrectTreeEntryCode(entryCode))
+    {
+      return false;
+    }
+    if (fHitColumns)
+    {
+      fHitColumns->fillTimeWindow(*fHitWindow);
+    }
+    return true;
   }
   return false;
 }
@@ -206,3 +223,36 @@ inline bool JPetReader::isCorrectTreeEntryCode(int entryCode) const
     return false;
   return true;
 }
+
+/**
+ * @brief Sets the columns (JPetHitColumns::Column flags) read from the trees
+ * with the hit columns, by default all of them. The other columns are not read.
+ */
+void JPetReader::setHitColumns(unsigned int columns)
+{
+  fHitColumnsToRead = columns;
+  if (fHitColumns)
+  {
+    bindHitColumns();
+    loadCurrentEntry();
+  }
+}
+
+bool JPetReader::isHitColumnar() const { return fHitColumns != nullptr; }
+
+/**
+ * @return columns of the current entry, nullptr if the tree was not written column-wise.
+ * Allows to use the columns directly instead of the hits of the current entry.
+ */
+const JPetHitColumns* JPetReader::getHitColumns() const { return fHitColumns.get(); }
+
+void JPetReader::bindHitColumns()
+{
+  if (!fHitColumns)
+  {
+    fHitColumns = std::unique_ptr<JPetHitColumns>(new JPetHitColumns());
+    fHitWindow = std::unique_ptr<JPetTimeWindow>(new JPetTimeWindow(JPetHit::Class_Name()));
+  }
+  fHitColumns->setBranchAddresses(*fTree, fHitColumnsToRead);
+  fEntry = fHitWindow.get();
+}
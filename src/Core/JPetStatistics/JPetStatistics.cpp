@@ -14,6 +14,7 @@
  */
 
 #include "JPetStatistics/JPetStatistics.h"
+#include <TList.h>
 
 ClassImp(JPetStatistics);
 
@@ -158,23 +159,20 @@ void JPetStatistics::fillHistogram(const char* name, double xValue, doubleCheck
     writeError(name, " does not exist" );
     return;
   }
-  TClass *cl = tempObject->IsA();
-  if( cl->InheritsFrom("TH1D") )
+  // type is checked with dynamic_cast only, for frequent fills use getHistoHandle
+  if( TH1D* tempHisto = dynamic_cast<TH1D*>(tempObject) )
   {
-    TH1D* tempHisto = dynamic_cast<TH1D*>(tempObject);
     tempHisto->Fill(xValue);
   }
-  else if( cl->InheritsFrom("TH2D") )
+  else if( TH2D* tempHisto = dynamic_cast<TH2D*>(tempObject) )
   {
-    TH2D* tempHisto = dynamic_cast<TH2D*>(tempObject);
     if(yValue.isChanged)
         tempHisto->Fill(xValue, yValue.value);
     else
         writeError(name, " does not received argument for Y axis" );
   }
-  else if( cl->InheritsFrom("TH3D") )
+  else if( TH3D* tempHisto = dynamic_cast<TH3D*>(tempObject) )
   {
-    TH3D* tempHisto = dynamic_cast<TH3D*>(tempObject);
     if(zValue.isChanged)
         tempHisto->Fill(xValue, yValue.value, zValue.value);
     else if(yValue.isChanged)
@@ -206,3 +204,101 @@ void JPetStatistics::writeError(const char* nameOfHistogram, const char* message
 {
   ERROR(std::string("Histogram with name ") + std::string(nameOfHistogram) + std::string(messageEnd) );
 }
+
+/**
+ * @brief Merges the content of other statistics container into this one.
+ */
+void JPetStatistics::merge(const JPetStatistics& other) { merge(std::vector<const JPetStatistics*>{&other}); }
+
+/**
+ * @brief Merges the content of other statistics containers into this one.
+ *
+ * Objects are matched by name and merged with the merge function provided
+ * by their class (e.g. TH1::Merge), with all matching objects of the other
+ * containers passed at once in the order of the containers. Counters with
+ * the same name are summed. Objects not present in this container are cloned
+ * from the first container having them and added to it.
+ */
+void JPetStatistics::merge(const std::vector<const JPetStatistics*>& others)
+{
+  std::set<std::string> mergedNames;
+  for (std::size_t i = 0; i < others.size(); i++)
+  {
+    TIter next(others[i]->getStatsTable());
+    while (TObject* otherObject = next())
+    {
+      std::string name = otherObject->GetName();
+      if (!mergedNames.insert(name).second)
+      {
+        continue;
+      }
+      TList toMerge;
+      TObject* object = fStats.FindObject(name.c_str());
+      if (!object)
+      {
+        object = otherObject->Clone();
+        fStats.Add(object);
+      }
+      else
+      {
+        toMerge.Add(otherObject);
+      }
+      for (std::size_t j = i + 1; j < others.size(); j++)
+      {
+        if (TObject* nextObject = others[j]->getStatsTable()->FindObject(name.c_str()))
+        {
+          toMerge.Add(nextObject);
+        }
+      }
+      if (toMerge.IsEmpty())
+      {
+        continue;
+      }
+      auto mergeFunction = object->IsA()->GetMerge();
+      if (!mergeFunction)
+      {
+        WARNING(std::string("Object ") + name + std::string(" cannot be merged, only the first instance is kept"));
+        continue;
+      }
+      mergeFunction(object, &toMerge, nullptr);
+    }
+  }
+  for (const auto other : others)
+  {
+    for (const auto& counter : other->fCounters)
+    {
+      fCounters[counter.first] += counter.second;
+    }
+  }
+}
+
+JPetStatisticsShards::JPetStatisticsShards(JPetStatistics& master) : fMaster(master) {}
+
+/**
+ * @brief Creates an empty shard, which should be used by one thread only.
+ * The reference stays valid until the JPetStatisticsShards object is destroyed.
+ */
+JPetStatistics& JPetStatisticsShards::createShard()
+{
+  fShards.push_back(std::unique_ptr<JPetStatistics>(new JPetStatistics()));
+  return *fShards.back();
+}
+
+JPetStatistics& JPetStatisticsShards::getShard(std::size_t index) { return *fShards.at(index); }
+
+std::size_t JPetStatisticsShards::getNumberOfShards() const { return fShards.size(); }
+
+/**
+ * @brief Merges all shards into the master statistics and removes them.
+ * Must be called after all threads using the shards are finished.
+ */
+void JPetStatisticsShards::mergeIntoMaster()
+{
+  std::vector<const JPetStatistics*> shards;
+  for (const auto& shard : fShards)
+  {
+    shards.push_back(shard.get());
+  }
+  fMaster.merge(shards);
+  fShards.clear();
+}
@@ -18,15 +18,35 @@
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetParamsFactory/JPetParamsFactory.h"
 
+#include "JPetTaskIOLoopPerSubTask/JPetTaskIOLoopPerSubTask.h"
+#include "JPetTimeWindowQueue/JPetTimeWindowQueue.h"
+
+#include <TROOT.h>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <thread>
+
+const std::string JPetTaskChainExecutor::kPipelineQueueSizeKey = "JPetTaskChainExecutor_PipelineQueueSize_int";
+const std::string JPetTaskChainExecutor::kSkipOutputEventsKey = "JPetTaskChainExecutor_SkipOutputEventsOfTasks_std::vector<std::string>";
+const std::string JPetTaskChainExecutor::kFileIndexKey = "JPetTaskChainExecutor_FileIndex_int";
+
+namespace
+{
+/// Number of time windows waiting in the queue between two pipelined tasks.
+const int kDefaultPipelineQueueSize = 16;
+} // namespace
 
 JPetTaskChainExecutor::JPetTaskChainExecutor(const TaskGeneratorChain& taskGeneratorChain, int processedFileId,
                                              const jpet_options_tools::OptsStrAny& opts)
     : fInputSeqId(processedFileId), ftaskGeneratorChain(taskGeneratorChain)
 {
   /// ParamManager is generated and added to fParams
-  fParams = jpet_params_factory::generateParams(opts);
+  /// The index of the processed file is passed to the tasks, e.g. to derive their random streams.
+  auto optsWithFileIndex = opts;
+  optsWithFileIndex[kFileIndexKey] = processedFileId;
+  fParams = jpet_params_factory::generateParams(optsWithFileIndex);
   assert(fParams.getParamManager());
   for (auto taskGenerator : ftaskGeneratorChain)
   {
@@ -38,39 +58,195 @@ JPetTaskChainExecutor::JPetTaskChainExecutor(const TaskGeneratorChain& taskGener
 bool JPetTaskChainExecutor::process()
 {
   JPetTimer timer;
-  JPetDataInterface nullDataObject;
   JPetParams controlParams; /// Parameters used to control the input file type and event range.
+  bool isPipelined = jpet_options_tools::isPipelinedProcessing(fParams.getOptions());
+
+  for (auto currentTask = fTasks.begin(); currentTask != fTasks.end();)
+  {
+    auto pipelineEnd = isPipelined ? findPipelineEnd(currentTask) : std::next(currentTask);
+    if (std::distance(currentTask, pipelineEnd) > 1)
+    {
+      if (!processPipeline(currentTask, pipelineEnd, controlParams, timer))
+      {
+        return false;
+      }
+      currentTask = pipelineEnd;
+    }
+    else
+    {
+      if (!processTask(**currentTask, controlParams, timer))
+      {
+        return false;
+      }
+      ++currentTask;
+    }
+  }
+  INFO(timer.getAllMeasuredTimes());
+  INFO(timer.getTotalMeasuredTime());
+  return true;
+}
+
+/**
+ * @brief Runs init(), run() and terminate() of a single task.
+ * The controlParams produced by the previous task are used to generate the input parameters
+ * and are replaced by the ones produced by the current task.
+ */
+bool JPetTaskChainExecutor::processTask(JPetTaskInterface& currentTask, JPetParams& controlParams, JPetTimer& timer)
+{
+  JPetDataInterface nullDataObject;
+  auto taskName = currentTask.getName();
+  auto& currParams = fParams;
+  /// We generate input parameters based on the current parameter set and the controlParams produced by
+  /// the previous task.
+  currParams = jpet_params_factory::generateParams(currParams, controlParams);
+  jpet_options_tools::printOptionsToLog(currParams.getOptions(), std::string("Options for ") + taskName);
+  timer.startMeasurement();
+  INFO(Form("Starting task: %s", taskName.c_str()));
+  if (!currentTask.init(currParams))
+  {
+    ERROR("In task " + taskName + " init()");
+    return false;
+  }
+  if (!currentTask.run(nullDataObject))
+  {
+    ERROR("In task " + taskName + " run()");
+    return false;
+  }
+  if (!currentTask.terminate(controlParams))
+  { /// Here controParams can be modified by the current task.
+    ERROR("In task " + taskName + " terminate()");
+    return false;
+  }
+  timer.stopMeasurement("task " + taskName);
+  return true;
+}
+
+/**
+ * @return iterator past the last of the consecutive tasks, starting from the first one,
+ * which can be connected in a pipeline.
+ */
+JPetTaskChainExecutor::TaskIterator JPetTaskChainExecutor::findPipelineEnd(TaskIterator first)
+{
+  auto canBePipelined = [](const std::unique_ptr<JPetTaskInterface>& task) {
+    auto taskIO = dynamic_cast<JPetTaskIOLoopPerSubTask*>(task.get());
+    return taskIO && taskIO->isInput() && taskIO->isOutput() && taskIO->getSubTasks().size() == 1;
+  };
+  return std::find_if_not(first, fTasks.end(), canBePipelined);
+}
 
-  /// We iterate over both tasks and parameters
-  for (const auto& currentTask : fTasks)
+/**
+ * @brief Runs the tasks in the range [first, last) at the same time, each in its own thread.
+ * Every task passes its output to the next one by a bounded queue.
+ * The tasks are initialized and terminated in the order of the chain.
+ */
+bool JPetTaskChainExecutor::processPipeline(TaskIterator first, TaskIterator last, JPetParams& controlParams, JPetTimer& timer)
+{
+  using namespace jpet_options_tools;
+  auto options = fParams.getOptions();
+  int queueSize = kDefaultPipelineQueueSize;
+  if (isOptionSet(options, kPipelineQueueSizeKey))
+  {
+    queueSize = getOptionAsInt(options, kPipelineQueueSizeKey);
+  }
+  std::vector<std::string> skipOutputEvents;
+  if (isOptionSet(options, kSkipOutputEventsKey))
   {
-    auto taskName = currentTask->getName();
-    auto& currParams = fParams;
-    /// We generate input parameters based on the current parameter set and the controlParams produced by
-    /// the previous task.
-    currParams = jpet_params_factory::generateParams(currParams, controlParams);
-    jpet_options_tools::printOptionsToLog(currParams.getOptions(), std::string("Options for ") + taskName);
-    timer.startMeasurement();
-    INFO(Form("Starting task: %s", taskName.c_str()));
-    if (!currentTask->init(currParams))
+    skipOutputEvents = getOptionAsVectorOfStrings(options, kSkipOutputEventsKey);
+  }
+
+  std::vector<JPetTaskIO*> stages;
+  std::string pipelineName;
+  for (auto it = first; it != last; ++it)
+  {
+    stages.push_back(static_cast<JPetTaskIO*>(it->get()));
+    pipelineName += (stages.size() > 1 ? " | " : "") + (*it)->getName();
+  }
+  std::vector<std::shared_ptr<JPetTimeWindowQueue>> queues;
+  for (std::size_t i = 0; i + 1 < stages.size(); i++)
+  {
+    queues.push_back(std::make_shared<JPetTimeWindowQueue>(queueSize > 0 ? queueSize : kDefaultPipelineQueueSize));
+  }
+
+  timer.startMeasurement();
+  INFO(Form("Starting pipeline: %s", pipelineName.c_str()));
+  for (std::size_t i = 0; i < stages.size(); i++)
+  {
+    auto stage = stages[i];
+    auto taskName = stage->getName();
+    fParams = jpet_params_factory::generateParams(fParams, controlParams);
+    printOptionsToLog(fParams.getOptions(), std::string("Options for ") + taskName);
+    if (i > 0)
+    {
+      stage->connectInputQueue(queues[i - 1], stages[i - 1]->getHeader());
+    }
+    if (i < queues.size())
+    {
+      stage->connectOutputQueue(queues[i]);
+      auto skip = std::find(skipOutputEvents.begin(), skipOutputEvents.end(), taskName) != skipOutputEvents.end();
+      stage->setSaveOutputEvents(!skip);
+    }
+    if (!stage->init(fParams))
     {
       ERROR("In task " + taskName + " init()");
       return false;
     }
-    if (!currentTask->run(nullDataObject))
+    /// The next task is initialized before this one finishes, so it gets the parameters in advance.
+    controlParams = stage->getOutputParams();
+  }
+
+  ROOT::EnableThreadSafety();
+  std::vector<int> results(stages.size(), 0);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < stages.size(); i++)
+  {
+    threads.emplace_back([&stages, &queues, &results, i]() {
+      JPetDataInterface nullDataObject;
+      results[i] = stages[i]->run(nullDataObject);
+      /// Nobody reads the input queue anymore, so the previous task must not wait for it.
+      if (i > 0)
+      {
+        queues[i - 1]->abort();
+      }
+      if (i < queues.size())
+      {
+        if (results[i])
+        {
+          queues[i]->close();
+        }
+        else
+        {
+          queues[i]->abort();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  bool isOK = true;
+  for (std::size_t i = 0; i < stages.size(); i++)
+  {
+    if (!results[i])
     {
-      ERROR("In task " + taskName + " run()");
-      return false;
+      ERROR("In task " + stages[i]->getName() + " run()");
+      isOK = false;
     }
-    if (!currentTask->terminate(controlParams))
-    { /// Here controParams can be modified by the current task.
-      ERROR("In task " + taskName + " terminate()");
+  }
+  if (!isOK)
+  {
+    return false;
+  }
+  for (auto stage : stages)
+  {
+    if (!stage->terminate(controlParams))
+    {
+      ERROR("In task " + stage->getName() + " terminate()");
       return false;
     }
-    timer.stopMeasurement("task " + taskName);
   }
-  INFO(timer.getAllMeasuredTimes());
-  INFO(timer.getTotalMeasuredTime());
+  timer.stopMeasurement("pipeline " + pipelineName);
   return true;
 }
 
@@ -101,7 +101,7 @@ TaskGeneratorChain generateDirectTaskGeneratorChain(const std::vector<TaskInfo>&
       {
         TaskGenerator userTaskGen = generatorsMap.at(task_name);
 
-        task->addSubTask(std::unique_ptr<JPetTaskInterface>(userTaskGen()));
+        task->addSubTaskGenerator(userTaskGen);
       }
       else
       {
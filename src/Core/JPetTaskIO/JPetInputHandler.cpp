@@ -16,14 +16,37 @@
 #include "JPetTaskIO/JPetInputHandler.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetPrefetchReader/JPetPrefetchReader.h"
 #include "JPetTaskIO/JPetTaskIOTools.h"
 
+const std::string JPetInputHandler::kPrefetchEntriesKey = "JPetInputHandler_PrefetchEntries_int";
+const std::string JPetInputHandler::kHitColumnsKey = "JPetInputHandler_HitColumns_std::vector<std::string>";
+
 JPetInputHandler::JPetInputHandler() { fReader = jpet_common_tools::make_unique<JPetReader>(); }
 
 bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& params)
 {
   using namespace jpet_options_tools;
   auto options = params.getOptions();
+  if (isOptionSet(options, kPrefetchEntriesKey) && getOptionAsInt(options, kPrefetchEntriesKey) > 0)
+  {
+    fReader = jpet_common_tools::make_unique<JPetPrefetchReader>(getOptionAsInt(options, kPrefetchEntriesKey));
+  }
+  auto hitColumns = fHitColumns;
+  if (isOptionSet(options, kHitColumnsKey))
+  {
+    hitColumns = JPetHitColumns::parseColumns(getOptionAsVectorOfStrings(options, kHitColumnsKey));
+  }
+  auto reader = dynamic_cast<JPetReader*>(fReader.get());
+  if (reader)
+  {
+    reader->setHitColumns(hitColumns);
+  }
+  else if (hitColumns != 0)
+  {
+    ERROR("The hit columns can be read only by JPetReader.");
+    return false;
+  }
   if (fReader->openFileAndLoadData(inputFilename, JPetReader::kRootTreeName.c_str()))
   {
     /// For all types of files which has not hld format we assume
@@ -49,10 +72,22 @@ bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& pa
   return true;
 }
 
+/**
+ * @brief Sets the hit columns read if the input tree was written column-wise, see JPetReader::setHitColumns.
+ */
+void JPetInputHandler::setHitColumns(unsigned int columns) { fHitColumns = columns; }
+
 void JPetInputHandler::closeInput()
 {
   if (fReader)
   {
+    auto prefetchReader = dynamic_cast<JPetPrefetchReader*>(fReader.get());
+    if (prefetchReader)
+    {
+      INFO(Form("Prefetching of %zu entries: waited %f s in %lld stalls, average number of ready entries: %f",
+                prefetchReader->getEntriesToPrefetch(), prefetchReader->getStallTimeInSeconds(), prefetchReader->getNumberOfStalls(),
+                prefetchReader->getAverageQueueDepth()));
+    }
     fReader->closeFile();
   }
 }
@@ -74,6 +109,11 @@ bool JPetInputHandler::setEntryRange(const jpet_options_tools::OptsStrAny& optio
   fEntryRange.lastEntry = lastEntry;
   fEntryRange.currentEntry = firstEntry;
   assert(fReader);
+  auto prefetchReader = dynamic_cast<JPetPrefetchReader*>(fReader.get());
+  if (prefetchReader)
+  {
+    prefetchReader->setLastEntryToRead(lastEntry);
+  }
   return fReader->nthEntry(fEntryRange.currentEntry);
 }
 
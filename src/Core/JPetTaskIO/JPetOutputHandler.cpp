@@ -14,19 +14,24 @@
  */
 
 #include "JPetTaskIO/JPetOutputHandler.h"
+#include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetTaskIO/version.h"
 #include "JPetTimeWindowMC/JPetTimeWindowMC.h"
 #include "JPetTreeHeader/JPetTreeHeader.h"
 #include "JPetUserTask/JPetUserTask.h"
 #include "JPetWriter/JPetWriter.h"
 #include <cassert>
+#include <typeinfo>
+
+const std::string JPetOutputHandler::kAsyncWindowsKey = "JPetOutputHandler_AsyncWindows_int";
+const std::string JPetOutputHandler::kHitColumnsKey = "JPetOutputHandler_HitColumns_std::vector<std::string>";
 
 JPetOutputHandler::JPetOutputHandler() : fWriter("defaultOutput.root") {}
 
 JPetOutputHandler::JPetOutputHandler(const char* outputFilename) : fWriter(outputFilename) {}
 
 void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fHeader, JPetStatistics* fStatistics,
-                                   std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
+                                   std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters)
 {
   assert(fHeader);
   assert(fStatistics);
@@ -40,7 +45,10 @@ void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fH
   }
   // store the parametric objects in the ouptut ROOT file
   manager.saveParametersToFile(&fWriter);
-  manager.clearParameters();
+  if (clearParameters)
+  {
+    manager.clearParameters();
+  }
 }
 
 bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
@@ -53,12 +61,26 @@ bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
     auto pInputEvent = dynamic_cast<JPetTimeWindowMC*>(pUserTask->getInputEvents());
     if ((pInputEvent != nullptr))
     {
-      fWriter.write(JPetTimeWindowMC(*pInputEvent, *pOutputEntry));
+      if (fWriter.isAsync())
+      {
+        fWriter.write(std::unique_ptr<JPetTimeWindow>(new JPetTimeWindowMC(*pInputEvent, *pOutputEntry)));
+      }
+      else
+      {
+        fWriter.write(JPetTimeWindowMC(*pInputEvent, *pOutputEntry));
+      }
     }
     else
     {
       if(pOutputEntry->getNumberOfEvents() > 0){
-        fWriter.write(*pOutputEntry);
+        if (fWriter.isAsync())
+        {
+          handOverOutputEvents(pUserTask);
+        }
+        else
+        {
+          fWriter.write(*pOutputEntry);
+        }
       }
     }
   }
@@ -70,10 +92,88 @@ bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
   return true;
 }
 
+/**
+ * @brief Writes already prepared time window, e.g. a copy of the task output
+ * made by one of the event-parallel workers of JPetTaskStreamIO.
+ */
+bool JPetOutputHandler::writeTimeWindow(const JPetTimeWindow& window) { return fWriter.write(window); }
+
+/**
+ * @brief Writes the time window without copying it if the writer works asynchronously.
+ */
+bool JPetOutputHandler::writeTimeWindow(std::unique_ptr<JPetTimeWindow> window) { return fWriter.write(std::move(window)); }
+
+/**
+ * @brief Switches the writer to the asynchronous mode, see JPetWriter::enableAsyncWriting.
+ */
+void JPetOutputHandler::enableAsyncWriting(std::size_t maxPendingWindows) { fWriter.enableAsyncWriting(maxPendingWindows); }
+
+/**
+ * @brief Switches the writer to the column-wise writing of the hits, see JPetWriter::setHitColumns.
+ */
+void JPetOutputHandler::setHitColumns(unsigned int columns) { fWriter.setHitColumns(columns); }
+
+/**
+ * @brief Passes the output time window of the task to the asynchronous writer and gives
+ * the task an empty (possibly already written and cleared) window in exchange.
+ * The output is copied if it cannot be exchanged, e.g. if the task passes its input
+ * as the output or uses a derived time window class.
+ */
+bool JPetOutputHandler::handOverOutputEvents(JPetUserTask* task)
+{
+  auto output = task->getOutputEvents();
+  if (output == task->getInputEvents() || typeid(*output) != typeid(JPetTimeWindow))
+  {
+    return fWriter.write(*output);
+  }
+  auto replacement = fWriter.takeRecycledWindow(output->getEventType());
+  if (!replacement)
+  {
+    replacement = jpet_common_tools::make_unique<JPetTimeWindow>(output->getEventType());
+  }
+  auto replacementPtr = replacement.get();
+  std::unique_ptr<JPetTimeWindow> previous(task->swapOutputEvents(replacement.release()));
+  if (previous.get() != output || task->getOutputEvents() != replacementPtr)
+  {
+    /// The task does not keep its output in fOutputEvents, so it is restored and copied.
+    replacement.reset(task->swapOutputEvents(previous.release()));
+    return fWriter.write(*output);
+  }
+  return fWriter.write(std::move(previous));
+}
+
+/**
+ * @brief Copies the output of the task in the form in which writeEventToFile would save it.
+ * The copy is set to nullptr if nothing should be saved.
+ * @return false if the task produced no output container.
+ */
+bool JPetOutputHandler::copyEventToSave(JPetTaskInterface* task, std::unique_ptr<JPetTimeWindow>& copy)
+{
+  assert(task);
+  copy.reset();
+  auto pUserTask = (dynamic_cast<JPetUserTask*>(task));
+  auto pOutputEntry = pUserTask->getOutputEvents();
+  if (!pOutputEntry)
+  {
+    ERROR("No proper timeWindow object returned to save to file, returning from subtask " + task->getName());
+    return false;
+  }
+  auto pInputEvent = dynamic_cast<JPetTimeWindowMC*>(pUserTask->getInputEvents());
+  if (pInputEvent)
+  {
+    copy = jpet_common_tools::make_unique<JPetTimeWindowMC>(*pInputEvent, *pOutputEntry);
+  }
+  else if (pOutputEntry->getNumberOfEvents() > 0)
+  {
+    copy = pOutputEntry->copy();
+  }
+  return true;
+}
+
 /// @todo change it!!!
 void JPetOutputHandler::saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* fHeader, JPetStatistics* fStatistics,
-                                           std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
+                                           std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters)
 {
-  saveOutput(manager, fHeader, fStatistics, fSubTasksStatistics);
+  saveOutput(manager, fHeader, fStatistics, fSubTasksStatistics, clearParameters);
   fWriter.closeFile();
 }
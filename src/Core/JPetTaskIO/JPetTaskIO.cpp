@@ -63,7 +63,7 @@ bool JPetTaskIO::init(const JPetParams& params)
     return false;
   }
 
-  if (isInput())
+  if (isInput() && !fInputQueue)
   {
     if (!createInputObjects(inputFilename.c_str()))
     {
@@ -87,15 +87,7 @@ bool JPetTaskIO::init(const JPetParams& params)
 bool JPetTaskIO::terminate(JPetParams& output_params)
 {
   auto subTaskName = getFirstSubTaskName();
-  if (isOutput())
-  {
-    auto newOpts = JPetTaskIOTools::setOutputOptions(fParams, fTaskInfo.fResetOutputPath, fTaskInfo.fOutFileFullPath);
-    output_params = JPetParams(newOpts, fParams.getParamManagerAsShared());
-  }
-  else
-  {
-    output_params = fParams;
-  }
+  output_params = getOutputParams();
 
   if (isOutput())
   {
@@ -111,9 +103,10 @@ bool JPetTaskIO::terminate(JPetParams& output_params)
       ERROR("Subtask name:" + subTaskName);
       return false;
     }
-    fOutputHandler->saveAndCloseOutput(getParamManager(), fHeader, fStatistics.get(), fSubTasksStatistics);
+    /// The parameters are still used by the next task if it is fed by the output queue.
+    fOutputHandler->saveAndCloseOutput(getParamManager(), fHeader, fStatistics.get(), fSubTasksStatistics, !fOutputQueue);
   }
-  if (isInput())
+  if (isInput() && !fInputQueue)
   {
     if (!fInputHandler)
     {
@@ -166,6 +159,38 @@ bool JPetTaskIO::isOutput() const { return fIsOutput; }
 
 bool JPetTaskIO::isInput() const { return fIsInput; }
 
+/**
+ * @return parameters for the next task in the chain, the same as returned by terminate().
+ */
+JPetParams JPetTaskIO::getOutputParams() const
+{
+  if (isOutput())
+  {
+    auto newOpts = JPetTaskIOTools::setOutputOptions(fParams, fTaskInfo.fResetOutputPath, fTaskInfo.fOutFileFullPath);
+    return JPetParams(newOpts, fParams.getParamManagerAsShared());
+  }
+  return fParams;
+}
+
+const JPetTreeHeader* JPetTaskIO::getHeader() const { return fHeader; }
+
+/**
+ * @brief Sets the queue used as the input instead of the input file.
+ * Must be called before init(). The header of the previous task is copied
+ * to the output file instead of the header read from the input file.
+ */
+void JPetTaskIO::connectInputQueue(std::shared_ptr<JPetTimeWindowQueue> queue, const JPetTreeHeader* inputHeader)
+{
+  fInputQueue = queue;
+  fInputHeader = inputHeader;
+}
+
+void JPetTaskIO::connectOutputQueue(std::shared_ptr<JPetTimeWindowQueue> queue) { fOutputQueue = queue; }
+
+void JPetTaskIO::setSaveOutputEvents(bool save) { fSaveOutputEvents = save; }
+
+bool JPetTaskIO::isSaveOutputEvents() const { return fSaveOutputEvents; }
+
 /**
  * @return (isOK, inputFile, outputFileFullPath, isResetOutputPath) based on provided options.
  * If isOK is set to false, that means that an error has occured.
@@ -179,9 +204,33 @@ std::tuple<bool, std::string, std::string, bool> JPetTaskIO::setInputAndOutputFi
 bool JPetTaskIO::createInputObjects(const char* inputFilename)
 {
   fInputHandler = jpet_common_tools::make_unique<JPetInputHandler>();
+  fInputHandler->setHitColumns(getRequiredHitColumns());
   return fInputHandler->openInput(inputFilename, fParams);
 }
 
+/**
+ * @brief Sum of the hit columns required by the user subtasks, all the columns
+ * if any of the subtasks is not a user task.
+ */
+unsigned int JPetTaskIO::getRequiredHitColumns() const
+{
+  if (fSubTasks.empty())
+  {
+    return JPetHitColumns::kAll;
+  }
+  unsigned int columns = 0;
+  for (const auto& subTask : fSubTasks)
+  {
+    auto userTask = dynamic_cast<const JPetUserTask*>(subTask.get());
+    if (!userTask)
+    {
+      return JPetHitColumns::kAll;
+    }
+    columns |= userTask->getRequiredHitColumns();
+  }
+  return columns;
+}
+
 bool JPetTaskIO::createOutputObjects(const char* outputFilename)
 {
   if (!isOutput())
@@ -197,6 +246,14 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
   }
   using namespace jpet_options_tools;
   auto options = fParams.getOptions();
+  if (isOptionSet(options, JPetOutputHandler::kAsyncWindowsKey) && getOptionAsInt(options, JPetOutputHandler::kAsyncWindowsKey) > 0)
+  {
+    fOutputHandler->enableAsyncWriting(getOptionAsInt(options, JPetOutputHandler::kAsyncWindowsKey));
+  }
+  if (isOptionSet(options, JPetOutputHandler::kHitColumnsKey))
+  {
+    fOutputHandler->setHitColumns(JPetHitColumns::parseColumns(getOptionAsVectorOfStrings(options, JPetOutputHandler::kHitColumnsKey)));
+  }
 
   if (file_type_checker::getInputFileType(options) == file_type_checker::kHldRoot ||
       file_type_checker::getInputFileType(options) == file_type_checker::kMCGeant)
@@ -211,7 +268,16 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
   }
   else
   {
-    if (isInput())
+    if (fInputQueue)
+    {
+      if (!fInputHeader)
+      {
+        ERROR("Input queue is connected, but the header of the previous task is not set.");
+        return false;
+      }
+      fHeader = static_cast<JPetTreeHeader*>(fInputHeader->Clone());
+    }
+    else if (isInput())
     {
       // read the header from the previous analysis stage
       fHeader = fInputHandler->getHeaderClone();
@@ -239,7 +305,8 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
     {
       auto task = dynamic_cast<JPetUserTask*>(fSubTask->get());
       std::string subtaskStatisticsName = task->getName() + std::string(" subtask ") + std::to_string(i) + std::string(" stats");
-      fSubTasksStatistics[subtaskStatisticsName] = std::move(jpet_common_tools::make_unique<JPetStatistics>(*fStatistics));
+      // each subtask gets its own container, the copy constructor would share the objects of fStatistics
+      fSubTasksStatistics[subtaskStatisticsName] = jpet_common_tools::make_unique<JPetStatistics>();
       task->setStatistics(fSubTasksStatistics[subtaskStatisticsName].get());
       i++;
     }
@@ -290,3 +357,29 @@ std::string JPetTaskIO::getFirstSubTaskName() const
   }
   return subTaskName;
 }
+
+/**
+ * @brief Saves the output of the task to the file and passes its copy to the output queue if connected.
+ * @return false in case of errors or if the output queue has been aborted.
+ */
+bool JPetTaskIO::writeOutputEvents(JPetTaskInterface* task)
+{
+  if (!fOutputQueue)
+  {
+    return fOutputHandler->writeEventToFile(task);
+  }
+  std::unique_ptr<JPetTimeWindow> copy;
+  if (!JPetOutputHandler::copyEventToSave(task, copy))
+  {
+    return false;
+  }
+  if (!copy)
+  {
+    return true;
+  }
+  if (fSaveOutputEvents && !fOutputHandler->writeTimeWindow(*copy))
+  {
+    return false;
+  }
+  return fOutputQueue->push(std::move(copy));
+}
@@ -34,7 +34,15 @@ bool JPetTaskIOLoopPerSubTask::run(const JPetDataInterface&)
     ERROR("No subTask set");
     return false;
   }
-  if (isInput())
+  if (fInputQueue)
+  {
+    if (fSubTasks.size() > 1)
+    {
+      ERROR("The input queue can be read only by a single subTask");
+      return false;
+    }
+  }
+  else if (isInput())
   {
     if (!fInputHandler)
     {
@@ -53,7 +61,14 @@ bool JPetTaskIOLoopPerSubTask::run(const JPetDataInterface&)
       continue;
     }
 
-    if (isInput())
+    if (fInputQueue)
+    {
+      if (!processEventsFromQueue(pTask.get()))
+      {
+        return false;
+      }
+    }
+    else if (isInput())
     {
       assert(fInputHandler);
       bool isProgressBarOn = isProgressBar(fParams.getOptions());
@@ -71,7 +86,8 @@ bool JPetTaskIOLoopPerSubTask::run(const JPetDataInterface&)
         {
           displayProgressBar(subTaskName, fInputHandler->getCurrentEntryNumber(), lastEvent);
         }
-        JPetData event(fInputHandler->getEntry());
+        auto entryNumber = fInputHandler->getCurrentEntryNumber();
+        JPetData event(fInputHandler->getEntry(), entryNumber, entryNumber == lastEvent);
         isOK = pTask->run(event);
         if (!isOK)
         {
@@ -80,7 +96,7 @@ bool JPetTaskIOLoopPerSubTask::run(const JPetDataInterface&)
         }
         if (isOutput())
         {
-          if (!fOutputHandler->writeEventToFile(pTask.get()))
+          if (!writeOutputEvents(pTask.get()))
           {
             ERROR("Some problems occured, while writing the event to file.");
             return false;
@@ -105,3 +121,44 @@ bool JPetTaskIOLoopPerSubTask::run(const JPetDataInterface&)
   }
   return true;
 }
+
+/**
+ * @brief Runs the subTask on the time windows taken from the input queue until the queue is closed.
+ */
+bool JPetTaskIOLoopPerSubTask::processEventsFromQueue(JPetTaskInterface* task)
+{
+  auto subTaskName = task->getName();
+  std::unique_ptr<JPetTimeWindow> window;
+  /// The subTask may keep a pointer to its last input event (e.g. as the output events),
+  /// so the previous window is destroyed only after the next one is processed.
+  std::unique_ptr<JPetTimeWindow> previousWindow;
+  /// The next window is taken before processing the current one to know if it is the last one.
+  std::unique_ptr<JPetTimeWindow> nextWindow;
+  bool isWindow = fInputQueue->pop(nextWindow);
+  while (isWindow)
+  {
+    window = std::move(nextWindow);
+    isWindow = fInputQueue->pop(nextWindow);
+    JPetData event(*window, -1, !isWindow);
+    if (!task->run(event))
+    {
+      ERROR("In run() of:" + subTaskName + ". ");
+      return false;
+    }
+    if (isOutput())
+    {
+      if (!writeOutputEvents(task))
+      {
+        ERROR("Some problems occured, while writing the event to file.");
+        return false;
+      }
+    }
+    previousWindow = std::move(window);
+  }
+  if (fInputQueue->isAborted())
+  {
+    ERROR("The input queue of:" + subTaskName + " has been aborted.");
+    return false;
+  }
+  return true;
+}
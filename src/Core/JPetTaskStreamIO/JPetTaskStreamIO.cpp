@@ -15,10 +15,110 @@
 
 #include "JPetTaskStreamIO/JPetTaskStreamIO.h"
 
+#include "./JPetCommonTools/JPetCommonTools.h"
 #include "./JPetData/JPetData.h"
 #include "./JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "./JPetReader/JPetReader.h"
 #include "./JPetUserTask/JPetUserTask.h"
 
+#include <TDirectory.h>
+#include <TROOT.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+const std::string JPetTaskStreamIO::kNumberOfWorkersKey = "JPetTaskStreamIO_NumberOfWorkers_int";
+
+namespace
+{
+/// Number of consecutive entries taken by a worker at once.
+const long long kEntriesPerChunk = 16;
+/// Number of processed entries per worker that can wait for being written.
+const long long kBufferedEntriesPerWorker = 64;
+
+/**
+ * @brief Buffer restoring the input order of the entries processed by the workers.
+ *
+ * Workers put the output of given entry, the writer takes the outputs
+ * in the order of entries. Workers which are too far ahead of the writer
+ * are blocked until the writer catches up.
+ */
+class ReorderBuffer
+{
+public:
+  ReorderBuffer(long long firstEntry, long long capacity) : fNextEntry(firstEntry), fCapacity(capacity) {}
+
+  void put(long long entry, std::unique_ptr<JPetTimeWindow> output)
+  {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fSpaceAvailable.wait(lock, [&] { return fAborted || entry < fNextEntry + fCapacity; });
+    if (fAborted)
+    {
+      return;
+    }
+    fOutputs[entry] = std::move(output);
+    fOutputReady.notify_all();
+  }
+
+  /// Returns false if the processing has been aborted.
+  bool takeNext(std::unique_ptr<JPetTimeWindow>& output)
+  {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fOutputReady.wait(lock, [&] { return fAborted || fOutputs.find(fNextEntry) != fOutputs.end(); });
+    if (fAborted)
+    {
+      return false;
+    }
+    auto it = fOutputs.find(fNextEntry);
+    output = std::move(it->second);
+    fOutputs.erase(it);
+    fNextEntry++;
+    fSpaceAvailable.notify_all();
+    return true;
+  }
+
+  void abort()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fAborted = true;
+    fOutputReady.notify_all();
+    fSpaceAvailable.notify_all();
+  }
+
+  bool isAborted()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fAborted;
+  }
+
+private:
+  std::mutex fMutex;
+  std::condition_variable fOutputReady;
+  std::condition_variable fSpaceAvailable;
+  std::map<long long, std::unique_ptr<JPetTimeWindow>> fOutputs;
+  long long fNextEntry = 0;
+  long long fCapacity = 0;
+  bool fAborted = false;
+};
+
+/**
+ * @brief Chain of subtasks processing events in one worker thread.
+ *
+ * The first worker uses the subtasks of the task stream itself,
+ * the other ones own their copies created by the subtask generators.
+ */
+struct StreamWorker
+{
+  std::vector<std::unique_ptr<JPetTaskInterface>> ownedTasks;
+  std::vector<JPetTaskInterface*> tasks;
+  JPetReader reader;
+};
+
+} // namespace
+
 JPetTaskStreamIO::JPetTaskStreamIO(const char* name, const char* in_file_type, const char* out_file_type)
     : JPetTaskIO(name, in_file_type, out_file_type)
 {
@@ -36,7 +136,6 @@ JPetTaskStreamIO::JPetTaskStreamIO(const char* name, const char* in_file_type, c
 
 bool JPetTaskStreamIO::run(const JPetDataInterface&)
 {
-  using namespace jpet_options_tools;
   if (fSubTasks.empty())
   {
     ERROR("No subTask set");
@@ -70,6 +169,91 @@ bool JPetTaskStreamIO::run(const JPetDataInterface&)
     return false;
   }
 
+  auto numberOfWorkers = getNumberOfWorkers();
+  bool isOK = false;
+  if (numberOfWorkers > 1 && fSubTaskGenerators.size() != fSubTasks.size())
+  {
+    WARNING("Subtasks were not added with their generators, the events will be processed by a single worker.");
+    numberOfWorkers = 1;
+  }
+  if (numberOfWorkers > 1 && !areSubTasksEntryIndependent())
+  {
+    WARNING("Some subtasks depend on the previously processed entries, the events will be processed by a single worker.");
+    numberOfWorkers = 1;
+  }
+  if (numberOfWorkers > 1)
+  {
+    isOK = processEventsInParallel(numberOfWorkers);
+  }
+  else
+  {
+    isOK = processEvents();
+  }
+  if (!isOK)
+  {
+    return false;
+  }
+
+  // terminate all subtasks after all processing
+  for (const auto& pTask : fSubTasks)
+  {
+    JPetParams subTaskParams;
+
+    bool ok = pTask->terminate(subTaskParams);
+    if (!ok)
+    {
+      ERROR("In terminate() of:" + pTask->getName() + ". ");
+    }
+    fParams = mergeWithExtraParams(fParams, subTaskParams);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Adds the subtask created by the generator. The generator is kept,
+ * so that the event-parallel workers can create their own copies of the subtask.
+ */
+void JPetTaskStreamIO::addSubTaskGenerator(SubTaskGenerator generator)
+{
+  addSubTask(generator());
+  fSubTaskGenerators.push_back(generator);
+}
+
+/**
+ * @return number of workers set with JPetTaskStreamIO_NumberOfWorkers_int option, 1 by default.
+ */
+int JPetTaskStreamIO::getNumberOfWorkers() const
+{
+  using namespace jpet_options_tools;
+  auto options = fParams.getOptions();
+  if (isOptionSet(options, kNumberOfWorkersKey))
+  {
+    return getOptionAsInt(options, kNumberOfWorkersKey);
+  }
+  return 1;
+}
+
+/**
+ * @return true if all subtasks are user tasks declaring JPetUserTask::isEntryIndependent.
+ */
+bool JPetTaskStreamIO::areSubTasksEntryIndependent() const
+{
+  return std::all_of(fSubTasks.begin(), fSubTasks.end(), [](const std::unique_ptr<JPetTaskInterface>& task) {
+    auto userTask = dynamic_cast<const JPetUserTask*>(task.get());
+    return userTask && userTask->isEntryIndependent();
+  });
+}
+
+bool JPetTaskStreamIO::createInputObjects(const char* inputFilename)
+{
+  fInputFileName = inputFilename;
+  return JPetTaskIO::createInputObjects(inputFilename);
+}
+
+bool JPetTaskStreamIO::processEvents()
+{
+  using namespace jpet_options_tools;
   auto lastEvent = fInputHandler->getLastEntryNumber();
   assert(lastEvent >= 0);
 
@@ -83,11 +267,12 @@ bool JPetTaskStreamIO::run(const JPetDataInterface&)
 
     // subsequently run all subtasks on the same event
     TObject* output_event = &(fInputHandler->getEntry());
+    auto entryNumber = fInputHandler->getCurrentEntryNumber();
 
     for (const auto& current_task : fSubTasks)
     {
 
-      if (!current_task->run(JPetData(*output_event)))
+      if (!current_task->run(JPetData(*output_event, entryNumber, entryNumber == lastEvent)))
       {
         ERROR("In run() of: " + current_task->getName() + ". ");
       }
@@ -108,21 +293,184 @@ bool JPetTaskStreamIO::run(const JPetDataInterface&)
     }
 
   } while (fInputHandler->nextEntry());
+  return true;
+}
 
-  // terminate all subtasks after all processing
+/**
+ * @brief Processes the entry range with the given number of workers.
+ *
+ * Entries are distributed in small chunks, so the workers stay close to each other
+ * and the reorder buffer used to write the outputs in the input order stays small.
+ * The subtasks of the workers other than the first one are terminated here
+ * and their statistics are merged, in the order of workers, into the statistics
+ * of the corresponding subtasks of the task stream.
+ */
+bool JPetTaskStreamIO::processEventsInParallel(int numberOfWorkers)
+{
+  using namespace jpet_options_tools;
+  ROOT::EnableThreadSafety();
+
+  // the copies of each subtask fill their own statistics shards, merged into the subtask statistics at the end
+  std::vector<std::unique_ptr<JPetStatisticsShards>> statisticsShards;
   for (const auto& pTask : fSubTasks)
   {
-    JPetParams subTaskParams;
+    statisticsShards.push_back(jpet_common_tools::make_unique<JPetStatisticsShards>(dynamic_cast<JPetUserTask*>(pTask.get())->getStatistics()));
+  }
 
-    bool ok = pTask->terminate(subTaskParams);
-    if (!ok)
+  std::vector<std::unique_ptr<StreamWorker>> workers;
+  for (int i = 0; i < numberOfWorkers; i++)
+  {
+    auto worker = jpet_common_tools::make_unique<StreamWorker>();
+    if (i == 0)
     {
-      ERROR("In terminate() of:" + pTask->getName() + ". ");
+      for (const auto& pTask : fSubTasks)
+      {
+        worker->tasks.push_back(pTask.get());
+      }
     }
-    fParams = mergeWithExtraParams(fParams, subTaskParams);
+    else
+    {
+      // histograms of the copies must not be attached to the output file
+      TDirectory::TContext directoryContext(nullptr);
+      for (unsigned int j = 0; j < fSubTaskGenerators.size(); j++)
+      {
+        auto task = fSubTaskGenerators[j]();
+        auto userTask = dynamic_cast<JPetUserTask*>(task.get());
+        if (!userTask)
+        {
+          ERROR("JPetTaskStreamIO currently only allows JPetUserTask as subtask");
+          return false;
+        }
+        userTask->setStatistics(&statisticsShards[j]->createShard());
+        if (!task->init(fParams))
+        {
+          ERROR("Init() of: " + task->getName() + " failed in worker " + std::to_string(i) + ". ");
+          return false;
+        }
+        worker->tasks.push_back(task.get());
+        worker->ownedTasks.push_back(std::move(task));
+      }
+    }
+    if (!worker->reader.openFileAndLoadData(fInputFileName.c_str(), JPetReader::kRootTreeName.c_str()))
+    {
+      ERROR("Worker " + std::to_string(i) + " could not open the input file: " + fInputFileName);
+      return false;
+    }
+    workers.push_back(std::move(worker));
   }
 
-  return true;
+  auto firstEntry = fInputHandler->getFirstEntryNumber();
+  auto lastEntry = fInputHandler->getLastEntryNumber();
+  assert(lastEntry >= 0);
+
+  ReorderBuffer buffer(firstEntry, kBufferedEntriesPerWorker * numberOfWorkers);
+  std::atomic<long long> nextChunk(firstEntry);
+  std::atomic<bool> isWorkerError(false);
+
+  auto processChunks = [&](StreamWorker& worker) {
+    try
+    {
+      while (!buffer.isAborted())
+      {
+        auto chunkStart = nextChunk.fetch_add(kEntriesPerChunk);
+        if (chunkStart > lastEntry)
+        {
+          return;
+        }
+        auto chunkEnd = std::min(chunkStart + kEntriesPerChunk - 1, lastEntry);
+        for (auto entry = chunkStart; entry <= chunkEnd; entry++)
+        {
+          if (!worker.reader.nthEntry(entry))
+          {
+            ERROR("Could not read the entry " + std::to_string(entry) + " of the input file.");
+            isWorkerError = true;
+            buffer.abort();
+            return;
+          }
+          TObject* output_event = &(worker.reader.getCurrentEntry());
+          for (auto current_task : worker.tasks)
+          {
+            if (!current_task->run(JPetData(*output_event, entry, entry == lastEntry)))
+            {
+              ERROR("In run() of: " + current_task->getName() + ". ");
+            }
+            output_event = dynamic_cast<JPetUserTask*>(current_task)->getOutputEvents();
+          }
+          std::unique_ptr<JPetTimeWindow> output;
+          if (!JPetOutputHandler::copyEventToSave(worker.tasks.back(), output))
+          {
+            isWorkerError = true;
+            buffer.abort();
+            return;
+          }
+          buffer.put(entry, std::move(output));
+        }
+      }
+    }
+    catch (const std::exception& ex)
+    {
+      ERROR(std::string("Exception in the event-parallel worker: ") + ex.what());
+      isWorkerError = true;
+      buffer.abort();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (const auto& worker : workers)
+  {
+    threads.emplace_back(processChunks, std::ref(*worker));
+  }
+
+  bool isOK = true;
+  for (auto entry = firstEntry; entry <= lastEntry; entry++)
+  {
+    if (isProgressBar(fParams.getOptions()))
+    {
+      displayProgressBar(getName(), entry, lastEntry);
+    }
+    std::unique_ptr<JPetTimeWindow> output;
+    if (!buffer.takeNext(output))
+    {
+      isOK = false;
+      break;
+    }
+    if (output && isOutput())
+    {
+      if (!fOutputHandler->writeTimeWindow(std::move(output)))
+      {
+        WARNING("Some problems occured while writing the event to file.");
+        buffer.abort();
+        isOK = false;
+        break;
+      }
+    }
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (unsigned int i = 1; i < workers.size(); i++)
+  {
+    for (const auto& pTask : workers[i]->ownedTasks)
+    {
+      JPetParams subTaskParams;
+      if (!pTask->terminate(subTaskParams))
+      {
+        ERROR("In terminate() of:" + pTask->getName() + " in worker " + std::to_string(i) + ". ");
+      }
+    }
+  }
+  for (const auto& shards : statisticsShards)
+  {
+    shards->mergeIntoMaster();
+  }
+  for (const auto& worker : workers)
+  {
+    worker->reader.closeFile();
+  }
+  return isOK && !isWorkerError;
 }
 
 JPetTaskStreamIO::~JPetTaskStreamIO() {}
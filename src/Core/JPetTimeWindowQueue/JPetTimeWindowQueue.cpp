@@ -0,0 +1,85 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTimeWindowQueue.cpp
+ */
+
+#include "JPetTimeWindowQueue/JPetTimeWindowQueue.h"
+#include <algorithm>
+
+JPetTimeWindowQueue::JPetTimeWindowQueue(std::size_t capacity) : fCapacity(std::max<std::size_t>(capacity, 1)) {}
+
+/**
+ * @brief Adds the window at the end of the queue, waiting for a free slot if needed.
+ * @return false if the queue has been aborted or closed, the window is dropped then.
+ */
+bool JPetTimeWindowQueue::push(std::unique_ptr<JPetTimeWindow> window)
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fNotFull.wait(lock, [this] { return fAborted || fClosed || fWindows.size() < fCapacity; });
+  if (fAborted || fClosed)
+  {
+    return false;
+  }
+  fWindows.push_back(std::move(window));
+  fNotEmpty.notify_one();
+  return true;
+}
+
+/**
+ * @brief Takes the first window from the queue, waiting for the producer if needed.
+ * @return false if the queue is closed and empty or if it has been aborted.
+ */
+bool JPetTimeWindowQueue::pop(std::unique_ptr<JPetTimeWindow>& window)
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fNotEmpty.wait(lock, [this] { return fAborted || fClosed || !fWindows.empty(); });
+  if (fAborted || fWindows.empty())
+  {
+    return false;
+  }
+  window = std::move(fWindows.front());
+  fWindows.pop_front();
+  fNotFull.notify_one();
+  return true;
+}
+
+/**
+ * @brief Marks the end of the data, windows already in the queue can still be taken.
+ */
+void JPetTimeWindowQueue::close()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fClosed = true;
+  fNotEmpty.notify_all();
+  fNotFull.notify_all();
+}
+
+/**
+ * @brief Stops the transfer immediately, the queued windows are discarded.
+ */
+void JPetTimeWindowQueue::abort()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fAborted = true;
+  fWindows.clear();
+  fNotEmpty.notify_all();
+  fNotFull.notify_all();
+}
+
+bool JPetTimeWindowQueue::isAborted() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fAborted;
+}
+
+std::size_t JPetTimeWindowQueue::getCapacity() const { return fCapacity; }
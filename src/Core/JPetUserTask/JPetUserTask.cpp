@@ -15,6 +15,7 @@
 
 #include "JPetUserTask/JPetUserTask.h"
 #include "JPetData/JPetData.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 
 JPetUserTask::JPetUserTask(const char* name) : JPetTask(name) {}
 
@@ -31,11 +32,16 @@ bool JPetUserTask::run(const JPetDataInterface& inData)
   {
     auto event = dynamic_cast<const JPetData&>(inData);
     setEvent(&(event.getEvent()));
+    fEntryNumber = event.getEntryNumber();
+    fIsLastEntry = event.isLastEntry();
   }
   catch (const std::bad_cast& ex)
   {
     WARNING("Input data type is not the expected one in User Task,  No event is set.");
   }
+  /// The references of the data objects stored as IDs are resolved with the bank of the processed file.
+  auto paramManager = fParams.getParamManager();
+  JPetParamRefResolver::Binding binding(paramManager ? &paramManager->getParamBank() : nullptr);
   return exec();
 }
 
@@ -66,10 +72,46 @@ void JPetUserTask::setEvent(TObject* ev) { fEvent = ev; }
 
 JPetTimeWindow* JPetUserTask::getInputEvents() { return dynamic_cast<JPetTimeWindow*>(fEvent); }
 
+/**
+ * @brief Number of the input file entry being processed, e.g. to derive the random stream of the event.
+ * @return -1 if the entry number is not known, e.g. for time windows passed between pipelined tasks.
+ */
+long long JPetUserTask::getEntryNumber() const { return fEntryNumber; }
+
+/**
+ * @brief True if no following entry is processed after the current one, see JPetData::isLastEntry.
+ */
+bool JPetUserTask::isLastEntry() const { return fIsLastEntry; }
+
+/**
+ * @brief Columns of the hits (JPetHitColumns::Column flags) used by the task, read from
+ * the input files with the hits written column-wise. Tasks using e.g. only the time, energy
+ * and position of the hits should override it, so the other columns are not read.
+ */
+unsigned int JPetUserTask::getRequiredHitColumns() const { return JPetHitColumns::kAll; }
+
+/**
+ * @brief True if the output of an entry depends only on that entry and not on the entries
+ * processed before, so the entries can be divided between the workers of JPetTaskStreamIO.
+ * False by default; tasks keeping any state between the entries must not override it.
+ */
+bool JPetUserTask::isEntryIndependent() const { return false; }
+
 jpet_options_tools::OptsStrAny JPetUserTask::getOptions() const { return fParams.getOptions(); }
 
 JPetTimeWindow* JPetUserTask::getOutputEvents() { return fOutputEvents; }
 
+/**
+ * @brief Replaces the output time window, e.g. by an empty one after the output was passed to the writer.
+ * @return the previous output time window, the ownership is passed to the caller.
+ */
+JPetTimeWindow* JPetUserTask::swapOutputEvents(JPetTimeWindow* replacement)
+{
+  auto previous = fOutputEvents;
+  fOutputEvents = replacement;
+  return previous;
+}
+
 void JPetUserTask::clearOutputEvents()
 {
   if (fOutputEvents)
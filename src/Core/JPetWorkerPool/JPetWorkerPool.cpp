@@ -0,0 +1,81 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWorkerPool.cpp
+ */
+
+#include "JPetWorkerPool/JPetWorkerPool.h"
+#include "JPetLoggerInclude.h"
+
+#include <TROOT.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+JPetWorkerPool::JPetWorkerPool(unsigned int maxThreads) : fMaxThreads(std::max(maxThreads, 1u)) {}
+
+void JPetWorkerPool::addJob(Job job) { fJobs.push_back(job); }
+
+/**
+ * @brief Executes all queued jobs and waits for them to finish.
+ * The queue is emptied afterwards.
+ * @return false if any of the jobs returned false or threw an exception.
+ */
+bool JPetWorkerPool::run()
+{
+  if (fJobs.empty())
+  {
+    return true;
+  }
+  ROOT::EnableThreadSafety();
+  std::atomic<std::size_t> nextJob(0);
+  std::atomic<bool> allSucceeded(true);
+  auto worker = [&]() {
+    for (auto i = nextJob++; i < fJobs.size(); i = nextJob++)
+    {
+      try
+      {
+        if (!fJobs[i]())
+        {
+          allSucceeded = false;
+        }
+      }
+      catch (const std::exception& ex)
+      {
+        ERROR("Exception thrown by the job " + std::to_string(i) + ": " + ex.what());
+        allSucceeded = false;
+      }
+    }
+  };
+  auto nThreads = std::min<std::size_t>(fMaxThreads, fJobs.size());
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < nThreads; i++)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  fJobs.clear();
+  return allSucceeded;
+}
+
+unsigned int JPetWorkerPool::getMaxThreads() const { return fMaxThreads; }
+
+std::size_t JPetWorkerPool::getNumberOfJobs() const { return fJobs.size(); }
+
+/**
+ * @return number of concurrent threads supported by the hardware or 1 if it cannot be determined.
+ */
+unsigned int JPetWorkerPool::getDefaultMaxThreads() { return std::max(std::thread::hardware_concurrency(), 1u); }
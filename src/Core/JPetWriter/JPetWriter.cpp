@@ -15,12 +15,17 @@
 
 #include "JPetWriter/JPetWriter.h"
 #include "JPetUserInfoStructure/JPetUserInfoStructure.h"
+#include <TROOT.h>
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
 
 /**
  * This tree name is compatible with the tree name produced by the Unpacker.
  */
 const std::string JPetWriter::kRootTreeName = "T";
 const long long JPetWriter::kTreeBufferSize = 10000;
+const std::size_t JPetWriter::kDefaultPendingWindows = 2;
 
 JPetWriter::JPetWriter(const char* p_fileName) : fFileName(p_fileName), fFile(0), fIsBranchCreated(false), fTree(0)
 {
@@ -39,6 +44,7 @@ JPetWriter::JPetWriter(const char* p_fileName) : fFileName(p_fileName), fFile(0)
 JPetWriter::~JPetWriter()
 {
   DEBUG("destructor of JPetWriter");
+  stopAsyncWriting();
   if (isOpen())
   {
     fTree->AutoSave("SaveSelf");
@@ -54,6 +60,8 @@ JPetWriter::~JPetWriter()
 
 void JPetWriter::closeFile()
 {
+  /// All pending time windows are saved before closing.
+  stopAsyncWriting();
   if (isOpen())
   {
     fTree->AutoSave("SaveSelf");
@@ -62,11 +70,13 @@ void JPetWriter::closeFile()
   }
   fFileName.clear();
   fIsBranchCreated = false;
+  fHitColumns.reset();
 }
 
 void JPetWriter::writeHeader(TObject* header)
 {
   assert(fTree);
+  waitForPendingWindows();
   /// @todo as the second argument should be passed some enum to indicate position of header
   fTree->GetUserInfo()->AddAt(header, JPetUserInfoStructure::kHeader);
 }
@@ -91,6 +101,7 @@ void JPetWriter::writeHeader(TObject* header)
  */
 void JPetWriter::writeCollection(const TCollection* col, const char* dirname, const char* subdirname)
 {
+  waitForPendingWindows();
   TDirectory* current = fFile->GetDirectory(dirname);
   if (!current)
   {
@@ -120,3 +131,275 @@ void JPetWriter::writeCollection(const TCollection* col, const char* dirname, co
   }
   fFile->cd();
 }
+
+/**
+ * @brief Writes the time window. In the asynchronous mode the window is copied
+ * and saved by the I/O thread. The window is copied with JPetTimeWindow::copy(),
+ * so the additional content of the derived classes is kept.
+ */
+bool JPetWriter::write(const JPetTimeWindow& obj)
+{
+  if (!isAsync())
+  {
+    if (!isWrittenInColumns(obj))
+    {
+      if (fHitColumns)
+      {
+        ERROR("Only the time windows of JPetHit can be written to the tree with the hit columns.");
+        return false;
+      }
+      return write<JPetTimeWindow>(obj);
+    }
+    if (!isOpen())
+    {
+      ERROR("Could not write to file. Have you closed it already?");
+      return false;
+    }
+    return fillHitColumns(obj);
+  }
+  return write(obj.copy());
+}
+
+/**
+ * @brief Writes the time window taking over its ownership, so it does not have to be copied.
+ * In the asynchronous mode the window is passed to the I/O thread. If the I/O thread
+ * is already behind by the maximal number of windows, the calling thread waits.
+ */
+bool JPetWriter::write(std::unique_ptr<JPetTimeWindow> window)
+{
+  if (!window)
+  {
+    ERROR("No time window to write.");
+    return false;
+  }
+  if (!isAsync())
+  {
+    return write(static_cast<const JPetTimeWindow&>(*window));
+  }
+  if (!isOpen())
+  {
+    ERROR("Could not write to file. Have you closed it already?");
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(fAsyncMutex);
+  if (fWindowsInProgress >= fMaxPendingWindows)
+  {
+    auto start = std::chrono::steady_clock::now();
+    fWindowWritten.wait(lock, [this] { return fWindowsInProgress < fMaxPendingWindows; });
+    fBackpressureTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fNumberOfBackpressureWaits++;
+  }
+  if (fAsyncWriteFailed)
+  {
+    ERROR("Previous time window could not be saved by the I/O thread.");
+    return false;
+  }
+  fPendingWindows.push_back(std::move(window));
+  fWindowsInProgress++;
+  fWindowPending.notify_one();
+  return true;
+}
+
+/**
+ * @brief Starts the I/O thread saving the time windows.
+ * @param maxPendingWindows number of windows handed over and not yet saved, after which the writing thread waits.
+ */
+void JPetWriter::enableAsyncWriting(std::size_t maxPendingWindows)
+{
+  if (isAsync())
+  {
+    WARNING("Asynchronous writing is already enabled.");
+    return;
+  }
+  if (!isOpen())
+  {
+    ERROR("Could not enable asynchronous writing, the file is not open.");
+    return;
+  }
+  ROOT::EnableThreadSafety();
+  fMaxPendingWindows = std::max<std::size_t>(maxPendingWindows, 1);
+  fStopIOThread = false;
+  fAsyncWriteFailed = false;
+  fIOThread = std::thread(&JPetWriter::writePendingWindows, this);
+}
+
+bool JPetWriter::isAsync() const { return fIOThread.joinable(); }
+
+/**
+ * @brief Blocks until all time windows handed over to the I/O thread are saved.
+ */
+void JPetWriter::waitForPendingWindows()
+{
+  if (!isAsync())
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(fAsyncMutex);
+  fWindowWritten.wait(lock, [this] { return fWindowsInProgress == 0; });
+}
+
+/**
+ * @brief Returns an already saved and cleared time window with the given type of events
+ * to be filled again, or nullptr if there is none.
+ */
+std::unique_ptr<JPetTimeWindow> JPetWriter::takeRecycledWindow(const std::string& eventType)
+{
+  std::lock_guard<std::mutex> lock(fAsyncMutex);
+  auto it = std::find_if(fRecycledWindows.begin(), fRecycledWindows.end(),
+                         [&eventType](const std::unique_ptr<JPetTimeWindow>& window) { return eventType == window->getEventType(); });
+  if (it == fRecycledWindows.end())
+  {
+    return nullptr;
+  }
+  auto window = std::move(*it);
+  fRecycledWindows.erase(it);
+  return window;
+}
+
+/**
+ * @return total time spent by the writing thread waiting for the I/O thread.
+ */
+double JPetWriter::getBackpressureTimeInSeconds() const
+{
+  std::lock_guard<std::mutex> lock(fAsyncMutex);
+  return fBackpressureTime;
+}
+
+long long JPetWriter::getNumberOfBackpressureWaits() const
+{
+  std::lock_guard<std::mutex> lock(fAsyncMutex);
+  return fNumberOfBackpressureWaits;
+}
+
+/**
+ * @brief Sets the columns (JPetHitColumns::Column flags) in which the time windows
+ * of JPetHit objects are written, 0 (default) writes them as JPetTimeWindow objects.
+ * Must be set before the first time window is written.
+ */
+void JPetWriter::setHitColumns(unsigned int columns)
+{
+  if (fIsBranchCreated || fHitColumns)
+  {
+    WARNING("The branches are already created, the hit columns cannot be changed.");
+    return;
+  }
+  fHitColumnsToWrite = columns;
+}
+
+unsigned int JPetWriter::getHitColumns() const { return fHitColumnsToWrite; }
+
+/**
+ * @brief Saves all pending time windows and stops the I/O thread.
+ */
+void JPetWriter::stopAsyncWriting()
+{
+  if (!isAsync())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fAsyncMutex);
+    fStopIOThread = true;
+  }
+  fWindowPending.notify_all();
+  fIOThread.join();
+  fRecycledWindows.clear();
+}
+
+/**
+ * @brief Body of the I/O thread.
+ */
+void JPetWriter::writePendingWindows()
+{
+  while (true)
+  {
+    std::unique_ptr<JPetTimeWindow> window;
+    {
+      std::unique_lock<std::mutex> lock(fAsyncMutex);
+      fWindowPending.wait(lock, [this] { return fStopIOThread || !fPendingWindows.empty(); });
+      if (fPendingWindows.empty())
+      {
+        break;
+      }
+      window = std::move(fPendingWindows.front());
+      fPendingWindows.pop_front();
+    }
+    bool isOK = fillTimeWindow(*window);
+    window->Clear();
+    std::lock_guard<std::mutex> lock(fAsyncMutex);
+    if (!isOK)
+    {
+      fAsyncWriteFailed = true;
+    }
+    if (typeid(*window) == typeid(JPetTimeWindow) && fRecycledWindows.size() < fMaxPendingWindows)
+    {
+      fRecycledWindows.push_back(std::move(window));
+    }
+    fWindowsInProgress--;
+    fWindowWritten.notify_all();
+  }
+}
+
+bool JPetWriter::fillTree(void* entry, const char* name, const char* className)
+{
+  std::lock_guard<std::mutex> lock(fTreeMutex);
+  // http://root.cern.ch/drupal/content/current-director
+  fFile->cd();
+  fBranchEntry = entry;
+  if (!fIsBranchCreated)
+  {
+    DEBUG("Branch name:" + std::string(name));
+    assert(fTree);
+    fTree->Branch(name, className, &fBranchEntry);
+    fIsBranchCreated = true;
+  }
+  DEBUG("fTree->Fill()");
+  fTree->Fill();
+  return true;
+}
+
+/**
+ * @brief Fills the tree with the time window, as an object or column-wise.
+ */
+bool JPetWriter::fillTimeWindow(const JPetTimeWindow& window)
+{
+  if (isWrittenInColumns(window))
+  {
+    return fillHitColumns(window);
+  }
+  if (fHitColumns)
+  {
+    ERROR("Only the time windows of JPetHit can be written to the tree with the hit columns.");
+    return false;
+  }
+  return fillTree(const_cast<JPetTimeWindow*>(&window), window.GetName(), window.GetName());
+}
+
+bool JPetWriter::fillHitColumns(const JPetTimeWindow& window)
+{
+  std::lock_guard<std::mutex> lock(fTreeMutex);
+  fFile->cd();
+  if (!fHitColumns)
+  {
+    assert(fTree);
+    fHitColumns = std::unique_ptr<JPetHitColumns>(new JPetHitColumns());
+    if (!fHitColumns->createBranches(*fTree, fHitColumnsToWrite))
+    {
+      return false;
+    }
+  }
+  fHitColumns->fill(window);
+  fTree->Fill();
+  return true;
+}
+
+/**
+ * @return true if the window is written column-wise, i.e. the hit columns are set,
+ * the window contains JPetHit objects and no other window was written as an object before.
+ * The MC windows are always written as objects.
+ */
+bool JPetWriter::isWrittenInColumns(const JPetTimeWindow& window) const
+{
+  return fHitColumnsToWrite != 0 && !fIsBranchCreated && typeid(window) == typeid(JPetTimeWindow) &&
+         std::string(window.getEventType()) == JPetHit::Class_Name();
+}
@@ -15,14 +15,16 @@
 
 #include "JPetBaseHit/JPetBaseHit.h"
 #include "JPetLoggerInclude.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 
 ClassImp(JPetBaseHit);
 
 JPetBaseHit::JPetBaseHit() : TObject() {}
 
 JPetBaseHit::JPetBaseHit(double time, double energy, TVector3& position, JPetScin& scin)
-    : TObject(), fTime(time), fEnergy(energy), fPos(position), fScin(&scin)
+    : TObject(), fTime(time), fEnergy(energy), fPos(position)
 {
+  setScin(scin);
 }
 
 JPetBaseHit::~JPetBaseHit() {}
@@ -44,9 +46,10 @@ double JPetBaseHit::getPos(int index) const { return fPos(index); }
 const TVector3& JPetBaseHit::getPos() const { return fPos; }
 const JPetScin& JPetBaseHit::getScin() const
 {
-  if (fScin.GetObject())
+  auto scin = JPetParamRefResolver::resolveScin(fScinID, fScin);
+  if (scin)
   {
-    return static_cast<JPetScin&>(*(fScin.GetObject()));
+    return *scin;
   }
   else
   {
@@ -71,7 +74,7 @@ void JPetBaseHit::setPosZ(double z) { fPos.SetZ(z); }
 void JPetBaseHit::setPos(double x, double y, double z) { fPos.SetXYZ(x, y, z); }
 void JPetBaseHit::setPos(TVector3& position) { fPos = position; }
 
-void JPetBaseHit::setScin(JPetScin& scin) { fScin = &scin; }
+void JPetBaseHit::setScin(JPetScin& scin) { JPetParamRefResolver::setRef(fScinID, fScin, scin, scin.getID()); }
 
 void JPetBaseHit::Clear(Option_t*)
 {
@@ -79,4 +82,5 @@ void JPetBaseHit::Clear(Option_t*)
   fEnergy = 0.0f;
   fPos = TVector3();
   fScin = nullptr;
+  fScinID = JPetParamRefResolver::kNoID;
 }
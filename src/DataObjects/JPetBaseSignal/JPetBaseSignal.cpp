@@ -14,6 +14,7 @@
  */
 
 #include "JPetBaseSignal/JPetBaseSignal.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 
 ClassImp(JPetBaseSignal);
 
@@ -32,12 +33,47 @@ JPetBaseSignal::JPetBaseSignal(bool isNull) : fIsNullObject(isNull) {}
  */
 JPetBaseSignal::~JPetBaseSignal() {}
 
+/**
+ * @brief Move constructor, the base signal holds only references and flags, so it is copied.
+ */
+JPetBaseSignal::JPetBaseSignal(JPetBaseSignal&& other) noexcept
+    : TObject(other), fPM(other.fPM), fBarrelSlot(other.fBarrelSlot), fFlag(other.fFlag), fPMID(other.fPMID), fBarrelSlotID(other.fBarrelSlotID),
+      fIsNullObject(other.fIsNullObject)
+{
+}
+
+/**
+ * @brief Move assignment, see the move constructor.
+ */
+JPetBaseSignal& JPetBaseSignal::operator=(JPetBaseSignal&& other) noexcept
+{
+  if (this != &other)
+  {
+    TObject::operator=(other);
+    fPM = other.fPM;
+    fBarrelSlot = other.fBarrelSlot;
+    fFlag = other.fFlag;
+    fPMID = other.fPMID;
+    fBarrelSlotID = other.fBarrelSlotID;
+    fIsNullObject = other.fIsNullObject;
+  }
+  return *this;
+}
+
 void JPetBaseSignal::setRecoFlag(JPetBaseSignal::RecoFlag flag) { fFlag = flag; }
 
 JPetBaseSignal::RecoFlag JPetBaseSignal::getRecoFlag() const { return fFlag; }
 
 bool JPetBaseSignal::isNullObject() const { return fIsNullObject; }
 
+void JPetBaseSignal::setPM(const JPetPM& pm) { JPetParamRefResolver::setRef(fPMID, fPM, pm, pm.getID()); }
+
+void JPetBaseSignal::setBarrelSlot(const JPetBarrelSlot& bs) { JPetParamRefResolver::setRef(fBarrelSlotID, fBarrelSlot, bs, bs.getID()); }
+
+const JPetPM& JPetBaseSignal::getPM() const { return *JPetParamRefResolver::resolvePM(fPMID, fPM); }
+
+const JPetBarrelSlot& JPetBaseSignal::getBarrelSlot() const { return *JPetParamRefResolver::resolveBarrelSlot(fBarrelSlotID, fBarrelSlot); }
+
 JPetBaseSignal& JPetBaseSignal::getDummyResult()
 {
   static JPetBaseSignal dummyResult(true);
@@ -48,4 +84,6 @@ void JPetBaseSignal::Clear(Option_t*)
 {
   fBarrelSlot = NULL;
   fPM = NULL;
+  fBarrelSlotID = JPetParamRefResolver::kNoID;
+  fPMID = JPetParamRefResolver::kNoID;
 }
@@ -25,6 +25,11 @@ JPetEvent::JPetEvent(const std::vector<JPetHit>& hits, JPetEventType eventType,
   setHits(hits, orderedByTime);
 }
 
+JPetEvent::JPetEvent(std::vector<JPetHit>&& hits, JPetEventType eventType, bool orderedByTime) : TObject(), fType(eventType)
+{
+  setHits(std::move(hits), orderedByTime);
+}
+
 void JPetEvent::setRecoFlag(JPetEvent::RecoFlag flag) { fFlag = flag; }
 
 JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
@@ -35,13 +40,23 @@ JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
  */
 void JPetEvent::setHits(const std::vector<JPetHit>& hits, bool orderedByTime)
 {
+  fHits = hits;
   if (orderedByTime)
   {
-    fHits = JPetAnalysisTools::getHitsOrderedByTime(hits);
+    sortHitsByTime();
   }
-  else
+}
+
+/**
+ * Moving the whole vector of hits into this event, without copying the hits,
+ * with boolean argument to decide if hits should additionally be ordered by time.
+ */
+void JPetEvent::setHits(std::vector<JPetHit>&& hits, bool orderedByTime)
+{
+  fHits = std::move(hits);
+  if (orderedByTime)
   {
-    fHits = hits;
+    sortHitsByTime();
   }
 }
 
@@ -50,6 +65,21 @@ void JPetEvent::setHits(const std::vector<JPetHit>& hits, bool orderedByTime)
  */
 void JPetEvent::addHit(const JPetHit& hit) { fHits.push_back(hit); }
 
+/**
+ * Moving hit into the event, this method does not sort nor order added hits by time.
+ */
+void JPetEvent::addHit(JPetHit&& hit) { fHits.push_back(std::move(hit)); }
+
+/**
+ * Reserving memory for the given number of hits, e.g. before adding them one by one.
+ */
+void JPetEvent::reserveHits(std::size_t numberOfHits) { fHits.reserve(numberOfHits); }
+
+/**
+ * Ordering the hits of this event by ascending time in place.
+ */
+void JPetEvent::sortHitsByTime() { JPetAnalysisTools::sortHitsByTime(fHits); }
+
 /**
  * Get vector of hits from this event.
  */
@@ -15,7 +15,9 @@
 
 #include "JPetHit/JPetHit.h"
 #include "JPetLoggerInclude.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 #include "TString.h"
+#include <utility>
 
 ClassImp(JPetHit);
 
@@ -30,8 +32,10 @@ JPetHit::JPetHit() : TObject(), fFlag(JPetHit::Unknown) {}
 JPetHit::JPetHit(float energy, float qualityOfEnergy, float time, float qualityOfTime, TVector3& position, JPetPhysSignal& signalA,
                  JPetPhysSignal& signalB, JPetBarrelSlot& barreSlot, JPetScin& scin)
     : TObject(), fFlag(JPetHit::Unknown), fEnergy(energy), fQualityOfEnergy(qualityOfEnergy), fTime(time), fQualityOfTime(qualityOfTime),
-      fPos(position), fSignalA(signalA), fSignalB(signalB), fBarrelSlot(&barreSlot), fScintillator(&scin)
+      fPos(position), fSignalA(signalA), fSignalB(signalB)
 {
+  setBarrelSlot(barreSlot);
+  setScintillator(scin);
   fIsSignalAset = true;
   fIsSignalBset = true;
   if (!checkConsistency())
@@ -45,6 +49,47 @@ JPetHit::JPetHit(float energy, float qualityOfEnergy, float time, float qualityO
  */
 JPetHit::~JPetHit() {}
 
+/**
+ * @brief Move constructor, takes over both signals of the hit.
+ */
+JPetHit::JPetHit(JPetHit&& other) noexcept
+    : TObject(other), fFlag(other.fFlag), fEnergy(other.fEnergy), fQualityOfEnergy(other.fQualityOfEnergy), fTime(other.fTime),
+      fQualityOfTime(other.fQualityOfTime), fTimeDiff(other.fTimeDiff), fQualityOfTimeDiff(other.fQualityOfTimeDiff), fIsSignalAset(other.fIsSignalAset),
+      fIsSignalBset(other.fIsSignalBset), fPos(other.fPos), fSignalA(std::move(other.fSignalA)), fSignalB(std::move(other.fSignalB)),
+      fBarrelSlot(other.fBarrelSlot), fScintillator(other.fScintillator), fMCindex(other.fMCindex), fBarrelSlotID(other.fBarrelSlotID),
+      fScintillatorID(other.fScintillatorID)
+{
+}
+
+/**
+ * @brief Move assignment, see the move constructor.
+ */
+JPetHit& JPetHit::operator=(JPetHit&& other) noexcept
+{
+  if (this != &other)
+  {
+    TObject::operator=(other);
+    fFlag = other.fFlag;
+    fEnergy = other.fEnergy;
+    fQualityOfEnergy = other.fQualityOfEnergy;
+    fTime = other.fTime;
+    fQualityOfTime = other.fQualityOfTime;
+    fTimeDiff = other.fTimeDiff;
+    fQualityOfTimeDiff = other.fQualityOfTimeDiff;
+    fIsSignalAset = other.fIsSignalAset;
+    fIsSignalBset = other.fIsSignalBset;
+    fPos = other.fPos;
+    fSignalA = std::move(other.fSignalA);
+    fSignalB = std::move(other.fSignalB);
+    fBarrelSlot = other.fBarrelSlot;
+    fScintillator = other.fScintillator;
+    fMCindex = other.fMCindex;
+    fBarrelSlotID = other.fBarrelSlotID;
+    fScintillatorID = other.fScintillatorID;
+  }
+  return *this;
+}
+
 /**
  * Get the reconstruction flag
  */
@@ -131,8 +176,9 @@ const JPetPhysSignal& JPetHit::getSignalB() const { return fSignalB; }
  */
 const JPetScin& JPetHit::getScintillator() const
 {
-  if (fScintillator.GetObject())
-    return (JPetScin&)*fScintillator.GetObject();
+  auto scin = JPetParamRefResolver::resolveScin(fScintillatorID, fScintillator);
+  if (scin)
+    return *scin;
   else
   {
     ERROR("No JPetScin slot set, Null object will be returned");
@@ -145,8 +191,9 @@ const JPetScin& JPetHit::getScintillator() const
  */
 const JPetBarrelSlot& JPetHit::getBarrelSlot() const
 {
-  if (fBarrelSlot.GetObject())
-    return (JPetBarrelSlot&)*fBarrelSlot.GetObject();
+  auto barrelSlot = JPetParamRefResolver::resolveBarrelSlot(fBarrelSlotID, fBarrelSlot);
+  if (barrelSlot)
+    return *barrelSlot;
   else
   {
     ERROR("No JPetBarrelSlot slot set, Null object will be returned");
@@ -154,6 +201,16 @@ const JPetBarrelSlot& JPetHit::getBarrelSlot() const
   }
 }
 
+/**
+ * Get the ID of the scintillator associated with this hit, -1 if not set
+ */
+int JPetHit::getScintillatorID() const { return fScintillatorID; }
+
+/**
+ * Get the ID of the barrel slot associated with this hit, -1 if not set
+ */
+int JPetHit::getBarrelSlotID() const { return fBarrelSlotID; }
+
 /** Get the index to MC hit structure
  */
 unsigned int JPetHit::getMCindex() const { return fMCindex; }
@@ -226,12 +283,31 @@ void JPetHit::setPos(float x, float y, float z) { fPos.SetXYZ(x, y, z); }
 /**
  * Set the barrel slot object for this hit
  */
-void JPetHit::setBarrelSlot(JPetBarrelSlot& bs) { fBarrelSlot = &bs; }
+void JPetHit::setBarrelSlot(JPetBarrelSlot& bs) { JPetParamRefResolver::setRef(fBarrelSlotID, fBarrelSlot, bs, bs.getID()); }
 
 /**
  * Set the scintillator object for this hit
  */
-void JPetHit::setScintillator(JPetScin& sc) { fScintillator = &sc; }
+void JPetHit::setScintillator(JPetScin& sc) { JPetParamRefResolver::setRef(fScintillatorID, fScintillator, sc, sc.getID()); }
+
+/**
+ * Set the reference to the barrel slot by its ID only, without the TRef.
+ * The barrel slot is then resolved with the param bank bound by JPetParamRefResolver.
+ */
+void JPetHit::setBarrelSlotID(int id)
+{
+  fBarrelSlotID = id;
+  fBarrelSlot = nullptr;
+}
+
+/**
+ * Set the reference to the scintillator by its ID only, see setBarrelSlotID.
+ */
+void JPetHit::setScintillatorID(int id)
+{
+  fScintillatorID = id;
+  fScintillator = nullptr;
+}
 
 /**
  * @brief Checks consistency of the hit object
@@ -357,5 +433,7 @@ void JPetHit::Clear(Option_t*)
   fIsSignalBset = false;
   fBarrelSlot = NULL;
   fScintillator = NULL;
+  fBarrelSlotID = JPetParamRefResolver::kNoID;
+  fScintillatorID = JPetParamRefResolver::kNoID;
   fMCindex = 0u;
 }
@@ -21,22 +21,22 @@ const double JPetHitUtils::Unset = -std::numeric_limits<double>::infinity();
 
 double JPetHitUtils::getTimeDiffAtThr(const JPetHit& hit, int thr)
 {
-  std::map<int, double> lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  if (lead_times_B.count(thr) > 0 && lead_times_A.count(thr) > 0)
+  const auto& rawSignalA = hit.getSignalA().getRecoSignal().getRawSignal();
+  const auto& rawSignalB = hit.getSignalB().getRecoSignal().getRawSignal();
+  if (rawSignalA.hasTime(JPetSigCh::Leading, thr) && rawSignalB.hasTime(JPetSigCh::Leading, thr))
   {
-    return lead_times_A[thr] - lead_times_B[thr];
+    return static_cast<double>(rawSignalA.getTime(JPetSigCh::Leading, thr)) - rawSignalB.getTime(JPetSigCh::Leading, thr);
   }
   return Unset;
 }
 
 double JPetHitUtils::getTimeAtThr(const JPetHit& hit, int thr)
 {
-  std::map<int, double> lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  if (lead_times_B.count(thr) > 0 && lead_times_A.count(thr) > 0)
+  const auto& rawSignalA = hit.getSignalA().getRecoSignal().getRawSignal();
+  const auto& rawSignalB = hit.getSignalB().getRecoSignal().getRawSignal();
+  if (rawSignalA.hasTime(JPetSigCh::Leading, thr) && rawSignalB.hasTime(JPetSigCh::Leading, thr))
   {
-    return 0.5 * (lead_times_A[thr] + lead_times_B[thr]);
+    return 0.5 * (static_cast<double>(rawSignalA.getTime(JPetSigCh::Leading, thr)) + rawSignalB.getTime(JPetSigCh::Leading, thr));
   }
   return Unset;
 }
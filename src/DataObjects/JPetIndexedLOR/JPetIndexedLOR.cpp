@@ -0,0 +1,256 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetIndexedLOR.cpp
+ */
+
+#include "JPetIndexedLOR/JPetIndexedLOR.h"
+
+ClassImp(JPetIndexedLOR);
+
+const int JPetIndexedLOR::kNoHit = -1;
+
+namespace
+{
+/**
+ * Returns the barrel slot ID and the time of the event with the given index
+ * in a window of JPetHit or JPetSlimHit objects.
+ */
+bool getSlotAndTime(const JPetTimeWindow& hits, int index, int& slotID, float& time)
+{
+  if (auto hit = dynamic_cast<const JPetHit*>(&hits[index]))
+  {
+    slotID = hit->getBarrelSlotID();
+    time = hit->getTime();
+    return true;
+  }
+  if (auto hit = dynamic_cast<const JPetSlimHit*>(&hits[index]))
+  {
+    slotID = hit->getBarrelSlotID();
+    time = hit->getTime();
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+/**
+ * Default constructor
+ */
+JPetIndexedLOR::JPetIndexedLOR() : TObject() {}
+
+/**
+ * Constructor
+ */
+JPetIndexedLOR::JPetIndexedLOR(float time, float qualityOfTime, int firstHitIndex, int secondHitIndex)
+    : TObject(), fTime(time), fQualityOfTime(qualityOfTime), fFirstHitIndex(firstHitIndex), fSecondHitIndex(secondHitIndex)
+{
+}
+
+/**
+ * Destructor
+ */
+JPetIndexedLOR::~JPetIndexedLOR() {}
+
+JPetLOR::RecoFlag JPetIndexedLOR::getRecoFlag() const { return fFlag; }
+
+void JPetIndexedLOR::setRecoFlag(JPetLOR::RecoFlag flag) { fFlag = flag; }
+
+/**
+ * Get LOR time in [ps].
+ */
+float JPetIndexedLOR::getTime() const { return fTime; }
+
+/**
+ * Get the value, that describes time reconstruction quality.
+ */
+float JPetIndexedLOR::getQualityOfTime() const { return fQualityOfTime; }
+
+/**
+ * Set LOR time in [ps]
+ */
+void JPetIndexedLOR::setTime(const float time) { fTime = time; }
+
+/**
+ * Set the value, that describes quality of reconstructed LOR time.
+ */
+void JPetIndexedLOR::setQualityOfTime(const float qualityOfTime) { fQualityOfTime = qualityOfTime; }
+
+/**
+ * Get LOR time difference.
+ */
+float JPetIndexedLOR::getTimeDiff() const { return fTimeDiff; }
+
+/**
+ * Get the value, that describes quality of LOR time difference.
+ */
+float JPetIndexedLOR::getQualityOfTimeDiff() const { return fQualityOfTimeDiff; }
+
+/**
+ * Set LOR time difference.
+ */
+void JPetIndexedLOR::setTimeDiff(const float td) { fTimeDiff = td; }
+
+/**
+ * Set the value, that describes quality of LOR time difference.
+ */
+void JPetIndexedLOR::setQualityOfTimeDiff(const float qtd) { fQualityOfTimeDiff = qtd; }
+
+/**
+ * Get the index of the hit, that is first in time, in the owning time window.
+ */
+int JPetIndexedLOR::getFirstHitIndex() const { return fFirstHitIndex; }
+
+/**
+ * Get the index of the hit, that is second in time, in the owning time window.
+ */
+int JPetIndexedLOR::getSecondHitIndex() const { return fSecondHitIndex; }
+
+/**
+ * Set the indices of both hits of this LOR at once.
+ */
+void JPetIndexedLOR::setHitIndices(int firstHitIndex, int secondHitIndex)
+{
+  fFirstHitIndex = firstHitIndex;
+  fSecondHitIndex = secondHitIndex;
+}
+
+/**
+ * Check if one of two hits, as indicated by index, is set or not.
+ */
+bool JPetIndexedLOR::isHitSet(const unsigned int index) const
+{
+  switch (index)
+  {
+  case 0:
+    return fFirstHitIndex != kNoHit;
+  case 1:
+    return fSecondHitIndex != kNoHit;
+  default:
+    return false;
+  };
+}
+
+/**
+ * @brief Checks if both hit indices are set and within the given window.
+ */
+bool JPetIndexedLOR::refersTo(const JPetTimeWindow& window) const
+{
+  const int size = window.getNumberOfEvents();
+  return fFirstHitIndex >= 0 && fFirstHitIndex < size && fSecondHitIndex >= 0 && fSecondHitIndex < size;
+}
+
+/**
+ * Get the hit, that is first in time, from the window of JPetHit objects.
+ */
+const JPetHit& JPetIndexedLOR::getFirstHit(const JPetTimeWindow& hits) const { return hits.getEvent<JPetHit>(fFirstHitIndex); }
+
+/**
+ * Get the hit, that is second in time, from the window of JPetHit objects.
+ */
+const JPetHit& JPetIndexedLOR::getSecondHit(const JPetTimeWindow& hits) const { return hits.getEvent<JPetHit>(fSecondHitIndex); }
+
+const JPetHit& JPetIndexedLOR::getFirstHit(const JPetTypedTimeWindow<JPetHit>& hits) const { return hits[fFirstHitIndex]; }
+
+const JPetHit& JPetIndexedLOR::getSecondHit(const JPetTypedTimeWindow<JPetHit>& hits) const { return hits[fSecondHitIndex]; }
+
+const JPetSlimHit& JPetIndexedLOR::getFirstHit(const JPetSlimHitWindow& hits) const { return hits.getHit(fFirstHitIndex); }
+
+const JPetSlimHit& JPetIndexedLOR::getSecondHit(const JPetSlimHitWindow& hits) const { return hits.getHit(fSecondHitIndex); }
+
+/**
+ * @brief Checks whether both hits of this LOR come from the different barrel
+ * slots and are properly time-ordered, as JPetLOR::isFromSameBarrelSlot() does.
+ * The window may contain JPetHit or JPetSlimHit objects.
+ *
+ * @return true if the checks are successful.
+ */
+bool JPetIndexedLOR::isFromSameBarrelSlot(const JPetTimeWindow& hits) const
+{
+  if (!isHitSet(0) || !isHitSet(1))
+  {
+    return true;
+  }
+  int slotA = 0, slotB = 0;
+  float timeA = 0.0f, timeB = 0.0f;
+  if (!refersTo(hits) || !getSlotAndTime(hits, fFirstHitIndex, slotA, timeA) || !getSlotAndTime(hits, fSecondHitIndex, slotB, timeB))
+  {
+    ERROR("Hits of the LOR are not found in the given time window.");
+    return false;
+  }
+  if (slotA == slotB)
+  {
+    ERROR(Form("Hits added to LOR come from the same barrel slots: %d.", slotA));
+    return false;
+  }
+  if (timeA > timeB)
+  {
+    ERROR("Hits added to LOR are not in chronological order.");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Sets the given JPetLOR to the one with copies of the hits referred
+ * to in the window of JPetHit or JPetSlimHit objects.
+ *
+ * @return false, leaving the LOR unchanged, if the hits are not found in the window.
+ */
+bool JPetIndexedLOR::toLOR(const JPetTimeWindow& hits, JPetLOR& lor) const
+{
+  if (!refersTo(hits))
+  {
+    ERROR("Hits of the LOR are not found in the given time window.");
+    return false;
+  }
+  JPetHit firstHit;
+  JPetHit secondHit;
+  if (auto slimHits = dynamic_cast<const JPetSlimHitWindow*>(&hits))
+  {
+    slimHits->fillHit(fFirstHitIndex, firstHit);
+    slimHits->fillHit(fSecondHitIndex, secondHit);
+  }
+  else if (dynamic_cast<const JPetHit*>(&hits[fFirstHitIndex]) && dynamic_cast<const JPetHit*>(&hits[fSecondHitIndex]))
+  {
+    firstHit = getFirstHit(hits);
+    secondHit = getSecondHit(hits);
+  }
+  else
+  {
+    ERROR(Form("Time window with events of type %s does not contain hits.", hits.getEventType()));
+    return false;
+  }
+  lor.Clear();
+  lor.setHits(firstHit, secondHit);
+  lor.setTime(fTime);
+  lor.setTimeDiff(fTimeDiff);
+  // JPetLOR::setQualityOfTimeDiff() sets the quality of time, so the latter is set last
+  lor.setQualityOfTimeDiff(fQualityOfTimeDiff);
+  lor.setQualityOfTime(fQualityOfTime);
+  lor.setRecoFlag(fFlag);
+  return true;
+}
+
+/**
+ * Resets LOR values to zero and the hit indices to kNoHit.
+ */
+void JPetIndexedLOR::Clear(Option_t*)
+{
+  fTime = 0.0f;
+  fQualityOfTime = 0.0f;
+  fTimeDiff = 0.0f;
+  fQualityOfTimeDiff = 0.0f;
+  fFirstHitIndex = kNoHit;
+  fSecondHitIndex = kNoHit;
+  fFlag = JPetLOR::Unknown;
+}
@@ -0,0 +1,258 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetLORGeometry.cpp
+ */
+
+#include "JPetLOR/JPetLORGeometry.h"
+#include "JPetIndexedLOR/JPetIndexedLOR.h"
+#include "JPetLoggerInclude.h"
+#include <TMath.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+const float JPetLORGeometry::kLightVelocity_cm_ps = 0.0299792458f;
+
+namespace
+{
+using HitPair = std::pair<const JPetHit*, const JPetHit*>;
+
+/**
+ * Kernel of JPetLORGeometry::calculate, the arrays are declared as not overlapping, so that
+ * the compiler does not have to check it at run time. The loop has no branches and uses
+ * only the arithmetic and square roots, so it is vectorized (if sqrt does not set errno).
+ */
+void calculateLORs(std::size_t size, const float* __restrict x1, const float* __restrict y1, const float* __restrict z1,
+                   const float* __restrict t1, const float* __restrict x2, const float* __restrict y2, const float* __restrict z2,
+                   const float* __restrict t2, float* __restrict tof, float* __restrict pointX, float* __restrict pointY,
+                   float* __restrict pointZ, float* __restrict pointDistance, float* __restrict length, float* __restrict distance)
+{
+  const float halfVelocity = 0.5f * JPetLORGeometry::kLightVelocity_cm_ps;
+  /// Lower limit of the lengths in the denominators, the numerators are zero for the LORs of zero length
+  const float kMinLength = 1.e-6f;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    const float dx = x2[i] - x1[i];
+    const float dy = y2[i] - y1[i];
+    const float dz = z2[i] - z1[i];
+    const float transverseLength = std::sqrt(dx * dx + dy * dy);
+    const float lorLength = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const float timeOfFlight = t1[i] - t2[i];
+    const float shift = halfVelocity * timeOfFlight / (lorLength > kMinLength ? lorLength : kMinLength);
+    const float px = 0.5f * (x1[i] + x2[i]) + shift * dx;
+    const float py = 0.5f * (y1[i] + y2[i]) + shift * dy;
+    const float pz = 0.5f * (z1[i] + z2[i]) + shift * dz;
+    tof[i] = timeOfFlight;
+    pointX[i] = px;
+    pointY[i] = py;
+    pointZ[i] = pz;
+    pointDistance[i] = std::sqrt(px * px + py * py + pz * pz);
+    length[i] = lorLength;
+    distance[i] = (x1[i] * dy - y1[i] * dx) / (transverseLength > kMinLength ? transverseLength : kMinLength);
+  }
+}
+} // namespace
+
+void JPetLORGeometry::HitArrays::resize(std::size_t size)
+{
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  time.resize(size);
+}
+
+void JPetLORGeometry::HitArrays::set(std::size_t index, const JPetHit& hit)
+{
+  x[index] = hit.getPosX();
+  y[index] = hit.getPosY();
+  z[index] = hit.getPosZ();
+  time[index] = hit.getTime();
+}
+
+void JPetLORGeometry::HitArrays::set(std::size_t index, const HitArrays& hits, std::size_t hitIndex)
+{
+  x[index] = hits.x[hitIndex];
+  y[index] = hits.y[hitIndex];
+  z[index] = hits.z[hitIndex];
+  time[index] = hits.time[hitIndex];
+}
+
+std::size_t JPetLORGeometry::HitArrays::size() const { return time.size(); }
+
+void JPetLORGeometry::LORArrays::resize(std::size_t size)
+{
+  tof.resize(size);
+  pointX.resize(size);
+  pointY.resize(size);
+  pointZ.resize(size);
+  pointDistance.resize(size);
+  length.resize(size);
+  angle.resize(size);
+  distance.resize(size);
+}
+
+std::size_t JPetLORGeometry::LORArrays::size() const { return tof.size(); }
+
+/**
+ * @brief Time of flight in [ps]: the time of the first hit minus the time of the second one.
+ */
+float JPetLORGeometry::calculateTOF(const JPetHit& firstHit, const JPetHit& secondHit) { return firstHit.getTime() - secondHit.getTime(); }
+
+/**
+ * @brief Annihilation point [cm] of a single LOR, the reference for the batch kernel.
+ */
+TVector3 JPetLORGeometry::calculateAnnihilationPoint(const JPetHit& firstHit, const JPetHit& secondHit)
+{
+  TVector3 middle = 0.5 * (firstHit.getPos() + secondHit.getPos());
+  TVector3 direction = secondHit.getPos() - firstHit.getPos();
+  if (direction.Mag() == 0.)
+  {
+    return middle;
+  }
+  double shift = 0.5 * calculateTOF(firstHit, secondHit) * kLightVelocity_cm_ps;
+  return middle + shift * direction.Unit();
+}
+
+/**
+ * @brief Calculates the parameters of the LORs given by the hits with the same index in the first and second arrays.
+ *
+ * The angles are calculated in a separate loop, as atan2 is not vectorized by the compilers in general.
+ * For a LOR of zero length the annihilation point is the hit position and the angle is zero.
+ */
+void JPetLORGeometry::calculate(const HitArrays& first, const HitArrays& second, LORArrays& lors)
+{
+  const std::size_t size = std::min(first.size(), second.size());
+  lors.resize(size);
+  calculateLORs(size, first.x.data(), first.y.data(), first.z.data(), first.time.data(), second.x.data(), second.y.data(), second.z.data(),
+                second.time.data(), lors.tof.data(), lors.pointX.data(), lors.pointY.data(), lors.pointZ.data(), lors.pointDistance.data(),
+                lors.length.data(), lors.distance.data());
+  const float* x1 = first.x.data();
+  const float* y1 = first.y.data();
+  const float* x2 = second.x.data();
+  const float* y2 = second.y.data();
+  float* distance = lors.distance.data();
+  float* angle = lors.angle.data();
+  const float pi = static_cast<float>(TMath::Pi());
+  for (std::size_t i = 0; i < size; i++)
+  {
+    /// The direction is flipped to have the angle in [0, pi), what changes the sign of the distance
+    float phi = std::atan2(y2[i] - y1[i], x2[i] - x1[i]);
+    const bool isFlipped = phi < 0.f || phi >= pi;
+    angle[i] = isFlipped ? (phi < 0.f ? phi + pi : phi - pi) : phi;
+    distance[i] = isFlipped ? -distance[i] : distance[i];
+  }
+}
+
+/**
+ * @brief Calculates the parameters of the given LORs.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::calculate(const std::vector<JPetLOR>& lors)
+{
+  return gatherAndCalculate(lors.size(), [&lors](std::size_t i) { return HitPair(&lors[i].getFirstHit(), &lors[i].getSecondHit()); });
+}
+
+/**
+ * @brief Calculates the parameters of the LORs in the time window of JPetLOR objects.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::calculate(const JPetTimeWindow& lors)
+{
+  return gatherAndCalculate(lors.getNumberOfEvents(), [&lors](std::size_t i) {
+    auto lor = dynamic_cast<const JPetLOR*>(&lors[i]);
+    return lor ? HitPair(&lor->getFirstHit(), &lor->getSecondHit()) : HitPair(nullptr, nullptr);
+  });
+}
+
+/**
+ * @brief Calculates the parameters of the JPetIndexedLOR objects referring to the window of JPetHit objects.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::calculate(const JPetTimeWindow& hits, const JPetTimeWindow& indexedLORs)
+{
+  return gatherAndCalculate(indexedLORs.getNumberOfEvents(), [&hits, &indexedLORs](std::size_t i) {
+    auto lor = dynamic_cast<const JPetIndexedLOR*>(&indexedLORs[i]);
+    if (!lor || !lor->refersTo(hits))
+    {
+      return HitPair(nullptr, nullptr);
+    }
+    return HitPair(dynamic_cast<const JPetHit*>(&hits[lor->getFirstHitIndex()]),
+                   dynamic_cast<const JPetHit*>(&hits[lor->getSecondHitIndex()]));
+  });
+}
+
+/**
+ * @brief Calculates the parameters of the LORs given by the pairs of indices of the hits,
+ * e.g. the ones found by JPetHitCombinatorics.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::calculate(const std::vector<JPetHit>& hits,
+                                                             const std::vector<std::array<std::uint32_t, 2>>& pairs)
+{
+  return gatherAndCalculate(pairs.size(), [&hits, &pairs](std::size_t i) {
+    if (pairs[i][0] >= hits.size() || pairs[i][1] >= hits.size())
+    {
+      return HitPair(nullptr, nullptr);
+    }
+    return HitPair(&hits[pairs[i][0]], &hits[pairs[i][1]]);
+  });
+}
+
+/**
+ * @brief Calculates the parameters of the LORs given by the pairs of indices of the hits
+ * in the arrays of the positions and times of all the hits of a window.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::calculate(const HitArrays& hits, const std::vector<std::array<std::uint32_t, 2>>& pairs)
+{
+  fFirstHits.resize(pairs.size());
+  fSecondHits.resize(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); i++)
+  {
+    if (pairs[i][0] >= hits.size() || pairs[i][1] >= hits.size())
+    {
+      ERROR(Form("The hits of the LOR number %zu are not available, no LOR parameters are calculated.", i));
+      fLORs.resize(0);
+      return fLORs;
+    }
+    fFirstHits.set(i, hits, pairs[i][0]);
+    fSecondHits.set(i, hits, pairs[i][1]);
+  }
+  calculate(fFirstHits, fSecondHits, fLORs);
+  return fLORs;
+}
+
+/**
+ * @brief Results of the last calculation.
+ */
+const JPetLORGeometry::LORArrays& JPetLORGeometry::getLORs() const { return fLORs; }
+
+/**
+ * Copies the positions and times of the hits of each LOR to the arrays and runs the kernel.
+ * If the hits of any LOR are not available, the result is empty.
+ */
+template <typename HitsGetter>
+const JPetLORGeometry::LORArrays& JPetLORGeometry::gatherAndCalculate(std::size_t size, HitsGetter getHits)
+{
+  fFirstHits.resize(size);
+  fSecondHits.resize(size);
+  for (std::size_t i = 0; i < size; i++)
+  {
+    auto hits = getHits(i);
+    if (!hits.first || !hits.second)
+    {
+      ERROR(Form("The hits of the LOR number %zu are not available, no LOR parameters are calculated.", i));
+      fLORs.resize(0);
+      return fLORs;
+    }
+    fFirstHits.set(i, *hits.first);
+    fSecondHits.set(i, *hits.second);
+  }
+  calculate(fFirstHits, fSecondHits, fLORs);
+  return fLORs;
+}
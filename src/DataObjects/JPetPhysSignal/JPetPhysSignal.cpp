@@ -14,6 +14,7 @@
  */
 
 #include "JPetPhysSignal/JPetPhysSignal.h"
+#include <utility>
 
 ClassImp(JPetPhysSignal);
 
@@ -27,6 +28,33 @@ JPetPhysSignal::JPetPhysSignal() : fTime(0), fQualityOfTime(0), fPhe(0), fQualit
  */
 JPetPhysSignal::~JPetPhysSignal() {}
 
+/**
+ * @brief Move constructor, takes over the underlying reco signal.
+ */
+JPetPhysSignal::JPetPhysSignal(JPetPhysSignal&& other) noexcept
+    : JPetBaseSignal(std::move(other)), fTime(other.fTime), fQualityOfTime(other.fQualityOfTime), fPhe(other.fPhe), fQualityOfPhe(other.fQualityOfPhe),
+      fRecoSignal(std::move(other.fRecoSignal)), fIsNullObject(other.fIsNullObject)
+{
+}
+
+/**
+ * @brief Move assignment, see the move constructor.
+ */
+JPetPhysSignal& JPetPhysSignal::operator=(JPetPhysSignal&& other) noexcept
+{
+  if (this != &other)
+  {
+    JPetBaseSignal::operator=(std::move(other));
+    fTime = other.fTime;
+    fQualityOfTime = other.fQualityOfTime;
+    fPhe = other.fPhe;
+    fQualityOfPhe = other.fQualityOfPhe;
+    fRecoSignal = std::move(other.fRecoSignal);
+    fIsNullObject = other.fIsNullObject;
+  }
+  return *this;
+}
+
 /**
  * Constructor with is null setting
  */
@@ -14,9 +14,81 @@
  */
 
 #include "JPetRawSignal/JPetRawSignal.h"
+#include <utility>
 
 ClassImp(JPetRawSignal);
 
+const int JPetRawSignal::kMaxThresholds;
+
+namespace
+{
+const JPetRawSignal::ThresholdArray& getUnsetArray()
+{
+  static JPetRawSignal::ThresholdArray unset = []() {
+    JPetRawSignal::ThresholdArray array;
+    array.fill(JPetSigCh::kUnset);
+    return array;
+  }();
+  return unset;
+}
+
+bool isInFlatRange(int thrNumber) { return thrNumber >= 1 && thrNumber <= JPetRawSignal::kMaxThresholds; }
+} // namespace
+
+JPetRawSignal::ThresholdIndex::ThresholdIndex() { reset(); }
+
+void JPetRawSignal::ThresholdIndex::reset()
+{
+  fTimes.fill(JPetSigCh::kUnset);
+  fThresholds.fill(JPetSigCh::kUnset);
+  fPoints.fill(-1);
+  fDoubled = false;
+  fOutOfRange = false;
+}
+
+/**
+ * Registers the point with the given index in the vector of points of one edge.
+ */
+void JPetRawSignal::ThresholdIndex::add(const std::vector<JPetSigCh>& points, std::size_t pointIndex)
+{
+  const auto& point = points[pointIndex];
+  int thrNumber = point.getThresholdNumber();
+  if (isInFlatRange(thrNumber))
+  {
+    if (fPoints[thrNumber - 1] >= 0)
+    {
+      fDoubled = true;
+      return;
+    }
+    fPoints[thrNumber - 1] = pointIndex;
+    fTimes[thrNumber - 1] = point.getValue();
+    fThresholds[thrNumber - 1] = point.getThreshold();
+  }
+  else
+  {
+    fOutOfRange = true;
+    for (std::size_t i = 0; i < pointIndex; i++)
+    {
+      if (points[i].getThresholdNumber() == point.getThresholdNumber())
+      {
+        fDoubled = true;
+      }
+    }
+  }
+}
+
+/**
+ * Rebuilds the index from all the points of one edge, e.g. after they were read from a file.
+ */
+void JPetRawSignal::ThresholdIndex::build(const std::vector<JPetSigCh>& points)
+{
+  reset();
+  for (std::size_t i = 0; i < points.size(); i++)
+  {
+    add(points, i);
+  }
+}
+
 /**
  * @brief Constructor
  *
@@ -33,6 +105,35 @@ JPetRawSignal::JPetRawSignal(const int points)
  */
 JPetRawSignal::~JPetRawSignal() {}
 
+/**
+ * @brief Move constructor, takes over the points and leaves the other signal empty
+ * with a consistent threshold index.
+ */
+JPetRawSignal::JPetRawSignal(JPetRawSignal&& other) noexcept
+    : JPetBaseSignal(std::move(other)), fLeadingPoints(std::move(other.fLeadingPoints)), fTrailingPoints(std::move(other.fTrailingPoints)),
+      fLeadingIndex(other.fLeadingIndex), fTrailingIndex(other.fTrailingIndex)
+{
+  other.JPetRawSignal::Clear();
+}
+
+/**
+ * @brief Move assignment, takes over the points and leaves the other signal empty
+ * with a consistent threshold index.
+ */
+JPetRawSignal& JPetRawSignal::operator=(JPetRawSignal&& other) noexcept
+{
+  if (this != &other)
+  {
+    JPetBaseSignal::operator=(std::move(other));
+    fLeadingPoints = std::move(other.fLeadingPoints);
+    fTrailingPoints = std::move(other.fTrailingPoints);
+    fLeadingIndex = other.fLeadingIndex;
+    fTrailingIndex = other.fTrailingIndex;
+    other.JPetRawSignal::Clear();
+  }
+  return *this;
+}
+
 /**
  * @brief Returns the number of points recorded on a leading or trailing edge of this signal.
  *
@@ -65,10 +166,12 @@ void JPetRawSignal::addPoint(const JPetSigCh& sigch)
   if (sigch.getType() == JPetSigCh::Trailing)
   {
     fTrailingPoints.push_back(sigch);
+    fTrailingIndex.add(fTrailingPoints, fTrailingPoints.size() - 1);
   }
   else if (sigch.getType() == JPetSigCh::Leading)
   {
     fLeadingPoints.push_back(sigch);
+    fLeadingIndex.add(fLeadingPoints, fLeadingPoints.size() - 1);
   }
 }
 
@@ -87,7 +190,7 @@ void JPetRawSignal::addPoint(const JPetSigCh& sigch)
  */
 std::vector<JPetSigCh> JPetRawSignal::getPoints(JPetSigCh::EdgeType edge, JPetRawSignal::PointsSortOrder order) const
 {
-  std::vector<JPetSigCh> sorted = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
+  std::vector<JPetSigCh> sorted = points(edge);
   if (order == JPetRawSignal::ByThrNum)
   {
     std::sort(sorted.begin(), sorted.end(), JPetSigCh::compareByThresholdNumber);
@@ -99,81 +202,203 @@ std::vector<JPetSigCh> JPetRawSignal::getPoints(JPetSigCh::EdgeType edge, JPetRa
   return sorted;
 }
 
+/**
+ * @brief Returns the points of the edge in the order they were added, without copying them.
+ */
+const std::vector<JPetSigCh>& JPetRawSignal::getPointsRef(JPetSigCh::EdgeType edge) const { return points(edge); }
+
+/**
+ * @brief Returns the point of the edge with the given threshold number, or nullptr
+ * if there is no such point or the threshold number is doubled at this edge.
+ */
+const JPetSigCh* JPetRawSignal::getPoint(JPetSigCh::EdgeType edge, int thrNumber) const
+{
+  const auto& thrIndex = index(edge);
+  if (thrIndex.fDoubled)
+  {
+    return nullptr;
+  }
+  if (isInFlatRange(thrNumber))
+  {
+    auto pointIndex = thrIndex.fPoints[thrNumber - 1];
+    return pointIndex >= 0 ? &points(edge)[pointIndex] : nullptr;
+  }
+  if (thrIndex.fOutOfRange)
+  {
+    for (const auto& point : points(edge))
+    {
+      if (static_cast<int>(point.getThresholdNumber()) == thrNumber)
+      {
+        return &point;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool JPetRawSignal::hasTime(JPetSigCh::EdgeType edge, int thrNumber) const { return getPoint(edge, thrNumber) != nullptr; }
+
+/**
+ * @brief Time [ps] at the threshold with the given number,
+ * JPetSigCh::kUnset if it is missing or doubled at this edge.
+ */
+float JPetRawSignal::getTime(JPetSigCh::EdgeType edge, int thrNumber) const
+{
+  const auto& thrIndex = index(edge);
+  if (!thrIndex.fDoubled && isInFlatRange(thrNumber))
+  {
+    return thrIndex.fTimes[thrNumber - 1];
+  }
+  auto point = getPoint(edge, thrNumber);
+  return point ? point->getValue() : JPetSigCh::kUnset;
+}
+
+/**
+ * @brief Value [mV] of the threshold with the given number,
+ * JPetSigCh::kUnset if there is no point at it or it is doubled at this edge.
+ */
+float JPetRawSignal::getThresholdValue(JPetSigCh::EdgeType edge, int thrNumber) const
+{
+  auto point = getPoint(edge, thrNumber);
+  return point ? point->getThreshold() : JPetSigCh::kUnset;
+}
+
+/**
+ * @brief Time over threshold [ps] for the threshold with the given number,
+ * JPetSigCh::kUnset if the leading or trailing time is missing.
+ */
+float JPetRawSignal::getTOT(int thrNumber) const
+{
+  if (!hasTime(JPetSigCh::Leading, thrNumber) || !hasTime(JPetSigCh::Trailing, thrNumber))
+  {
+    return JPetSigCh::kUnset;
+  }
+  return getTime(JPetSigCh::Trailing, thrNumber) - getTime(JPetSigCh::Leading, thrNumber);
+}
+
+/**
+ * @brief Times [ps] at the thresholds 1 to kMaxThresholds (at index thrNumber - 1),
+ * JPetSigCh::kUnset for the missing ones. All are unset if any threshold is doubled.
+ */
+const JPetRawSignal::ThresholdArray& JPetRawSignal::getTimes(JPetSigCh::EdgeType edge) const
+{
+  const auto& thrIndex = index(edge);
+  return thrIndex.fDoubled ? getUnsetArray() : thrIndex.fTimes;
+}
+
+/**
+ * @brief Values [mV] of the thresholds 1 to kMaxThresholds, as in getTimes().
+ */
+const JPetRawSignal::ThresholdArray& JPetRawSignal::getThresholdValues(JPetSigCh::EdgeType edge) const
+{
+  const auto& thrIndex = index(edge);
+  return thrIndex.fDoubled ? getUnsetArray() : thrIndex.fThresholds;
+}
+
+bool JPetRawSignal::hasDoubledThreshold(JPetSigCh::EdgeType edge) const { return index(edge).fDoubled; }
+
 /**
  * @brief Get a map with (threshold number, time [ps]) pairs.
  */
 std::map<int, double> JPetRawSignal::getTimesVsThresholdNumber(JPetSigCh::EdgeType edge) const
 {
   std::map<int, double> thrToTime;
-  const std::vector<JPetSigCh>& vec = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
-  for (std::vector<JPetSigCh>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+  const auto& thrIndex = index(edge);
+  if (thrIndex.fDoubled)
+  {
+    WARNING("Doube threshold in edge signal channels, returning empty map.");
+    return thrToTime;
+  }
+  if (thrIndex.fOutOfRange)
   {
-    if (thrToTime.find(it->getThresholdNumber()) == thrToTime.end())
+    for (const auto& point : points(edge))
     {
-      thrToTime[it->getThresholdNumber()] = it->getValue();
+      thrToTime[point.getThresholdNumber()] = point.getValue();
     }
-    else
+    return thrToTime;
+  }
+  for (int i = 0; i < kMaxThresholds; i++)
+  {
+    if (thrIndex.fPoints[i] >= 0)
     {
-      WARNING("Doube threshold in edge signal channels, returning empty map.");
-      std::map<int, double> empty;
-      return empty;
+      thrToTime.emplace_hint(thrToTime.end(), i + 1, thrIndex.fTimes[i]);
     }
   }
   return thrToTime;
 }
 
 /**
- * @brief Get a map with (threshold value [mV], time [ps]) pairs.
+ * @brief Get a map with (threshold number, (threshold value [mV], time [ps])) pairs.
  */
 std::map<int, std::pair<float, float>> JPetRawSignal::getTimesVsThresholdValue(JPetSigCh::EdgeType edge) const
 {
   std::map<int, std::pair<float, float>> thrToTime;
-  const std::vector<JPetSigCh>& vec = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
-  for (std::vector<JPetSigCh>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+  const auto& thrIndex = index(edge);
+  if (thrIndex.fDoubled)
+  {
+    WARNING("Doube threshold in edge signal channels, returning empty map.");
+    return thrToTime;
+  }
+  if (thrIndex.fOutOfRange)
   {
-    if (thrToTime.find(it->getThresholdNumber()) == thrToTime.end())
+    for (const auto& point : points(edge))
     {
-      thrToTime[it->getThresholdNumber()] = std::make_pair(it->getThreshold(), it->getValue());
+      thrToTime[point.getThresholdNumber()] = std::make_pair(point.getThreshold(), point.getValue());
     }
-    else
+    return thrToTime;
+  }
+  for (int i = 0; i < kMaxThresholds; i++)
+  {
+    if (thrIndex.fPoints[i] >= 0)
     {
-      WARNING("Doube threshold in edge signal channels, returning empty map.");
-      std::map<int, std::pair<float, float>> empty;
-      return empty;
+      thrToTime.emplace_hint(thrToTime.end(), i + 1, std::make_pair(thrIndex.fThresholds[i], thrIndex.fTimes[i]));
     }
   }
   return thrToTime;
 }
 
 /**
- * @brief Get a map with (threshold value [mV], TOT [ps]) pairs.
+ * @brief Get a map with (threshold number, TOT [ps]) pairs.
  */
 std::map<int, double> JPetRawSignal::getTOTsVsThresholdNumber() const
 {
   std::map<int, double> thrToTOT;
-  for (auto leading : fLeadingPoints)
+  const auto& leadingIndex = index(JPetSigCh::Leading);
+  const auto& trailingIndex = index(JPetSigCh::Trailing);
+  if (leadingIndex.fDoubled || leadingIndex.fOutOfRange || trailingIndex.fDoubled || trailingIndex.fOutOfRange)
   {
-    for (auto trailing : fTrailingPoints)
+    for (const auto& leading : fLeadingPoints)
     {
-      if (leading.getThresholdNumber() == trailing.getThresholdNumber())
+      for (const auto& trailing : fTrailingPoints)
       {
-        thrToTOT[leading.getThresholdNumber()] = trailing.getValue() - leading.getValue();
-        break;
+        if (leading.getThresholdNumber() == trailing.getThresholdNumber())
+        {
+          thrToTOT[leading.getThresholdNumber()] = trailing.getValue() - leading.getValue();
+          break;
+        }
       }
     }
+    return thrToTOT;
+  }
+  for (int i = 0; i < kMaxThresholds; i++)
+  {
+    if (leadingIndex.fPoints[i] >= 0 && trailingIndex.fPoints[i] >= 0)
+    {
+      thrToTOT.emplace_hint(thrToTOT.end(), i + 1, trailingIndex.fTimes[i] - leadingIndex.fTimes[i]);
+    }
   }
   return thrToTOT;
 }
 
 /**
- * @brief Get a map with (threshold number, TOT [ps]) pairs.
+ * @brief Get a map with (threshold value [mV], TOT [ps]) pairs.
  */
 std::map<int, double> JPetRawSignal::getTOTsVsThresholdValue() const
 {
   std::map<int, double> thrToTOT;
-  for (auto leading : fLeadingPoints)
+  for (const auto& leading : fLeadingPoints)
   {
-    for (auto trailing : fTrailingPoints)
+    for (const auto& trailing : fTrailingPoints)
     {
       if (leading.getThreshold() == trailing.getThreshold())
       {
@@ -189,4 +414,16 @@ void JPetRawSignal::Clear(Option_t*)
 {
   fLeadingPoints.clear();
   fTrailingPoints.clear();
+  fLeadingIndex.reset();
+  fTrailingIndex.reset();
+}
+
+const std::vector<JPetSigCh>& JPetRawSignal::points(JPetSigCh::EdgeType edge) const
+{
+  return edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints;
+}
+
+const JPetRawSignal::ThresholdIndex& JPetRawSignal::index(JPetSigCh::EdgeType edge) const
+{
+  return edge == JPetSigCh::Trailing ? fTrailingIndex : fLeadingIndex;
 }
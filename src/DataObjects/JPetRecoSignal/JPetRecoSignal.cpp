@@ -14,6 +14,7 @@
  */
 
 #include "JPetRecoSignal/JPetRecoSignal.h"
+#include <utility>
 
 ClassImp(JPetRecoSignal);
 
@@ -33,6 +34,34 @@ JPetRecoSignal::JPetRecoSignal(const int points) : fDelay(0), fAmplitude(0), fOf
 
 JPetRecoSignal::~JPetRecoSignal() {}
 
+/**
+ * @brief Move constructor, takes over the shape, the reconstructed times and the raw signal.
+ */
+JPetRecoSignal::JPetRecoSignal(JPetRecoSignal&& other) noexcept
+    : JPetBaseSignal(std::move(other)), fRecoTimesAtThreshold(std::move(other.fRecoTimesAtThreshold)), fShape(std::move(other.fShape)),
+      fRawSignal(std::move(other.fRawSignal)), fDelay(other.fDelay), fAmplitude(other.fAmplitude), fOffset(other.fOffset), fCharge(other.fCharge)
+{
+}
+
+/**
+ * @brief Move assignment, see the move constructor.
+ */
+JPetRecoSignal& JPetRecoSignal::operator=(JPetRecoSignal&& other) noexcept
+{
+  if (this != &other)
+  {
+    JPetBaseSignal::operator=(std::move(other));
+    fRecoTimesAtThreshold = std::move(other.fRecoTimesAtThreshold);
+    fShape = std::move(other.fShape);
+    fRawSignal = std::move(other.fRawSignal);
+    fDelay = other.fDelay;
+    fAmplitude = other.fAmplitude;
+    fOffset = other.fOffset;
+    fCharge = other.fCharge;
+  }
+  return *this;
+}
+
 /**
  * Set one point (i.e. (time, amplitude) pair) in the signal shape.
  *
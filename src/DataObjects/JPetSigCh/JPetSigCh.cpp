@@ -14,6 +14,7 @@
  */
 
 #include "JPetSigCh/JPetSigCh.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 
 #include <limits>
 
@@ -79,9 +80,10 @@ int JPetSigCh::getDAQch() const { return fDAQch; }
  */
 const JPetPM& JPetSigCh::getPM() const
 {
-  if (fPM.GetObject())
+  auto object = JPetParamRefResolver::resolvePM(fPMID, fPM);
+  if (object)
   {
-    return (JPetPM&)*fPM.GetObject();
+    return *object;
   }
   else
   {
@@ -95,9 +97,10 @@ const JPetPM& JPetSigCh::getPM() const
  */
 const JPetFEB& JPetSigCh::getFEB() const
 {
-  if (fFEB.GetObject())
+  auto object = JPetParamRefResolver::resolveFEB(fFEBID, fFEB);
+  if (object)
   {
-    return (JPetFEB&)*fFEB.GetObject();
+    return *object;
   }
   else
   {
@@ -111,9 +114,10 @@ const JPetFEB& JPetSigCh::getFEB() const
  */
 const JPetTRB& JPetSigCh::getTRB() const
 {
-  if (fTRB.GetObject())
+  auto object = JPetParamRefResolver::resolveTRB(fTRBID, fTRB);
+  if (object)
   {
-    return (JPetTRB&)*fTRB.GetObject();
+    return *object;
   }
   else
   {
@@ -127,9 +131,10 @@ const JPetTRB& JPetSigCh::getTRB() const
  */
 const JPetTOMBChannel& JPetSigCh::getTOMBChannel() const
 {
-  if (fTOMBChannel.GetObject())
+  auto object = JPetParamRefResolver::resolveTOMBChannel(fTOMBChannelID, fTOMBChannel);
+  if (object)
   {
-    return (JPetTOMBChannel&)*fTOMBChannel.GetObject();
+    return *object;
   }
   else
   {
@@ -139,9 +144,17 @@ const JPetTOMBChannel& JPetSigCh::getTOMBChannel() const
 }
 
 /**
- * A proxy method for quick access to DAQ channel number ignorantly of what a TOMBCHannel is
+ * A proxy method for quick access to DAQ channel number ignorantly of what a TOMBCHannel is.
+ * The stored channel number is returned without resolving the TOMBChannel, if it is known.
  */
-int JPetSigCh::getChannel() const { return getTOMBChannel().getChannel(); }
+int JPetSigCh::getChannel() const
+{
+  if (fTOMBChannelID != JPetParamRefResolver::kNoID)
+  {
+    return fTOMBChannelID;
+  }
+  return getTOMBChannel().getChannel();
+}
 
 /**
  * Set the reconstruction flag with enum
@@ -176,22 +189,25 @@ void JPetSigCh::setDAQch(int daq) { fDAQch = daq; }
 /**
  * Set the PM associated with this Signal Channel
  */
-void JPetSigCh::setPM(const JPetPM& pm) { fPM = const_cast<JPetPM*>(&pm); }
+void JPetSigCh::setPM(const JPetPM& pm) { JPetParamRefResolver::setRef(fPMID, fPM, pm, pm.getID()); }
 
 /**
  * Set the FEB associated with this Signal Channel
  */
-void JPetSigCh::setFEB(const JPetFEB& feb) { fFEB = const_cast<JPetFEB*>(&feb); }
+void JPetSigCh::setFEB(const JPetFEB& feb) { JPetParamRefResolver::setRef(fFEBID, fFEB, feb, feb.getID()); }
 
 /**
  * Set the TRB associated with this Signal Channel
  */
-void JPetSigCh::setTRB(const JPetTRB& trb) { fTRB = const_cast<JPetTRB*>(&trb); }
+void JPetSigCh::setTRB(const JPetTRB& trb) { JPetParamRefResolver::setRef(fTRBID, fTRB, trb, trb.getID()); }
 
 /**
  * Set the TOMBChannel associated with this Signal Channel
  */
-void JPetSigCh::setTOMBChannel(const JPetTOMBChannel& channel) { fTOMBChannel = const_cast<JPetTOMBChannel*>(&channel); }
+void JPetSigCh::setTOMBChannel(const JPetTOMBChannel& channel)
+{
+  JPetParamRefResolver::setRef(fTOMBChannelID, fTOMBChannel, channel, channel.getChannel());
+}
 
 /**
  * Compares two SigChs by their threshold value
@@ -218,4 +234,8 @@ void JPetSigCh::Clear(Option_t*)
   fFEB = NULL;
   fTRB = NULL;
   fTOMBChannel = NULL;
+  fPMID = JPetParamRefResolver::kNoID;
+  fFEBID = JPetParamRefResolver::kNoID;
+  fTRBID = JPetParamRefResolver::kNoID;
+  fTOMBChannelID = JPetParamRefResolver::kNoID;
 }
@@ -0,0 +1,182 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHit.cpp
+ */
+
+#include "JPetSlimHit/JPetSlimHit.h"
+#include "JPetLoggerInclude.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
+#include <TRef.h>
+
+ClassImp(JPetSlimHit);
+
+const int JPetSlimHit::kNoSignal = -1;
+
+JPetSlimHit::JPetSlimHit() : TObject() {}
+
+/**
+ * Constructor copying the quantities of the hit, the signals are given
+ * by their indices in the signal table of the window.
+ */
+JPetSlimHit::JPetSlimHit(const JPetHit& hit, int signalAIndex, int signalBIndex)
+    : TObject(), fFlag(hit.getRecoFlag()), fEnergy(hit.getEnergy()), fQualityOfEnergy(hit.getQualityOfEnergy()), fTime(hit.getTime()),
+      fQualityOfTime(hit.getQualityOfTime()), fTimeDiff(hit.getTimeDiff()), fQualityOfTimeDiff(hit.getQualityOfTimeDiff()),
+      fPosX(hit.getPosX()), fPosY(hit.getPosY()), fPosZ(hit.getPosZ()), fScintillatorID(hit.getScintillatorID()),
+      fBarrelSlotID(hit.getBarrelSlotID()), fSignalAIndex(signalAIndex), fSignalBIndex(signalBIndex), fMCindex(hit.getMCindex())
+{
+}
+
+JPetSlimHit::~JPetSlimHit() {}
+
+JPetHit::RecoFlag JPetSlimHit::getRecoFlag() const { return fFlag; }
+
+float JPetSlimHit::getEnergy() const { return fEnergy; }
+
+float JPetSlimHit::getQualityOfEnergy() const { return fQualityOfEnergy; }
+
+float JPetSlimHit::getTime() const { return fTime; }
+
+float JPetSlimHit::getQualityOfTime() const { return fQualityOfTime; }
+
+float JPetSlimHit::getTimeDiff() const { return fTimeDiff; }
+
+float JPetSlimHit::getQualityOfTimeDiff() const { return fQualityOfTimeDiff; }
+
+float JPetSlimHit::getPosX() const { return fPosX; }
+
+float JPetSlimHit::getPosY() const { return fPosY; }
+
+float JPetSlimHit::getPosZ() const { return fPosZ; }
+
+/**
+ * Get the position of the hit in [cm] as a TVector3
+ */
+TVector3 JPetSlimHit::getPos() const { return TVector3(fPosX, fPosY, fPosZ); }
+
+int JPetSlimHit::getScintillatorID() const { return fScintillatorID; }
+
+int JPetSlimHit::getBarrelSlotID() const { return fBarrelSlotID; }
+
+/**
+ * Get the scintillator from the bound param bank, the dummy object if it cannot be resolved
+ */
+const JPetScin& JPetSlimHit::getScintillator() const
+{
+  auto scin = JPetParamRefResolver::resolveScin(fScintillatorID, TRef());
+  if (scin)
+  {
+    return *scin;
+  }
+  ERROR("No JPetScin found for the hit, Null object will be returned");
+  return JPetScin::getDummyResult();
+}
+
+/**
+ * Get the barrel slot from the bound param bank, the dummy object if it cannot be resolved
+ */
+const JPetBarrelSlot& JPetSlimHit::getBarrelSlot() const
+{
+  auto barrelSlot = JPetParamRefResolver::resolveBarrelSlot(fBarrelSlotID, TRef());
+  if (barrelSlot)
+  {
+    return *barrelSlot;
+  }
+  ERROR("No JPetBarrelSlot found for the hit, Null object will be returned");
+  return JPetBarrelSlot::getDummyResult();
+}
+
+/**
+ * Get the index of the signal from the side A in the signal table of the window, kNoSignal if not set
+ */
+int JPetSlimHit::getSignalAIndex() const { return fSignalAIndex; }
+
+/**
+ * Get the index of the signal from the side B in the signal table of the window, kNoSignal if not set
+ */
+int JPetSlimHit::getSignalBIndex() const { return fSignalBIndex; }
+
+bool JPetSlimHit::isSignalASet() const { return fSignalAIndex != kNoSignal; }
+
+bool JPetSlimHit::isSignalBSet() const { return fSignalBIndex != kNoSignal; }
+
+unsigned int JPetSlimHit::getMCindex() const { return fMCindex; }
+
+void JPetSlimHit::setRecoFlag(JPetHit::RecoFlag flag) { fFlag = flag; }
+
+void JPetSlimHit::setEnergy(float energy) { fEnergy = energy; }
+
+void JPetSlimHit::setQualityOfEnergy(float qualityOfEnergy) { fQualityOfEnergy = qualityOfEnergy; }
+
+void JPetSlimHit::setTime(float time) { fTime = time; }
+
+void JPetSlimHit::setQualityOfTime(float qualityOfTime) { fQualityOfTime = qualityOfTime; }
+
+void JPetSlimHit::setTimeDiff(float timeDiff) { fTimeDiff = timeDiff; }
+
+void JPetSlimHit::setQualityOfTimeDiff(float qualityOfTimeDiff) { fQualityOfTimeDiff = qualityOfTimeDiff; }
+
+void JPetSlimHit::setPos(float x, float y, float z)
+{
+  fPosX = x;
+  fPosY = y;
+  fPosZ = z;
+}
+
+void JPetSlimHit::setScintillatorID(int id) { fScintillatorID = id; }
+
+void JPetSlimHit::setBarrelSlotID(int id) { fBarrelSlotID = id; }
+
+void JPetSlimHit::setSignalIndices(int signalAIndex, int signalBIndex)
+{
+  fSignalAIndex = signalAIndex;
+  fSignalBIndex = signalBIndex;
+}
+
+void JPetSlimHit::setMCindex(unsigned int index) { fMCindex = index; }
+
+/**
+ * Sets all the quantities of the full hit except for the signals, which are kept in the window.
+ */
+void JPetSlimHit::fillHit(JPetHit& hit) const
+{
+  hit.setRecoFlag(fFlag);
+  hit.setEnergy(fEnergy);
+  hit.setQualityOfEnergy(fQualityOfEnergy);
+  hit.setTime(fTime);
+  hit.setQualityOfTime(fQualityOfTime);
+  hit.setTimeDiff(fTimeDiff);
+  hit.setQualityOfTimeDiff(fQualityOfTimeDiff);
+  hit.setPos(fPosX, fPosY, fPosZ);
+  hit.setScintillatorID(fScintillatorID);
+  hit.setBarrelSlotID(fBarrelSlotID);
+  hit.setMCindex(fMCindex);
+}
+
+void JPetSlimHit::Clear(Option_t*)
+{
+  fFlag = JPetHit::Unknown;
+  fEnergy = 0.0f;
+  fQualityOfEnergy = 0.0f;
+  fTime = 0.0f;
+  fQualityOfTime = 0.0f;
+  fTimeDiff = 0.0f;
+  fQualityOfTimeDiff = 0.0f;
+  fPosX = 0.0f;
+  fPosY = 0.0f;
+  fPosZ = 0.0f;
+  fScintillatorID = -1;
+  fBarrelSlotID = -1;
+  fSignalAIndex = kNoSignal;
+  fSignalBIndex = kNoSignal;
+  fMCindex = JPetHit::kMCindexError;
+}
@@ -0,0 +1,126 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHitWindow.cpp
+ */
+
+#include "JPetSlimHitWindow/JPetSlimHitWindow.h"
+#include "JPetLoggerInclude.h"
+
+ClassImp(JPetSlimHitWindow);
+
+/**
+ * @brief Copy of the window, the hits and the signals are assigned one by one.
+ */
+std::unique_ptr<JPetTimeWindow> JPetSlimHitWindow::copy() const
+{
+  auto window = std::unique_ptr<JPetSlimHitWindow>(new JPetSlimHitWindow());
+  for (size_t i = 0; i < getNumberOfEvents(); i++)
+  {
+    window->add<JPetSlimHit>(getHit(i));
+  }
+  for (size_t i = 0; i < getNumberOfSignals(); i++)
+  {
+    window->addSignal(getSignal(i));
+  }
+  return std::move(window);
+}
+
+/**
+ * @brief Adds the signal to the signal table.
+ * @return index of the signal in the table
+ */
+int JPetSlimHitWindow::addSignal(const JPetPhysSignal& signal)
+{
+  dynamic_cast<JPetPhysSignal&>(*(fSignals.ConstructedAt(fSignalCount))) = signal;
+  return fSignalCount++;
+}
+
+/**
+ * @brief Adds the slim counterpart of the hit, its signals (if set) go to the signal table.
+ */
+void JPetSlimHitWindow::addHit(const JPetHit& hit)
+{
+  int signalAIndex = hit.isSignalASet() ? addSignal(hit.getSignalA()) : JPetSlimHit::kNoSignal;
+  int signalBIndex = hit.isSignalBSet() ? addSignal(hit.getSignalB()) : JPetSlimHit::kNoSignal;
+  add<JPetSlimHit>(JPetSlimHit(hit, signalAIndex, signalBIndex));
+}
+
+/**
+ * @brief Replaces the content of this window with the slim counterparts of the hits in the given window.
+ * @return false, leaving this window empty, if the window does not contain JPetHit objects.
+ */
+bool JPetSlimHitWindow::fill(const JPetTimeWindow& hits)
+{
+  Clear();
+  for (size_t i = 0; i < hits.getNumberOfEvents(); i++)
+  {
+    auto hit = dynamic_cast<const JPetHit*>(&hits[i]);
+    if (!hit)
+    {
+      ERROR(Form("Time window with events of type %s cannot be converted to the window of slim hits.", hits.getEventType()));
+      Clear();
+      return false;
+    }
+    addHit(*hit);
+  }
+  return true;
+}
+
+/**
+ * @brief Creates a window of full JPetHit objects, with copies of the signals, e.g. for the tasks expecting one.
+ */
+std::unique_ptr<JPetTimeWindow> JPetSlimHitWindow::toHitWindow() const
+{
+  auto window = std::unique_ptr<JPetTimeWindow>(new JPetTimeWindow(JPetHit::Class_Name()));
+  JPetHit hit;
+  for (size_t i = 0; i < getNumberOfEvents(); i++)
+  {
+    hit.Clear();
+    fillHit(i, hit);
+    window->add<JPetHit>(hit);
+  }
+  return window;
+}
+
+/**
+ * @brief Sets the hit to the full counterpart of the i-th slim hit, including the copies of its signals.
+ */
+void JPetSlimHitWindow::fillHit(int i, JPetHit& hit) const
+{
+  const auto& slimHit = getHit(i);
+  slimHit.fillHit(hit);
+  if (slimHit.isSignalASet() && slimHit.isSignalBSet())
+  {
+    hit.setSignals(getSignalA(slimHit), getSignalB(slimHit));
+  }
+  else if (slimHit.isSignalASet())
+  {
+    hit.setSignalA(getSignalA(slimHit));
+  }
+  else if (slimHit.isSignalBSet())
+  {
+    hit.setSignalB(getSignalB(slimHit));
+  }
+}
+
+const JPetPhysSignal& JPetSlimHitWindow::getSignal(int index) const { return *(dynamic_cast<JPetPhysSignal*>(fSignals[index])); }
+
+/**
+ * @brief Signal from the side A of the hit, the hit must have it set.
+ */
+const JPetPhysSignal& JPetSlimHitWindow::getSignalA(const JPetSlimHit& hit) const { return getSignal(hit.getSignalAIndex()); }
+
+/**
+ * @brief Signal from the side B of the hit, the hit must have it set.
+ */
+const JPetPhysSignal& JPetSlimHitWindow::getSignalB(const JPetSlimHit& hit) const { return getSignal(hit.getSignalBIndex()); }
@@ -14,5 +14,11 @@
  */
 
 #include "JPetTimeWindow/JPetTimeWindow.h"
+#include <TClass.h>
 
 ClassImp(JPetTimeWindow);
+
+/**
+ * @return name of the class of the events stored in the window, as given in the constructor.
+ */
+const char* JPetTimeWindow::getEventType() const { return fEvents.GetClass() ? fEvents.GetClass()->GetName() : ""; }
@@ -17,6 +17,7 @@
 #include <JPetGeantParser/JPetGeantParser.h>
 #include <JPetGeantParser/JPetGeantParserTools.h>
 #include <JPetOptionsTools/JPetOptionsTools.h>
+#include <JPetTaskChainExecutor/JPetTaskChainExecutor.h>
 #include <JPetWriter/JPetWriter.h>
 #include <iostream>
 
@@ -24,6 +25,7 @@
 #include <TMath.h>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <string>
 
 using namespace jpet_options_tools;
@@ -35,7 +37,7 @@ JPetGeantParser::~JPetGeantParser() {}
 bool JPetGeantParser::init()
 {
   // create detector map
-  std::unique_ptr<JPetGeomMapping> fDetectorMap(new JPetGeomMapping(getParamBank()));
+  fDetectorMap.reset(new JPetGeomMapping(getParamBank()));
 
   fOutputEvents = new JPetTimeWindowMC("JPetHit", "JPetMCHit", "JPetMCDecayTree");
   auto opts = getOptions();
@@ -75,6 +77,13 @@ bool JPetGeantParser::init()
   }
 
   JPetGeantParserTools::setSeedTogRandom(getOriginalSeed());
+  if (isOptionSet(fParams.getOptions(), JPetTaskChainExecutor::kFileIndexKey))
+  {
+    fFileIndex = getOptionAsInt(fParams.getOptions(), JPetTaskChainExecutor::kFileIndexKey);
+  }
+  /// the numbers drawn before the first event have their own stream
+  fRandomStream.setStream(getOriginalSeed(), fFileIndex, std::numeric_limits<ULong64_t>::max());
+  fExperimentalParametrizer.setRandomGenerator(&fRandomStream);
   INFO("Seed value used for resolution smearing of MC simulation data: " << boost::lexical_cast<std::string>(getOriginalSeed()));
 
   loadSmearingOptionsAndSetupExperimentalParametrizer();
@@ -86,7 +95,8 @@ bool JPetGeantParser::init()
 
   // make distribution of decays in time window
   // needed to adjust simulation times into time window scheme
-  std::tie(fTimeDistroOfDecays, fTimeDiffDistro) = JPetGeantParserTools::getTimeDistoOfDecays(fSimulatedActivity, fMinTime, fMaxTime);
+  std::tie(fTimeDistroOfDecays, fTimeDiffDistro) =
+      JPetGeantParserTools::getTimeDistoOfDecays(fSimulatedActivity, fMinTime, fMaxTime, &fRandomStream);
 
   INFO("MC Hit wrapper started.");
 
@@ -190,6 +200,8 @@ bool JPetGeantParser::exec()
 
   if (auto& mcEventPack = dynamic_cast<JPetGeantEventPack* const>(fEvent))
   {
+    fRandomStream.setEventIndex(getEntryNumber() >= 0 ? getEntryNumber() : fProcessedEvents);
+    fProcessedEvents++;
 
     processMCEvent(mcEventPack);
 
@@ -203,7 +215,8 @@ bool JPetGeantParser::exec()
       {
         saveHits();
         clearTimeDistoOfDecays();
-        std::tie(fTimeDistroOfDecays, fTimeDiffDistro) = JPetGeantParserTools::getTimeDistoOfDecays(fSimulatedActivity, fMinTime, fMaxTime);
+        std::tie(fTimeDistroOfDecays, fTimeDiffDistro) =
+            JPetGeantParserTools::getTimeDistoOfDecays(fSimulatedActivity, fMinTime, fMaxTime, &fRandomStream);
       }
     }
   }
@@ -263,7 +276,7 @@ void JPetGeantParser::processMCEvent(JPetGeantEventPack* evPack)
     if (fMakeHisto)
       fillHistoMCGen(mcHit);
     // create reconstructed hit and add all smearings
-    JPetHit recHit = JPetGeantParserTools::reconstructHit(mcHit, getParamBank(), timeShift, fExperimentalParametrizer);
+    JPetHit recHit = JPetGeantParserTools::reconstructHit(mcHit, *fDetectorMap, timeShift, fExperimentalParametrizer);
 
     // add criteria for possible rejection of reconstructed events (e.g. E>50 keV)
     if (JPetGeantParserTools::isHitReconstructed(recHit, fExperimentalThreshold))
@@ -346,33 +359,33 @@ void JPetGeantParser::fillHistoGenInfo(JPetGeantEventInformation* evInfo)
   bool isGen3g = evInfo->GetThreeGammaGen();
 
   // general histograms
-  getStatistics().getHisto1D("gen_lifetime")->Fill(evInfo->GetLifetime());
+  getStatistics().fill(fHGenLifetime, evInfo->GetLifetime());
 
   // histograms for prompt gamma
   if (isGenPrompt)
   {
-    getStatistics().getHisto1D("gen_hit_multiplicity")->Fill(1);
-    getStatistics().getHisto2D("gen_prompt_XY")->Fill(evInfo->GetVtxPromptPositionX(), evInfo->GetVtxPromptPositionY());
-    getStatistics().getHisto2D("gen_prompt_XZ")->Fill(evInfo->GetVtxPromptPositionX(), evInfo->GetVtxPromptPositionZ());
-    getStatistics().getHisto2D("gen_prompt_YZ")->Fill(evInfo->GetVtxPromptPositionY(), evInfo->GetVtxPromptPositionZ());
+    getStatistics().fill(fHGenHitMultiplicity, 1);
+    getStatistics().fill(fHGenPromptXY, evInfo->GetVtxPromptPositionX(), evInfo->GetVtxPromptPositionY());
+    getStatistics().fill(fHGenPromptXZ, evInfo->GetVtxPromptPositionX(), evInfo->GetVtxPromptPositionZ());
+    getStatistics().fill(fHGenPromptYZ, evInfo->GetVtxPromptPositionY(), evInfo->GetVtxPromptPositionZ());
   }
 
   // histograms for annihilation 2g 3g
   if (isGen2g)
   {
-    getStatistics().getHisto1D("gen_hit_multiplicity")->Fill(2);
+    getStatistics().fill(fHGenHitMultiplicity, 2);
   }
 
   if (isGen3g)
   {
-    getStatistics().getHisto1D("gen_hit_multiplicity")->Fill(3);
+    getStatistics().fill(fHGenHitMultiplicity, 3);
   }
 
   if (isGen2g || isGen3g)
   {
-    getStatistics().getHisto2D("gen_XY")->Fill(evInfo->GetVtxPositionX(), evInfo->GetVtxPositionY());
-    getStatistics().getHisto2D("gen_XZ")->Fill(evInfo->GetVtxPositionX(), evInfo->GetVtxPositionZ());
-    getStatistics().getHisto2D("gen_YZ")->Fill(evInfo->GetVtxPositionY(), evInfo->GetVtxPositionZ());
+    getStatistics().fill(fHGenXY, evInfo->GetVtxPositionX(), evInfo->GetVtxPositionY());
+    getStatistics().fill(fHGenXZ, evInfo->GetVtxPositionX(), evInfo->GetVtxPositionZ());
+    getStatistics().fill(fHGenYZ, evInfo->GetVtxPositionY(), evInfo->GetVtxPositionZ());
   }
 }
 
@@ -391,11 +404,8 @@ void JPetGeantParser::saveHits()
 
   if (fMakeHisto)
   {
-    getStatistics().getHisto1D("hits_per_time_window")->Fill(fStoredHits.size());
-    for (const auto i : fTimeDiffDistro)
-    {
-      getStatistics().getHisto1D("time_diff_bw_decays")->Fill(i);
-    }
+    getStatistics().fill(fHHitsPerTimeWindow, fStoredHits.size());
+    getStatistics().fill(fHTimeDiffBwDecays, fTimeDiffDistro);
   }
 
   fStoredMCHits.clear();
@@ -404,18 +414,18 @@ void JPetGeantParser::saveHits()
 
 void JPetGeantParser::fillHistoMCGen(JPetMCHit& mcHit)
 {
-  getStatistics().getHisto1D("gen_hits_z_pos")->Fill(mcHit.getPosZ());
-  getStatistics().getHisto2D("gen_hits_xy_pos")->Fill(mcHit.getPosX(), mcHit.getPosY());
-  getStatistics().getHisto1D("gen_hit_time")->Fill(mcHit.getTime());
-  getStatistics().getHisto1D("gen_hit_eneDepos")->Fill(mcHit.getEnergy());
+  getStatistics().fill(fHGenHitsZPos, mcHit.getPosZ());
+  getStatistics().fill(fHGenHitsXyPos, mcHit.getPosX(), mcHit.getPosY());
+  getStatistics().fill(fHGenHitTime, mcHit.getTime());
+  getStatistics().fill(fHGenHitEneDepos, mcHit.getEnergy());
 }
 
 void JPetGeantParser::fillHistoMCRec(JPetHit& recHit)
 {
-  getStatistics().getHisto1D("hits_z_pos")->Fill(recHit.getPosZ());
-  getStatistics().getHisto2D("hits_xy_pos")->Fill(recHit.getPosX(), recHit.getPosY());
-  getStatistics().getHisto1D("rec_hit_time")->Fill(recHit.getTime());
-  getStatistics().getHisto1D("rec_hit_eneDepos")->Fill(recHit.getEnergy());
+  getStatistics().fill(fHHitsZPos, recHit.getPosZ());
+  getStatistics().fill(fHHitsXyPos, recHit.getPosX(), recHit.getPosY());
+  getStatistics().fill(fHRecHitTime, recHit.getTime());
+  getStatistics().fill(fHRecHitEneDepos, recHit.getEnergy());
 }
 
 void JPetGeantParser::bookBasicHistograms()
@@ -461,6 +471,26 @@ void JPetGeantParser::bookBasicHistograms()
   getStatistics().createHistogram(new TH1F("rec_hit_time", "hit time", 100, 0.0, 15000.0));
 
   getStatistics().createHistogram(new TH1F("rec_hit_eneDepos", "hit ene deposition", 750, 0.0, 1500.0));
+
+  // histograms are filled through the handles, without looking them up by name for each hit
+  fHHitsPerTimeWindow = getStatistics().getHistoHandle<TH1F>("hits_per_time_window");
+  fHTimeDiffBwDecays = getStatistics().getHistoHandle<TH1F>("time_diff_bw_decays");
+  fHGenHitsZPos = getStatistics().getHistoHandle<TH1F>("gen_hits_z_pos");
+  fHGenHitTime = getStatistics().getHistoHandle<TH1F>("gen_hit_time");
+  fHGenHitEneDepos = getStatistics().getHistoHandle<TH1F>("gen_hit_eneDepos");
+  fHGenHitMultiplicity = getStatistics().getHistoHandle<TH1F>("gen_hit_multiplicity");
+  fHGenLifetime = getStatistics().getHistoHandle<TH1F>("gen_lifetime");
+  fHHitsZPos = getStatistics().getHistoHandle<TH1F>("hits_z_pos");
+  fHRecHitTime = getStatistics().getHistoHandle<TH1F>("rec_hit_time");
+  fHRecHitEneDepos = getStatistics().getHistoHandle<TH1F>("rec_hit_eneDepos");
+  fHGenHitsXyPos = getStatistics().getHistoHandle<TH2F>("gen_hits_xy_pos");
+  fHGenXY = getStatistics().getHistoHandle<TH2F>("gen_XY");
+  fHGenXZ = getStatistics().getHistoHandle<TH2F>("gen_XZ");
+  fHGenYZ = getStatistics().getHistoHandle<TH2F>("gen_YZ");
+  fHGenPromptXY = getStatistics().getHistoHandle<TH2F>("gen_prompt_XY");
+  fHGenPromptXZ = getStatistics().getHistoHandle<TH2F>("gen_prompt_XZ");
+  fHGenPromptYZ = getStatistics().getHistoHandle<TH2F>("gen_prompt_YZ");
+  fHHitsXyPos = getStatistics().getHistoHandle<TH2F>("hits_xy_pos");
 }
 
 void JPetGeantParser::bookEfficiencyHistograms()
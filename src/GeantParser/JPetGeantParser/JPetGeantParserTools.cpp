@@ -35,6 +35,41 @@ JPetMCHit JPetGeantParserTools::createJPetMCHit(JPetGeantScinHits* geantHit, con
 
 JPetHit JPetGeantParserTools::reconstructHit(JPetMCHit& mcHit, const JPetParamBank& paramBank, const float timeShift,
                                              JPetHitExperimentalParametrizer& parametrizer)
+{
+  JPetHit hit = smearHit(mcHit, timeShift, parametrizer);
+  const auto& slot = paramBank.getScintillator(mcHit.getScintillator().getID()).getBarrelSlot();
+  auto radius = slot.getLayer().getRadius();
+  auto theta = TMath::DegToRad() * slot.getTheta();
+  hit.setPosX(radius * std::cos(theta));
+  hit.setPosY(radius * std::sin(theta));
+  return hit;
+}
+
+/// Version of reconstructHit using the precomputed slot positions from the geometry mapping
+/// instead of the param bank objects, so no trigonometric functions are evaluated per hit.
+JPetHit JPetGeantParserTools::reconstructHit(JPetMCHit& mcHit, const JPetGeomMapping& mapping, const float timeShift,
+                                             JPetHitExperimentalParametrizer& parametrizer)
+{
+  JPetHit hit = smearHit(mcHit, timeShift, parametrizer);
+  auto scinID = mcHit.getScintillator().getID();
+  auto geometry = mapping.getScinGeometry(scinID);
+  if (geometry)
+  {
+    hit.setPosX(geometry->x);
+    hit.setPosY(geometry->y);
+  }
+  else
+  {
+    ERROR("No geometry found for scintillator with ID: " + std::to_string(scinID));
+    hit.setPosX(0.);
+    hit.setPosY(0.);
+  }
+  return hit;
+}
+
+/// Copy of the MC hit with the energy, time (shifted to the time window) and z position smeared,
+/// common part of both versions of reconstructHit, which set the x and y positions.
+JPetHit JPetGeantParserTools::smearHit(JPetMCHit& mcHit, const float timeShift, JPetHitExperimentalParametrizer& parametrizer)
 {
   JPetHit hit = dynamic_cast<JPetHit&>(mcHit);
   /// Nonsmeared values
@@ -46,12 +81,7 @@ JPetHit JPetGeantParserTools::reconstructHit(JPetMCHit& mcHit, const JPetParamBa
   hit.setEnergy(parametrizer.addEnergySmearing(scinID, posZ, energy, time));
   // adjust to time window and smear
   hit.setTime(parametrizer.addTimeSmearing(scinID, posZ, energy, time));
-  auto radius = paramBank.getScintillator(scinID).getBarrelSlot().getLayer().getRadius();
-  auto theta = TMath::DegToRad() * paramBank.getScintillator(mcHit.getScintillator().getID()).getBarrelSlot().getTheta();
-  hit.setPosX(radius * std::cos(theta));
-  hit.setPosY(radius * std::sin(theta));
   hit.setPosZ(parametrizer.addZHitSmearing(scinID, posZ, energy, time));
-
   return hit;
 }
 
@@ -82,22 +112,22 @@ void JPetGeantParserTools::identifyRecoHits(JPetGeantScinHits* geantHit, const J
   }
 }
 
-float JPetGeantParserTools::estimateNextDecayTimeExp(float activityMBq) { return gRandom->Exp((pow(10, 6) / activityMBq)); }
+float JPetGeantParserTools::estimateNextDecayTimeExp(float activityMBq, TRandom* random) { return random->Exp((pow(10, 6) / activityMBq)); }
 
 std::tuple<std::vector<float>, std::vector<float>> JPetGeantParserTools::getTimeDistoOfDecays(float activityMBq, float timeWindowMin,
-                                                                                              float timeWindowMax)
+                                                                                              float timeWindowMax, TRandom* random)
 {
   std::vector<float> fTimeDistroOfDecays;
   std::vector<float> fTimeDiffOfDecays;
 
-  float timeShift = estimateNextDecayTimeExp(activityMBq);
+  float timeShift = estimateNextDecayTimeExp(activityMBq, random);
   float nextTime = timeWindowMin + timeShift;
 
   while (nextTime < timeWindowMax)
   {
     fTimeDistroOfDecays.push_back(nextTime);
     fTimeDiffOfDecays.push_back(timeShift);
-    timeShift = estimateNextDecayTimeExp(activityMBq);
+    timeShift = estimateNextDecayTimeExp(activityMBq, random);
     nextTime = nextTime + timeShift;
   }
   return std::make_tuple(fTimeDistroOfDecays, fTimeDiffOfDecays);
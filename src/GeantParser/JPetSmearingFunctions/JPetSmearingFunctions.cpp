@@ -16,11 +16,40 @@
 #include "JPetLoggerInclude.h"
 #include <JPetSmearingFunctions/JPetSmearingFunctions.h>
 
+#include <Math/ProbFuncMathCore.h>
+#include <Math/QuantFuncMathCore.h>
+#include <RVersion.h>
 #include <TMath.h>
+#include <TRandom.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 using SmearingType = JPetHitExperimentalParametrizer::SmearingType;
 using SmearingFunctionLimits = JPetHitExperimentalParametrizer::SmearingFunctionLimits;
 
+const JPetHitExperimentalParametrizer::ParameterBinning JPetHitExperimentalParametrizer::kDefaultParameterBinning = {{1., 2., 10., 0.}};
+const int JPetHitExperimentalParametrizer::kCDFPoints = 400;
+const int JPetHitExperimentalParametrizer::kInverseCDFPoints = 256;
+const std::size_t JPetHitExperimentalParametrizer::kMaxInverseCDFTables = 10000;
+
+namespace
+{
+/// Index of the default parameter which is smeared by the given function, the sampling range is shifted by its value.
+int getSmearedParameterIndex(SmearingType type)
+{
+  switch (type)
+  {
+  case SmearingType::kTime:
+    return 3;
+  case SmearingType::kEnergy:
+    return 2;
+  default:
+    return 1;
+  }
+}
+} // namespace
+
 JPetHitExperimentalParametrizer::JPetHitExperimentalParametrizer()
 {
 
@@ -97,12 +126,15 @@ void JPetHitExperimentalParametrizer::setSmearingFunctions(const std::vector<Fun
   auto energyFuncAndParams = params[1];
   auto zPositionFuncAndParams = params[2];
 
+  clearInverseCDFTables();
+
   auto timeFunc = timeFuncAndParams.first;
   auto timeParams = timeFuncAndParams.second;
   int nCustomParams = timeParams.size();
   int nTotalParams = nCustomParams + nDefaultParams;
   if (!timeFunc.empty())
   {
+    fIsDefaultFunction[kTime] = false;
     fSmearingFunctions[kTime] = std::make_unique<TF1>("funTimeHitSmearing", timeFunc.c_str(), -200., 200., nTotalParams);
   }
   for (int i = 0; i < nCustomParams; i++)
@@ -116,6 +148,7 @@ void JPetHitExperimentalParametrizer::setSmearingFunctions(const std::vector<Fun
   nTotalParams = nCustomParams + nDefaultParams;
   if (!energyFunc.empty())
   {
+    fIsDefaultFunction[kEnergy] = false;
     fSmearingFunctions[kEnergy] = std::make_unique<TF1>("funEnergySmearing", energyFunc.c_str(), -200., 200., nTotalParams);
   }
   for (int i = 0; i < nCustomParams; i++)
@@ -129,6 +162,7 @@ void JPetHitExperimentalParametrizer::setSmearingFunctions(const std::vector<Fun
   nTotalParams = nCustomParams + nDefaultParams;
   if (!zPositionFunc.empty())
   {
+    fIsDefaultFunction[kZPosition] = false;
     fSmearingFunctions[kZPosition] = std::make_unique<TF1>("funzHitSmearing", zPositionFunc.c_str(), -200., 200., nTotalParams);
   }
   for (int i = 0; i < nCustomParams; i++)
@@ -145,6 +179,7 @@ void JPetHitExperimentalParametrizer::setSmearingFunctionLimits(const std::vecto
   auto timeLim = limits[0];
   auto energyLim = limits[1];
   auto zPositionLim = limits[2];
+  clearInverseCDFTables();
   if (timeLim.first < timeLim.second)
   {
     fFunctionLimits[kTime] = timeLim;
@@ -217,36 +252,252 @@ std::map<SmearingType, SmearingFunctionLimits> JPetHitExperimentalParametrizer::
 /// function is randomize in the range [lowLim + timeIn, highLim + timeIn]
 double JPetHitExperimentalParametrizer::addTimeSmearing(int scinID, double zIn, double eneIn, double timeIn)
 {
-  /// We cannot use setParameters(...) cause if there are more then 4 parameters
-  /// It would set it all to 0.
-  fSmearingFunctions[kTime]->SetParameter(0, double(scinID));
-  fSmearingFunctions[kTime]->SetParameter(1, zIn);
-  fSmearingFunctions[kTime]->SetParameter(2, eneIn);
-  fSmearingFunctions[kTime]->SetParameter(3, timeIn);
-  fSmearingFunctions[kTime]->SetRange(timeIn + fFunctionLimits[kTime].first, timeIn + fFunctionLimits[kTime].second);
-  return fSmearingFunctions[kTime]->GetRandom();
+  return sample(kTime, scinID, zIn, eneIn, timeIn);
 }
 
 /// function is randomize in the range [lowLim + eneIn, highLim + eneIn]
 double JPetHitExperimentalParametrizer::addEnergySmearing(int scinID, double zIn, double eneIn, double timeIn)
 {
-  fSmearingFunctions[kEnergy]->SetParameter(0, double(scinID));
-  fSmearingFunctions[kEnergy]->SetParameter(1, zIn);
-  fSmearingFunctions[kEnergy]->SetParameter(2, eneIn);
-  fSmearingFunctions[kEnergy]->SetParameter(3, timeIn);
-  fSmearingFunctions[kEnergy]->SetRange(eneIn + fFunctionLimits[kEnergy].first, eneIn + fFunctionLimits[kEnergy].second);
-  return fSmearingFunctions[kEnergy]->GetRandom();
+  return sample(kEnergy, scinID, zIn, eneIn, timeIn);
 }
 
 /// function is randomize in the range [lowLim + zIn, highLim + zIn]
 double JPetHitExperimentalParametrizer::addZHitSmearing(int scinID, double zIn, double eneIn, double timeIn)
 {
+  return sample(kZPosition, scinID, zIn, eneIn, timeIn);
+}
+
+void JPetHitExperimentalParametrizer::setRandomGenerator(TRandom* random) { fRandom = random; }
+
+TRandom* JPetHitExperimentalParametrizer::getRandomGenerator() const { return fRandom ? fRandom : gRandom; }
+
+void JPetHitExperimentalParametrizer::setFastSampling(bool fastSampling) { fFastSampling = fastSampling; }
+
+bool JPetHitExperimentalParametrizer::isFastSampling() const { return fFastSampling; }
+
+void JPetHitExperimentalParametrizer::setParameterBinning(SmearingType type, const ParameterBinning& binning)
+{
+  fParameterBinning[type] = binning;
+  fInverseCDFTables[type].clear();
+}
+
+JPetHitExperimentalParametrizer::ParameterBinning JPetHitExperimentalParametrizer::getParameterBinning(SmearingType type) const
+{
+  return fParameterBinning.at(type);
+}
+
+std::size_t JPetHitExperimentalParametrizer::BinKeyHash::operator()(const BinKey& key) const
+{
+  std::size_t hash = 0;
+  for (auto value : key)
+  {
+    hash = hash * 1000003u ^ std::hash<long long>()(value);
+  }
+  return hash;
+}
+
+/**
+ * @brief Table of the bin, which becomes the most recently used one, or nullptr if it is not cached.
+ */
+const std::vector<double>* JPetHitExperimentalParametrizer::InverseCDFCache::find(const BinKey& key)
+{
+  auto entry = fIndex.find(key);
+  if (entry == fIndex.end())
+  {
+    return nullptr;
+  }
+  fTables.splice(fTables.begin(), fTables, entry->second);
+  return &entry->second->second;
+}
+
+/**
+ * @brief Adds the table of the bin, replacing the least recently used one if the cache is full.
+ */
+const std::vector<double>& JPetHitExperimentalParametrizer::InverseCDFCache::insert(const BinKey& key, std::vector<double>&& table)
+{
+  if (fIndex.size() >= kMaxInverseCDFTables)
+  {
+    fIndex.erase(fTables.back().first);
+    fTables.splice(fTables.begin(), fTables, std::prev(fTables.end()));
+    fTables.front().first = key;
+    fTables.front().second = std::move(table);
+  }
+  else
+  {
+    fTables.emplace_front(key, std::move(table));
+  }
+  fIndex[key] = fTables.begin();
+  return fTables.front().second;
+}
+
+void JPetHitExperimentalParametrizer::InverseCDFCache::clear()
+{
+  fIndex.clear();
+  fTables.clear();
+}
+
+double JPetHitExperimentalParametrizer::sample(SmearingType type, int scinID, double zIn, double eneIn, double timeIn)
+{
+  if (!fFastSampling)
+  {
+    return sampleWithTF1(type, scinID, zIn, eneIn, timeIn);
+  }
+  if (fIsDefaultFunction[type])
+  {
+    double sigma = getGaussianSigma(type, eneIn);
+    if (!(sigma > 0.) || !std::isfinite(sigma))
+    {
+      /// e.g. non-positive energy, the behaviour of the function itself is preserved.
+      return sampleWithTF1(type, scinID, zIn, eneIn, timeIn);
+    }
+    std::array<double, 4> params = {{double(scinID), zIn, eneIn, timeIn}};
+    double mean = params[getSmearedParameterIndex(type)];
+    const auto& limits = fFunctionLimits[type];
+    return sampleTruncatedGaussian(mean, sigma, mean + limits.first, mean + limits.second);
+  }
+  return sampleFromInverseCDF(type, scinID, zIn, eneIn, timeIn);
+}
+
+double JPetHitExperimentalParametrizer::sampleWithTF1(SmearingType type, int scinID, double zIn, double eneIn, double timeIn)
+{
+  auto& function = fSmearingFunctions[type];
+  std::array<double, 4> params = {{double(scinID), zIn, eneIn, timeIn}};
   /// We cannot use setParameters(...) cause if there are more then 4 parameters
   /// It would set it all to 0.
-  fSmearingFunctions[kZPosition]->SetParameter(0, double(scinID));
-  fSmearingFunctions[kZPosition]->SetParameter(1, zIn);
-  fSmearingFunctions[kZPosition]->SetParameter(2, eneIn);
-  fSmearingFunctions[kZPosition]->SetParameter(3, timeIn);
-  fSmearingFunctions[kZPosition]->SetRange(zIn + fFunctionLimits[kZPosition].first, zIn + fFunctionLimits[kZPosition].second);
-  return fSmearingFunctions[kZPosition]->GetRandom();
+  for (int i = 0; i < 4; i++)
+  {
+    function->SetParameter(i, params[i]);
+  }
+  double mean = params[getSmearedParameterIndex(type)];
+  function->SetRange(mean + fFunctionLimits[type].first, mean + fFunctionLimits[type].second);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 24, 0)
+  return function->GetRandom(getRandomGenerator());
+#else
+  /// older versions of TF1 can use only gRandom
+  return function->GetRandom();
+#endif
+}
+
+/// Sigma of the default gaussian parametrization, the formulas must be the same as in the constructor.
+double JPetHitExperimentalParametrizer::getGaussianSigma(SmearingType type, double eneIn) const
+{
+  const auto& function = fSmearingFunctions.at(type);
+  switch (type)
+  {
+  case kTime:
+  {
+    double sigma = function->GetParameter(4);
+    double energyTreshold = function->GetParameter(5);
+    double referenceEnergy = function->GetParameter(6);
+    if (eneIn < energyTreshold)
+    {
+      sigma = sigma / sqrt(eneIn / referenceEnergy);
+    }
+    return sigma;
+  }
+  case kEnergy:
+    return eneIn * 0.044 / sqrt(eneIn / 1000.);
+  default:
+    return function->GetParameter(4);
+  }
+}
+
+/// If the range covers at least +-3 sigma, the values are generated until one falls into the range,
+/// otherwise the inverse of the normal cumulative distribution restricted to the range is used.
+double JPetHitExperimentalParametrizer::sampleTruncatedGaussian(double mean, double sigma, double low, double high) const
+{
+  const double kRejectionLimit = 3.;
+  if (low <= mean - kRejectionLimit * sigma && high >= mean + kRejectionLimit * sigma)
+  {
+    while (true)
+    {
+      double value = getRandomGenerator()->Gaus(mean, sigma);
+      if (value >= low && value <= high)
+      {
+        return value;
+      }
+    }
+  }
+  double cdfLow = ROOT::Math::normal_cdf(low, sigma, mean);
+  double cdfHigh = ROOT::Math::normal_cdf(high, sigma, mean);
+  double value = mean + ROOT::Math::normal_quantile(cdfLow + getRandomGenerator()->Rndm() * (cdfHigh - cdfLow), sigma);
+  return std::min(std::max(value, low), high);
 }
+
+/// The tables are stored relative to the smeared value, which is added back to the result.
+double JPetHitExperimentalParametrizer::sampleFromInverseCDF(SmearingType type, int scinID, double zIn, double eneIn, double timeIn)
+{
+  std::array<double, 4> params = {{double(scinID), zIn, eneIn, timeIn}};
+  const auto& binning = fParameterBinning[type];
+  BinKey key;
+  std::array<double, 4> binCenters;
+  for (int i = 0; i < 4; i++)
+  {
+    key[i] = binning[i] > 0. ? std::llround(params[i] / binning[i]) : 0;
+    binCenters[i] = key[i] * binning[i];
+  }
+  auto& tables = fInverseCDFTables[type];
+  auto table = tables.find(key);
+  if (!table)
+  {
+    table = &tables.insert(key, buildInverseCDF(type, binCenters));
+  }
+  const auto& inverseCDF = *table;
+  if (inverseCDF.empty())
+  {
+    /// the function could not be normalized in the range
+    return sampleWithTF1(type, scinID, zIn, eneIn, timeIn);
+  }
+  double position = getRandomGenerator()->Rndm() * kInverseCDFPoints;
+  int index = std::min(static_cast<int>(position), kInverseCDFPoints - 1);
+  double fraction = position - index;
+  double relativeValue = inverseCDF[index] + fraction * (inverseCDF[index + 1] - inverseCDF[index]);
+  return params[getSmearedParameterIndex(type)] + relativeValue;
+}
+
+/**
+ * @brief Builds the inverse cumulative distribution of the smearing function in the limits relative to the smeared value.
+ * @return kInverseCDFPoints + 1 values for the equally spaced probabilities from 0 to 1,
+ * or empty vector if the function has no positive integral in the range.
+ */
+std::vector<double> JPetHitExperimentalParametrizer::buildInverseCDF(SmearingType type, const std::array<double, 4>& params) const
+{
+  auto& function = fSmearingFunctions.at(type);
+  for (int i = 0; i < 4; i++)
+  {
+    function->SetParameter(i, params[i]);
+  }
+  const auto& limits = fFunctionLimits.at(type);
+  double mean = params[getSmearedParameterIndex(type)];
+  double step = (limits.second - limits.first) / kCDFPoints;
+  std::vector<double> cdf(kCDFPoints + 1, 0.);
+  for (int i = 1; i <= kCDFPoints; i++)
+  {
+    double value = function->Eval(mean + limits.first + (i - 0.5) * step);
+    cdf[i] = cdf[i - 1] + (std::isfinite(value) && value > 0. ? value : 0.);
+  }
+  double total = cdf[kCDFPoints];
+  if (!(total > 0.) || !std::isfinite(total))
+  {
+    ERROR(std::string("Smearing function ") + function->GetName() + " cannot be normalized in the given limits");
+    return {};
+  }
+  std::vector<double> inverseCDF(kInverseCDFPoints + 1);
+  int bin = 1;
+  for (int k = 0; k <= kInverseCDFPoints; k++)
+  {
+    double probability = total * k / kInverseCDFPoints;
+    /// empty bins are skipped, so the values are always taken from the support of the function
+    while (bin < kCDFPoints && (cdf[bin] < probability || cdf[bin] <= cdf[bin - 1]))
+    {
+      bin++;
+    }
+    double binContent = cdf[bin] - cdf[bin - 1];
+    double fraction = binContent > 0. ? (probability - cdf[bin - 1]) / binContent : 0.;
+    fraction = std::min(std::max(fraction, 0.), 1.);
+    inverseCDF[k] = limits.first + (bin - 1 + fraction) * step;
+  }
+  return inverseCDF;
+}
+
+void JPetHitExperimentalParametrizer::clearInverseCDFTables() { fInverseCDFTables.clear(); }
@@ -40,6 +40,7 @@
 #pragma link C++ function JPetWriter::Write(vector <JPetTimeWindow>&);
 
 #pragma link C++ class JPetParamBank + ;
+#pragma link C++ class JPetParamRef - ;
 #pragma link C++ class JPetFEB + ;
 #pragma link C++ class JPetScin + ;
 #pragma link C++ class JPetRecoSignal + ;
@@ -60,6 +61,7 @@
 #pragma link C++ class JPetTOMBChannel + ;
 #pragma link C++ class JPetEvent + ;
 #pragma link C++ class JPetLOR + ;
+#pragma link C++ class JPetIndexedLOR + ;
 #pragma link C++ class JPetGeantEventPack + ;
 #pragma link C++ class JPetMCDecayTree + ;
 #pragma link C++ class JPetTimeWindow + ;
@@ -73,6 +75,15 @@
 #pragma link C++ class JPetLayer + ;
 #pragma link C++ class JPetGeantEventInformation + ;
 #pragma link C++ class JPetMCHit + ;
+#pragma link C++ class JPetSlimHit + ;
+#pragma link C++ class JPetSlimHitWindow + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetSigCh> + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetRawSignal> + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetRecoSignal> + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetPhysSignal> + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetHit> + ;
+#pragma link C++ class JPetTypedTimeWindow<JPetEvent> + ;
+#pragma link C++ class std::vector<JPetPhysSignal> + ;
 
 #pragma link C++ enum JPetBaseSignal::RecoFlag;
 #pragma link C++ enum JPetSigCh::RecoFlag;
@@ -82,4 +93,22 @@
 #pragma link C++ struct JPetScin::ScinDimensions + ;
 #pragma link C++ struct JPetTreeHeader::ProcessingStageInfo + ;
 
+#pragma read sourceClass = "JPetRawSignal" targetClass = "JPetRawSignal" version = "[1-]" \
+  source = "std::vector<JPetSigCh> fLeadingPoints; std::vector<JPetSigCh> fTrailingPoints" target = "fLeadingIndex, fTrailingIndex" \
+  code = "{ fLeadingIndex.build(onfile.fLeadingPoints); fTrailingIndex.build(onfile.fTrailingPoints); }"
+
+// The references to the parametric objects were written as plain TRefs before JPetParamRef
+#pragma read sourceClass = "JPetSigCh" targetClass = "JPetSigCh" version = "[-10]" \
+  source = "TRef fPM; TRef fFEB; TRef fTRB; TRef fTOMBChannel" target = "fPM, fFEB, fTRB, fTOMBChannel" \
+  code = "{ fPM = onfile.fPM; fFEB = onfile.fFEB; fTRB = onfile.fTRB; fTOMBChannel = onfile.fTOMBChannel; }"
+#pragma read sourceClass = "JPetBaseSignal" targetClass = "JPetBaseSignal" version = "[-6]" \
+  source = "TRef fPM; TRef fBarrelSlot" target = "fPM, fBarrelSlot" \
+  code = "{ fPM = onfile.fPM; fBarrelSlot = onfile.fBarrelSlot; }"
+#pragma read sourceClass = "JPetBaseHit" targetClass = "JPetBaseHit" version = "[-2]" \
+  source = "TRef fScin" target = "fScin" \
+  code = "{ fScin = onfile.fScin; }"
+#pragma read sourceClass = "JPetHit" targetClass = "JPetHit" version = "[-9]" \
+  source = "TRef fBarrelSlot; TRef fScintillator" target = "fBarrelSlot, fScintillator" \
+  code = "{ fBarrelSlot = onfile.fBarrelSlot; fScintillator = onfile.fScintillator; }"
+
 #endif
@@ -76,6 +76,7 @@ std::map<std::string, std::vector<bool (*)(std::pair<std::string, boost::any>)>>
   validationMap["detectorType_std::string"].push_back(&isDetectorValid);
   validationMap["localDB_std::string"].push_back(&isLocalDBValid);
   validationMap["outputPath_std::string"].push_back(&isOutputDirectoryValid);
+  validationMap["maxThreads_int"].push_back(&isMaxThreadsValid);
   return validationMap;
 }
 
@@ -215,6 +216,16 @@ bool JPetOptionValidator::isOutputDirectoryValid(std::pair<std::string, boost::a
   return true;
 }
 
+bool JPetOptionValidator::isMaxThreadsValid(std::pair<std::string, boost::any> option)
+{
+  if (any_cast<int>(option.second) < 1)
+  {
+    ERROR("Maximal number of threads must be a positive number.");
+    return false;
+  }
+  return true;
+}
+
 JPetOptionValidator::ManyOptionsWrapper::ManyOptionsWrapper(std::initializer_list<boost::any> options) { optionsVector = options; }
 
 std::vector<boost::any> JPetOptionValidator::ManyOptionsWrapper::getOptionsVector() { return optionsVector; }
@@ -31,6 +31,7 @@ std::map<std::string, boost::any> kDefaultOptions = {{"inputFile_std::string", s
                                                      {"lastEvent_int", -1},
                                                      {"progressBar_bool", false},
                                                      {"directProcessing_bool", false},
+                                                     {"pipelinedProcessing_bool", false},
                                                      {"runID_int", -1},
                                                      {"detectorType_std::string", std::string("barrel")},
                                                      {"unpackerConfigFile_std::string", std::string("conf_trb3.xml")},
@@ -44,6 +45,10 @@ std::map<std::string, std::string> kOptCmdLineNameToExtendedName = {{"type", "ty
                                                                     {"unpackerCalibFile", "unpackerCalibFile_std::string"},
                                                                     {"runID", "runID_int"},
                                                                     {"directProcessing", "directProcessing_bool"},
+                                                                    {"pipelinedProcessing", "pipelinedProcessing_bool"},
+                                                                    {"maxThreads", "maxThreads_int"},
+                                                                    {"largestFileFirst", "largestFileFirst_bool"},
+                                                                    {"integerParamRefs", "integerParamRefs_bool"},
                                                                     {"detector", "detectorType_std::string"},
                                                                     {"progressBar", "progressBar_bool"},
                                                                     {"localDB", "localDB_std::string"},
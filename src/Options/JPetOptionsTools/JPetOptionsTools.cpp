@@ -217,6 +217,46 @@ bool isDirectProcessing(const std::map<std::string, boost::any>& opts)
   return false;
 }
 
+bool isPipelinedProcessing(const std::map<std::string, boost::any>& opts)
+{
+  if (opts.find("pipelinedProcessing_bool") != opts.end())
+  {
+    return any_cast<bool>(opts.at("pipelinedProcessing_bool"));
+  }
+  return false;
+}
+
+bool isIntegerParamRefs(const std::map<std::string, boost::any>& opts)
+{
+  if (opts.find("integerParamRefs_bool") != opts.end())
+  {
+    return any_cast<bool>(opts.at("integerParamRefs_bool"));
+  }
+  return false;
+}
+
+bool isLargestFileFirst(const std::map<std::string, boost::any>& opts)
+{
+  if (opts.find("largestFileFirst_bool") != opts.end())
+  {
+    return any_cast<bool>(opts.at("largestFileFirst_bool"));
+  }
+  return false;
+}
+
+/**
+ * Returns the maximal number of threads used to process the input files
+ * or -1 if the limit is not set.
+ */
+int getMaxThreads(const std::map<std::string, boost::any>& opts)
+{
+  if (opts.find("maxThreads_int") != opts.end())
+  {
+    return any_cast<int>(opts.at("maxThreads_int"));
+  }
+  return -1;
+}
+
 bool isLocalDB(const std::map<std::string, boost::any>& opts) { return (bool)opts.count("localDB_std::string"); }
 
 std::string getLocalDB(const std::map<std::string, boost::any>& opts)
@@ -17,28 +17,62 @@
 
 ClassImp(JPetParamBank);
 
+const int JPetParamBank::kMaxDenseIndex = 1 << 16;
+
 JPetParamBank::JPetParamBank() : fDummy(false) {}
 
 JPetParamBank::JPetParamBank(const bool d) : fDummy(d) {}
 
-JPetParamBank::JPetParamBank(const JPetParamBank& paramBank) : fDummy(false)
+/**
+ * Copy constructor. The parameter objects are not copied, the new bank
+ * shares them (and the storage owning them) with the original one,
+ * so they must not be modified through the copy, see the class description.
+ */
+JPetParamBank::JPetParamBank(const JPetParamBank& paramBank)
+    : fDummy(false), fTOMBChannels(paramBank.fTOMBChannels), fDataSources(paramBank.fDataSources),
+      fDataModules(paramBank.fDataModules), fBarrelSlots(paramBank.fBarrelSlots), fScintillators(paramBank.fScintillators),
+      fLayers(paramBank.fLayers), fFrames(paramBank.fFrames), fFEBs(paramBank.fFEBs), fTRBs(paramBank.fTRBs), fPMs(paramBank.fPMs),
+      fStorage(paramBank.fStorage), fTOMBChannelsIndex(paramBank.fTOMBChannelsIndex), fDataSourcesIndex(paramBank.fDataSourcesIndex),
+      fDataModulesIndex(paramBank.fDataModulesIndex), fBarrelSlotsIndex(paramBank.fBarrelSlotsIndex),
+      fScintillatorsIndex(paramBank.fScintillatorsIndex), fLayersIndex(paramBank.fLayersIndex), fFramesIndex(paramBank.fFramesIndex),
+      fFEBsIndex(paramBank.fFEBsIndex), fTRBsIndex(paramBank.fTRBsIndex), fPMsIndex(paramBank.fPMsIndex)
 {
-  copyMapValues(fScintillators, paramBank.fScintillators);
-  copyMapValues(fPMs, paramBank.fPMs);
-  copyMapValues(fFEBs, paramBank.fFEBs);
-  copyMapValues(fTRBs, paramBank.fTRBs);
-  copyMapValues(fBarrelSlots, paramBank.fBarrelSlots);
-  copyMapValues(fLayers, paramBank.fLayers);
-  copyMapValues(fFrames, paramBank.fFrames);
-  copyMapValues(fTOMBChannels, paramBank.fTOMBChannels);
-  copyMapValues(fDataSources, paramBank.fDataSources);
-  copyMapValues(fDataModules, paramBank.fDataModules);
 }
 
 JPetParamBank::~JPetParamBank() {}
 
 bool JPetParamBank::isDummy() const { return fDummy; }
 
+JPetParamBank::Storage& JPetParamBank::getStorage()
+{
+  if (!fStorage) {
+    fStorage = std::make_shared<Storage>();
+  }
+  return *fStorage;
+}
+
+/**
+ * Rebuilds the dense ID -> object tables from the maps. Must be called
+ * if the maps were filled directly, e.g. when the bank was read from a ROOT file.
+ */
+void JPetParamBank::rebuildIndex()
+{
+  rebuildIndex(fScintillatorsIndex, fScintillators);
+  rebuildIndex(fPMsIndex, fPMs);
+  rebuildIndex(fFEBsIndex, fFEBs);
+  rebuildIndex(fTRBsIndex, fTRBs);
+  rebuildIndex(fBarrelSlotsIndex, fBarrelSlots);
+  rebuildIndex(fLayersIndex, fLayers);
+  rebuildIndex(fFramesIndex, fFrames);
+  rebuildIndex(fTOMBChannelsIndex, fTOMBChannels);
+  rebuildIndex(fDataSourcesIndex, fDataSources);
+  rebuildIndex(fDataModulesIndex, fDataModules);
+}
+
+/**
+ * Removes all the objects from the bank. The objects added to the bank are
+ * destroyed when no other copy of the bank shares them.
+ */
 void JPetParamBank::clear()
 {
   fScintillators.clear();
@@ -51,6 +85,8 @@ void JPetParamBank::clear()
   fTOMBChannels.clear();
   fDataSources.clear();
   fDataModules.clear();
+  fStorage.reset();
+  rebuildIndex();
 }
 
 int JPetParamBank::getSize(ParamObjectType type) const
@@ -0,0 +1,49 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamRef.cpp
+ */
+
+#include "JPetParamBank/JPetParamRef.h"
+#include <TBuffer.h>
+
+ClassImp(JPetParamRef);
+
+/**
+ * @brief Custom streamer, see the class description. The unique ID of a set TRef
+ * is the one of the referenced object, which is never 0.
+ */
+void JPetParamRef::Streamer(TBuffer& buffer)
+{
+  if (buffer.IsReading())
+  {
+    UChar_t isWritten = 0;
+    buffer >> isWritten;
+    if (isWritten)
+    {
+      TRef::Streamer(buffer);
+    }
+    else
+    {
+      TRef::operator=(nullptr);
+    }
+  }
+  else
+  {
+    UChar_t isWritten = isSet() ? 1 : 0;
+    buffer << isWritten;
+    if (isWritten)
+    {
+      TRef::Streamer(buffer);
+    }
+  }
+}
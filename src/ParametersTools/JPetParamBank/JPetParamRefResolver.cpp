@@ -0,0 +1,83 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamRefResolver.cpp
+ */
+
+#include "JPetParamBank/JPetParamRefResolver.h"
+
+#include <atomic>
+
+const int JPetParamRefResolver::kNoID = -1;
+
+namespace
+{
+std::atomic<int> gRefMode(JPetParamRefResolver::kTRef);
+thread_local const JPetParamBank* tBoundBank = nullptr;
+
+/**
+ * Uses the TRef if it points to an object and falls back to the ID looked up in the bound bank.
+ */
+template <typename T, typename Finder>
+const T* resolve(int id, const TRef& ref, Finder find)
+{
+  auto referenced = ref.GetObject();
+  if (referenced)
+  {
+    return static_cast<const T*>(referenced);
+  }
+  if (id != JPetParamRefResolver::kNoID && tBoundBank)
+  {
+    return (tBoundBank->*find)(id);
+  }
+  return nullptr;
+}
+} // namespace
+
+/**
+ * Sets the process-wide mode used by the setters of the references in the data objects.
+ */
+void JPetParamRefResolver::setRefMode(RefMode mode) { gRefMode = mode; }
+
+JPetParamRefResolver::RefMode JPetParamRefResolver::getRefMode() { return static_cast<RefMode>(gRefMode.load()); }
+
+bool JPetParamRefResolver::isTRefMode() { return gRefMode.load(std::memory_order_relaxed) == kTRef; }
+
+/**
+ * Binds the bank used to resolve the IDs in the current thread, nullptr removes the binding.
+ * The bank must outlive the binding.
+ */
+void JPetParamRefResolver::bind(const JPetParamBank* bank) { tBoundBank = bank; }
+
+const JPetParamBank* JPetParamRefResolver::getBoundBank() { return tBoundBank; }
+
+JPetParamRefResolver::Binding::Binding(const JPetParamBank* bank) : fPrevious(tBoundBank) { tBoundBank = bank; }
+
+JPetParamRefResolver::Binding::~Binding() { tBoundBank = fPrevious; }
+
+const JPetPM* JPetParamRefResolver::resolvePM(int id, const TRef& ref) { return resolve<JPetPM>(id, ref, &JPetParamBank::findPM); }
+
+const JPetFEB* JPetParamRefResolver::resolveFEB(int id, const TRef& ref) { return resolve<JPetFEB>(id, ref, &JPetParamBank::findFEB); }
+
+const JPetTRB* JPetParamRefResolver::resolveTRB(int id, const TRef& ref) { return resolve<JPetTRB>(id, ref, &JPetParamBank::findTRB); }
+
+const JPetTOMBChannel* JPetParamRefResolver::resolveTOMBChannel(int channel, const TRef& ref)
+{
+  return resolve<JPetTOMBChannel>(channel, ref, &JPetParamBank::findTOMBChannel);
+}
+
+const JPetBarrelSlot* JPetParamRefResolver::resolveBarrelSlot(int id, const TRef& ref)
+{
+  return resolve<JPetBarrelSlot>(id, ref, &JPetParamBank::findBarrelSlot);
+}
+
+const JPetScin* JPetParamRefResolver::resolveScin(int id, const TRef& ref) { return resolve<JPetScin>(id, ref, &JPetParamBank::findScintillator); }
@@ -0,0 +1,162 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamAsciiCache.cpp
+ */
+
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
+#include "JPetParamGetterAscii/JPetParamAsciiConstants.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+JPetParamAsciiCache& JPetParamAsciiCache::getInstance()
+{
+  static JPetParamAsciiCache instance;
+  return instance;
+}
+
+/**
+ * Returns the descriptions of the parameter objects from the given run,
+ * or nullptr if the file or the run does not exist. The file is parsed only
+ * if it was not parsed before or if it has been modified since then.
+ */
+std::shared_ptr<const JPetParamAsciiRun> JPetParamAsciiCache::getRun(const std::string& filename, const int runID)
+{
+  boost::system::error_code ec;
+  auto modificationTime = boost::filesystem::last_write_time(filename, ec);
+  if (ec)
+  {
+    return nullptr;
+  }
+  auto size = boost::filesystem::file_size(filename, ec);
+  if (ec)
+  {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto it = fFiles.find(filename);
+  if (it == fFiles.end() || it->second.fModificationTime != modificationTime || it->second.fSize != size)
+  {
+    auto parsed = parseFile(filename);
+    parsed.fModificationTime = modificationTime;
+    parsed.fSize = size;
+    fNumberOfParsings++;
+    it = fFiles.insert(std::make_pair(filename, ParsedFile())).first;
+    it->second = std::move(parsed);
+  }
+  auto run = it->second.fRuns.find(runID);
+  if (run == it->second.fRuns.end())
+  {
+    return nullptr;
+  }
+  return run->second;
+}
+
+/**
+ * Removes the given file from the cache, e.g. after it was overwritten.
+ */
+void JPetParamAsciiCache::invalidate(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fFiles.erase(filename);
+}
+
+void JPetParamAsciiCache::clear()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fFiles.clear();
+}
+
+/**
+ * Returns how many times the json files were parsed since the start of the process.
+ */
+std::size_t JPetParamAsciiCache::getNumberOfParsings() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNumberOfParsings;
+}
+
+JPetParamAsciiCache::ParsedFile JPetParamAsciiCache::parseFile(const std::string& filename) const
+{
+  ParsedFile result;
+  boost::property_tree::ptree dataFromFile;
+  boost::property_tree::read_json(filename, dataFromFile);
+  for (const auto& runRaw : dataFromFile)
+  {
+    int runID = 0;
+    try
+    {
+      runID = boost::lexical_cast<int>(runRaw.first);
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+      WARNING(std::string("Skipping the entry which is not a run number:") + runRaw.first);
+      continue;
+    }
+    auto run = parseRun(runRaw.second);
+    result.fRuns.insert(std::make_pair(runID, run));
+  }
+  return result;
+}
+
+/**
+ * Indexes the content of a single run (in the json DB format) by the object type and ID.
+ */
+std::shared_ptr<JPetParamAsciiRun> JPetParamAsciiCache::parseRun(const boost::property_tree::ptree& runContents)
+{
+  auto run = std::make_shared<JPetParamAsciiRun>();
+  for (const auto& typeAndName : objectsNames)
+  {
+    auto possibleInfos = runContents.get_child_optional(typeAndName.second);
+    if (!possibleInfos)
+    {
+      continue;
+    }
+    auto& descriptions = run->fDescriptions[typeAndName.first];
+    for (const auto& infoRaw : *possibleInfos)
+    {
+      ParamObjectDescription description = toDescription(infoRaw.second);
+      int id;
+      if (typeAndName.first == kTOMBChannel)
+      {
+        id = boost::lexical_cast<int>(description["channel"]);
+      }
+      else
+      {
+        id = boost::lexical_cast<int>(description["id"]);
+      }
+      descriptions[id] = std::move(description);
+    }
+  }
+  return run;
+}
+
+ParamObjectDescription JPetParamAsciiCache::toDescription(const boost::property_tree::ptree& info)
+{
+  ParamObjectDescription description;
+  for (const auto& value : info)
+  {
+    std::string val = value.second.get_value<std::string>();
+    if (val == "true")
+    {
+      val = "1";
+    }
+    if (val == "false")
+    {
+      val = "0";
+    }
+    description[value.first] = val;
+  }
+  return description;
+}
@@ -15,128 +15,65 @@
 
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
 #include "JPetParamBank/JPetParamBank.h"
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
 #include "JPetParamGetterAscii/JPetParamAsciiConstants.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/property_tree/json_parser.hpp>
 
 ParamObjectsDescriptions JPetParamGetterAscii::getAllBasicData(ParamObjectType type, const int runId)
 {
-  std::string runNumberS = boost::lexical_cast<std::string>(runId);
-  std::string objectsName = objectsNames.at(type);
-  ParamObjectsDescriptions result;
-  if (boost::filesystem::exists(filename))
-  {
-    boost::property_tree::ptree dataFromFile;
-    boost::property_tree::read_json(filename, dataFromFile);
-    if (auto possibleRunContents = dataFromFile.get_child_optional(runNumberS))
-    {
-      auto runContents = *possibleRunContents;
-      if (auto possibleInfos = runContents.get_child_optional(objectsName))
-      {
-        auto infos = *possibleInfos;
-        for (auto infoRaw : infos)
-        {
-          auto info = infoRaw.second;
-          ParamObjectDescription description = toDescription(info);
-          int id;
-          if (type == kTOMBChannel)
-          {
-            id = boost::lexical_cast<int>(description["channel"]);
-          }
-          else
-          {
-            id = boost::lexical_cast<int>(description["id"]);
-          }
-          result[id] = description;
-        }
-      }
-      else
-      {
-        ERROR(std::string("No ") + objectsName + " in the specified run.");
-      }
-    }
-    else
-    {
-      ERROR(std::string("No run with such id:") + runNumberS);
-    }
-  }
-  else
+  auto descriptions = getDescriptions(type, runId);
+  if (descriptions)
   {
-    ERROR(std::string("Input file does not exist:") + filename);
+    return *descriptions;
   }
-  return result;
+  return ParamObjectsDescriptions();
 }
 
 ParamRelationalData JPetParamGetterAscii::getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runId)
 {
-  std::string runNumberS = boost::lexical_cast<std::string>(runId);
-  std::string objectsName = objectsNames.at(type1);
   std::string fieldName = objectsNames.at(type2) + "_id";
   ParamRelationalData result;
-  if (boost::filesystem::exists(filename))
+  auto descriptions = getDescriptions(type1, runId);
+  if (descriptions)
   {
-    boost::property_tree::ptree dataFromFile;
-    boost::property_tree::read_json(filename, dataFromFile);
-    if (auto possibleRunContents = dataFromFile.get_child_optional(runNumberS))
+    for (const auto& el : *descriptions)
     {
-      auto runContents = *possibleRunContents;
-      if (auto possibleInfos = runContents.get_child_optional(objectsName))
-      {
-        auto infos = *possibleInfos;
-        for (auto infoRaw : infos)
-        {
-          auto info = infoRaw.second;
-          ParamObjectDescription description = toDescription(info);
-          if (description.count(fieldName))
-          {
-            int id;
-            if (type1 == kTOMBChannel)
-            {
-              id = boost::lexical_cast<int>(description["channel"]);
-            }
-            else
-            {
-              id = boost::lexical_cast<int>(description["id"]);
-            }
-            int otherId = boost::lexical_cast<int>(description[fieldName]);
-            result[id] = otherId;
-          }
-        }
-      }
-      else
+      auto field = el.second.find(fieldName);
+      if (field != el.second.end())
       {
-        ERROR(std::string("No ") + objectsName + " in the specified run.");
+        result[el.first] = boost::lexical_cast<int>(field->second);
       }
     }
-    else
-    {
-      ERROR(std::string("No run with such id:") + runNumberS);
-    }
-  }
-  else
-  {
-    ERROR(std::string("Input file does not exist:") + filename);
   }
   return result;
 }
 
-ParamObjectDescription JPetParamGetterAscii::toDescription(boost::property_tree::ptree& info)
+/**
+ * Returns the descriptions of all objects of the given type from the run,
+ * taken from the parsed DB cache, or nullptr if they are not available.
+ */
+std::shared_ptr<const ParamObjectsDescriptions> JPetParamGetterAscii::getDescriptions(ParamObjectType type, const int runId)
 {
-  ParamObjectDescription description;
-  for (auto value : info)
+  std::string runNumberS = boost::lexical_cast<std::string>(runId);
+  std::string objectsName = objectsNames.at(type);
+  if (!boost::filesystem::exists(filename))
   {
-    std::string val = value.second.get_value<std::string>();
-    if (val == "true")
-    {
-      val = "1";
-    }
-    if (val == "false")
-    {
-      val = "0";
-    }
-    description[value.first] = val;
+    ERROR(std::string("Input file does not exist:") + filename);
+    return nullptr;
+  }
+  auto run = JPetParamAsciiCache::getInstance().getRun(filename, runId);
+  if (!run)
+  {
+    ERROR(std::string("No run with such id:") + runNumberS);
+    return nullptr;
+  }
+  auto descriptions = run->fDescriptions.find(type);
+  if (descriptions == run->fDescriptions.end())
+  {
+    ERROR(std::string("No ") + objectsName + " in the specified run.");
+    return nullptr;
   }
-  return description;
+  return std::shared_ptr<const ParamObjectsDescriptions>(run, &descriptions->second);
 }
@@ -15,7 +15,9 @@
 
 #include "JPetParamGetterAscii/JPetParamSaverAscii.h"
 #include "JPetParamBank/JPetParamBank.h"
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
 #include "JPetParamGetterAscii/JPetParamAsciiConstants.h"
+#include "JPetParamManager/JPetParamBankRegistry.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -27,6 +29,8 @@ void JPetParamSaverAscii::saveParamBank(const JPetParamBank& bank, const int run
   auto fileTree = getTreeFromFile(filename);
   addToTree(fileTree, bank, runNumberS);
   write_json(filename, fileTree);
+  JPetParamAsciiCache::getInstance().invalidate(filename);
+  JPetParamBankRegistry::getInstance().invalidate(filename);
 }
 
 boost::property_tree::ptree JPetParamSaverAscii::getTreeFromFile(const std::string& filename)
@@ -46,6 +50,14 @@ void JPetParamSaverAscii::addToTree(boost::property_tree::ptree& tree, const JPe
     WARNING("Overwriting parameters in run number " + runNumber + ". I hope you wanted to do that.");
     tree.erase(runNumber);
   }
+  tree.add_child(runNumber, getRunContents(bank));
+}
+
+/**
+ * Returns the content of a single run in the json DB format describing all the objects from the bank.
+ */
+boost::property_tree::ptree JPetParamSaverAscii::getRunContents(const JPetParamBank& bank)
+{
   boost::property_tree::ptree runContents;
   fillScintillators(runContents, bank);
   fillPMs(runContents, bank);
@@ -57,7 +69,7 @@ void JPetParamSaverAscii::addToTree(boost::property_tree::ptree& tree, const JPe
   fillTOMBChannels(runContents, bank);
   fillDataSources(runContents, bank);
   fillDataModules(runContents, bank);
-  tree.add_child(runNumber, runContents);
+  return runContents;
 }
 
 void JPetParamSaverAscii::fillScintillators(boost::property_tree::ptree& runContents, const JPetParamBank& bank)
@@ -0,0 +1,173 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBankRegistry.cpp
+ */
+
+#include "JPetParamManager/JPetParamBankRegistry.h"
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+
+JPetParamBankRegistry& JPetParamBankRegistry::getInstance()
+{
+  static JPetParamBankRegistry instance;
+  return instance;
+}
+
+/**
+ * Returns the bank registered for the given run, DB file and missing object types.
+ * If there is none, the bank is generated with the builder and registered. The builder
+ * is called without holding the registry lock: the callers asking for the same bank
+ * at the same time wait for the first one instead of generating it again, and the other
+ * banks can be obtained meanwhile. Exceptions thrown by the builder are propagated
+ * to all the waiting callers and nothing is registered. If the DB file cannot be
+ * accessed, the built bank is returned without registering it.
+ */
+std::shared_ptr<const JPetParamBank> JPetParamBankRegistry::getBank(const int runID, const std::string& dbFile,
+                                                                    const std::set<ParamObjectType>& expectMissing, const BankBuilder& builder)
+{
+  boost::system::error_code ec;
+  auto modificationTime = boost::filesystem::last_write_time(dbFile, ec);
+  auto size = ec ? 0 : boost::filesystem::file_size(dbFile, ec);
+  if (ec)
+  {
+    return builder();
+  }
+  Key key(dbFile, modificationTime, size, runID, expectMissing);
+  std::promise<std::shared_ptr<const JPetParamBank>> promise;
+  BankFuture future;
+  bool isBuiltHere = false;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto it = fBanks.find(key);
+    if (it != fBanks.end())
+    {
+      future = it->second;
+    }
+    else
+    {
+      future = promise.get_future().share();
+      fBanks.emplace(key, future);
+      isBuiltHere = true;
+    }
+  }
+  if (!isBuiltHere)
+  {
+    return future.get();
+  }
+  std::shared_ptr<const JPetParamBank> bank;
+  try
+  {
+    bank = builder();
+  }
+  catch (...)
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fBanks.erase(key);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fNumberOfBuilds++;
+  }
+  promise.set_value(bank);
+  return bank;
+}
+
+/**
+ * Removes the banks of the given run generated from the given DB file,
+ * e.g. once all the input files of the run are processed.
+ */
+void JPetParamBankRegistry::release(const int runID, const std::string& dbFile)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  for (auto it = fBanks.begin(); it != fBanks.end();)
+  {
+    if (std::get<0>(it->first) == dbFile && std::get<3>(it->first) == runID)
+    {
+      it = fBanks.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * Removes the built banks which are not used outside of the registry,
+ * the banks being built are kept.
+ * @return number of the removed banks
+ */
+std::size_t JPetParamBankRegistry::releaseUnused()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  std::size_t released = 0;
+  for (auto it = fBanks.begin(); it != fBanks.end();)
+  {
+    if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready && it->second.get().use_count() == 1)
+    {
+      it = fBanks.erase(it);
+      released++;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return released;
+}
+
+/**
+ * Removes all the banks generated from the given DB file, e.g. after it was overwritten.
+ * The handles already given out stay valid.
+ */
+void JPetParamBankRegistry::invalidate(const std::string& dbFile)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  for (auto it = fBanks.begin(); it != fBanks.end();)
+  {
+    if (std::get<0>(it->first) == dbFile)
+    {
+      it = fBanks.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void JPetParamBankRegistry::clear()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fBanks.clear();
+}
+
+std::size_t JPetParamBankRegistry::getNumberOfBuilds() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNumberOfBuilds;
+}
+
+/**
+ * Number of the registered banks, including the ones being built.
+ */
+std::size_t JPetParamBankRegistry::getNumberOfBanks() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fBanks.size();
+}
@@ -15,7 +15,9 @@
 
 #include "JPetParamManager/JPetParamManager.h"
 #include "JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetParamManager/JPetParamBankRegistry.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamSnapshot/JPetParamGetterBinary.h"
 
 #include <TFile.h>
 #include <boost/property_tree/xml_parser.hpp>
@@ -46,7 +48,17 @@ std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const s
       expectMissing.insert(ParamObjectType::kDataSource);
       expectMissing.insert(ParamObjectType::kDataModule);
     }
-    return std::make_shared<JPetParamManager>(new JPetParamGetterAscii(getLocalDB(options)), expectMissing);
+    std::shared_ptr<JPetParamManager> manager;
+    if (JPetParamSnapshot::isSnapshotFile(getLocalDB(options)))
+    {
+      manager = std::make_shared<JPetParamManager>(new JPetParamGetterBinary(getLocalDB(options)), expectMissing);
+    }
+    else
+    {
+      manager = std::make_shared<JPetParamManager>(new JPetParamGetterAscii(getLocalDB(options)), expectMissing);
+    }
+    manager->setDBSource(getLocalDB(options));
+    return manager;
   }
   else
   {
@@ -57,11 +69,6 @@ std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const s
 
 JPetParamManager::~JPetParamManager()
 {
-  if (fBank)
-  {
-    delete fBank;
-    fBank = 0;
-  }
   if (fParamGetter)
   {
     delete fParamGetter;
@@ -186,20 +193,33 @@ JPetDataModuleFactory& JPetParamManager::getDataModuleFactory(const int runID)
   return fDataModuleFactories.at(runID);
 }
 
+/**
+ * Fills the parameter bank for the given run. If the DB source is set, the bank
+ * is taken from JPetParamBankRegistry, so it is generated only once per process
+ * and shared with all the other managers of the same run and DB file.
+ */
 void JPetParamManager::fillParameterBank(const int run)
 {
-  if (fBank)
+  fBank.reset();
+  if (fDBSource.empty())
   {
-    delete fBank;
-    fBank = 0;
+    fBank = buildParameterBank(run);
   }
-  fBank = new JPetParamBank();
+  else
+  {
+    fBank = JPetParamBankRegistry::getInstance().getBank(run, fDBSource, fExpectMissing, [this, run]() { return buildParameterBank(run); });
+  }
+}
+
+std::shared_ptr<JPetParamBank> JPetParamManager::buildParameterBank(const int run)
+{
+  auto bank = std::make_shared<JPetParamBank>();
   if (!fExpectMissing.count(ParamObjectType::kTRB))
   {
     for (auto& trbp : getTRBs(run))
     {
       auto& trb = *trbp.second;
-      fBank->addTRB(trb);
+      bank->addTRB(trb);
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kFEB))
@@ -207,8 +227,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& febp : getFEBs(run))
     {
       auto& feb = *febp.second;
-      fBank->addFEB(feb);
-      fBank->getFEB(feb.getID()).setTRB(fBank->getTRB(feb.getTRB().getID()));
+      bank->addFEB(feb);
+      bank->getFEB(feb.getID()).setTRB(bank->getTRB(feb.getTRB().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kFrame))
@@ -216,7 +236,7 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& framep : getFrames(run))
     {
       auto& frame = *framep.second;
-      fBank->addFrame(frame);
+      bank->addFrame(frame);
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kLayer))
@@ -224,8 +244,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& layerp : getLayers(run))
     {
       auto& layer = *layerp.second;
-      fBank->addLayer(layer);
-      fBank->getLayer(layer.getID()).setFrame(fBank->getFrame(layer.getFrame().getID()));
+      bank->addLayer(layer);
+      bank->getLayer(layer.getID()).setFrame(bank->getFrame(layer.getFrame().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kBarrelSlot))
@@ -233,10 +253,10 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& barrelSlotp : getBarrelSlots(run))
     {
       auto& barrelSlot = *barrelSlotp.second;
-      fBank->addBarrelSlot(barrelSlot);
+      bank->addBarrelSlot(barrelSlot);
       if (barrelSlot.hasLayer())
       {
-        fBank->getBarrelSlot(barrelSlot.getID()).setLayer(fBank->getLayer(barrelSlot.getLayer().getID()));
+        bank->getBarrelSlot(barrelSlot.getID()).setLayer(bank->getLayer(barrelSlot.getLayer().getID()));
       }
     }
   }
@@ -245,8 +265,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& scinp : getScins(run))
     {
       auto& scin = *scinp.second;
-      fBank->addScintillator(scin);
-      fBank->getScintillator(scin.getID()).setBarrelSlot(fBank->getBarrelSlot(scin.getBarrelSlot().getID()));
+      bank->addScintillator(scin);
+      bank->getScintillator(scin.getID()).setBarrelSlot(bank->getBarrelSlot(scin.getBarrelSlot().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kPM))
@@ -254,13 +274,13 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& pmp : getPMs(run))
     {
       auto& pm = *pmp.second;
-      fBank->addPM(pm);
+      bank->addPM(pm);
       if (pm.hasFEB())
       {
-        fBank->getPM(pm.getID()).setFEB(fBank->getFEB(pm.getFEB().getID()));
+        bank->getPM(pm.getID()).setFEB(bank->getFEB(pm.getFEB().getID()));
       }
-      fBank->getPM(pm.getID()).setScin(fBank->getScintillator(pm.getScin().getID()));
-      fBank->getPM(pm.getID()).setBarrelSlot(fBank->getBarrelSlot(pm.getBarrelSlot().getID()));
+      bank->getPM(pm.getID()).setScin(bank->getScintillator(pm.getScin().getID()));
+      bank->getPM(pm.getID()).setBarrelSlot(bank->getBarrelSlot(pm.getBarrelSlot().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kTOMBChannel))
@@ -268,10 +288,10 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& tombChannelp : getTOMBChannels(run))
     {
       auto& tombChannel = *tombChannelp.second;
-      fBank->addTOMBChannel(tombChannel);
-      fBank->getTOMBChannel(tombChannel.getChannel()).setFEB(fBank->getFEB(tombChannel.getFEB().getID()));
-      fBank->getTOMBChannel(tombChannel.getChannel()).setTRB(fBank->getTRB(tombChannel.getTRB().getID()));
-      fBank->getTOMBChannel(tombChannel.getChannel()).setPM(fBank->getPM(tombChannel.getPM().getID()));
+      bank->addTOMBChannel(tombChannel);
+      bank->getTOMBChannel(tombChannel.getChannel()).setFEB(bank->getFEB(tombChannel.getFEB().getID()));
+      bank->getTOMBChannel(tombChannel.getChannel()).setTRB(bank->getTRB(tombChannel.getTRB().getID()));
+      bank->getTOMBChannel(tombChannel.getChannel()).setPM(bank->getPM(tombChannel.getPM().getID()));
     }
   }
 
@@ -280,7 +300,7 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& dataSourceElement : getDataSources(run))
     {
       auto& dataSource = *dataSourceElement.second;
-      fBank->addDataSource(dataSource);
+      bank->addDataSource(dataSource);
     }
   }
 
@@ -289,10 +309,11 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& dataModuleElement : getDataModules(run))
     {
       auto& dataModule = *dataModuleElement.second;
-      fBank->addDataModule(dataModule);
-      fBank->getDataModule(dataModule.getID()).setDataSource(fBank->getDataSource(dataModule.getDataSource().getID()));
+      bank->addDataModule(dataModule);
+      bank->getDataModule(dataModule.getID()).setDataSource(bank->getDataSource(dataModule.getDataSource().getID()));
     }
   }
+  return bank;
 }
 
 bool JPetParamManager::readParametersFromFile(JPetReader* reader)
@@ -303,9 +324,12 @@ bool JPetParamManager::readParametersFromFile(JPetReader* reader)
     ERROR("Cannot read parameters from file. The provided JPetReader is closed.");
     return false;
   }
-  fBank = static_cast<JPetParamBank*>(reader->getObjectFromFile("ParamBank;1"));
-  if (!fBank)
+  auto bank = static_cast<JPetParamBank*>(reader->getObjectFromFile("ParamBank;1"));
+  fBank.reset();
+  if (!bank)
     return false;
+  bank->rebuildIndex();
+  fBank.reset(bank);
   return true;
 }
 
@@ -317,7 +341,7 @@ bool JPetParamManager::saveParametersToFile(JPetWriter* writer)
     ERROR("Could not write parameters to file. The provided JPetWriter is closed.");
     return false;
   }
-  writer->writeObject(fBank, "ParamBank");
+  writer->writeObject(fBank.get(), "ParamBank");
   return true;
 }
 
@@ -329,9 +353,12 @@ bool JPetParamManager::readParametersFromFile(std::string filename)
     ERROR("Could not read from file.");
     return false;
   }
-  fBank = static_cast<JPetParamBank*>(file.Get("ParamBank;1"));
-  if (!fBank)
+  auto bank = static_cast<JPetParamBank*>(file.Get("ParamBank;1"));
+  fBank.reset();
+  if (!bank)
     return false;
+  bank->rebuildIndex();
+  fBank.reset(bank);
   return true;
 }
 
@@ -345,6 +372,12 @@ const JPetParamBank& JPetParamManager::getParamBank() const
     return DummyResult;
 }
 
+/**
+ * Returns a shared handle to the current bank, which stays valid after the manager
+ * is cleared or destroyed. Returns nullptr if no bank was generated or read.
+ */
+std::shared_ptr<const JPetParamBank> JPetParamManager::getSharedParamBank() const { return fBank; }
+
 bool JPetParamManager::saveParametersToFile(std::string filename)
 {
   TFile file(filename.c_str(), "UPDATE");
@@ -355,12 +388,16 @@ bool JPetParamManager::saveParametersToFile(std::string filename)
   }
   file.cd();
   assert(fBank);
-  file.WriteObject(fBank, "ParamBank");
+  file.WriteObject(fBank.get(), "ParamBank");
   return true;
 }
 
+/**
+ * The bank can be shared with other managers, so it is not modified here.
+ * The manager drops its handle and continues with an empty bank.
+ */
 void JPetParamManager::clearParameters()
 {
   assert(fBank);
-  fBank->clear();
+  fBank = std::make_shared<JPetParamBank>();
 }
@@ -0,0 +1,70 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamGetterBinary.cpp
+ */
+
+#include "JPetParamSnapshot/JPetParamGetterBinary.h"
+#include "JPetParamGetterAscii/JPetParamAsciiConstants.h"
+
+#include <boost/lexical_cast.hpp>
+
+ParamObjectsDescriptions JPetParamGetterBinary::getAllBasicData(ParamObjectType type, const int runID)
+{
+  if (!checkRequest(type, runID))
+  {
+    return ParamObjectsDescriptions();
+  }
+  return fSnapshot.getDescriptions(type);
+}
+
+ParamRelationalData JPetParamGetterBinary::getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runID)
+{
+  ParamRelationalData result;
+  if (!checkRequest(type1, runID))
+  {
+    return result;
+  }
+  std::string fieldName = objectsNames.at(type2) + "_id";
+  for (auto id : fSnapshot.getIDs(type1))
+  {
+    if (auto value = fSnapshot.getField(type1, id, fieldName))
+    {
+      result[id] = boost::lexical_cast<int>(value);
+    }
+  }
+  return result;
+}
+
+/**
+ * Maps the snapshot if needed and checks if it contains the requested run and
+ * object type. The error messages are the same as for the json DB.
+ */
+bool JPetParamGetterBinary::checkRequest(ParamObjectType type, const int runID)
+{
+  if (!fSnapshot.isOpen() && !fSnapshot.open(fFilename))
+  {
+    ERROR(std::string("Input file does not exist:") + fFilename);
+    return false;
+  }
+  if (fSnapshot.getRunID() != runID)
+  {
+    ERROR(std::string("No run with such id:") + std::to_string(runID));
+    return false;
+  }
+  if (!fSnapshot.hasType(type))
+  {
+    ERROR(std::string("No ") + objectsNames.at(type) + " in the specified run.");
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,407 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamSnapshot.cpp
+ */
+
+#include "JPetParamSnapshot/JPetParamSnapshot.h"
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
+#include "JPetParamGetterAscii/JPetParamSaverAscii.h"
+#include "JPetParamManager/JPetParamManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char JPetParamSnapshot::kMagic[8] = {'J', 'P', 'E', 'T', 'P', 'B', 'S', '1'};
+const std::uint32_t JPetParamSnapshot::kVersion = 1;
+
+namespace
+{
+const std::uint32_t kByteOrderMark = 0x01020304;
+
+template <typename T>
+void appendRecord(std::vector<char>& buffer, const T& record)
+{
+  const char* bytes = reinterpret_cast<const char*>(&record);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+} // namespace
+
+JPetParamSnapshot::JPetParamSnapshot() {}
+
+JPetParamSnapshot::JPetParamSnapshot(const std::string& filename) { open(filename); }
+
+JPetParamSnapshot::~JPetParamSnapshot() { close(); }
+
+/**
+ * Maps the snapshot file into memory. Returns false if the file
+ * cannot be mapped or it is not a valid snapshot.
+ */
+bool JPetParamSnapshot::open(const std::string& filename)
+{
+  close();
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    ERROR("Cannot open the param snapshot file:" + filename);
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(Header)))
+  {
+    ERROR("The file is too small to be a param snapshot:" + filename);
+    ::close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    ERROR("Cannot map the param snapshot file:" + filename);
+    return false;
+  }
+  fData = static_cast<const char*>(data);
+  fSize = fileStat.st_size;
+  if (!validate())
+  {
+    ERROR("The file is not a valid param snapshot:" + filename);
+    close();
+    return false;
+  }
+  return true;
+}
+
+void JPetParamSnapshot::close()
+{
+  if (fData)
+  {
+    munmap(const_cast<char*>(fData), fSize);
+  }
+  fData = nullptr;
+  fSize = 0;
+}
+
+bool JPetParamSnapshot::isOpen() const { return fData != nullptr; }
+
+int JPetParamSnapshot::getRunID() const
+{
+  if (!isOpen())
+  {
+    return -1;
+  }
+  return reinterpret_cast<const Header*>(fData)->fRunID;
+}
+
+bool JPetParamSnapshot::hasType(ParamObjectType type) const { return findSection(type) != nullptr; }
+
+std::size_t JPetParamSnapshot::getNumberOfObjects(ParamObjectType type) const
+{
+  auto section = findSection(type);
+  return section ? section->fNumberOfObjects : 0;
+}
+
+/**
+ * Returns the sorted IDs of all the objects of the given type.
+ */
+std::vector<int> JPetParamSnapshot::getIDs(ParamObjectType type) const
+{
+  std::vector<int> result;
+  auto section = findSection(type);
+  if (!section)
+  {
+    return result;
+  }
+  auto objects = reinterpret_cast<const ObjectRecord*>(fData + section->fObjectsOffset);
+  result.reserve(section->fNumberOfObjects);
+  for (std::uint32_t i = 0; i < section->fNumberOfObjects; i++)
+  {
+    result.push_back(objects[i].fID);
+  }
+  return result;
+}
+
+/**
+ * Returns the value of the field of the object with the given type and ID
+ * as a pointer into the mapped file, or nullptr if there is no such field.
+ * The pointer is valid as long as the snapshot is open.
+ */
+const char* JPetParamSnapshot::getField(ParamObjectType type, int id, const std::string& key) const
+{
+  auto section = findSection(type);
+  if (!section)
+  {
+    return nullptr;
+  }
+  auto object = findObject(*section, id);
+  if (!object)
+  {
+    return nullptr;
+  }
+  auto fields = reinterpret_cast<const FieldRecord*>(fData + object->fFieldsOffset);
+  auto end = fields + object->fNumberOfFields;
+  auto field = std::lower_bound(fields, end, key,
+                                [this](const FieldRecord& record, const std::string& name) { return std::strcmp(getString(record.fKey), name.c_str()) < 0; });
+  if (field == end || key != getString(field->fKey))
+  {
+    return nullptr;
+  }
+  return getString(field->fValue);
+}
+
+/**
+ * Returns the descriptions of all the objects of the given type in the form
+ * used by the param getters.
+ */
+ParamObjectsDescriptions JPetParamSnapshot::getDescriptions(ParamObjectType type) const
+{
+  ParamObjectsDescriptions result;
+  auto section = findSection(type);
+  if (!section)
+  {
+    return result;
+  }
+  auto objects = reinterpret_cast<const ObjectRecord*>(fData + section->fObjectsOffset);
+  for (std::uint32_t i = 0; i < section->fNumberOfObjects; i++)
+  {
+    auto& description = result[objects[i].fID];
+    auto fields = reinterpret_cast<const FieldRecord*>(fData + objects[i].fFieldsOffset);
+    for (std::uint32_t j = 0; j < objects[i].fNumberOfFields; j++)
+    {
+      description.emplace_hint(description.end(), getString(fields[j].fKey), getString(fields[j].fValue));
+    }
+  }
+  return result;
+}
+
+/**
+ * Checks if the file starts with the snapshot magic number.
+ */
+bool JPetParamSnapshot::isSnapshotFile(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(kMagic)];
+  if (!file.read(magic, sizeof(magic)))
+  {
+    return false;
+  }
+  return std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+/**
+ * Writes the descriptions of the objects of a single run as a snapshot file.
+ * Identical strings are stored only once.
+ */
+bool JPetParamSnapshot::write(const std::string& filename, const int runID, const std::map<ParamObjectType, ParamObjectsDescriptions>& descriptions)
+{
+  std::vector<char> strings;
+  std::map<std::string, std::uint32_t> stringOffsets;
+  auto addString = [&strings, &stringOffsets](const std::string& value) {
+    auto it = stringOffsets.find(value);
+    if (it != stringOffsets.end())
+    {
+      return it->second;
+    }
+    std::uint32_t offset = strings.size();
+    strings.insert(strings.end(), value.begin(), value.end());
+    strings.push_back('\0');
+    stringOffsets[value] = offset;
+    return offset;
+  };
+
+  std::size_t numberOfObjects = 0;
+  for (const auto& section : descriptions)
+  {
+    numberOfObjects += section.second.size();
+  }
+  std::uint64_t objectsOffset = sizeof(Header) + descriptions.size() * sizeof(SectionRecord);
+  std::uint64_t fieldsOffset = objectsOffset + numberOfObjects * sizeof(ObjectRecord);
+
+  std::vector<char> sectionsBuffer;
+  std::vector<char> objectsBuffer;
+  std::vector<char> fieldsBuffer;
+  for (const auto& section : descriptions)
+  {
+    SectionRecord sectionRecord;
+    sectionRecord.fType = section.first;
+    sectionRecord.fNumberOfObjects = section.second.size();
+    sectionRecord.fObjectsOffset = objectsOffset + objectsBuffer.size();
+    appendRecord(sectionsBuffer, sectionRecord);
+    for (const auto& object : section.second)
+    {
+      ObjectRecord objectRecord;
+      objectRecord.fID = object.first;
+      objectRecord.fNumberOfFields = object.second.size();
+      objectRecord.fFieldsOffset = fieldsOffset + fieldsBuffer.size();
+      appendRecord(objectsBuffer, objectRecord);
+      for (const auto& field : object.second)
+      {
+        FieldRecord fieldRecord;
+        fieldRecord.fKey = addString(field.first);
+        fieldRecord.fValue = addString(field.second);
+        appendRecord(fieldsBuffer, fieldRecord);
+      }
+    }
+  }
+
+  Header header;
+  std::memcpy(header.fMagic, kMagic, sizeof(kMagic));
+  header.fVersion = kVersion;
+  header.fByteOrderMark = kByteOrderMark;
+  header.fRunID = runID;
+  header.fNumberOfSections = descriptions.size();
+  header.fStringsOffset = fieldsOffset + fieldsBuffer.size();
+  header.fStringsSize = strings.size();
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file)
+  {
+    ERROR("Cannot create the param snapshot file:" + filename);
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(sectionsBuffer.data(), sectionsBuffer.size());
+  file.write(objectsBuffer.data(), objectsBuffer.size());
+  file.write(fieldsBuffer.data(), fieldsBuffer.size());
+  file.write(strings.data(), strings.size());
+  if (!file)
+  {
+    ERROR("Error while writing the param snapshot file:" + filename);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Creates the snapshot of the given run from the local json DB.
+ */
+bool JPetParamSnapshot::convertFromAscii(const std::string& jsonFile, const int runID, const std::string& snapshotFile)
+{
+  auto run = JPetParamAsciiCache::getInstance().getRun(jsonFile, runID);
+  if (!run)
+  {
+    ERROR("No run with id:" + std::to_string(runID) + " in the local DB file:" + jsonFile);
+    return false;
+  }
+  return write(snapshotFile, runID, run->fDescriptions);
+}
+
+/**
+ * Creates the snapshot from the param bank stored in the ROOT file. The bank
+ * does not contain the run number, so it must be given by the caller.
+ */
+bool JPetParamSnapshot::convertFromRootFile(const std::string& rootFile, const int runID, const std::string& snapshotFile)
+{
+  JPetParamManager manager;
+  if (!manager.readParametersFromFile(rootFile))
+  {
+    ERROR("Cannot read the param bank from the ROOT file:" + rootFile);
+    return false;
+  }
+  JPetParamSaverAscii saver;
+  auto run = JPetParamAsciiCache::parseRun(saver.getRunContents(manager.getParamBank()));
+  return write(snapshotFile, runID, run->fDescriptions);
+}
+
+/**
+ * Checks the header and that all the records and strings lie inside the mapped file,
+ * so that the later lookups do not need any bounds checking.
+ */
+bool JPetParamSnapshot::validate() const
+{
+  auto header = reinterpret_cast<const Header*>(fData);
+  if (std::memcmp(header->fMagic, kMagic, sizeof(kMagic)) != 0 || header->fVersion != kVersion || header->fByteOrderMark != kByteOrderMark)
+  {
+    return false;
+  }
+  if (header->fStringsOffset > fSize || header->fStringsSize > fSize - header->fStringsOffset)
+  {
+    return false;
+  }
+  if (header->fStringsSize > 0 && fData[header->fStringsOffset + header->fStringsSize - 1] != '\0')
+  {
+    return false;
+  }
+  if (header->fNumberOfSections > (fSize - sizeof(Header)) / sizeof(SectionRecord))
+  {
+    return false;
+  }
+  auto sections = reinterpret_cast<const SectionRecord*>(fData + sizeof(Header));
+  for (std::uint32_t i = 0; i < header->fNumberOfSections; i++)
+  {
+    const auto& section = sections[i];
+    if (section.fObjectsOffset > fSize || section.fObjectsOffset % alignof(ObjectRecord) != 0 ||
+        section.fNumberOfObjects > (fSize - section.fObjectsOffset) / sizeof(ObjectRecord))
+    {
+      return false;
+    }
+    auto objects = reinterpret_cast<const ObjectRecord*>(fData + section.fObjectsOffset);
+    for (std::uint32_t j = 0; j < section.fNumberOfObjects; j++)
+    {
+      const auto& object = objects[j];
+      if ((j > 0 && objects[j - 1].fID >= object.fID) || object.fFieldsOffset > fSize || object.fFieldsOffset % alignof(FieldRecord) != 0 ||
+          object.fNumberOfFields > (fSize - object.fFieldsOffset) / sizeof(FieldRecord))
+      {
+        return false;
+      }
+      auto fields = reinterpret_cast<const FieldRecord*>(fData + object.fFieldsOffset);
+      for (std::uint32_t k = 0; k < object.fNumberOfFields; k++)
+      {
+        if (fields[k].fKey >= header->fStringsSize || fields[k].fValue >= header->fStringsSize)
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+const JPetParamSnapshot::SectionRecord* JPetParamSnapshot::findSection(ParamObjectType type) const
+{
+  if (!isOpen())
+  {
+    return nullptr;
+  }
+  auto header = reinterpret_cast<const Header*>(fData);
+  auto sections = reinterpret_cast<const SectionRecord*>(fData + sizeof(Header));
+  for (std::uint32_t i = 0; i < header->fNumberOfSections; i++)
+  {
+    if (sections[i].fType == type)
+    {
+      return &sections[i];
+    }
+  }
+  return nullptr;
+}
+
+const JPetParamSnapshot::ObjectRecord* JPetParamSnapshot::findObject(const SectionRecord& section, int id) const
+{
+  auto objects = reinterpret_cast<const ObjectRecord*>(fData + section.fObjectsOffset);
+  auto end = objects + section.fNumberOfObjects;
+  auto object = std::lower_bound(objects, end, id, [](const ObjectRecord& record, int value) { return record.fID < value; });
+  if (object == end || object->fID != id)
+  {
+    return nullptr;
+  }
+  return object;
+}
+
+const char* JPetParamSnapshot::getString(std::uint32_t offset) const
+{
+  auto header = reinterpret_cast<const Header*>(fData);
+  return fData + header->fStringsOffset + offset;
+}
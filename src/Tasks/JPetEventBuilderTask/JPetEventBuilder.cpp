@@ -0,0 +1,294 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEventBuilder.cpp
+ */
+
+#include "JPetEventBuilderTask/JPetEventBuilder.h"
+#include "JPetLoggerInclude.h"
+#include <array>
+#include <cstring>
+
+/// Coincidence window in [ps]
+const double JPetEventBuilder::kDefaultCoincidenceWindow = 5000.;
+
+namespace
+{
+/**
+ * Maps the float to an unsigned integer with the same ordering,
+ * i.e. flips all the bits of the negative numbers and the sign bit of the others.
+ */
+inline std::uint32_t toSortableKey(float value)
+{
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+} // namespace
+
+JPetEventBuilder::JPetEventBuilder(double coincidenceWindow) : fCoincidenceWindow(coincidenceWindow) {}
+
+/**
+ * Sets the coincidence window in [ps], i.e. the maximal time after the first hit of the event for the other hits.
+ */
+void JPetEventBuilder::setCoincidenceWindow(double coincidenceWindow) { fCoincidenceWindow = coincidenceWindow; }
+
+double JPetEventBuilder::getCoincidenceWindow() const { return fCoincidenceWindow; }
+
+/**
+ * Sets the minimal number of hits of the built events, the groups of fewer hits are skipped.
+ */
+void JPetEventBuilder::setMinimalMultiplicity(std::size_t multiplicity) { fMinimalMultiplicity = multiplicity; }
+
+std::size_t JPetEventBuilder::getMinimalMultiplicity() const { return fMinimalMultiplicity; }
+
+/**
+ * Enables or disables keeping the hits of the last event of a window for the next one.
+ */
+void JPetEventBuilder::setCarryOver(bool carryOver) { fCarryOver = carryOver; }
+
+bool JPetEventBuilder::isCarryOver() const { return fCarryOver; }
+
+/**
+ * Sets the length of the time windows in [ps], to be used if the hit times are given
+ * with respect to the beginning of each window. Zero (default) means absolute hit times,
+ * with relative ones the carried hits would be sorted after the hits of the next window.
+ */
+void JPetEventBuilder::setTimeWindowLength(double length) { fTimeWindowLength = length; }
+
+double JPetEventBuilder::getTimeWindowLength() const { return fTimeWindowLength; }
+
+/**
+ * Sets the function tagging the built events, classifyByMultiplicity is used if it is empty.
+ */
+void JPetEventBuilder::setClassifier(const Classifier& classifier) { fClassifier = classifier; }
+
+/**
+ * @brief Builds the events of the given window of JPetHit objects (and of the hits carried
+ * from the previous one) and adds them to the window of events.
+ * @return number of added events.
+ */
+std::size_t JPetEventBuilder::buildEvents(const JPetTimeWindow& hits, JPetTimeWindow& events)
+{
+  /// All events of the window are of the same class, so only the first one is checked,
+  /// before the carried hits are shifted to the frame of this window
+  if (hits.getNumberOfEvents() > 0 && !dynamic_cast<const JPetHit*>(&hits[0]))
+  {
+    ERROR(Form("Events cannot be built from the time window with events of type %s.", hits.getEventType()));
+    return 0;
+  }
+  fHits.clear();
+  fTimes.clear();
+  collectCarriedHits();
+  for (std::size_t i = 0; i < hits.getNumberOfEvents(); i++)
+  {
+    auto hit = static_cast<const JPetHit*>(&hits[i]);
+    fHits.push_back(hit);
+    fTimes.push_back(hit->getTime());
+  }
+  return sweep(false, [&events](const JPetEvent& event) { events.add<JPetEvent>(event); });
+}
+
+/**
+ * @brief Builds the events of the given hits (and of the hits carried from the previous call)
+ * and appends them to the vector of events.
+ * @return number of added events.
+ */
+std::size_t JPetEventBuilder::buildEvents(const std::vector<JPetHit>& hits, std::vector<JPetEvent>& events)
+{
+  fHits.clear();
+  fTimes.clear();
+  collectCarriedHits();
+  for (const auto& hit : hits)
+  {
+    fHits.push_back(&hit);
+    fTimes.push_back(hit.getTime());
+  }
+  return sweep(false, [&events](const JPetEvent& event) { events.push_back(event); });
+}
+
+/**
+ * @brief Builds the event of the hits carried from the last window, to be called after the last window.
+ * @return number of added events.
+ */
+std::size_t JPetEventBuilder::flush(JPetTimeWindow& events)
+{
+  fHits.clear();
+  fTimes.clear();
+  for (const auto& hit : fCarriedHits)
+  {
+    fHits.push_back(&hit);
+    fTimes.push_back(hit.getTime());
+  }
+  return sweep(true, [&events](const JPetEvent& event) { events.add<JPetEvent>(event); });
+}
+
+std::size_t JPetEventBuilder::flush(std::vector<JPetEvent>& events)
+{
+  fHits.clear();
+  fTimes.clear();
+  for (const auto& hit : fCarriedHits)
+  {
+    fHits.push_back(&hit);
+    fTimes.push_back(hit.getTime());
+  }
+  return sweep(true, [&events](const JPetEvent& event) { events.push_back(event); });
+}
+
+std::size_t JPetEventBuilder::getNumberOfCarriedHits() const { return fCarriedHits.size(); }
+
+/**
+ * Drops the carried hits, e.g. before processing the windows of another file.
+ */
+void JPetEventBuilder::reset() { fCarriedHits.clear(); }
+
+/**
+ * @brief Default classifier of the events: k2Gamma for two hits, k3Gamma for three and kUnknown otherwise.
+ */
+JPetEventType JPetEventBuilder::classifyByMultiplicity(const JPetEvent& event)
+{
+  switch (event.getHits().size())
+  {
+  case 2:
+    return JPetEventType::k2Gamma;
+  case 3:
+    return JPetEventType::k3Gamma;
+  default:
+    return JPetEventType::kUnknown;
+  }
+}
+
+/**
+ * @brief Stable least significant digit radix sort of the float times, in four passes of 8 bits,
+ * the passes in which all the keys have the same digit are skipped.
+ *
+ * @param order filled with the indices of the times in the ascending order
+ * @param keys, buffer working memory, kept by the caller to avoid allocations
+ */
+void JPetEventBuilder::sortByTime(const std::vector<float>& times, std::vector<std::uint32_t>& order, std::vector<std::uint32_t>& keys,
+                                  std::vector<std::uint32_t>& buffer)
+{
+  const std::size_t size = times.size();
+  order.resize(size);
+  keys.resize(size);
+  buffer.resize(size);
+  for (std::size_t i = 0; i < size; i++)
+  {
+    order[i] = i;
+    keys[i] = toSortableKey(times[i]);
+  }
+  if (size < 2)
+  {
+    return;
+  }
+  std::array<std::size_t, 256> counts;
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    counts.fill(0);
+    for (std::size_t i = 0; i < size; i++)
+    {
+      counts[(keys[i] >> shift) & 0xFFu]++;
+    }
+    if (counts[(keys[0] >> shift) & 0xFFu] == size)
+    {
+      continue;
+    }
+    std::size_t position = 0;
+    for (auto& count : counts)
+    {
+      auto current = count;
+      count = position;
+      position += current;
+    }
+    for (std::size_t i = 0; i < size; i++)
+    {
+      buffer[counts[(keys[order[i]] >> shift) & 0xFFu]++] = order[i];
+    }
+    order.swap(buffer);
+  }
+}
+
+/**
+ * Adds the hits carried from the previous window to the processed ones, with the times
+ * shifted to the frame of the current window if the window length is set.
+ */
+void JPetEventBuilder::collectCarriedHits()
+{
+  for (auto& hit : fCarriedHits)
+  {
+    if (fTimeWindowLength > 0.)
+    {
+      hit.setTime(hit.getTime() - fTimeWindowLength);
+    }
+    fHits.push_back(&hit);
+    fTimes.push_back(hit.getTime());
+  }
+}
+
+/**
+ * @brief Sorts the collected hits and groups them into events in a single pass.
+ * Unless it is the last window, the hits of the last group are carried to the next window
+ * if the carry-over is enabled and the group could still be completed by the next window.
+ */
+template <typename Output>
+std::size_t JPetEventBuilder::sweep(bool isLastWindow, Output output)
+{
+  sortByTime(fTimes, fOrder, fKeys, fBuffer);
+  fNextCarriedHits.clear();
+  const std::size_t size = fHits.size();
+  std::size_t numberOfEvents = 0;
+  std::size_t begin = 0;
+  while (begin < size)
+  {
+    const double start = fTimes[fOrder[begin]];
+    std::size_t end = begin + 1;
+    while (end < size && fTimes[fOrder[end]] - start < fCoincidenceWindow)
+    {
+      end++;
+    }
+    if (end == size && !isLastWindow && fCarryOver && (fTimeWindowLength <= 0. || start + fCoincidenceWindow > fTimeWindowLength))
+    {
+      for (std::size_t i = begin; i < end; i++)
+      {
+        fNextCarriedHits.push_back(*fHits[fOrder[i]]);
+      }
+      break;
+    }
+    if (emitEvent(begin, end, output))
+    {
+      numberOfEvents++;
+    }
+    begin = end;
+  }
+  /// The collected hits may point to the carried ones, which are replaced here
+  fHits.clear();
+  fCarriedHits.swap(fNextCarriedHits);
+  return numberOfEvents;
+}
+
+template <typename Output>
+bool JPetEventBuilder::emitEvent(std::size_t begin, std::size_t end, Output output)
+{
+  if (end - begin < fMinimalMultiplicity)
+  {
+    return false;
+  }
+  fEvent.Clear();
+  fEvent.reserveHits(end - begin);
+  for (std::size_t i = begin; i < end; i++)
+  {
+    fEvent.addHit(*fHits[fOrder[i]]);
+  }
+  fEvent.setEventType(fClassifier ? fClassifier(fEvent) : classifyByMultiplicity(fEvent));
+  output(fEvent);
+  return true;
+}
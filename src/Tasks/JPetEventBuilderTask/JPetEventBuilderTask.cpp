@@ -0,0 +1,104 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEventBuilderTask.cpp
+ */
+
+#include "JPetEventBuilderTask/JPetEventBuilderTask.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
+
+using namespace jpet_options_tools;
+
+JPetEventBuilderTask::JPetEventBuilderTask(const char* name) : JPetUserTask(name) {}
+
+const JPetEventBuilder& JPetEventBuilderTask::getEventBuilder() const { return fEventBuilder; }
+
+bool JPetEventBuilderTask::init()
+{
+  INFO("Event builder started.");
+  auto opts = fParams.getOptions();
+  if (isOptionSet(opts, kCoincidenceWindowParamKey))
+  {
+    fEventBuilder.setCoincidenceWindow(getOptionAsDouble(opts, kCoincidenceWindowParamKey));
+  }
+  if (isOptionSet(opts, kMinimalMultiplicityParamKey))
+  {
+    int multiplicity = getOptionAsInt(opts, kMinimalMultiplicityParamKey);
+    if (multiplicity < 1)
+    {
+      ERROR("The minimal multiplicity of the events must be positive.");
+      return false;
+    }
+    fEventBuilder.setMinimalMultiplicity(multiplicity);
+  }
+  if (isOptionSet(opts, kCarryOverParamKey))
+  {
+    fEventBuilder.setCarryOver(getOptionAsBool(opts, kCarryOverParamKey));
+  }
+  if (isOptionSet(opts, kTimeWindowLengthParamKey))
+  {
+    double length = getOptionAsDouble(opts, kTimeWindowLengthParamKey);
+    if (length < 0.)
+    {
+      ERROR("The time window length of the event builder cannot be negative.");
+      return false;
+    }
+    fEventBuilder.setTimeWindowLength(length);
+  }
+  else if (fEventBuilder.isCarryOver())
+  {
+    ERROR("With the carry-over of the hits, " + kTimeWindowLengthParamKey +
+          " has to be set to the length of the time windows, or to 0 if the hit times are absolute.");
+    return false;
+  }
+  if (fEventBuilder.getCoincidenceWindow() <= 0.)
+  {
+    ERROR("The coincidence window of the event builder must be positive.");
+    return false;
+  }
+  fEventBuilder.reset();
+  fPreviousEntryNumber = -1;
+  fOutputEvents = new JPetTimeWindow("JPetEvent");
+  return true;
+}
+
+bool JPetEventBuilderTask::exec()
+{
+  auto hits = getInputEvents();
+  if (!hits)
+  {
+    ERROR("The input of the event builder is not a time window.");
+    return false;
+  }
+  bool isConsecutive = fEntryNumber < 0 || fPreviousEntryNumber < 0 || fEntryNumber == fPreviousEntryNumber + 1;
+  if (!isConsecutive)
+  {
+    fEventBuilder.flush(*fOutputEvents);
+  }
+  fPreviousEntryNumber = fEntryNumber;
+  fEventBuilder.buildEvents(*hits, *fOutputEvents);
+  if (isLastEntry())
+  {
+    fEventBuilder.flush(*fOutputEvents);
+  }
+  return true;
+}
+
+bool JPetEventBuilderTask::terminate()
+{
+  if (fEventBuilder.getNumberOfCarriedHits() > 0)
+  {
+    WARNING(std::to_string(fEventBuilder.getNumberOfCarriedHits()) + " hits carried after the last processed time window are lost.");
+  }
+  INFO("Event builder finished.");
+  return true;
+}
@@ -36,4 +36,33 @@ BOOST_AUTO_TEST_CASE(constructor_getHitsOrderedByTime)
   BOOST_REQUIRE_CLOSE(results[3].getTime(), 4, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(getHitsOrderedByTime_rvalue)
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(3);
+  hits[1].setTime(1);
+  hits[2].setTime(2);
+  auto results = JPetAnalysisTools::getHitsOrderedByTime(std::move(hits));
+  BOOST_REQUIRE_EQUAL(results.size(), 3u);
+  BOOST_REQUIRE_EQUAL(results[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(results[1].getTime(), 2);
+  BOOST_REQUIRE_EQUAL(results[2].getTime(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(sortHitsByTime)
+{
+  std::vector<JPetHit> hits(4);
+  hits[0].setTime(2);
+  hits[1].setTime(1);
+  hits[2].setTime(4);
+  hits[3].setTime(3);
+  const auto data = hits.data();
+  JPetAnalysisTools::sortHitsByTime(hits);
+  BOOST_REQUIRE(hits.data() == data);
+  BOOST_REQUIRE_EQUAL(hits[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(hits[1].getTime(), 2);
+  BOOST_REQUIRE_EQUAL(hits[2].getTime(), 3);
+  BOOST_REQUIRE_EQUAL(hits[3].getTime(), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
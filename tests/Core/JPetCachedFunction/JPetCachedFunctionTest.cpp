@@ -91,4 +91,80 @@ BOOST_AUTO_TEST_CASE(cached_log)
   BOOST_CHECK_CLOSE(func.getRange().fMin, 2, 0.1);
   BOOST_CHECK_CLOSE(func.getRange().fMax, 100, 0.1);
 }
+BOOST_AUTO_TEST_CASE(values_ref)
+{
+  JPetCachedFunctionParams params("pol1", {1., 2.});
+  JPetCachedFunction1D func(params, Range(10, 0., 10.));
+  const auto& values = func.getValuesRef();
+  BOOST_CHECK_EQUAL(&values, &func.getValuesRef());
+  BOOST_CHECK_EQUAL(values.size(), 10);
+  BOOST_CHECK_CLOSE(values[3], 7., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(upper_edge_of_range)
+{
+  JPetCachedFunctionParams params("pol1", {1., 2.});
+  JPetCachedFunction1D func(params, Range(10, 0., 10.));
+  BOOST_CHECK_CLOSE(func(10.), 19., 0.001);
+  BOOST_CHECK_EQUAL(func(10.1), 0.);
+  func.setInterpolation(true);
+  BOOST_CHECK_CLOSE(func(10.), 19., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(linear_interpolation_1D)
+{
+  JPetCachedFunctionParams params("pol1", {1., 2.}); /// 1 + 2 * x
+  JPetCachedFunction1D func(params, Range(10, 0., 10.));
+  BOOST_CHECK(!func.isInterpolation());
+  BOOST_CHECK_CLOSE(func(2.5), 5., 0.001);
+  func.setInterpolation(true);
+  BOOST_CHECK(func.isInterpolation());
+  BOOST_CHECK_CLOSE(func(0.), 1., 0.001);
+  BOOST_CHECK_CLOSE(func(2.5), 6., 0.001);
+  BOOST_CHECK_CLOSE(func(8.75), 18.5, 0.001);
+  BOOST_CHECK_EQUAL(func(-0.5), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(bilinear_interpolation_2D)
+{
+  JPetCachedFunctionParams params("[0] + [1] * x  + [2] * y", {1., 1., 2.}); /// 1 + x + 2 * y
+  JPetCachedFunction2D func(params, Range(10, 0., 10.), Range(20, 0., 10.));
+  BOOST_CHECK_CLOSE(func(2.5, 3.75), 10., 0.001);
+  func.setInterpolation(true);
+  BOOST_CHECK_CLOSE(func(2.5, 3.75), 11., 0.001);
+  BOOST_CHECK_CLOSE(func(0.3, 0.1), 1.5, 0.001);
+  BOOST_CHECK_CLOSE(func(5., 5.), 16., 0.001);
+  BOOST_CHECK_EQUAL(func(5., 10.5), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(batch_evaluate_1D)
+{
+  JPetCachedFunctionParams params("pol2", {1., 1., 1.}); /// 1 + x + x^2
+  JPetCachedFunction1D func(params, Range(100, 0., 10.));
+  std::vector<double> xs = { -1., 0., 0.05, 1.234, 5., 9.99, 10., 11.};
+  for (auto interpolation : {false, true}) {
+    func.setInterpolation(interpolation);
+    auto out = func.evaluate(xs);
+    BOOST_REQUIRE_EQUAL(out.size(), xs.size());
+    for (std::size_t i = 0; i < xs.size(); i++) {
+      BOOST_CHECK_CLOSE(out[i], func(xs[i]), 1e-9);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(batch_evaluate_2D)
+{
+  JPetCachedFunctionParams params("[0] + [1] * x * y", {1., 0.5});
+  JPetCachedFunction2D func(params, Range(50, 0., 5.), Range(40, -2., 2.));
+  std::vector<double> xs = { -1., 0., 0.05, 1.234, 2.5, 4.99, 5., 3.};
+  std::vector<double> ys = {0., -2., 1.5, -0.77, 2., 0.01, 1., 2.5};
+  for (auto interpolation : {false, true}) {
+    func.setInterpolation(interpolation);
+    auto out = func.evaluate(xs, ys);
+    BOOST_REQUIRE_EQUAL(out.size(), xs.size());
+    for (std::size_t i = 0; i < xs.size(); i++) {
+      BOOST_CHECK_CLOSE(out[i], func(xs[i], ys[i]), 1e-9);
+    }
+  }
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -19,7 +19,9 @@
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
 #include "JPetParamManager/JPetParamManager.h"
 
+#include <TMath.h>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 
 const std::string dataDir = "unitTestData/JPetGeomMappingTest/";
 const std::string dataFileName = dataDir + "data.json";
@@ -180,4 +182,56 @@ BOOST_FIXTURE_TEST_CASE(radiusOfLayer, myFixture)
   BOOST_REQUIRE_EQUAL(mapper.getRadiusOfLayer(-1), 0.);
 }
 
+BOOST_AUTO_TEST_CASE(flatTablesMatchMaps)
+{
+  JPetParamManager fparamManagerInstance(new JPetParamGetterAscii("unitTestData/JPetGeomMappingTest/large_barrel.json"));
+  fparamManagerInstance.fillParameterBank(43);
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  for (const auto& el : mapper.getTOMBMapping())
+  {
+    const auto& key = el.first;
+    BOOST_REQUIRE_EQUAL(mapper.getTOMB(std::get<0>(key), std::get<1>(key), std::get<2>(key), std::get<3>(key)), el.second);
+  }
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(0, 1, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(1, 1000, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(1, 1, JPetPM::SideA, 100), -1);
+
+  BOOST_REQUIRE(!bank.getBarrelSlots().empty());
+  for (const auto& el : bank.getBarrelSlots())
+  {
+    const auto& slot = *el.second;
+    auto geometry = mapper.getSlotGeometry(el.first);
+    BOOST_REQUIRE(geometry);
+    BOOST_REQUIRE_EQUAL(static_cast<size_t>(geometry->layer), mapper.getLayerNumber(slot.getLayer()));
+    BOOST_REQUIRE_EQUAL(static_cast<size_t>(geometry->slot), mapper.getSlotNumber(slot));
+    BOOST_REQUIRE_EQUAL(geometry->radius, slot.getLayer().getRadius());
+    BOOST_REQUIRE_EQUAL(geometry->theta, slot.getTheta());
+    BOOST_REQUIRE_CLOSE(geometry->x, slot.getLayer().getRadius() * std::cos(TMath::DegToRad() * slot.getTheta()), 0.0001);
+    BOOST_REQUIRE_CLOSE(geometry->y, slot.getLayer().getRadius() * std::sin(TMath::DegToRad() * slot.getTheta()), 0.0001);
+  }
+  for (const auto& el : bank.getScintillators())
+  {
+    auto geometry = mapper.getScinGeometry(el.first);
+    BOOST_REQUIRE(geometry);
+    BOOST_REQUIRE_EQUAL(geometry->slot, mapper.getSlotGeometry(el.second->getBarrelSlot().getID())->slot);
+    BOOST_REQUIRE_EQUAL(geometry->layer, mapper.getSlotGeometry(el.second->getBarrelSlot().getID())->layer);
+  }
+  BOOST_REQUIRE(!mapper.getSlotGeometry(-1));
+  BOOST_REQUIRE(!mapper.getScinGeometry(100000));
+}
+
+BOOST_FIXTURE_TEST_CASE(calcDeltaID, myFixture)
+{
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  JPetLayer layerOK(1, true, "Layer01", 42.5);
+  JPetBarrelSlot slotOK1(1, true, "C1_C2", 0, 1);
+  slotOK1.setLayer(layerOK);
+  JPetBarrelSlot slotOK2(2, true, "C3_C4", 90, 1);
+  slotOK2.setLayer(layerOK);
+  BOOST_REQUIRE_EQUAL(mapper.calcDeltaID(slotOK1, slotOK2), 1u);
+  BOOST_REQUIRE_EQUAL(mapper.calcDeltaID(slotOK1, slotOK1), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,12 +17,15 @@
 #define BOOST_TEST_MODULE JPetHaddTest
 #include "JPetBarrelSlot/JPetBarrelSlot.h"
 #include "JPetEvent/JPetEvent.h"
+#include "JPetParamBank/JPetParamBank.h"
+#include "JPetParamBank/JPetParamRefResolver.h"
 #include "JPetReader/JPetReader.h"
 #include "JPetScin/JPetScin.h"
 #include "JPetTimeWindow/JPetTimeWindow.h"
 
 #include <boost/test/unit_test.hpp>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <stdio.h>
 #include <string>
@@ -161,4 +164,27 @@ BOOST_AUTO_TEST_CASE(check_param_bank)
   delete haddedParamBank;
 }
 
+BOOST_AUTO_TEST_CASE(hits_written_with_plain_trefs_are_read)
+{
+  // The file was written before the IDs of the parametric objects were stored and the references were plain TRefs
+  JPetReader reader("unitTestData/JPetHaddTest/single_link_def/dabc_17237091818.hadd.test.root");
+  BOOST_REQUIRE(reader.isOpen());
+  std::unique_ptr<TObject> paramBankObject(reader.getObjectFromFile("ParamBank;1"));
+  auto paramBank = dynamic_cast<JPetParamBank*>(paramBankObject.get());
+  BOOST_REQUIRE(paramBank);
+  const auto& timeWindow = static_cast<const JPetTimeWindow&>(reader.getCurrentEntry());
+  BOOST_REQUIRE_PREDICATE(std::not_equal_to<size_t>(), (timeWindow.getNumberOfEvents())(0));
+  const auto& hits = static_cast<const JPetEvent&>(timeWindow[0]).getHits();
+  BOOST_REQUIRE(!hits.empty());
+  for (const auto& hit : hits)
+  {
+    BOOST_REQUIRE_EQUAL(hit.getScintillatorID(), JPetParamRefResolver::kNoID);
+    BOOST_REQUIRE_EQUAL(hit.getBarrelSlotID(), JPetParamRefResolver::kNoID);
+    const auto& scin = hit.getScintillator();
+    BOOST_REQUIRE_EQUAL(&scin, &paramBank->getScintillator(scin.getID()));
+    const auto& slot = hit.getBarrelSlot();
+    BOOST_REQUIRE_EQUAL(&slot, &paramBank->getBarrelSlot(slot.getID()));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
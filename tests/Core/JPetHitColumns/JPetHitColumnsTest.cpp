@@ -0,0 +1,156 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitColumnsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHitColumnsTest
+
+#include "JPetHitColumns/JPetHitColumns.h"
+
+#include <TTree.h>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+JPetTimeWindow createHitWindow(int numberOfHits)
+{
+  JPetTimeWindow window("JPetHit");
+  for (int i = 0; i < numberOfHits; i++)
+  {
+    JPetHit hit;
+    hit.setTime(100.0f * i);
+    hit.setTimeDiff(10.0f * i);
+    hit.setEnergy(511.0f - i);
+    hit.setPos(i, 2.0f * i, 3.0f * i);
+    hit.setScintillatorID(i + 1);
+    hit.setBarrelSlotID(i + 1);
+    window.add<JPetHit>(hit);
+  }
+  return window;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JPetHitColumnsTestSuite)
+
+BOOST_AUTO_TEST_CASE(parse_columns)
+{
+  BOOST_REQUIRE_EQUAL(JPetHitColumns::parseColumns({"time", "energy"}), JPetHitColumns::kTime | JPetHitColumns::kEnergy);
+  BOOST_REQUIRE_EQUAL(JPetHitColumns::parseColumns({"basic", "signals"}), JPetHitColumns::kAll);
+  BOOST_REQUIRE_EQUAL(JPetHitColumns::parseColumns({"position", "unknown"}), JPetHitColumns::kPosition);
+  BOOST_REQUIRE_EQUAL(JPetHitColumns::parseColumns({}), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(write_and_read_basic_columns)
+{
+  TTree tree("T", "T");
+  JPetHitColumns output;
+  BOOST_REQUIRE(!JPetHitColumns::isColumnarTree(tree));
+  BOOST_REQUIRE(output.createBranches(tree, JPetHitColumns::kBasic));
+  BOOST_REQUIRE(JPetHitColumns::isColumnarTree(tree));
+  for (int i = 0; i < 3; i++)
+  {
+    output.fill(createHitWindow(i + 1));
+    tree.Fill();
+  }
+
+  JPetHitColumns input;
+  BOOST_REQUIRE_EQUAL(input.setBranchAddresses(tree, JPetHitColumns::kBasic), JPetHitColumns::kBasic);
+  BOOST_REQUIRE(tree.GetEntry(2) > 0);
+  BOOST_REQUIRE_EQUAL(input.size(), 3u);
+  BOOST_REQUIRE_EQUAL(input.getEnergies()[1], 510.0f);
+  JPetTimeWindow window("JPetHit");
+  input.fillTimeWindow(window);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 3u);
+  const auto& hit = window.getEvent<JPetHit>(2);
+  BOOST_REQUIRE_EQUAL(hit.getTime(), 200.0f);
+  BOOST_REQUIRE_EQUAL(hit.getTimeDiff(), 20.0f);
+  BOOST_REQUIRE_EQUAL(hit.getEnergy(), 509.0f);
+  BOOST_REQUIRE_EQUAL(hit.getPosY(), 4.0f);
+  BOOST_REQUIRE_EQUAL(hit.getScintillatorID(), 3);
+  BOOST_REQUIRE_EQUAL(hit.getBarrelSlotID(), 3);
+  BOOST_REQUIRE(!hit.isSignalASet());
+}
+
+BOOST_AUTO_TEST_CASE(only_requested_columns_are_read)
+{
+  TTree tree("T", "T");
+  JPetHitColumns output;
+  BOOST_REQUIRE(output.createBranches(tree, JPetHitColumns::kBasic));
+  output.fill(createHitWindow(2));
+  tree.Fill();
+
+  JPetHitColumns input;
+  BOOST_REQUIRE_EQUAL(input.setBranchAddresses(tree, JPetHitColumns::kTime), JPetHitColumns::kTime);
+  BOOST_REQUIRE(tree.GetEntry(0) > 0);
+  BOOST_REQUIRE_EQUAL(input.getTimes().size(), 2u);
+  BOOST_REQUIRE(input.getEnergies().empty());
+  BOOST_REQUIRE(input.getPosX().empty());
+  JPetTimeWindow window("JPetHit");
+  input.fillTimeWindow(window);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 2u);
+  BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(1).getTime(), 100.0f);
+  BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(1).getEnergy(), 0.0f);
+  BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(1).getScintillatorID(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(missing_columns_are_not_bound)
+{
+  TTree tree("T", "T");
+  JPetHitColumns output;
+  BOOST_REQUIRE(output.createBranches(tree, JPetHitColumns::kEnergy));
+  output.fill(createHitWindow(1));
+  tree.Fill();
+
+  JPetHitColumns input;
+  BOOST_REQUIRE_EQUAL(input.setBranchAddresses(tree, JPetHitColumns::kEnergy | JPetHitColumns::kSignals), JPetHitColumns::kEnergy);
+  BOOST_REQUIRE_EQUAL(input.getColumns(), JPetHitColumns::kEnergy);
+}
+
+BOOST_AUTO_TEST_CASE(set_signals_are_restored)
+{
+  TTree tree("T", "T");
+  JPetHitColumns output;
+  BOOST_REQUIRE(output.createBranches(tree, JPetHitColumns::kAll));
+  JPetTimeWindow hits("JPetHit");
+  JPetPhysSignal signal;
+  signal.setTime(5.0f);
+  JPetHit hitWithSignalA;
+  hitWithSignalA.setSignalA(signal);
+  hits.add<JPetHit>(hitWithSignalA);
+  JPetHit hitWithSignalB;
+  hitWithSignalB.setSignalB(signal);
+  hits.add<JPetHit>(hitWithSignalB);
+  hits.add<JPetHit>(JPetHit());
+  output.fill(hits);
+  tree.Fill();
+
+  JPetHitColumns input;
+  BOOST_REQUIRE_EQUAL(input.setBranchAddresses(tree, JPetHitColumns::kAll), JPetHitColumns::kAll);
+  BOOST_REQUIRE(tree.GetEntry(0) > 0);
+  BOOST_REQUIRE_EQUAL(input.getSignalFlags().size(), 3u);
+  BOOST_REQUIRE_EQUAL(input.getSignalFlags()[0], JPetHitColumns::kSignalASet);
+  BOOST_REQUIRE_EQUAL(input.getSignalFlags()[2], 0);
+  JPetTimeWindow window("JPetHit");
+  input.fillTimeWindow(window);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 3u);
+  BOOST_REQUIRE(window.getEvent<JPetHit>(0).isSignalASet());
+  BOOST_REQUIRE(!window.getEvent<JPetHit>(0).isSignalBSet());
+  BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(0).getSignalA().getTime(), 5.0f);
+  BOOST_REQUIRE(!window.getEvent<JPetHit>(1).isSignalASet());
+  BOOST_REQUIRE(window.getEvent<JPetHit>(1).isSignalBSet());
+  BOOST_REQUIRE(!window.getEvent<JPetHit>(2).isSignalASet());
+  BOOST_REQUIRE(!window.getEvent<JPetHit>(2).isSignalBSet());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,215 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitCombinatoricsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHitCombinatoricsTest
+
+#include "JPetHitCombinatorics/JPetHitCombinatorics.h"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace
+{
+/// Two layers of 48 slots, the barrel slot IDs are 1-48 in the first layer and 49-96 in the second one
+const JPetParamBank& fillBank(JPetParamBank& bank)
+{
+  bank.addLayer(JPetLayer(1, true, "Layer01", 42.5));
+  bank.addLayer(JPetLayer(2, true, "Layer02", 46.75));
+  for (int layer = 1; layer <= 2; layer++)
+  {
+    for (int i = 0; i < 48; i++)
+    {
+      JPetBarrelSlot slot((layer - 1) * 48 + i + 1, true, "", 7.5 * i, i + 1);
+      slot.setLayer(bank.getLayer(layer));
+      bank.addBarrelSlot(slot);
+    }
+  }
+  return bank;
+}
+
+JPetHit createHit(int barrelSlotID, float time, float energy = 200.f)
+{
+  JPetHit hit;
+  hit.setBarrelSlotID(barrelSlotID);
+  hit.setTime(time);
+  hit.setEnergy(energy);
+  return hit;
+}
+
+std::vector<JPetHit> createRandomHits(std::size_t numberOfHits, float timeRange, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int> slots(0, 97);
+  std::uniform_real_distribution<float> times(0.f, timeRange);
+  std::uniform_real_distribution<float> energies(0.f, 600.f);
+  std::vector<JPetHit> hits;
+  for (std::size_t i = 0; i < numberOfHits; i++)
+  {
+    hits.push_back(createHit(slots(generator), times(generator), energies(generator)));
+  }
+  /// hits at the same time to check the ordering of the candidates
+  hits[1].setTime(hits[0].getTime());
+  return hits;
+}
+
+template <typename Tuple>
+std::vector<Tuple> sorted(std::vector<Tuple> tuples)
+{
+  std::sort(tuples.begin(), tuples.end());
+  return tuples;
+}
+
+struct BankFixture
+{
+  BankFixture() : fMapping(fillBank(fBank)) {}
+  JPetParamBank fBank;
+  JPetGeomMapping fMapping;
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(JPetHitCombinatoricsTestSuite, BankFixture)
+
+BOOST_AUTO_TEST_CASE(pairs_fulfill_the_cuts)
+{
+  JPetHitCombinatorics::Cuts cuts;
+  cuts.maxTimeDiff = 10.;
+  cuts.minDeltaID = 20;
+  cuts.minEnergy = 100.;
+  JPetHitCombinatorics combinatorics(fMapping, cuts);
+  std::vector<JPetHit> hits = {createHit(1, 5.f), createHit(25, 0.f), createHit(2, 1.f), createHit(45, 30.f), createHit(21, 38.f),
+                               createHit(70, 2.f), createHit(22, 3.f, 50.f), createHit(-1, 4.f)};
+  std::vector<JPetHitCombinatorics::Pair> pairs;
+  BOOST_REQUIRE_EQUAL(combinatorics.findPairs(hits, pairs), 6u);
+  /// the delta ID cut does not apply to the hits from different layers
+  std::vector<JPetHitCombinatorics::Pair> expected = {{{1, 0}}, {{1, 2}}, {{5, 0}}, {{1, 5}}, {{2, 5}}, {{3, 4}}};
+  BOOST_REQUIRE(sorted(pairs) == sorted(expected));
+  /// the earlier hit is the first one
+  for (const auto& pair : pairs)
+  {
+    BOOST_REQUIRE(hits[pair[0]].getTime() <= hits[pair[1]].getTime());
+  }
+  BOOST_REQUIRE(!combinatorics.isAccepted(hits[6]));
+  BOOST_REQUIRE(!combinatorics.isAccepted(hits[7]));
+  BOOST_REQUIRE(combinatorics.areCompatible(hits[0], hits[1]));
+  BOOST_REQUIRE(!combinatorics.areCompatible(hits[0], hits[2]));
+
+  cuts.sameLayerOnly = true;
+  combinatorics.setCuts(cuts);
+  BOOST_REQUIRE_EQUAL(combinatorics.findPairs(hits, pairs), 3u);
+  BOOST_REQUIRE(std::none_of(pairs.begin(), pairs.end(), [](const JPetHitCombinatorics::Pair& pair) { return pair[0] == 5 || pair[1] == 5; }));
+}
+
+BOOST_AUTO_TEST_CASE(triplets_fulfill_the_cuts_for_each_pair)
+{
+  JPetHitCombinatorics::Cuts cuts;
+  cuts.maxTimeDiff = 10.;
+  cuts.minDeltaID = 10;
+  JPetHitCombinatorics combinatorics(fMapping, cuts);
+  std::vector<JPetHit> hits = {createHit(33, 8.f), createHit(1, 0.f), createHit(17, 4.f), createHit(20, 6.f), createHit(40, 12.f)};
+  std::vector<JPetHitCombinatorics::Triplet> triplets;
+  BOOST_REQUIRE_EQUAL(combinatorics.findTriplets(hits, triplets), 2u);
+  std::vector<JPetHitCombinatorics::Triplet> expected = {{{1, 2, 0}}, {{1, 3, 0}}};
+  BOOST_REQUIRE(sorted(triplets) == sorted(expected));
+
+  JPetEvent event(hits, JPetEventType::k3Gamma);
+  BOOST_REQUIRE_EQUAL(combinatorics.findTriplets(event, triplets), 2u);
+  std::vector<JPetHitCombinatorics::Pair> pairs;
+  BOOST_REQUIRE_EQUAL(combinatorics.findPairs(event, pairs), 7u);
+  std::vector<JPetHit> empty;
+  BOOST_REQUIRE_EQUAL(combinatorics.findTriplets(empty, triplets), 0u);
+  BOOST_REQUIRE(triplets.empty());
+}
+
+BOOST_AUTO_TEST_CASE(same_candidates_as_naive_loops)
+{
+  auto hits = createRandomHits(300, 100000.f, 7);
+  std::vector<JPetHitCombinatorics::Cuts> allCuts(4);
+  allCuts[1].maxTimeDiff = 2000.;
+  allCuts[2].maxTimeDiff = 5000.;
+  allCuts[2].minDeltaID = 5;
+  allCuts[2].maxDeltaID = 20;
+  allCuts[2].minEnergy = 100.;
+  allCuts[3] = allCuts[2];
+  allCuts[3].sameLayerOnly = true;
+  for (const auto& cuts : allCuts)
+  {
+    JPetHitCombinatorics combinatorics(fMapping, cuts);
+    std::vector<JPetHitCombinatorics::Pair> pairs, naivePairs;
+    combinatorics.findPairs(hits, pairs);
+    combinatorics.findPairsNaive(hits, naivePairs);
+    BOOST_REQUIRE(!naivePairs.empty());
+    BOOST_REQUIRE(sorted(pairs) == sorted(naivePairs));
+  }
+  hits.resize(120);
+  for (const auto& cuts : allCuts)
+  {
+    JPetHitCombinatorics combinatorics(fMapping, cuts);
+    std::vector<JPetHitCombinatorics::Triplet> triplets, naiveTriplets;
+    combinatorics.findTriplets(hits, triplets);
+    combinatorics.findTripletsNaive(hits, naiveTriplets);
+    BOOST_REQUIRE(!naiveTriplets.empty());
+    BOOST_REQUIRE(sorted(triplets) == sorted(naiveTriplets));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(combinatorics_benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+  /// about 10 hits per microsecond
+  auto hits = createRandomHits(2000, 200000.f, 11);
+  JPetHitCombinatorics::Cuts cuts;
+  cuts.maxTimeDiff = 3000.;
+  cuts.minDeltaID = 3;
+  cuts.minEnergy = 100.;
+  JPetHitCombinatorics combinatorics(fMapping, cuts);
+  const int repetitions = 5;
+
+  std::vector<JPetHitCombinatorics::Pair> pairs, naivePairs;
+  auto start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    combinatorics.findPairsNaive(hits, naivePairs);
+  }
+  auto naiveTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    combinatorics.findPairs(hits, pairs);
+  }
+  auto prunedTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  BOOST_TEST_MESSAGE("pairs of " << hits.size() << " hits: naive " << naiveTime / repetitions << " us, pruned " << prunedTime / repetitions
+                                 << " us, " << pairs.size() << " candidates");
+  BOOST_REQUIRE(sorted(pairs) == sorted(naivePairs));
+
+  hits.resize(400);
+  std::vector<JPetHitCombinatorics::Triplet> triplets, naiveTriplets;
+  start = Clock::now();
+  combinatorics.findTripletsNaive(hits, naiveTriplets);
+  naiveTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    combinatorics.findTriplets(hits, triplets);
+  }
+  prunedTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  BOOST_TEST_MESSAGE("triplets of " << hits.size() << " hits: naive " << naiveTime << " us, pruned " << prunedTime / repetitions << " us, "
+                                    << triplets.size() << " candidates");
+  BOOST_REQUIRE(sorted(triplets) == sorted(naiveTriplets));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetPrefetchReaderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetPrefetchReaderTest
+
+#include "JPetPrefetchReader/JPetPrefetchReader.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+
+#include <TError.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+const char* kTestFile = "unitTestData/JPetReaderTest/timewindows_v2.root";
+
+std::size_t getNumberOfEvents(JPetReader& reader)
+{
+  return dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents();
+}
+
+BOOST_AUTO_TEST_SUITE(JPetPrefetchReaderTestSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetPrefetchReader reader;
+  BOOST_REQUIRE_EQUAL(reader.getEntriesToPrefetch(), JPetPrefetchReader::kDefaultEntriesToPrefetch);
+  BOOST_REQUIRE_EQUAL(std::string(reader.getCurrentEntry().GetName()), std::string("Empty event"));
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE(!reader.nextEntry());
+  BOOST_REQUIRE(!reader.firstEntry());
+  BOOST_REQUIRE(!reader.lastEntry());
+  BOOST_REQUIRE(!reader.nthEntry(0));
+  BOOST_REQUIRE(!reader.nthEntry(-1));
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), -1);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 0);
+  BOOST_REQUIRE(!reader.getObjectFromFile("testObj"));
+}
+
+BOOST_AUTO_TEST_CASE(bad_file)
+{
+  gErrorIgnoreLevel = 6000;
+  JPetPrefetchReader reader(2);
+  BOOST_REQUIRE(!reader.openFileAndLoadData("bad_file.txt", "tree"));
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE(!reader.nextEntry());
+  BOOST_REQUIRE(!reader.nthEntry(1));
+}
+
+BOOST_AUTO_TEST_CASE(same_entries_as_JPetReader)
+{
+  JPetReader reader(kTestFile, "tree");
+  std::vector<std::size_t> expected;
+  do
+  {
+    expected.push_back(getNumberOfEvents(reader));
+  } while (reader.nextEntry());
+  BOOST_REQUIRE_EQUAL(expected.size(), 10u);
+
+  for (std::size_t entriesToPrefetch : {1u, 3u, 20u})
+  {
+    JPetPrefetchReader prefetchReader(kTestFile, "tree", entriesToPrefetch);
+    BOOST_REQUIRE(prefetchReader.isOpen());
+    BOOST_REQUIRE_EQUAL(prefetchReader.getCurrentEntryNumber(), 0);
+    std::vector<std::size_t> result;
+    do
+    {
+      result.push_back(getNumberOfEvents(prefetchReader));
+    } while (prefetchReader.nextEntry());
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(result.begin(), result.end(), expected.begin(), expected.end());
+    BOOST_REQUIRE(prefetchReader.getQueueDepth() <= entriesToPrefetch);
+    BOOST_REQUIRE(prefetchReader.getAverageQueueDepth() <= entriesToPrefetch);
+    BOOST_REQUIRE(prefetchReader.getStallTimeInSeconds() >= 0.0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(random_access)
+{
+  JPetPrefetchReader reader(kTestFile, "tree", 2);
+  BOOST_REQUIRE(reader.nthEntry(5));
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 5);
+  BOOST_REQUIRE(reader.nextEntry());
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 6);
+  BOOST_REQUIRE(reader.lastEntry());
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 9);
+  BOOST_REQUIRE(!reader.nextEntry());
+  BOOST_REQUIRE(reader.firstEntry());
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 0);
+  BOOST_REQUIRE(!reader.nthEntry(10));
+  BOOST_REQUIRE(reader.getHeaderClone());
+  BOOST_REQUIRE(reader.getObjectFromFile("tree"));
+}
+
+BOOST_AUTO_TEST_CASE(last_entry_to_read)
+{
+  JPetPrefetchReader reader(kTestFile, "tree", 4);
+  reader.setLastEntryToRead(2);
+  BOOST_REQUIRE(reader.nthEntry(1));
+  BOOST_REQUIRE(reader.nextEntry());
+  BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 2);
+  BOOST_REQUIRE(!reader.nextEntry());
+}
+
+BOOST_AUTO_TEST_CASE(closeFile)
+{
+  JPetPrefetchReader reader(kTestFile, "tree");
+  BOOST_REQUIRE(reader.isOpen());
+  reader.closeFile();
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE_EQUAL(std::string(reader.getCurrentEntry().GetName()), std::string("Empty event"));
+  BOOST_REQUIRE(!reader.nextEntry());
+  BOOST_REQUIRE(!reader.firstEntry());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
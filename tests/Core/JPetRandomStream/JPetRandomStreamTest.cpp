@@ -0,0 +1,90 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRandomStreamTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetRandomStreamTest
+
+#include "JPetRandomStream/JPetRandomStream.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JPetRandomStreamTestSuite)
+
+BOOST_AUTO_TEST_CASE(same_stream_gives_the_same_numbers)
+{
+  JPetRandomStream first(42, 3, 1000);
+  JPetRandomStream second(7, 0, 0);
+  second.setStream(42, 3, 1000);
+  for (int i = 0; i < 100; i++)
+  {
+    BOOST_REQUIRE_EQUAL(first.Rndm(), second.Rndm());
+  }
+  BOOST_REQUIRE_EQUAL(first.getCounter(), 100u);
+  first.setEventIndex(1000);
+  BOOST_REQUIRE_EQUAL(first.getCounter(), 0u);
+  second.setStream(42, 3, 1000);
+  BOOST_REQUIRE_EQUAL(first.Gaus(1., 2.), second.Gaus(1., 2.));
+  BOOST_REQUIRE_EQUAL(first.Exp(5.), second.Exp(5.));
+}
+
+BOOST_AUTO_TEST_CASE(streams_do_not_depend_on_the_order_of_events)
+{
+  JPetRandomStream stream(42, 1, 0);
+  std::vector<double> inOrder;
+  for (int event = 0; event < 10; event++)
+  {
+    stream.setEventIndex(event);
+    inOrder.push_back(stream.Rndm());
+  }
+  for (int event = 9; event >= 0; event--)
+  {
+    stream.setEventIndex(event);
+    BOOST_REQUIRE_EQUAL(stream.Rndm(), inOrder[event]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(different_streams_are_different)
+{
+  BOOST_REQUIRE(JPetRandomStream::deriveKey(1, 0, 0) != JPetRandomStream::deriveKey(2, 0, 0));
+  BOOST_REQUIRE(JPetRandomStream::deriveKey(1, 0, 0) != JPetRandomStream::deriveKey(1, 1, 0));
+  BOOST_REQUIRE(JPetRandomStream::deriveKey(1, 0, 0) != JPetRandomStream::deriveKey(1, 0, 1));
+  BOOST_REQUIRE(JPetRandomStream::deriveKey(1, 0, 1) != JPetRandomStream::deriveKey(1, 1, 0));
+  JPetRandomStream first(1, 0, 0);
+  JPetRandomStream second(1, 0, 1);
+  BOOST_REQUIRE(first.Rndm() != second.Rndm());
+}
+
+BOOST_AUTO_TEST_CASE(numbers_are_uniform_in_open_unit_interval)
+{
+  JPetRandomStream stream(123, 0, 0);
+  const int kNumberOfValues = 100000;
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  for (int i = 0; i < kNumberOfValues; i++)
+  {
+    double value = stream.Rndm();
+    BOOST_REQUIRE(value > 0.0 && value < 1.0);
+    sum += value;
+    sumOfSquares += value * value;
+  }
+  double mean = sum / kNumberOfValues;
+  double variance = sumOfSquares / kNumberOfValues - mean * mean;
+  BOOST_REQUIRE_CLOSE(mean, 0.5, 1.0);
+  BOOST_REQUIRE_CLOSE(variance, 1.0 / 12.0, 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStatisticsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetStatisticsTest
+
+#include "JPetStatistics/JPetStatistics.h"
+
+#include <TROOT.h>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JPetStatisticsTestSuite)
+
+BOOST_AUTO_TEST_CASE(histo_handle_of_missing_or_wrong_type_histogram_is_empty)
+{
+  JPetStatistics stats;
+  stats.createHistogram(new TH1F("h1", "h1", 10, 0.0, 10.0));
+  BOOST_REQUIRE(!stats.getHistoHandle<TH1F>("missing"));
+  BOOST_REQUIRE(!stats.getHistoHandle<TH2F>("h1"));
+  auto handle = stats.getHistoHandle<TH1F>("h1");
+  BOOST_REQUIRE(handle);
+  BOOST_REQUIRE_EQUAL(handle.get(), stats.getHisto1D("h1"));
+}
+
+BOOST_AUTO_TEST_CASE(fill_through_empty_handle_is_ignored)
+{
+  JPetStatistics stats;
+  stats.createHistogram(new TH1F("h1", "h1", 10, 0.0, 10.0));
+  auto missing = stats.getHistoHandle<TH1F>("missing");
+  auto wrongType = stats.getHistoHandle<TH2F>("h1");
+  std::vector<double> x = {1.0, 2.0};
+  stats.fill(missing, 1.0);
+  stats.fill(missing, x);
+  stats.fill(wrongType, 1.0, 2.0);
+  stats.fill(wrongType, x, x);
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D("h1")->GetEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(fill_through_handle)
+{
+  JPetStatistics stats;
+  stats.createHistogram(new TH1F("h1", "h1", 10, 0.0, 10.0));
+  stats.createHistogram(new TH2F("h2", "h2", 10, 0.0, 10.0, 10, 0.0, 10.0));
+  auto h1 = stats.getHistoHandle<TH1F>("h1");
+  auto h2 = stats.getHistoHandle<TH2F>("h2");
+  stats.fill(h1, 1.5);
+  stats.fill(h2, 1.5, 2.5);
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D("h1")->GetEntries(), 1);
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D("h1")->GetBinContent(2), 1);
+  BOOST_REQUIRE_EQUAL(stats.getHisto2D("h2")->GetBinContent(2, 3), 1);
+}
+
+BOOST_AUTO_TEST_CASE(batch_fill_gives_the_same_result_as_single_fills)
+{
+  JPetStatistics stats;
+  stats.createHistogram(new TH1F("single", "single", 10, 0.0, 10.0));
+  stats.createHistogram(new TH1F("batch", "batch", 10, 0.0, 10.0));
+  stats.createHistogram(new TH1F("batchFloat", "batchFloat", 10, 0.0, 10.0));
+  stats.createHistogram(new TH2F("single2D", "single2D", 10, 0.0, 10.0, 10, 0.0, 10.0));
+  stats.createHistogram(new TH2F("batch2D", "batch2D", 10, 0.0, 10.0, 10, 0.0, 10.0));
+  std::vector<double> x = {0.5, 1.5, 1.7, 9.9, 12.0, -1.0};
+  std::vector<double> y = {3.5, 2.5, 2.7, 0.1, 1.0, 5.0};
+  std::vector<float> xFloat(x.begin(), x.end());
+  auto single = stats.getHistoHandle<TH1F>("single");
+  auto single2D = stats.getHistoHandle<TH2F>("single2D");
+  for (std::size_t i = 0; i < x.size(); i++)
+  {
+    stats.fill(single, x[i]);
+    stats.fill(single2D, x[i], y[i]);
+  }
+  stats.fill(stats.getHistoHandle<TH1F>("batch"), x);
+  stats.fill(stats.getHistoHandle<TH1F>("batchFloat"), xFloat);
+  stats.fill(stats.getHistoHandle<TH2F>("batch2D"), x, y);
+  for (int bin = 0; bin <= 11; bin++)
+  {
+    BOOST_REQUIRE_EQUAL(stats.getHisto1D("single")->GetBinContent(bin), stats.getHisto1D("batch")->GetBinContent(bin));
+    BOOST_REQUIRE_EQUAL(stats.getHisto1D("single")->GetBinContent(bin), stats.getHisto1D("batchFloat")->GetBinContent(bin));
+    for (int binY = 0; binY <= 11; binY++)
+    {
+      BOOST_REQUIRE_EQUAL(stats.getHisto2D("single2D")->GetBinContent(bin, binY), stats.getHisto2D("batch2D")->GetBinContent(bin, binY));
+    }
+  }
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D("single")->GetEntries(), stats.getHisto1D("batch")->GetEntries());
+}
+
+BOOST_AUTO_TEST_CASE(merge_of_statistics_shards)
+{
+  ROOT::EnableThreadSafety();
+  const int kNumberOfShards = 4;
+  const int kFillsPerShard = 1000;
+  JPetStatistics master;
+  master.createHistogram(new TH1F("h1", "h1", 10, 0.0, 10.0));
+  master.createCounter("counter");
+  master.getCounter("counter") = 1;
+  JPetStatisticsShards shards(master);
+  for (int i = 0; i < kNumberOfShards; i++)
+  {
+    auto& shard = shards.createShard();
+    TDirectory::TContext directoryContext(nullptr);
+    shard.createHistogram(new TH1F("h1", "h1", 10, 0.0, 10.0));
+    shard.createHistogram(new TH1F("onlyInShards", "onlyInShards", 10, 0.0, 10.0));
+    shard.createCounter("counter");
+  }
+  BOOST_REQUIRE_EQUAL(shards.getNumberOfShards(), kNumberOfShards);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumberOfShards; i++)
+  {
+    threads.emplace_back([&shards, i]() {
+      auto& shard = shards.getShard(i);
+      auto h1 = shard.getHistoHandle<TH1F>("h1");
+      auto onlyInShards = shard.getHistoHandle<TH1F>("onlyInShards");
+      for (int j = 0; j < kFillsPerShard; j++)
+      {
+        shard.fill(h1, i);
+        shard.fill(onlyInShards, i);
+        shard.getCounter("counter")++;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  shards.mergeIntoMaster();
+  BOOST_REQUIRE_EQUAL(shards.getNumberOfShards(), 0);
+  BOOST_REQUIRE_EQUAL(master.getCounter("counter"), 1 + kNumberOfShards * kFillsPerShard);
+  BOOST_REQUIRE_EQUAL(master.getHisto1D("h1")->GetEntries(), kNumberOfShards * kFillsPerShard);
+  BOOST_REQUIRE(master.getHisto1D("onlyInShards"));
+  for (int i = 0; i < kNumberOfShards; i++)
+  {
+    BOOST_REQUIRE_EQUAL(master.getHisto1D("h1")->GetBinContent(i + 1), kFillsPerShard);
+    BOOST_REQUIRE_EQUAL(master.getHisto1D("onlyInShards")->GetBinContent(i + 1), kFillsPerShard);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,13 +18,17 @@
 
 #include "JPetTaskChainExecutor/JPetTaskChainExecutor.h"
 #include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetEvent/JPetEvent.h"
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsGenerator.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetReader/JPetReader.h"
 #include "JPetTaskIO/JPetTaskIO.h"
 #include "JPetTaskIOLoopPerSubTask/JPetTaskIOLoopPerSubTask.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
 #include "JPetUserTask/JPetUserTask.h"
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 class TestTask : public JPetUserTask
@@ -44,6 +48,70 @@ public:
   bool terminate() override { return true; }
 };
 
+/// Runs the chain of three tasks forwarding the time windows, serially or as a pipeline,
+/// with the output files written to the given directory.
+bool processThreeTaskChain(bool isPipelined, const std::string& outputPath)
+{
+  boost::filesystem::create_directories(outputPath);
+  auto opt = jpet_options_generator_tools::getDefaultOptions();
+  opt["inputFile_std::string"] = std::string("unitTestData/JPetTaskChainExecutorTest/dabc_17025151847.unk.evt.root");
+  opt["inputFileType_std::string"] = std::string("root");
+  opt["outputPath_std::string"] = outputPath;
+  opt["pipelinedProcessing_bool"] = isPipelined;
+  opt[JPetTaskChainExecutor::kPipelineQueueSizeKey] = 2;
+  opt[JPetTaskChainExecutor::kSkipOutputEventsKey] = std::vector<std::string>{"TaskB"};
+  auto generator = [](const char* name, const char* inType, const char* outType) {
+    return [name, inType, outType]() {
+      auto taskIO = jpet_common_tools::make_unique<JPetTaskIOLoopPerSubTask>(name, inType, outType);
+      taskIO->addSubTask(std::unique_ptr<TestTask>(new TestTask((std::string(name) + " TestTask").c_str())));
+      return taskIO;
+    };
+  };
+  TaskGeneratorChain chain;
+  chain.push_back(generator("TaskA", "unk.evt", "pipe1.file"));
+  chain.push_back(generator("TaskB", "pipe1.file", "pipe2.file"));
+  chain.push_back(generator("TaskC", "pipe2.file", "pipe3.file"));
+  JPetTaskChainExecutor taskExecutor(chain, 1, opt);
+  return taskExecutor.process();
+}
+
+/// Compares the entries of the trees of time windows saved in two files, event by event.
+void compareTimeWindowFiles(const std::string& firstFile, const std::string& secondFile)
+{
+  JPetReader first;
+  JPetReader second;
+  BOOST_REQUIRE(first.openFileAndLoadData(firstFile.c_str(), JPetReader::kRootTreeName.c_str()));
+  BOOST_REQUIRE(second.openFileAndLoadData(secondFile.c_str(), JPetReader::kRootTreeName.c_str()));
+  BOOST_REQUIRE_GT(first.getNbOfAllEntries(), 0);
+  BOOST_REQUIRE_EQUAL(first.getNbOfAllEntries(), second.getNbOfAllEntries());
+  for (long long entry = 0; entry < first.getNbOfAllEntries(); entry++)
+  {
+    BOOST_REQUIRE(first.nthEntry(entry));
+    BOOST_REQUIRE(second.nthEntry(entry));
+    auto firstWindow = dynamic_cast<JPetTimeWindow*>(&first.getCurrentEntry());
+    auto secondWindow = dynamic_cast<JPetTimeWindow*>(&second.getCurrentEntry());
+    BOOST_REQUIRE(firstWindow);
+    BOOST_REQUIRE(secondWindow);
+    BOOST_REQUIRE_EQUAL(std::string(firstWindow->getEventType()), std::string(secondWindow->getEventType()));
+    BOOST_REQUIRE_EQUAL(firstWindow->getNumberOfEvents(), secondWindow->getNumberOfEvents());
+    for (std::size_t i = 0; i < firstWindow->getNumberOfEvents(); i++)
+    {
+      BOOST_REQUIRE_EQUAL(std::string((*firstWindow)[i].ClassName()), std::string((*secondWindow)[i].ClassName()));
+      auto firstEvent = dynamic_cast<const JPetEvent*>(&(*firstWindow)[i]);
+      auto secondEvent = dynamic_cast<const JPetEvent*>(&(*secondWindow)[i]);
+      if (firstEvent && secondEvent)
+      {
+        BOOST_REQUIRE_EQUAL(firstEvent->getHits().size(), secondEvent->getHits().size());
+        for (std::size_t j = 0; j < firstEvent->getHits().size(); j++)
+        {
+          BOOST_REQUIRE_EQUAL(firstEvent->getHits()[j].getTime(), secondEvent->getHits()[j].getTime());
+          BOOST_REQUIRE_EQUAL(firstEvent->getHits()[j].getEnergy(), secondEvent->getHits()[j].getEnergy());
+        }
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(JPetTaskChainExecutorTestSuite)
 
 BOOST_AUTO_TEST_CASE(test0)
@@ -91,4 +159,15 @@ BOOST_AUTO_TEST_CASE(test2)
   BOOST_REQUIRE(taskExecutor.process());
 }
 
+BOOST_AUTO_TEST_CASE(pipelined_chain)
+{
+  const std::string serialPath = "JPetTaskChainExecutorTestSerial/";
+  const std::string pipelinedPath = "JPetTaskChainExecutorTestPipeline/";
+  BOOST_REQUIRE(processThreeTaskChain(false, serialPath));
+  BOOST_REQUIRE(processThreeTaskChain(true, pipelinedPath));
+  compareTimeWindowFiles(serialPath + "dabc_17025151847.pipe3.file.root", pipelinedPath + "dabc_17025151847.pipe3.file.root");
+  boost::filesystem::remove_all(serialPath);
+  boost::filesystem::remove_all(pipelinedPath);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -203,4 +203,31 @@ BOOST_AUTO_TEST_CASE(getNextEntry)
   BOOST_REQUIRE(!handler.nextEntry());
 }
 
+BOOST_AUTO_TEST_CASE(getNextEntryWithPrefetching)
+{
+  using namespace jpet_options_generator_tools;
+  auto opts = getDefaultOptions();
+
+  opts["firstEvent_int"] = -1;
+  opts["lastEvent_int"] = 5;
+  opts[JPetInputHandler::kPrefetchEntriesKey] = 3;
+  auto mgr = std::make_shared<JPetParamManager>(new JPetParamManager(new JPetParamGetterAscii(dataFileName)));
+  JPetParams params(opts, mgr);
+
+  JPetInputHandler handler;
+  BOOST_REQUIRE(handler.openInput(kInputTestFile, params));
+  BOOST_REQUIRE(handler.setEntryRange(opts));
+  BOOST_REQUIRE_EQUAL(getEntrysInWindow(handler), 15);
+  BOOST_REQUIRE(handler.nextEntry());
+  BOOST_REQUIRE_EQUAL(getEntrysInWindow(handler), 10);
+  BOOST_REQUIRE(handler.nextEntry());
+  BOOST_REQUIRE_EQUAL(getEntrysInWindow(handler), 6);
+  BOOST_REQUIRE_EQUAL(handler.getCurrentEntryNumber(), 2);
+  BOOST_REQUIRE(handler.nextEntry());
+  BOOST_REQUIRE(handler.nextEntry());
+  BOOST_REQUIRE(handler.nextEntry());
+  BOOST_REQUIRE(!handler.nextEntry());
+  handler.closeInput();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,8 @@
 #include "./JPetUserTask/JPetUserTask.h"
 #include "./JPetCommonTools/JPetCommonTools.h"
 #include "./JPetDataInterface/JPetDataInterface.h"
+#include "./JPetReader/JPetReader.h"
+#include "./JPetSigCh/JPetSigCh.h"
 #include <boost/test/unit_test.hpp>
 
 class JPetTaskTest: public JPetUserTask
@@ -74,6 +76,106 @@ protected:
   }
 };
 
+class JPetTaskWindowSize: public JPetUserTask
+{
+public:
+  explicit JPetTaskWindowSize(const char* name): JPetUserTask(name) {}
+  virtual ~JPetTaskWindowSize()
+  {
+    ;
+  }
+  bool isEntryIndependent() const override
+  {
+    return true;
+  }
+
+protected:
+  bool init()
+  {
+    fOutputEvents = new JPetTimeWindow("JPetSigCh");
+    getStatistics().createCounter("processedWindows");
+    return true;
+  }
+  bool exec()
+  {
+    auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent);
+    JPetSigCh sigCh;
+    sigCh.setValue(timeWindow ? timeWindow->getNumberOfEvents() : -1.0f);
+    fOutputEvents->add<JPetSigCh>(sigCh);
+    getStatistics().getCounter("processedWindows")++;
+    return true;
+  }
+  bool terminate()
+  {
+    return true;
+  }
+};
+
+/// Task saving the number of windows processed so far, so its output depends on the previous entries
+class JPetTaskWindowCounter: public JPetUserTask
+{
+public:
+  explicit JPetTaskWindowCounter(const char* name): JPetUserTask(name) {}
+  virtual ~JPetTaskWindowCounter()
+  {
+    ;
+  }
+
+protected:
+  bool init()
+  {
+    fOutputEvents = new JPetTimeWindow("JPetSigCh");
+    getStatistics().createCounter("processedWindows");
+    return true;
+  }
+  bool exec()
+  {
+    fProcessedWindows++;
+    JPetSigCh sigCh;
+    sigCh.setValue(fProcessedWindows);
+    fOutputEvents->add<JPetSigCh>(sigCh);
+    getStatistics().getCounter("processedWindows")++;
+    return true;
+  }
+  bool terminate()
+  {
+    return true;
+  }
+
+  int fProcessedWindows = 0;
+};
+
+/// Runs the stream with the given number of workers and returns the values saved in the output file
+/// together with the number of processed windows counted by the subtask statistics.
+template <typename Task>
+std::pair<std::vector<float>, double> runWindowSizeStream(int numberOfWorkers)
+{
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts["inputFile_std::string"] = std::string("unitTestData/JPetTaskChainExecutorTest/dabc_17025151847.unk.evt.root");
+  opts[JPetTaskStreamIO::kNumberOfWorkersKey] = numberOfWorkers;
+  auto mgr = std::make_shared<JPetParamManager>(new JPetParamManager);
+  JPetParams params(opts, mgr);
+  JPetTaskStreamIO taskStreamIO("myTestIO", "unk.evt", "out");
+  taskStreamIO.addSubTaskGenerator([]() { return jpet_common_tools::make_unique<Task>("windowSizeTask"); });
+  BOOST_REQUIRE(taskStreamIO.init(params));
+  JPetDataInterface pseudoData;
+  BOOST_REQUIRE(taskStreamIO.run(pseudoData));
+  auto subTask = dynamic_cast<JPetUserTask*>(taskStreamIO.getSubTasks().front());
+  BOOST_REQUIRE(subTask);
+  auto processedWindows = subTask->getStatistics().getCounter("processedWindows");
+  BOOST_REQUIRE(taskStreamIO.terminate(params));
+
+  std::vector<float> values;
+  JPetReader reader("unitTestData/JPetTaskChainExecutorTest/dabc_17025151847.out.root");
+  for (long long i = 0; i < reader.getNbOfAllEntries(); i++)
+  {
+    reader.nthEntry(i);
+    auto& timeWindow = dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry());
+    values.push_back(timeWindow.getEvent<JPetSigCh>(0).getValue());
+  }
+  return std::make_pair(values, processedWindows);
+}
+
 BOOST_AUTO_TEST_SUITE( FirstSuite )
 
 BOOST_AUTO_TEST_CASE(Run_ok)
@@ -107,4 +209,28 @@ BOOST_AUTO_TEST_CASE(Any_subtask_init_failed)
   BOOST_REQUIRE(!taskStreamIO.run(pseudoData));
 }
 
+BOOST_AUTO_TEST_CASE(Parallel_output_matches_serial_output)
+{
+  auto serial = runWindowSizeStream<JPetTaskWindowSize>(1);
+  auto parallel = runWindowSizeStream<JPetTaskWindowSize>(4);
+  BOOST_REQUIRE(!serial.first.empty());
+  BOOST_REQUIRE_EQUAL(serial.first.size(), parallel.first.size());
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(serial.first.begin(), serial.first.end(), parallel.first.begin(), parallel.first.end());
+  BOOST_REQUIRE_EQUAL(serial.second, parallel.second);
+  BOOST_REQUIRE_EQUAL(serial.second, serial.first.size());
+}
+
+BOOST_AUTO_TEST_CASE(Entry_dependent_subtask_is_processed_serially)
+{
+  auto serial = runWindowSizeStream<JPetTaskWindowCounter>(1);
+  auto parallel = runWindowSizeStream<JPetTaskWindowCounter>(4);
+  BOOST_REQUIRE(!serial.first.empty());
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(serial.first.begin(), serial.first.end(), parallel.first.begin(), parallel.first.end());
+  for (std::size_t i = 0; i < parallel.first.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(parallel.first[i], i + 1);
+  }
+  BOOST_REQUIRE_EQUAL(parallel.second, parallel.first.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
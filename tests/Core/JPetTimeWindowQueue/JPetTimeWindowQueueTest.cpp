@@ -0,0 +1,97 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTimeWindowQueueTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetTimeWindowQueueTest
+
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindowQueue/JPetTimeWindowQueue.h"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+std::unique_ptr<JPetTimeWindow> createWindow(int numberOfEvents)
+{
+  auto window = jpet_common_tools::make_unique<JPetTimeWindow>("JPetSigCh");
+  for (int i = 0; i < numberOfEvents; i++)
+  {
+    window->add<JPetSigCh>(JPetSigCh());
+  }
+  return window;
+}
+
+BOOST_AUTO_TEST_SUITE(JPetTimeWindowQueueTestSuite)
+
+BOOST_AUTO_TEST_CASE(capacity_is_at_least_one)
+{
+  JPetTimeWindowQueue queue(0);
+  BOOST_REQUIRE_EQUAL(queue.getCapacity(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(windows_are_passed_in_order)
+{
+  const int kNumberOfWindows = 100;
+  JPetTimeWindowQueue queue(4);
+  std::thread producer([&queue]() {
+    for (int i = 0; i < kNumberOfWindows; i++)
+    {
+      queue.push(createWindow(i % 7));
+    }
+    queue.close();
+  });
+  std::vector<int> sizes;
+  std::unique_ptr<JPetTimeWindow> window;
+  while (queue.pop(window))
+  {
+    sizes.push_back(window->getNumberOfEvents());
+  }
+  producer.join();
+  BOOST_REQUIRE_EQUAL(sizes.size(), kNumberOfWindows);
+  for (int i = 0; i < kNumberOfWindows; i++)
+  {
+    BOOST_REQUIRE_EQUAL(sizes[i], i % 7);
+  }
+  BOOST_REQUIRE(!queue.isAborted());
+}
+
+BOOST_AUTO_TEST_CASE(closed_queue_can_be_emptied)
+{
+  JPetTimeWindowQueue queue(2);
+  BOOST_REQUIRE(queue.push(createWindow(1)));
+  queue.close();
+  BOOST_REQUIRE(!queue.push(createWindow(2)));
+  std::unique_ptr<JPetTimeWindow> window;
+  BOOST_REQUIRE(queue.pop(window));
+  BOOST_REQUIRE_EQUAL(window->getNumberOfEvents(), 1u);
+  BOOST_REQUIRE(!queue.pop(window));
+}
+
+BOOST_AUTO_TEST_CASE(abort_unblocks_producer)
+{
+  JPetTimeWindowQueue queue(1);
+  BOOST_REQUIRE(queue.push(createWindow(1)));
+  bool pushResult = true;
+  std::thread producer([&queue, &pushResult]() { pushResult = queue.push(createWindow(1)); });
+  queue.abort();
+  producer.join();
+  BOOST_REQUIRE(!pushResult);
+  BOOST_REQUIRE(queue.isAborted());
+  std::unique_ptr<JPetTimeWindow> window;
+  BOOST_REQUIRE(!queue.pop(window));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
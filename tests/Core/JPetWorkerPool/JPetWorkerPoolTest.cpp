@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWorkerPoolTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetWorkerPoolTest
+
+#include "JPetWorkerPool/JPetWorkerPool.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(JPetWorkerPoolTestSuite)
+
+BOOST_AUTO_TEST_CASE(maxThreads_is_at_least_one)
+{
+  JPetWorkerPool pool(0);
+  BOOST_REQUIRE_EQUAL(pool.getMaxThreads(), 1);
+  BOOST_REQUIRE(JPetWorkerPool::getDefaultMaxThreads() >= 1);
+}
+
+BOOST_AUTO_TEST_CASE(empty_pool)
+{
+  JPetWorkerPool pool(4);
+  BOOST_REQUIRE(pool.run());
+}
+
+BOOST_AUTO_TEST_CASE(all_jobs_are_executed_within_the_thread_limit)
+{
+  const unsigned int kMaxThreads = 3;
+  const int kNumberOfJobs = 20;
+  std::atomic<int> executed(0);
+  std::atomic<int> running(0);
+  std::atomic<int> maxRunning(0);
+  JPetWorkerPool pool(kMaxThreads);
+  for (int i = 0; i < kNumberOfJobs; i++)
+  {
+    pool.addJob([&]() {
+      auto current = ++running;
+      auto previousMax = maxRunning.load();
+      while (current > previousMax && !maxRunning.compare_exchange_weak(previousMax, current))
+      {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --running;
+      ++executed;
+      return true;
+    });
+  }
+  BOOST_REQUIRE_EQUAL(pool.getNumberOfJobs(), kNumberOfJobs);
+  BOOST_REQUIRE(pool.run());
+  BOOST_REQUIRE_EQUAL(executed.load(), kNumberOfJobs);
+  BOOST_REQUIRE(maxRunning.load() <= static_cast<int>(kMaxThreads));
+  BOOST_REQUIRE_EQUAL(pool.getNumberOfJobs(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(failed_job_does_not_stop_other_jobs)
+{
+  std::atomic<int> executed(0);
+  JPetWorkerPool pool(2);
+  pool.addJob([&]() {
+    ++executed;
+    return false;
+  });
+  pool.addJob([&]() -> bool {
+    ++executed;
+    throw std::runtime_error("job error");
+  });
+  pool.addJob([&]() {
+    ++executed;
+    return true;
+  });
+  BOOST_REQUIRE(!pool.run());
+  BOOST_REQUIRE_EQUAL(executed.load(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -328,4 +328,112 @@ BOOST_AUTO_TEST_CASE(saving_ROOT_container_subdir)
   fread.Close();
 }
 
+BOOST_AUTO_TEST_CASE(async_writing_of_time_windows)
+{
+  auto fileTest = "asyncWritingTest.root";
+  const int kNumberOfWindows = 50;
+  JPetWriter writer(fileTest);
+  writer.enableAsyncWriting(2);
+  BOOST_REQUIRE(writer.isAsync());
+  for (int i = 0; i < kNumberOfWindows; i++)
+  {
+    auto window = writer.takeRecycledWindow("JPetSigCh");
+    if (!window)
+    {
+      window.reset(new JPetTimeWindow("JPetSigCh"));
+    }
+    BOOST_REQUIRE_EQUAL(window->getNumberOfEvents(), 0);
+    for (int j = 0; j <= i % 3; j++)
+    {
+      JPetSigCh sigCh;
+      sigCh.setValue(i);
+      window->add<JPetSigCh>(sigCh);
+    }
+    BOOST_REQUIRE(writer.write(std::move(window)));
+  }
+  writer.closeFile();
+  BOOST_REQUIRE(!writer.isAsync());
+  BOOST_REQUIRE(writer.getNumberOfBackpressureWaits() >= 0);
+
+  JPetReader reader(fileTest);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), kNumberOfWindows);
+  for (int i = 0; i < kNumberOfWindows; i++)
+  {
+    reader.nthEntry(i);
+    auto& window = dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry());
+    BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), i % 3 + 1);
+    BOOST_REQUIRE_EQUAL(window.getEvent<JPetSigCh>(0).getValue(), i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(async_writing_keeps_order_with_copied_windows)
+{
+  auto fileTest = "asyncWritingCopyTest.root";
+  JPetWriter writer(fileTest);
+  writer.enableAsyncWriting();
+  JPetTimeWindow window("JPetSigCh");
+  for (int i = 0; i < 10; i++)
+  {
+    window.Clear();
+    JPetSigCh sigCh;
+    sigCh.setValue(i);
+    window.add<JPetSigCh>(sigCh);
+    BOOST_REQUIRE(writer.write(window));
+  }
+  writer.waitForPendingWindows();
+  BOOST_REQUIRE(writer.takeRecycledWindow("JPetSigCh"));
+  BOOST_REQUIRE(!writer.takeRecycledWindow("JPetHit"));
+  writer.closeFile();
+
+  JPetReader reader(fileTest);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 10);
+  for (int i = 0; i < 10; i++)
+  {
+    reader.nthEntry(i);
+    auto& readWindow = dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry());
+    BOOST_REQUIRE_EQUAL(readWindow.getEvent<JPetSigCh>(0).getValue(), i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(writing_and_reading_hit_columns)
+{
+  auto fileTest = "hitColumnsTest.root";
+  JPetWriter writer(fileTest);
+  writer.setHitColumns(JPetHitColumns::kBasic);
+  for (int i = 0; i < 5; i++)
+  {
+    JPetTimeWindow window("JPetHit");
+    for (int j = 0; j <= i; j++)
+    {
+      JPetHit hit;
+      hit.setTime(i);
+      hit.setEnergy(j);
+      hit.setPos(1.0, 2.0, 3.0);
+      window.add<JPetHit>(hit);
+    }
+    BOOST_REQUIRE(writer.write(window));
+  }
+  /// windows of other types would corrupt the tree with the hit columns
+  JPetTimeWindow sigChWindow("JPetSigCh");
+  sigChWindow.add<JPetSigCh>(JPetSigCh());
+  BOOST_REQUIRE(!writer.write(sigChWindow));
+  writer.closeFile();
+
+  JPetReader reader;
+  reader.setHitColumns(JPetHitColumns::kTime | JPetHitColumns::kEnergy);
+  BOOST_REQUIRE(reader.openFileAndLoadData(fileTest));
+  BOOST_REQUIRE(reader.isHitColumnar());
+  BOOST_REQUIRE_EQUAL(reader.getHitColumns()->getColumns(), JPetHitColumns::kTime | JPetHitColumns::kEnergy);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 5);
+  for (int i = 0; i < 5; i++)
+  {
+    BOOST_REQUIRE(reader.nthEntry(i));
+    auto& window = dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry());
+    BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), i + 1);
+    BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(i).getTime(), i);
+    BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(i).getEnergy(), i);
+    BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(i).getPosZ(), 0.0);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
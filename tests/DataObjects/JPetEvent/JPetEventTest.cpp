@@ -21,6 +21,26 @@
 #include "JPetWriter/JPetWriter.h"
 
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+/// Number of calls of the global operator new, used by the event building benchmark
+static std::size_t gAllocations = 0;
+
+void* operator new(std::size_t size)
+{
+  gAllocations++;
+  if (void* ptr = std::malloc(size ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
 
 BOOST_AUTO_TEST_SUITE(FirstSuite)
 
@@ -253,4 +273,148 @@ BOOST_AUTO_TEST_CASE(addEventType3)
   BOOST_REQUIRE((type & JPetEventType::kScattered) != JPetEventType::kScattered);
 }
 
+BOOST_AUTO_TEST_CASE(constructor_movedHits)
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(3);
+  hits[1].setTime(1);
+  hits[2].setTime(2);
+  JPetEvent event(std::move(hits), JPetEventType::k2Gamma);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(event.getHits()[2].getTime(), 3);
+  BOOST_REQUIRE(event.isOnlyTypeOf(JPetEventType::k2Gamma));
+}
+
+BOOST_AUTO_TEST_CASE(set_movedHits)
+{
+  JPetEvent event;
+  std::vector<JPetHit> hits(2);
+  hits[0].setTime(2);
+  hits[1].setTime(1);
+  event.setHits(std::move(hits), false);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 2);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 1);
+  event.sortHitsByTime();
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(emplaceAndMoveHits)
+{
+  JPetEvent event;
+  event.reserveHits(3);
+  JPetHit hit;
+  hit.setTime(3);
+  event.addHit(std::move(hit));
+  auto& emplaced = event.emplaceHit();
+  emplaced.setTime(1);
+  JPetHit copied;
+  copied.setTime(2);
+  event.addHit(copied);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 1);
+  event.sortHitsByTime();
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 2);
+  BOOST_REQUIRE_EQUAL(event.getHits()[2].getTime(), 3);
+}
+
+/// Compares the number of allocations and the time needed to build events from hits with
+/// full signals by copying them into new events, as done until now, with moving them
+/// into new events without reserveHits(), so that the hits are moved when the vector grows,
+/// and into a single event reused with Clear() and reserveHits().
+BOOST_AUTO_TEST_CASE(event_building_benchmark)
+{
+  const int kEvents = 10000;
+  const int kHitsPerEvent = 4;
+  JPetPM pm(1, "first");
+  JPetBarrelSlot slot(1, true, "", 0, 1);
+  JPetRawSignal rawSignal;
+  rawSignal.setPM(pm);
+  rawSignal.setBarrelSlot(slot);
+  for (int thr = 1; thr <= 4; thr++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, 10.f * thr);
+    leading.setThresholdNumber(thr);
+    rawSignal.addPoint(leading);
+    JPetSigCh trailing(JPetSigCh::Trailing, 100.f * thr);
+    trailing.setThresholdNumber(thr);
+    rawSignal.addPoint(trailing);
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  JPetHit hitTemplate;
+  hitTemplate.setSignals(physSignal, physSignal);
+
+  double timeSum = 0.;
+  auto allocationsBefore = gAllocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kEvents; i++)
+  {
+    std::vector<JPetHit> hits;
+    for (int j = 0; j < kHitsPerEvent; j++)
+    {
+      JPetHit hit(hitTemplate);
+      hit.setTime(kHitsPerEvent - j);
+      hits.push_back(hit);
+    }
+    JPetEvent event(hits, JPetEventType::kUnknown);
+    timeSum += event.getHits().front().getTime();
+  }
+  auto afterCopying = std::chrono::steady_clock::now();
+  auto copyingAllocations = gAllocations - allocationsBefore;
+
+  allocationsBefore = gAllocations;
+  for (int i = 0; i < kEvents; i++)
+  {
+    JPetEvent newEvent;
+    for (int j = 0; j < kHitsPerEvent; j++)
+    {
+      JPetHit hit(hitTemplate);
+      hit.setTime(kHitsPerEvent - j);
+      newEvent.addHit(std::move(hit));
+    }
+    newEvent.sortHitsByTime();
+    timeSum += newEvent.getHits().front().getTime();
+  }
+  auto afterGrowing = std::chrono::steady_clock::now();
+  auto growingAllocations = gAllocations - allocationsBefore;
+
+  allocationsBefore = gAllocations;
+  JPetEvent event;
+  for (int i = 0; i < kEvents; i++)
+  {
+    event.Clear();
+    event.reserveHits(kHitsPerEvent);
+    for (int j = 0; j < kHitsPerEvent; j++)
+    {
+      JPetHit hit(hitTemplate);
+      hit.setTime(kHitsPerEvent - j);
+      event.addHit(std::move(hit));
+    }
+    event.sortHitsByTime();
+    timeSum -= event.getHits().front().getTime();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  auto movingAllocations = gAllocations - allocationsBefore;
+
+  double copyingTime = std::chrono::duration<double, std::micro>(afterCopying - start).count();
+  double growingTime = std::chrono::duration<double, std::micro>(afterGrowing - afterCopying).count();
+  double movingTime = std::chrono::duration<double, std::micro>(stop - afterGrowing).count();
+  BOOST_TEST_MESSAGE("Building events by copying: " << static_cast<double>(copyingAllocations) / kEvents << " allocations and "
+                                                    << copyingTime / kEvents << " us per event, by moving into a new event: "
+                                                    << static_cast<double>(growingAllocations) / kEvents << " allocations and "
+                                                    << growingTime / kEvents << " us per event, by moving into a reused event: "
+                                                    << static_cast<double>(movingAllocations) / kEvents << " allocations and "
+                                                    << movingTime / kEvents << " us per event");
+  BOOST_REQUIRE_EQUAL(timeSum, static_cast<double>(kEvents));
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), static_cast<std::size_t>(kHitsPerEvent));
+  BOOST_REQUIRE_EQUAL(event.getHits().front().getTime(), 1);
+  BOOST_REQUIRE_LT(growingAllocations, copyingAllocations);
+  BOOST_REQUIRE_LT(movingAllocations, growingAllocations);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetIndexedLORTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetIndexedLORTest
+
+#include "JPetIndexedLOR/JPetIndexedLOR.h"
+#include "JPetSigCh/JPetSigCh.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+JPetTimeWindow createHits()
+{
+  JPetTimeWindow hits("JPetHit");
+  for (int i = 0; i < 3; i++)
+  {
+    JPetHit hit;
+    hit.setTime(100.0f * i);
+    hit.setEnergy(10.0f * i);
+    hit.setBarrelSlotID(i + 1);
+    hits.add<JPetHit>(hit);
+  }
+  return hits;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JPetIndexedLORTestSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetIndexedLOR lor;
+  BOOST_REQUIRE_EQUAL(lor.getRecoFlag(), JPetLOR::Unknown);
+  BOOST_REQUIRE_EQUAL(lor.getTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(lor.getQualityOfTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(lor.getFirstHitIndex(), JPetIndexedLOR::kNoHit);
+  BOOST_REQUIRE(!lor.isHitSet(0));
+  BOOST_REQUIRE(!lor.isHitSet(1));
+  BOOST_REQUIRE(lor.isFromSameBarrelSlot(createHits()));
+}
+
+BOOST_AUTO_TEST_CASE(hits_are_resolved_against_the_window)
+{
+  auto hits = createHits();
+  JPetIndexedLOR lor(8.5f, 4.5f, 0, 2);
+  BOOST_REQUIRE(lor.isHitSet(0));
+  BOOST_REQUIRE(lor.isHitSet(1));
+  BOOST_REQUIRE(lor.refersTo(hits));
+  BOOST_REQUIRE_EQUAL(lor.getFirstHit(hits).getEnergy(), 0.0f);
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit(hits).getEnergy(), 20.0f);
+  BOOST_REQUIRE(lor.isFromSameBarrelSlot(hits));
+
+  JPetTypedTimeWindow<JPetHit> typedHits;
+  BOOST_REQUIRE(typedHits.fill(hits));
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit(typedHits).getTime(), 200.0f);
+
+  JPetSlimHitWindow slimHits;
+  BOOST_REQUIRE(slimHits.fill(hits));
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit(slimHits).getTime(), 200.0f);
+  BOOST_REQUIRE(lor.isFromSameBarrelSlot(slimHits));
+
+  lor.setHitIndices(2, 3);
+  BOOST_REQUIRE(!lor.refersTo(hits));
+}
+
+BOOST_AUTO_TEST_CASE(consistency_check)
+{
+  auto hits = createHits();
+  JPetIndexedLOR lor(0.0f, 0.0f, 2, 1);
+  BOOST_REQUIRE(!lor.isFromSameBarrelSlot(hits));
+  JPetTimeWindow sameSlotHits("JPetHit");
+  JPetHit hit;
+  hit.setBarrelSlotID(5);
+  sameSlotHits.add<JPetHit>(hit);
+  sameSlotHits.add<JPetHit>(hit);
+  lor.setHitIndices(0, 1);
+  BOOST_REQUIRE(!lor.isFromSameBarrelSlot(sameSlotHits));
+}
+
+BOOST_AUTO_TEST_CASE(conversion_to_lor)
+{
+  auto hits = createHits();
+  JPetIndexedLOR lor(8.5f, 4.5f, 1, 2);
+  lor.setTimeDiff(100.0f);
+  lor.setRecoFlag(JPetLOR::Good);
+  JPetLOR fullLOR;
+  BOOST_REQUIRE(lor.toLOR(hits, fullLOR));
+  BOOST_REQUIRE_EQUAL(fullLOR.getTime(), 8.5f);
+  BOOST_REQUIRE_EQUAL(fullLOR.getQualityOfTime(), 4.5f);
+  BOOST_REQUIRE_EQUAL(fullLOR.getTimeDiff(), 100.0f);
+  BOOST_REQUIRE_EQUAL(fullLOR.getRecoFlag(), JPetLOR::Good);
+  BOOST_REQUIRE_EQUAL(fullLOR.getFirstHit().getEnergy(), 10.0f);
+  BOOST_REQUIRE_EQUAL(fullLOR.getSecondHit().getEnergy(), 20.0f);
+
+  JPetSlimHitWindow slimHits;
+  BOOST_REQUIRE(slimHits.fill(hits));
+  BOOST_REQUIRE(lor.toLOR(slimHits, fullLOR));
+  BOOST_REQUIRE_EQUAL(fullLOR.getFirstHit().getTime(), 100.0f);
+
+  JPetTimeWindow sigChs("JPetSigCh");
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  BOOST_REQUIRE(!lor.toLOR(sigChs, fullLOR));
+  lor.setHitIndices(1, 5);
+  BOOST_REQUIRE(!lor.toLOR(hits, fullLOR));
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+  JPetIndexedLOR lor(8.5f, 4.5f, 1, 2);
+  lor.setRecoFlag(JPetLOR::Good);
+  lor.Clear();
+  BOOST_REQUIRE_EQUAL(lor.getTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(lor.getRecoFlag(), JPetLOR::Unknown);
+  BOOST_REQUIRE(!lor.isHitSet(0));
+  BOOST_REQUIRE(!lor.isHitSet(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
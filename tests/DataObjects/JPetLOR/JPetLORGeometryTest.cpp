@@ -0,0 +1,229 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetLORGeometryTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetLORGeometryTest
+
+#include "JPetIndexedLOR/JPetIndexedLOR.h"
+#include "JPetLOR/JPetLORGeometry.h"
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <random>
+
+namespace
+{
+JPetHit createHit(float x, float y, float z, float time)
+{
+  JPetHit hit;
+  hit.setPos(x, y, z);
+  hit.setTime(time);
+  return hit;
+}
+
+std::vector<JPetHit> createRandomHits(std::size_t numberOfHits, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> angles(0.f, 2.f * M_PI);
+  std::uniform_real_distribution<float> positionsZ(-25.f, 25.f);
+  std::uniform_real_distribution<float> times(0.f, 20000.f);
+  std::vector<JPetHit> hits;
+  for (std::size_t i = 0; i < numberOfHits; i++)
+  {
+    float angle = angles(generator);
+    hits.push_back(createHit(42.5f * std::cos(angle), 42.5f * std::sin(angle), positionsZ(generator), times(generator)));
+  }
+  return hits;
+}
+
+std::vector<std::array<std::uint32_t, 2>> createPairs(std::size_t numberOfHits)
+{
+  std::vector<std::array<std::uint32_t, 2>> pairs;
+  for (std::uint32_t i = 0; i + 1 < numberOfHits; i += 2)
+  {
+    pairs.push_back({{i, i + 1}});
+  }
+  return pairs;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JPetLORGeometryTestSuite)
+
+BOOST_AUTO_TEST_CASE(annihilation_point_of_single_lor)
+{
+  const float c = JPetLORGeometry::kLightVelocity_cm_ps;
+  /// annihilation at x = -3 cm, 7 cm from the first hit and 13 cm from the second one
+  auto firstHit = createHit(-10.f, 0.f, 0.f, 1000.f + 7.f / c);
+  auto secondHit = createHit(10.f, 0.f, 0.f, 1000.f + 13.f / c);
+  BOOST_REQUIRE_CLOSE(JPetLORGeometry::calculateTOF(firstHit, secondHit), -6.f / c, 0.01);
+  auto point = JPetLORGeometry::calculateAnnihilationPoint(firstHit, secondHit);
+  BOOST_REQUIRE_CLOSE(point.X(), -3., 0.01);
+  BOOST_REQUIRE_SMALL(point.Y(), 1.e-6);
+  BOOST_REQUIRE_SMALL(point.Z(), 1.e-6);
+
+  JPetLORGeometry geometry;
+  const auto& lors = geometry.calculate(std::vector<JPetLOR>({JPetLOR(0.f, 0.f, firstHit, secondHit)}));
+  BOOST_REQUIRE_EQUAL(lors.size(), 1u);
+  BOOST_REQUIRE_CLOSE(lors.tof[0], -6.f / c, 0.01);
+  BOOST_REQUIRE_CLOSE(lors.pointX[0], -3.f, 0.01);
+  BOOST_REQUIRE_SMALL(lors.pointY[0], 1.e-6f);
+  BOOST_REQUIRE_CLOSE(lors.pointDistance[0], 3.f, 0.01);
+  BOOST_REQUIRE_CLOSE(lors.length[0], 20.f, 0.0001);
+  BOOST_REQUIRE_SMALL(lors.angle[0], 1.e-6f);
+  BOOST_REQUIRE_SMALL(lors.distance[0], 1.e-6f);
+}
+
+BOOST_AUTO_TEST_CASE(sinogram_coordinates_do_not_depend_on_hit_order)
+{
+  std::vector<JPetHit> hits = {createHit(0.f, 5.f, 0.f, 0.f),  createHit(10.f, 5.f, 1.f, 0.f), createHit(3.f, -10.f, 0.f, 0.f),
+                               createHit(3.f, 10.f, 0.f, 0.f), createHit(1.f, 1.f, 1.f, 0.f), createHit(1.f, 1.f, 1.f, 0.f)};
+  std::vector<std::array<std::uint32_t, 2>> pairs = {{{0, 1}}, {{1, 0}}, {{2, 3}}, {{3, 2}}, {{4, 5}}};
+  JPetLORGeometry geometry;
+  const auto& lors = geometry.calculate(hits, pairs);
+  BOOST_REQUIRE_EQUAL(lors.size(), pairs.size());
+  for (int i = 0; i < 2; i++)
+  {
+    BOOST_REQUIRE_SMALL(lors.angle[i], 1.e-6f);
+    BOOST_REQUIRE_CLOSE(lors.distance[i], -5.f, 0.0001);
+    BOOST_REQUIRE_CLOSE(lors.angle[i + 2], M_PI / 2., 0.0001);
+    BOOST_REQUIRE_CLOSE(lors.distance[i + 2], 3.f, 0.0001);
+  }
+  /// LOR of zero length
+  BOOST_REQUIRE_EQUAL(lors.length[4], 0.f);
+  BOOST_REQUIRE_EQUAL(lors.pointX[4], 1.f);
+  BOOST_REQUIRE_EQUAL(lors.angle[4], 0.f);
+  BOOST_REQUIRE_EQUAL(lors.distance[4], 0.f);
+
+  pairs.push_back({{0, 6}});
+  BOOST_REQUIRE_EQUAL(geometry.calculate(hits, pairs).size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(batch_agrees_with_single_lor_calculation)
+{
+  auto hits = createRandomHits(2000, 5);
+  auto pairs = createPairs(hits.size());
+  JPetLORGeometry geometry;
+  const auto& lors = geometry.calculate(hits, pairs);
+  BOOST_REQUIRE_EQUAL(lors.size(), pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); i++)
+  {
+    const auto& firstHit = hits[pairs[i][0]];
+    const auto& secondHit = hits[pairs[i][1]];
+    auto point = JPetLORGeometry::calculateAnnihilationPoint(firstHit, secondHit);
+    BOOST_REQUIRE_EQUAL(lors.tof[i], JPetLORGeometry::calculateTOF(firstHit, secondHit));
+    BOOST_REQUIRE_SMALL(lors.pointX[i] - point.X(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.pointY[i] - point.Y(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.pointZ[i] - point.Z(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.pointDistance[i] - point.Mag(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.length[i] - (secondHit.getPos() - firstHit.getPos()).Mag(), 1.e-3);
+    BOOST_REQUIRE(lors.angle[i] >= 0.f && lors.angle[i] < M_PI);
+    BOOST_REQUIRE(std::abs(lors.distance[i]) <= 42.5f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(lors_from_time_windows)
+{
+  auto hits = createRandomHits(10, 7);
+  JPetTimeWindow hitWindow("JPetHit");
+  JPetTimeWindow lorWindow("JPetLOR");
+  JPetTimeWindow indexedLORWindow("JPetIndexedLOR");
+  for (const auto& hit : hits)
+  {
+    hitWindow.add<JPetHit>(hit);
+  }
+  auto pairs = createPairs(hits.size());
+  for (const auto& pair : pairs)
+  {
+    lorWindow.add<JPetLOR>(JPetLOR(0.f, 0.f, hits[pair[0]], hits[pair[1]]));
+    indexedLORWindow.add<JPetIndexedLOR>(JPetIndexedLOR(0.f, 0.f, pair[0], pair[1]));
+  }
+  JPetLORGeometry::HitArrays hitArrays;
+  hitArrays.resize(hits.size());
+  for (std::size_t i = 0; i < hits.size(); i++)
+  {
+    hitArrays.set(i, hits[i]);
+  }
+  JPetLORGeometry geometry;
+  auto fromPairs = geometry.calculate(hits, pairs);
+  auto fromArrays = geometry.calculate(hitArrays, pairs);
+  auto fromLORs = geometry.calculate(lorWindow);
+  auto fromIndexedLORs = geometry.calculate(hitWindow, indexedLORWindow);
+  BOOST_REQUIRE_EQUAL(fromPairs.size(), pairs.size());
+  BOOST_REQUIRE(fromArrays.pointX == fromPairs.pointX);
+  BOOST_REQUIRE(fromArrays.length == fromPairs.length);
+  BOOST_REQUIRE(fromLORs.pointX == fromPairs.pointX);
+  BOOST_REQUIRE(fromLORs.distance == fromPairs.distance);
+  BOOST_REQUIRE(fromIndexedLORs.tof == fromPairs.tof);
+  BOOST_REQUIRE(fromIndexedLORs.angle == fromPairs.angle);
+  BOOST_REQUIRE(geometry.getLORs().pointZ == fromPairs.pointZ);
+
+  /// the indices do not refer to the window and the window is not of LORs
+  indexedLORWindow.add<JPetIndexedLOR>(JPetIndexedLOR(0.f, 0.f, 1, 10));
+  BOOST_REQUIRE_EQUAL(geometry.calculate(hitWindow, indexedLORWindow).size(), 0u);
+  BOOST_REQUIRE_EQUAL(geometry.calculate(hitWindow).size(), 0u);
+  pairs.push_back({{0, 10}});
+  BOOST_REQUIRE_EQUAL(geometry.calculate(hitArrays, pairs).size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(lor_geometry_benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+  auto hits = createRandomHits(200000, 11);
+  auto pairs = createPairs(hits.size());
+  JPetLORGeometry geometry;
+  geometry.calculate(hits, pairs);
+  const int repetitions = 5;
+
+  std::vector<TVector3> points(pairs.size());
+  auto start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    for (std::size_t j = 0; j < pairs.size(); j++)
+    {
+      points[j] = JPetLORGeometry::calculateAnnihilationPoint(hits[pairs[j][0]], hits[pairs[j][1]]);
+    }
+  }
+  auto singleTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    geometry.calculate(hits, pairs);
+  }
+  auto batchTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  /// positions and times of all the hits of the window, as read e.g. with JPetHitColumns
+  JPetLORGeometry::HitArrays hitArrays;
+  hitArrays.resize(hits.size());
+  for (std::size_t j = 0; j < hits.size(); j++)
+  {
+    hitArrays.set(j, hits[j]);
+  }
+  start = Clock::now();
+  for (int i = 0; i < repetitions; i++)
+  {
+    geometry.calculate(hitArrays, pairs);
+  }
+  auto arraysTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  BOOST_TEST_MESSAGE(pairs.size() << " LORs: TVector3 annihilation points " << singleTime / repetitions << " us, all parameters from hits "
+                                  << batchTime / repetitions << " us, from hit arrays " << arraysTime / repetitions << " us");
+  const auto& lors = geometry.getLORs();
+  for (std::size_t j = 0; j < pairs.size(); j += 1000)
+  {
+    BOOST_REQUIRE_SMALL(lors.pointX[j] - points[j].X(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.pointY[j] - points[j].Y(), 1.e-3);
+    BOOST_REQUIRE_SMALL(lors.pointZ[j] - points[j].Z(), 1.e-3);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
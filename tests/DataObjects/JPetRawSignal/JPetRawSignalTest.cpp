@@ -20,7 +20,10 @@
 #include "JPetBarrelSlot/JPetBarrelSlot.h"
 #include "JPetPM/JPetPM.h"
 
+#include <TFile.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <memory>
 
 BOOST_AUTO_TEST_SUITE(ParamDataTS)
 
@@ -205,4 +208,156 @@ BOOST_AUTO_TEST_CASE(GetMapOfTOTsVsThrNumOrValueTest)
   BOOST_REQUIRE_EQUAL(map2.count(200.f), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(PerThresholdQueriesTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigch1l(JPetSigCh::Leading, 10.f);
+  sigch1l.setThreshold(80.f);
+  sigch1l.setThresholdNumber(1);
+  JPetSigCh sigch3l(JPetSigCh::Leading, 12.f);
+  sigch3l.setThreshold(240.f);
+  sigch3l.setThresholdNumber(3);
+  JPetSigCh sigch1t(JPetSigCh::Trailing, 25.f);
+  sigch1t.setThreshold(80.f);
+  sigch1t.setThresholdNumber(1);
+  signal.addPoint(sigch3l);
+  signal.addPoint(sigch1l);
+  signal.addPoint(sigch1t);
+
+  BOOST_REQUIRE(signal.hasTime(JPetSigCh::Leading, 1));
+  BOOST_REQUIRE(!signal.hasTime(JPetSigCh::Leading, 2));
+  BOOST_REQUIRE(!signal.hasTime(JPetSigCh::Trailing, 3));
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 3), 12.f);
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 2), JPetSigCh::kUnset);
+  BOOST_REQUIRE_EQUAL(signal.getThresholdValue(JPetSigCh::Leading, 3), 240.f);
+  BOOST_REQUIRE_EQUAL(signal.getTOT(1), 15.f);
+  BOOST_REQUIRE_EQUAL(signal.getTOT(3), JPetSigCh::kUnset);
+
+  const auto& times = signal.getTimes(JPetSigCh::Leading);
+  BOOST_REQUIRE_EQUAL(times[0], 10.f);
+  BOOST_REQUIRE_EQUAL(times[1], JPetSigCh::kUnset);
+  BOOST_REQUIRE_EQUAL(times[2], 12.f);
+  BOOST_REQUIRE_EQUAL(signal.getThresholdValues(JPetSigCh::Trailing)[0], 80.f);
+
+  auto point = signal.getPoint(JPetSigCh::Leading, 3);
+  BOOST_REQUIRE(point);
+  BOOST_REQUIRE_EQUAL(point->getValue(), 12.f);
+  BOOST_REQUIRE(!signal.getPoint(JPetSigCh::Trailing, 3));
+  BOOST_REQUIRE(!signal.getPoint(JPetSigCh::Leading, 0));
+  BOOST_REQUIRE(!signal.getPoint(JPetSigCh::Leading, JPetRawSignal::kMaxThresholds + 1));
+  BOOST_REQUIRE_EQUAL(signal.getPointsRef(JPetSigCh::Leading).size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(DoubledAndOutOfRangeThresholdsTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh first(JPetSigCh::Leading, 10.f);
+  first.setThresholdNumber(2);
+  JPetSigCh second(JPetSigCh::Leading, 11.f);
+  second.setThresholdNumber(2);
+  JPetSigCh outOfRange(JPetSigCh::Leading, 13.f);
+  outOfRange.setThresholdNumber(JPetRawSignal::kMaxThresholds + 2);
+  signal.addPoint(first);
+  signal.addPoint(outOfRange);
+  BOOST_REQUIRE(!signal.hasDoubledThreshold(JPetSigCh::Leading));
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 2), 10.f);
+  auto map = signal.getTimesVsThresholdNumber(JPetSigCh::Leading);
+  BOOST_REQUIRE_EQUAL(map.size(), 2u);
+  BOOST_REQUIRE_EQUAL(map[JPetRawSignal::kMaxThresholds + 2], 13.f);
+
+  signal.addPoint(second);
+  BOOST_REQUIRE(signal.hasDoubledThreshold(JPetSigCh::Leading));
+  BOOST_REQUIRE(!signal.hasTime(JPetSigCh::Leading, 2));
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 2), JPetSigCh::kUnset);
+  BOOST_REQUIRE(signal.getTimesVsThresholdNumber(JPetSigCh::Leading).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ClearResetsThresholdArraysTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigch(JPetSigCh::Trailing, 5.f);
+  sigch.setThresholdNumber(1);
+  signal.addPoint(sigch);
+  signal.addPoint(sigch);
+  BOOST_REQUIRE(signal.hasDoubledThreshold(JPetSigCh::Trailing));
+  signal.Clear();
+  BOOST_REQUIRE(!signal.hasDoubledThreshold(JPetSigCh::Trailing));
+  BOOST_REQUIRE(!signal.hasTime(JPetSigCh::Trailing, 1));
+  for (auto time : signal.getTimes(JPetSigCh::Trailing))
+  {
+    BOOST_REQUIRE_EQUAL(time, JPetSigCh::kUnset);
+  }
+  signal.addPoint(sigch);
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Trailing, 1), 5.f);
+}
+
+BOOST_AUTO_TEST_CASE(MoveTakesOverPointsAndThresholdArraysTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigch(JPetSigCh::Leading, 7.f);
+  sigch.setThresholdNumber(2);
+  signal.addPoint(sigch);
+  JPetRawSignal moved(std::move(signal));
+  BOOST_REQUIRE_EQUAL(moved.getNumberOfPoints(JPetSigCh::Leading), 1);
+  BOOST_REQUIRE_EQUAL(moved.getTime(JPetSigCh::Leading, 2), 7.f);
+  BOOST_REQUIRE_EQUAL(signal.getNumberOfPoints(JPetSigCh::Leading), 0);
+  BOOST_REQUIRE(!signal.hasTime(JPetSigCh::Leading, 2));
+  JPetRawSignal assigned;
+  assigned = std::move(moved);
+  BOOST_REQUIRE_EQUAL(assigned.getTime(JPetSigCh::Leading, 2), 7.f);
+  BOOST_REQUIRE(!moved.hasTime(JPetSigCh::Leading, 2));
+}
+
+BOOST_AUTO_TEST_CASE(BuiltIndexIsTheSameAsAddedPointsTest)
+{
+  JPetRawSignal signal;
+  std::vector<JPetSigCh> points;
+  for (int thr : {2, 4, 7})
+  {
+    JPetSigCh sigch(JPetSigCh::Leading, 10.f * thr);
+    sigch.setThresholdNumber(thr);
+    sigch.setThreshold(100.f * thr);
+    signal.addPoint(sigch);
+    points.push_back(sigch);
+  }
+  JPetRawSignal::ThresholdIndex index;
+  index.build(points);
+  BOOST_REQUIRE(index.fTimes == signal.getTimes(JPetSigCh::Leading));
+  BOOST_REQUIRE(index.fThresholds == signal.getThresholdValues(JPetSigCh::Leading));
+  BOOST_REQUIRE(!index.fDoubled);
+  BOOST_REQUIRE(index.fOutOfRange);
+  points.push_back(points.front());
+  index.build(points);
+  BOOST_REQUIRE(index.fDoubled);
+}
+
+BOOST_AUTO_TEST_CASE(ThresholdArraysAreBuiltWhenReadFromFileTest)
+{
+  const std::string fileName = "JPetRawSignalTestThresholdArrays.root";
+  JPetRawSignal signal;
+  for (int thr = 1; thr <= JPetRawSignal::kMaxThresholds; thr++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, 10.f * thr);
+    leading.setThresholdNumber(thr);
+    signal.addPoint(leading);
+    JPetSigCh trailing(JPetSigCh::Trailing, 100.f * thr);
+    trailing.setThresholdNumber(thr);
+    signal.addPoint(trailing);
+  }
+  {
+    TFile file(fileName.c_str(), "RECREATE");
+    file.WriteObject(&signal, "signal");
+  }
+  std::unique_ptr<const JPetRawSignal> readSignal;
+  {
+    TFile file(fileName.c_str(), "READ");
+    readSignal.reset(static_cast<JPetRawSignal*>(file.Get("signal")));
+  }
+  boost::filesystem::remove(fileName);
+  BOOST_REQUIRE(readSignal);
+  BOOST_REQUIRE(readSignal->getTimes(JPetSigCh::Leading) == signal.getTimes(JPetSigCh::Leading));
+  BOOST_REQUIRE(readSignal->getTimes(JPetSigCh::Trailing) == signal.getTimes(JPetSigCh::Trailing));
+  BOOST_REQUIRE_EQUAL(readSignal->getTOT(3), 270.f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
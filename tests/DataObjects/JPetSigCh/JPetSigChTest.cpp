@@ -15,9 +15,43 @@
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE JPetSigChTest
+#include "JPetParamBank/JPetParamRefResolver.h"
 #include "JPetSigCh/JPetSigCh.h"
 
+#include <TBufferFile.h>
+#include <TFile.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <memory>
+
+JPetParamBank createBank()
+{
+  JPetParamBank bank;
+  bank.addPM(JPetPM(1, "first"));
+  bank.addFEB(JPetFEB(43, true, "", "", 1, 1, 8, 1));
+  bank.addTRB(JPetTRB(22, 1, 123));
+  bank.addTOMBChannel(JPetTOMBChannel(1234));
+  return bank;
+}
+
+void setReferences(JPetSigCh& sigCh)
+{
+  JPetPM pm(1, "first");
+  sigCh.setPM(pm);
+  JPetFEB feb(43, true, "", "", 1, 1, 8, 1);
+  sigCh.setFEB(feb);
+  JPetTRB trb(22, 1, 123);
+  sigCh.setTRB(trb);
+  JPetTOMBChannel tomb(1234);
+  sigCh.setTOMBChannel(tomb);
+}
+
+int getWrittenSize(JPetSigCh& sigCh)
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  sigCh.Streamer(buffer);
+  return buffer.Length();
+}
 
 BOOST_AUTO_TEST_SUITE(SigChTestSuite)
 
@@ -91,4 +125,81 @@ BOOST_AUTO_TEST_CASE(compareByThresholdNumber_Test)
   BOOST_REQUIRE(!JPetSigCh::compareByThresholdNumber(sigCh2, sigCh1));
 }
 
+BOOST_AUTO_TEST_CASE(set_tref_is_preferred_to_bound_bank)
+{
+  auto bank = createBank();
+  JPetSigCh sigCh;
+  JPetPM pm(1, "first");
+  sigCh.setPM(pm);
+  BOOST_REQUIRE_EQUAL(&sigCh.getPM(), &pm);
+  JPetParamRefResolver::Binding binding(&bank);
+  BOOST_REQUIRE_EQUAL(JPetParamRefResolver::getBoundBank(), &bank);
+  BOOST_REQUIRE_EQUAL(&sigCh.getPM(), &pm);
+  BOOST_REQUIRE_EQUAL(&sigCh.getFEB(), &JPetFEB::getDummyResult());
+}
+
+BOOST_AUTO_TEST_CASE(integer_id_mode)
+{
+  auto bank = createBank();
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kIntegerID);
+  JPetSigCh sigCh;
+  setReferences(sigCh);
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kTRef);
+  BOOST_REQUIRE_EQUAL(JPetParamRefResolver::getBoundBank(), static_cast<const JPetParamBank*>(nullptr));
+  BOOST_REQUIRE_EQUAL(&sigCh.getPM(), &JPetPM::getDummyResult());
+  BOOST_REQUIRE_EQUAL(sigCh.getChannel(), 1234);
+  {
+    JPetParamRefResolver::Binding binding(&bank);
+    BOOST_REQUIRE_EQUAL(&sigCh.getPM(), &bank.getPM(1));
+    BOOST_REQUIRE_EQUAL(&sigCh.getFEB(), &bank.getFEB(43));
+    BOOST_REQUIRE_EQUAL(&sigCh.getTRB(), &bank.getTRB(22));
+    BOOST_REQUIRE_EQUAL(&sigCh.getTOMBChannel(), &bank.getTOMBChannel(1234));
+  }
+  BOOST_REQUIRE_EQUAL(JPetParamRefResolver::getBoundBank(), static_cast<const JPetParamBank*>(nullptr));
+  sigCh.Clear();
+  BOOST_REQUIRE_EQUAL(sigCh.getChannel(), JPetTOMBChannel::getDummyResult().getChannel());
+}
+
+BOOST_AUTO_TEST_CASE(integer_id_mode_makes_written_object_smaller)
+{
+  JPetSigCh sigChWithTRefs;
+  setReferences(sigChWithTRefs);
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kIntegerID);
+  JPetSigCh sigChWithIDs;
+  setReferences(sigChWithIDs);
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kTRef);
+  auto sizeWithTRefs = getWrittenSize(sigChWithTRefs);
+  auto sizeWithIDs = getWrittenSize(sigChWithIDs);
+  JPetSigCh sigChWithoutReferences;
+  BOOST_TEST_MESSAGE("Written JPetSigCh: " << sizeWithTRefs << " bytes with TRefs, " << sizeWithIDs << " bytes with IDs only");
+  BOOST_REQUIRE_EQUAL(sizeWithIDs, getWrittenSize(sigChWithoutReferences));
+  BOOST_REQUIRE_GE(sizeWithTRefs - sizeWithIDs, 4 * 10);
+}
+
+BOOST_AUTO_TEST_CASE(integer_id_mode_write_and_read)
+{
+  const std::string fileName = "JPetSigChTestIntegerRefs.root";
+  auto bank = createBank();
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kIntegerID);
+  JPetSigCh sigCh(JPetSigCh::Leading, 12.5);
+  setReferences(sigCh);
+  JPetParamRefResolver::setRefMode(JPetParamRefResolver::kTRef);
+  {
+    TFile file(fileName.c_str(), "RECREATE");
+    file.WriteObject(&sigCh, "sigCh");
+  }
+  std::unique_ptr<JPetSigCh> readSigCh;
+  {
+    TFile file(fileName.c_str(), "READ");
+    readSigCh.reset(static_cast<JPetSigCh*>(file.Get("sigCh")));
+  }
+  boost::filesystem::remove(fileName);
+  BOOST_REQUIRE(readSigCh);
+  BOOST_REQUIRE_CLOSE(readSigCh->getValue(), 12.5, 0.001);
+  BOOST_REQUIRE_EQUAL(readSigCh->getChannel(), 1234);
+  JPetParamRefResolver::Binding binding(&bank);
+  BOOST_REQUIRE_EQUAL(&readSigCh->getPM(), &bank.getPM(1));
+  BOOST_REQUIRE_EQUAL(&readSigCh->getTOMBChannel(), &bank.getTOMBChannel(1234));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
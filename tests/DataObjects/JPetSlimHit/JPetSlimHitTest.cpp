@@ -0,0 +1,92 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHitTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetSlimHitTest
+
+#include "JPetSlimHit/JPetSlimHit.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(JPetSlimHitTestSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetSlimHit hit;
+  BOOST_REQUIRE_EQUAL(hit.getRecoFlag(), JPetHit::Unknown);
+  BOOST_REQUIRE_EQUAL(hit.getEnergy(), 0.0f);
+  BOOST_REQUIRE_EQUAL(hit.getTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(hit.getScintillatorID(), -1);
+  BOOST_REQUIRE(!hit.isSignalASet());
+  BOOST_REQUIRE(!hit.isSignalBSet());
+  BOOST_REQUIRE(hit.getMCindex() == JPetHit::kMCindexError);
+}
+
+BOOST_AUTO_TEST_CASE(constructor_from_hit)
+{
+  JPetHit hit;
+  hit.setRecoFlag(JPetHit::Good);
+  hit.setEnergy(511.0f);
+  hit.setQualityOfEnergy(0.5f);
+  hit.setTime(1000.0f);
+  hit.setQualityOfTime(0.25f);
+  hit.setTimeDiff(-20.0f);
+  hit.setQualityOfTimeDiff(0.125f);
+  hit.setPos(1.0f, 2.0f, 3.0f);
+  hit.setScintillatorID(7);
+  hit.setBarrelSlotID(8);
+  hit.setMCindex(3);
+  JPetSlimHit slimHit(hit, 0, 1);
+  BOOST_REQUIRE_EQUAL(slimHit.getRecoFlag(), JPetHit::Good);
+  BOOST_REQUIRE_EQUAL(slimHit.getEnergy(), 511.0f);
+  BOOST_REQUIRE_EQUAL(slimHit.getQualityOfEnergy(), 0.5f);
+  BOOST_REQUIRE_EQUAL(slimHit.getTime(), 1000.0f);
+  BOOST_REQUIRE_EQUAL(slimHit.getQualityOfTime(), 0.25f);
+  BOOST_REQUIRE_EQUAL(slimHit.getTimeDiff(), -20.0f);
+  BOOST_REQUIRE_EQUAL(slimHit.getQualityOfTimeDiff(), 0.125f);
+  BOOST_REQUIRE_EQUAL(slimHit.getPos().Z(), 3.0);
+  BOOST_REQUIRE_EQUAL(slimHit.getScintillatorID(), 7);
+  BOOST_REQUIRE_EQUAL(slimHit.getBarrelSlotID(), 8);
+  BOOST_REQUIRE_EQUAL(slimHit.getSignalAIndex(), 0);
+  BOOST_REQUIRE_EQUAL(slimHit.getSignalBIndex(), 1);
+  BOOST_REQUIRE_EQUAL(slimHit.getMCindex(), 3u);
+
+  JPetHit restored;
+  slimHit.fillHit(restored);
+  BOOST_REQUIRE_EQUAL(restored.getEnergy(), hit.getEnergy());
+  BOOST_REQUIRE_EQUAL(restored.getTimeDiff(), hit.getTimeDiff());
+  BOOST_REQUIRE_EQUAL(restored.getPosY(), hit.getPosY());
+  BOOST_REQUIRE_EQUAL(restored.getScintillatorID(), 7);
+  BOOST_REQUIRE_EQUAL(restored.getMCindex(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+  JPetSlimHit slimHit;
+  slimHit.setEnergy(1.0f);
+  slimHit.setPos(1.0f, 1.0f, 1.0f);
+  slimHit.setSignalIndices(2, 3);
+  slimHit.Clear();
+  BOOST_REQUIRE_EQUAL(slimHit.getEnergy(), 0.0f);
+  BOOST_REQUIRE_EQUAL(slimHit.getPosX(), 0.0f);
+  BOOST_REQUIRE(!slimHit.isSignalASet());
+}
+
+BOOST_AUTO_TEST_CASE(slim_hit_is_several_times_smaller)
+{
+  BOOST_REQUIRE_LT(4 * sizeof(JPetSlimHit), sizeof(JPetHit));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,235 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSlimHitWindowTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetSlimHitWindowTest
+
+#include "JPetBarrelSlot/JPetBarrelSlot.h"
+#include "JPetPM/JPetPM.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetSlimHitWindow/JPetSlimHitWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+JPetPhysSignal createSignal(float time)
+{
+  JPetPhysSignal signal;
+  signal.setTime(time);
+  return signal;
+}
+
+/// Signal with the raw signal of 4 leading and 4 trailing points, as reconstructed from the data
+JPetPhysSignal createFullSignal(float time, const JPetPM& pm, const JPetBarrelSlot& slot)
+{
+  JPetRawSignal rawSignal;
+  rawSignal.setPM(pm);
+  rawSignal.setBarrelSlot(slot);
+  for (int thr = 1; thr <= 4; thr++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, time + 10.f * thr);
+    leading.setThresholdNumber(thr);
+    rawSignal.addPoint(leading);
+    JPetSigCh trailing(JPetSigCh::Trailing, time + 1000.f - 10.f * thr);
+    trailing.setThresholdNumber(thr);
+    rawSignal.addPoint(trailing);
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal signal;
+  signal.setRecoSignal(recoSignal);
+  signal.setTime(time);
+  return signal;
+}
+
+/// Writes the windows to the file and returns its size in bytes
+std::uintmax_t writeWindows(const std::string& fileName, const std::vector<std::unique_ptr<JPetTimeWindow>>& windows)
+{
+  JPetWriter writer(fileName.c_str());
+  for (const auto& window : windows)
+  {
+    BOOST_REQUIRE(writer.write(*window));
+  }
+  writer.closeFile();
+  return boost::filesystem::file_size(fileName);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JPetSlimHitWindowTestSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetSlimHitWindow window;
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 0u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 0u);
+  BOOST_REQUIRE_EQUAL(std::string(window.getEventType()), "JPetSlimHit");
+}
+
+BOOST_AUTO_TEST_CASE(hits_refer_to_the_signal_table)
+{
+  JPetSlimHitWindow window;
+  JPetHit hit1;
+  hit1.setTime(10.0f);
+  hit1.setSignalA(createSignal(1.0f));
+  JPetHit hit2;
+  hit2.setTime(20.0f);
+  hit2.setSignalB(createSignal(2.0f));
+  JPetHit hit3;
+  window.addHit(hit1);
+  window.addHit(hit2);
+  window.addHit(hit3);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 3u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 2u);
+  BOOST_REQUIRE_EQUAL(window.getHit(1).getTime(), 20.0f);
+  BOOST_REQUIRE(!window.getHit(1).isSignalASet());
+  BOOST_REQUIRE_EQUAL(window.getSignalB(window.getHit(1)).getTime(), 2.0f);
+  BOOST_REQUIRE_EQUAL(window.getSignalA(window.getHit(0)).getTime(), 1.0f);
+  BOOST_REQUIRE(!window.getHit(2).isSignalASet());
+  BOOST_REQUIRE(!window.getHit(2).isSignalBSet());
+
+  window.Clear();
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 0u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(conversion_from_and_to_hit_window)
+{
+  JPetTimeWindow hits("JPetHit");
+  for (int i = 0; i < 3; i++)
+  {
+    JPetHit hit;
+    hit.setEnergy(100.0f * i);
+    hit.setSignalA(createSignal(i));
+    hits.add<JPetHit>(hit);
+  }
+  JPetSlimHitWindow window;
+  BOOST_REQUIRE(window.fill(hits));
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 3u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 3u);
+
+  auto restored = window.toHitWindow();
+  BOOST_REQUIRE_EQUAL(std::string(restored->getEventType()), "JPetHit");
+  BOOST_REQUIRE_EQUAL(restored->getNumberOfEvents(), 3u);
+  const auto& hit = restored->getEvent<JPetHit>(2);
+  BOOST_REQUIRE_EQUAL(hit.getEnergy(), 200.0f);
+  BOOST_REQUIRE(hit.isSignalASet());
+  BOOST_REQUIRE(!hit.isSignalBSet());
+  BOOST_REQUIRE_EQUAL(hit.getSignalA().getTime(), 2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(copy_keeps_the_type_and_the_signal_table)
+{
+  JPetSlimHitWindow window;
+  JPetHit hit1;
+  hit1.setTime(10.0f);
+  hit1.setSignalA(createSignal(1.0f));
+  JPetHit hit2;
+  hit2.setSignalB(createSignal(2.0f));
+  window.addHit(hit1);
+  window.addHit(hit2);
+
+  auto copy = window.copy();
+  auto slimCopy = dynamic_cast<const JPetSlimHitWindow*>(copy.get());
+  BOOST_REQUIRE(slimCopy);
+  BOOST_REQUIRE_EQUAL(slimCopy->getNumberOfEvents(), 2u);
+  BOOST_REQUIRE_EQUAL(slimCopy->getNumberOfSignals(), 2u);
+  BOOST_REQUIRE_EQUAL(slimCopy->getHit(0).getTime(), 10.0f);
+  BOOST_REQUIRE(!slimCopy->getHit(1).isSignalASet());
+  BOOST_REQUIRE_EQUAL(slimCopy->getSignalB(slimCopy->getHit(1)).getTime(), 2.0f);
+  window.Clear();
+  BOOST_REQUIRE_EQUAL(slimCopy->getSignalA(slimCopy->getHit(0)).getTime(), 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(conversion_from_window_of_other_type_fails)
+{
+  JPetTimeWindow sigChs("JPetSigCh");
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  JPetSlimHitWindow window;
+  window.addHit(JPetHit());
+  BOOST_REQUIRE(!window.fill(sigChs));
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 0u);
+}
+
+/// Writes the same hits with full signals as the windows of JPetHit and of JPetSlimHit objects,
+/// compares the slim hits read back with the original ones and the sizes of the files.
+BOOST_AUTO_TEST_CASE(writing_and_reading_and_size_compared_to_hit_window)
+{
+  const int kWindows = 50;
+  const int kHitsPerWindow = 20;
+  const std::string hitFileName = "JPetSlimHitWindowTestHits.root";
+  const std::string slimFileName = "JPetSlimHitWindowTestSlimHits.root";
+  JPetPM pm(1, "first");
+  JPetBarrelSlot slot(1, true, "", 0, 1);
+  std::vector<std::unique_ptr<JPetTimeWindow>> hitWindows;
+  std::vector<std::unique_ptr<JPetTimeWindow>> slimWindows;
+  for (int i = 0; i < kWindows; i++)
+  {
+    std::unique_ptr<JPetTimeWindow> hits(new JPetTimeWindow("JPetHit"));
+    for (int j = 0; j < kHitsPerWindow; j++)
+    {
+      JPetHit hit;
+      float time = 10000.f * i + 100.f * j;
+      hit.setTime(time);
+      hit.setEnergy(5.f * j);
+      hit.setPos(0.5f * j, -0.5f * j, 0.1f * i);
+      hit.setBarrelSlot(slot);
+      hit.setSignals(createFullSignal(time - 50.f, pm, slot), createFullSignal(time + 50.f, pm, slot));
+      hits->add<JPetHit>(hit);
+    }
+    std::unique_ptr<JPetSlimHitWindow> slimHits(new JPetSlimHitWindow());
+    BOOST_REQUIRE(slimHits->fill(*hits));
+    hitWindows.push_back(std::move(hits));
+    slimWindows.push_back(std::move(slimHits));
+  }
+  auto hitFileSize = writeWindows(hitFileName, hitWindows);
+  auto slimFileSize = writeWindows(slimFileName, slimWindows);
+
+  JPetReader reader(slimFileName.c_str());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), kWindows);
+  for (int i = 0; i < kWindows; i++)
+  {
+    BOOST_REQUIRE(reader.nthEntry(i));
+    auto window = dynamic_cast<JPetSlimHitWindow*>(&reader.getCurrentEntry());
+    BOOST_REQUIRE(window);
+    BOOST_REQUIRE_EQUAL(window->getNumberOfEvents(), static_cast<std::size_t>(kHitsPerWindow));
+    BOOST_REQUIRE_EQUAL(window->getNumberOfSignals(), static_cast<std::size_t>(2 * kHitsPerWindow));
+    for (int j = 0; j < kHitsPerWindow; j++)
+    {
+      const auto& original = hitWindows[i]->getEvent<JPetHit>(j);
+      const auto& slimHit = window->getHit(j);
+      BOOST_REQUIRE_EQUAL(slimHit.getTime(), original.getTime());
+      BOOST_REQUIRE_EQUAL(slimHit.getEnergy(), original.getEnergy());
+      BOOST_REQUIRE_EQUAL(slimHit.getPosX(), original.getPosX());
+      BOOST_REQUIRE_EQUAL(slimHit.getPosZ(), original.getPosZ());
+      BOOST_REQUIRE_EQUAL(slimHit.getBarrelSlotID(), 1);
+      BOOST_REQUIRE_EQUAL(window->getSignalA(slimHit).getTime(), original.getSignalA().getTime());
+      BOOST_REQUIRE_EQUAL(window->getSignalB(slimHit).getTime(), original.getSignalB().getTime());
+      const auto& rawSignal = window->getSignalB(slimHit).getRecoSignal().getRawSignal();
+      BOOST_REQUIRE_EQUAL(rawSignal.getTOT(2), original.getSignalB().getRecoSignal().getRawSignal().getTOT(2));
+    }
+  }
+  reader.closeFile();
+  boost::filesystem::remove(hitFileName);
+  boost::filesystem::remove(slimFileName);
+  BOOST_TEST_MESSAGE("Size of the file with " << kWindows * kHitsPerWindow << " hits with full signals: " << hitFileSize
+                                              << " B as JPetHit objects, " << slimFileSize << " B as JPetSlimHit objects");
+  BOOST_REQUIRE_LT(slimFileSize, hitFileSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedTimeWindowTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetTypedTimeWindowTest
+
+#include "JPetHit/JPetHit.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTypedTimeWindow/JPetTypedTimeWindow.h"
+
+#include <TFile.h>
+#include <TTree.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetTypedTimeWindow<JPetSigCh> test;
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 0u);
+  BOOST_REQUIRE(test.empty());
+  BOOST_REQUIRE_EQUAL(std::string(test.getEventType()), "JPetSigCh");
+}
+
+BOOST_AUTO_TEST_CASE(add_emplace_and_iterate)
+{
+  JPetTypedTimeWindow<JPetSigCh> test;
+  JPetSigCh sigCh(JPetSigCh::Trailing, 1.2);
+  test.add(sigCh);
+  test.add(JPetSigCh(JPetSigCh::Leading, 1.5));
+  auto& emplaced = test.emplace(JPetSigCh::Leading, 98);
+  BOOST_REQUIRE_EQUAL(&emplaced, &test[2]);
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 3u);
+  double epsilon = 0.001;
+  BOOST_REQUIRE_CLOSE(test[0].getValue(), 1.2, epsilon);
+  BOOST_REQUIRE_CLOSE(test.getEvent(1).getValue(), 1.5, epsilon);
+  BOOST_REQUIRE_CLOSE(test.getEvents().back().getValue(), 98, epsilon);
+  double sum = 0.0;
+  for (const auto& event : test)
+  {
+    sum += event.getValue();
+  }
+  BOOST_REQUIRE_CLOSE(sum, 1.2 + 1.5 + 98, epsilon);
+}
+
+BOOST_AUTO_TEST_CASE(clearing_keeps_capacity)
+{
+  JPetTypedTimeWindow<JPetHit> test(10);
+  BOOST_REQUIRE(test.capacity() >= 10u);
+  for (int i = 0; i < 20; i++)
+  {
+    test.emplace();
+  }
+  auto capacity = test.capacity();
+  auto data = &test[0];
+  test.Clear();
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 0u);
+  BOOST_REQUIRE_EQUAL(test.capacity(), capacity);
+  test.emplace();
+  BOOST_REQUIRE_EQUAL(&test[0], data);
+}
+
+BOOST_AUTO_TEST_CASE(conversion_from_and_to_time_window)
+{
+  JPetTimeWindow window("JPetSigCh");
+  window.add<JPetSigCh>(JPetSigCh(JPetSigCh::Trailing, 1.2));
+  window.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.5));
+  JPetTypedTimeWindow<JPetSigCh> typed;
+  typed.emplace(JPetSigCh::Leading, 7.0);
+  BOOST_REQUIRE(typed.fill(window));
+  BOOST_REQUIRE_EQUAL(typed.getNumberOfEvents(), 2u);
+  BOOST_REQUIRE_EQUAL(typed[0].getType(), JPetSigCh::Trailing);
+  BOOST_REQUIRE_CLOSE(typed[1].getValue(), 1.5, 0.001);
+
+  auto converted = typed.toTimeWindow();
+  BOOST_REQUIRE_EQUAL(std::string(converted->getEventType()), "JPetSigCh");
+  BOOST_REQUIRE_EQUAL(converted->getNumberOfEvents(), 2u);
+  BOOST_REQUIRE_CLOSE(converted->getEvent<JPetSigCh>(1).getValue(), 1.5, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(conversion_from_window_of_other_type_fails)
+{
+  JPetTimeWindow window("JPetHit");
+  window.add<JPetHit>(JPetHit());
+  JPetTypedTimeWindow<JPetSigCh> typed;
+  typed.emplace(JPetSigCh::Leading, 7.0);
+  BOOST_REQUIRE(!typed.fill(window));
+  BOOST_REQUIRE(typed.empty());
+}
+
+BOOST_AUTO_TEST_CASE(writing_and_reading_tree_of_hit_windows)
+{
+  const std::string fileName = "JPetTypedTimeWindowTestHits.root";
+  const int kWindows = 3;
+  {
+    TFile file(fileName.c_str(), "RECREATE");
+    TTree tree("T", "typed windows");
+    auto window = new JPetTypedTimeWindow<JPetHit>();
+    tree.Branch("window", &window);
+    for (int i = 0; i < kWindows; i++)
+    {
+      window->Clear();
+      for (int j = 0; j <= i; j++)
+      {
+        auto& hit = window->emplace();
+        hit.setTime(1000.f * i + j);
+        hit.setEnergy(511.f - j);
+        hit.setQualityOfEnergy(0.5f);
+        hit.setPos(1.f * i, 2.f * j, -3.f);
+      }
+      tree.Fill();
+    }
+    file.Write();
+    delete window;
+  }
+  {
+    TFile file(fileName.c_str(), "READ");
+    auto tree = dynamic_cast<TTree*>(file.Get("T"));
+    BOOST_REQUIRE(tree);
+    BOOST_REQUIRE_EQUAL(tree->GetEntries(), kWindows);
+    JPetTypedTimeWindow<JPetHit>* window = nullptr;
+    tree->SetBranchAddress("window", &window);
+    for (int i = 0; i < kWindows; i++)
+    {
+      tree->GetEntry(i);
+      BOOST_REQUIRE(window);
+      BOOST_REQUIRE_EQUAL(window->getNumberOfEvents(), static_cast<std::size_t>(i + 1));
+      for (int j = 0; j <= i; j++)
+      {
+        const auto& hit = (*window)[j];
+        BOOST_REQUIRE_EQUAL(hit.getTime(), 1000.f * i + j);
+        BOOST_REQUIRE_EQUAL(hit.getEnergy(), 511.f - j);
+        BOOST_REQUIRE_EQUAL(hit.getQualityOfEnergy(), 0.5f);
+        BOOST_REQUIRE_EQUAL(hit.getPosX(), 1.f * i);
+        BOOST_REQUIRE_EQUAL(hit.getPosY(), 2.f * j);
+        BOOST_REQUIRE_EQUAL(hit.getPosZ(), -3.f);
+      }
+    }
+    tree->ResetBranchAddresses();
+    delete window;
+  }
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
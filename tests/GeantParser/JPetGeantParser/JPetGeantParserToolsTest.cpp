@@ -19,6 +19,7 @@
 
 #include "JPetGeantEventPack/JPetGeantEventPack.h"
 #include "JPetGeantParser/JPetGeantParserTools.h"
+#include "JPetRandomStream/JPetRandomStream.h"
 
 JPetGeantEventPack* createPack(bool genPrompt, bool gen2g, bool gen3g)
 {
@@ -102,4 +103,27 @@ BOOST_AUTO_TEST_CASE(testIdentification)
   }
 }
 
+BOOST_AUTO_TEST_CASE(testDecayTimesFromRandomStreamAreReproducible)
+{
+  JPetRandomStream firstStream(11, 2, 5);
+  JPetRandomStream secondStream(11, 2, 5);
+  /// drawing from the global generator in between must not change the results
+  gRandom->Rndm();
+  auto first = JPetGeantParserTools::getTimeDistoOfDecays(4.7, -50.e6, 0., &firstStream);
+  gRandom->Rndm();
+  auto second = JPetGeantParserTools::getTimeDistoOfDecays(4.7, -50.e6, 0., &secondStream);
+  BOOST_REQUIRE(!std::get<0>(first).empty());
+  BOOST_REQUIRE(std::get<0>(first) == std::get<0>(second));
+  BOOST_REQUIRE(std::get<1>(first) == std::get<1>(second));
+
+  JPetHitExperimentalParametrizer parametrizer;
+  parametrizer.setRandomGenerator(&firstStream);
+  firstStream.setEventIndex(6);
+  auto time = parametrizer.addTimeSmearing(1, 0., 300., 1000.);
+  auto energy = parametrizer.addEnergySmearing(1, 0., 300., 1000.);
+  firstStream.setEventIndex(6);
+  BOOST_REQUIRE_EQUAL(parametrizer.addTimeSmearing(1, 0., 300., 1000.), time);
+  BOOST_REQUIRE_EQUAL(parametrizer.addEnergySmearing(1, 0., 300., 1000.), energy);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,11 @@
 
 #include <TFile.h>
 #include <TH1F.h>
+#include <TMath.h>
+#include <TRandom.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 using SmearingType = JPetHitExperimentalParametrizer::SmearingType;
 
@@ -161,4 +166,104 @@ BOOST_AUTO_TEST_CASE(testCustomZFunction)
   BOOST_REQUIRE(prob > alpha);
 }
 
+/// Compares the fast sampling with the sampling done by TF1::GetRandom() for the same inputs.
+double compareFastAndTF1Sampling(JPetHitExperimentalParametrizer& parametrizer, SmearingType type, int scinID, double zIn, double eneIn,
+                                 double timeIn)
+{
+  const int nTrials = 20000;
+  std::vector<double> vals;
+  std::vector<double> valsRef;
+  for (auto fastSampling : {true, false})
+  {
+    parametrizer.setFastSampling(fastSampling);
+    auto& values = fastSampling ? vals : valsRef;
+    for (int i = 0; i < nTrials; i++)
+    {
+      switch (type)
+      {
+      case SmearingType::kTime:
+        values.push_back(parametrizer.addTimeSmearing(scinID, zIn, eneIn, timeIn));
+        break;
+      case SmearingType::kEnergy:
+        values.push_back(parametrizer.addEnergySmearing(scinID, zIn, eneIn, timeIn));
+        break;
+      default:
+        values.push_back(parametrizer.addZHitSmearing(scinID, zIn, eneIn, timeIn));
+      }
+    }
+  }
+  std::sort(vals.begin(), vals.end());
+  std::sort(valsRef.begin(), valsRef.end());
+  return TMath::KolmogorovTest(vals.size(), &vals[0], valsRef.size(), &valsRef[0], "");
+}
+
+BOOST_AUTO_TEST_CASE(testFastSamplingOfDefaultFunctions)
+{
+  gRandom->SetSeed(12345);
+  JPetHitExperimentalParametrizer parametrizer;
+  BOOST_REQUIRE(parametrizer.isFastSampling());
+  double alpha = 0.01;
+  /// above the energy threshold the whole range is wider than +-3 sigma
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kTime, 1, 2.5, 300., 1000.) > alpha);
+  /// below the energy threshold the time resolution is much worse and the gaussian is truncated by the limits
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kTime, 1, 2.5, 20., -500.) > alpha);
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kEnergy, 1, 2.5, 340., 1000.) > alpha);
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kZPosition, 1, -12.3, 340., 1000.) > alpha);
+  parametrizer.setSmearingFunctionLimits({{0, 0}, {0, 0}, {-0.5, 1.5}});
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kZPosition, 1, -12.3, 340., 1000.) > alpha);
+}
+
+BOOST_AUTO_TEST_CASE(testFastSamplingOfCustomFunctions)
+{
+  gRandom->SetSeed(54321);
+  JPetHitExperimentalParametrizer parametrizer;
+  std::string timeSmearing = "[&](double* x, double* p)->double{ return TMath::Gaus(x[0], p[3], p[4] * (1. + p[2] / 1000.), 1);};";
+  std::string zSmearing = "[&](double* x, double* p)->double{ return TMath::Landau(x[0],p[1],p[4], 0);};";
+  parametrizer.setSmearingFunctions({{timeSmearing, {100.}}, {"", {}}, {zSmearing, {2.}}});
+  parametrizer.setSmearingFunctionLimits({{-200, 200}, {0, 0}, {-4, 4}});
+  double alpha = 0.01;
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kTime, 7, 0., 150., 12345.6) > alpha);
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kTime, 7, 0., 600., -77.) > alpha);
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kZPosition, 7, 3.3, 150., 0.) > alpha);
+
+  auto binning = parametrizer.getParameterBinning(SmearingType::kTime);
+  BOOST_REQUIRE_EQUAL(binning[3], 0.);
+  parametrizer.setParameterBinning(SmearingType::kTime, {{1., 1., 10., 0.}});
+  BOOST_REQUIRE(compareFastAndTF1Sampling(parametrizer, SmearingType::kTime, 7, 0., 600., -77.) > alpha);
+}
+
+/// Reports the time of smearing the hits with parameters spread as in the simulations by the fast sampling
+/// of a custom function, with the default binning, and by TF1::GetRandom(). The times are only reported,
+/// they depend on the machine.
+BOOST_AUTO_TEST_CASE(fastSamplingBenchmark)
+{
+  const int kHits = 10000;
+  const int kScintillators = 192;
+  JPetHitExperimentalParametrizer parametrizer;
+  std::string timeSmearing = "[&](double* x, double* p)->double{ return TMath::Gaus(x[0], p[3], p[4] * (1. + p[2] / 1000.), 1);};";
+  parametrizer.setSmearingFunctions({{timeSmearing, {100.}}, {"", {}}, {"", {}}});
+  parametrizer.setSmearingFunctionLimits({{-400, 400}, {0, 0}, {0, 0}});
+  TRandom random(2021);
+  std::vector<std::array<double, 4>> hits(kHits);
+  for (auto& hit : hits)
+  {
+    hit = {{double(random.Integer(kScintillators) + 1), random.Uniform(-25., 25.), random.Uniform(0., 511.), random.Uniform(0., 1.e6)}};
+  }
+  std::vector<double> seconds;
+  for (auto fastSampling : {false, true})
+  {
+    parametrizer.setFastSampling(fastSampling);
+    double sum = 0.;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& hit : hits)
+    {
+      sum += parametrizer.addTimeSmearing(int(hit[0]), hit[1], hit[2], hit[3]) - hit[3];
+    }
+    seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    BOOST_REQUIRE(std::isfinite(sum));
+  }
+  BOOST_TEST_MESSAGE("Time smearing of " << kHits << " hits with TF1::GetRandom(): " << seconds[0] << " s, with the fast sampling: " << seconds[1]
+                                         << " s");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -267,16 +267,37 @@ BOOST_AUTO_TEST_CASE(testBooleanOptions)
 
   BOOST_REQUIRE_EQUAL(isProgressBar(options1), false);
   BOOST_REQUIRE_EQUAL(isDirectProcessing(options1), false);
+  BOOST_REQUIRE_EQUAL(isPipelinedProcessing(options1), false);
 
   OptsStrAny options2 = {{"progressBar_bool", false}, {"directProcessing_bool", false}};
 
   BOOST_REQUIRE_EQUAL(isProgressBar(options2), false);
   BOOST_REQUIRE_EQUAL(isDirectProcessing(options2), false);
 
-  OptsStrAny options3 = {{"progressBar_bool", true}, {"directProcessing_bool", true}};
+  OptsStrAny options3 = {{"progressBar_bool", true}, {"directProcessing_bool", true}, {"pipelinedProcessing_bool", true}};
 
   BOOST_REQUIRE_EQUAL(isProgressBar(options3), true);
   BOOST_REQUIRE_EQUAL(isDirectProcessing(options3), true);
+  BOOST_REQUIRE_EQUAL(isPipelinedProcessing(options3), true);
+}
+
+BOOST_AUTO_TEST_CASE(testThreadsOptions)
+{
+  OptsStrAny options1;
+  BOOST_REQUIRE_EQUAL(isLargestFileFirst(options1), false);
+  BOOST_REQUIRE_EQUAL(getMaxThreads(options1), -1);
+
+  OptsStrAny options2 = {{"largestFileFirst_bool", true}, {"maxThreads_int", 4}};
+  BOOST_REQUIRE_EQUAL(isLargestFileFirst(options2), true);
+  BOOST_REQUIRE_EQUAL(getMaxThreads(options2), 4);
+}
+
+BOOST_AUTO_TEST_CASE(testIntegerParamRefsOption)
+{
+  OptsStrAny options1;
+  BOOST_REQUIRE_EQUAL(isIntegerParamRefs(options1), false);
+  OptsStrAny options2 = {{"integerParamRefs_bool", true}};
+  BOOST_REQUIRE_EQUAL(isIntegerParamRefs(options2), true);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -357,4 +357,49 @@ BOOST_AUTO_TEST_CASE(saving_reading_file)
   file2.Close();
 }
 
+BOOST_AUTO_TEST_CASE(copy_shares_objects)
+{
+  JPetParamBank bank;
+  for (int i = 1; i <= 10; i++) {
+    bank.addPM(JPetPM(i, "pm"));
+    bank.addScintillator(JPetScin(i, 0, 0, 0, 0));
+  }
+  bank.getPM(3).setScin(bank.getScintillator(3));
+  JPetParamBank copy(bank);
+  BOOST_REQUIRE_EQUAL(copy.getPMsSize(), 10);
+  BOOST_REQUIRE_EQUAL(&copy.getPM(3), &bank.getPM(3));
+  BOOST_REQUIRE_EQUAL(&copy.getScintillator(7), &bank.getScintillator(7));
+  BOOST_REQUIRE_EQUAL(copy.getPM(3).getScin().getID(), 3);
+
+  copy.getPM(5).setHVset(1500);
+  BOOST_REQUIRE_EQUAL(bank.getPM(5).getHVset(), 1500);
+  copy.addPM(JPetPM(11, "added to the copy"));
+  BOOST_REQUIRE_EQUAL(copy.getPMsSize(), 11);
+  BOOST_REQUIRE_EQUAL(bank.getPMsSize(), 10);
+
+  bank.clear();
+  BOOST_REQUIRE_EQUAL(bank.getPMsSize(), 0);
+  BOOST_REQUIRE_EQUAL(copy.getPM(3).getID(), 3);
+  BOOST_REQUIRE_EQUAL(copy.getPM(3).getScin().getID(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(lookup_by_id)
+{
+  JPetParamBank bank;
+  bank.addTOMBChannel(JPetTOMBChannel(5u));
+  bank.addTOMBChannel(JPetTOMBChannel(JPetParamBank::kMaxDenseIndex + 10));
+  bank.addPM(JPetPM(-2, "negative"));
+  bank.addPM(JPetPM(7, "first"));
+  bank.addPM(JPetPM(7, "second"));
+  BOOST_REQUIRE_EQUAL(bank.getPMsSize(), 2);
+  BOOST_REQUIRE_EQUAL(bank.getPM(7).getDescription(), "first");
+  BOOST_REQUIRE_EQUAL(bank.getPM(-2).getID(), -2);
+  BOOST_REQUIRE_EQUAL(bank.getTOMBChannel(5).getChannel(), 5);
+  BOOST_REQUIRE_EQUAL(bank.getTOMBChannel(JPetParamBank::kMaxDenseIndex + 10).getChannel(), JPetParamBank::kMaxDenseIndex + 10);
+  BOOST_REQUIRE_EQUAL(&bank.getPM(7), bank.getPMs().at(7));
+  BOOST_CHECK_THROW(bank.getPM(6), std::out_of_range);
+  BOOST_CHECK_THROW(bank.getPM(100), std::out_of_range);
+  BOOST_CHECK_THROW(bank.getTOMBChannel(6), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
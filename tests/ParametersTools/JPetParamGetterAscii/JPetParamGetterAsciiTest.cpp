@@ -16,6 +16,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE JPetParamGetterAsciiTest
 
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
 #include "JPetParamGetterAscii/JPetParamSaverAscii.h"
 #include "JPetParamManager/JPetParamManager.h"
@@ -167,4 +168,43 @@ BOOST_AUTO_TEST_CASE(minimal_example_write)
   boost::filesystem::remove(writtenFileName);
 }
 
+BOOST_AUTO_TEST_CASE(file_is_parsed_once)
+{
+  auto& cache = JPetParamAsciiCache::getInstance();
+  cache.invalidate(dataDir + "DB2.json");
+  auto parsingsBefore = cache.getNumberOfParsings();
+  JPetParamManager paramManager1(new JPetParamGetterAscii(dataDir + "DB2.json"));
+  paramManager1.fillParameterBank(1);
+  JPetParamManager paramManager2(new JPetParamGetterAscii(dataDir + "DB2.json"));
+  paramManager2.fillParameterBank(1);
+  BOOST_REQUIRE_EQUAL(cache.getNumberOfParsings(), parsingsBefore + 1);
+  BOOST_REQUIRE_EQUAL(paramManager1.getParamBank().getPMsSize(), paramManager2.getParamBank().getPMsSize());
+
+  auto run1 = cache.getRun(dataDir + "DB2.json", 1);
+  auto run2 = cache.getRun(dataDir + "DB2.json", 1);
+  BOOST_REQUIRE(run1);
+  BOOST_REQUIRE_EQUAL(run1.get(), run2.get());
+  BOOST_REQUIRE_EQUAL(run1->fDescriptions.at(ParamObjectType::kPM).size(), 1u);
+  BOOST_REQUIRE(!cache.getRun(dataDir + "DB2.json", 12345));
+  BOOST_REQUIRE(!cache.getRun(dataDir + "noExisting.json", 1));
+  BOOST_REQUIRE_EQUAL(cache.getNumberOfParsings(), parsingsBefore + 1);
+}
+
+BOOST_AUTO_TEST_CASE(saved_file_is_parsed_again)
+{
+  JPetParamManager paramManager(new JPetParamGetterAscii(dataDir + "DB2.json"));
+  paramManager.fillParameterBank(1);
+  std::string writtenFileName(dataDir + "writtenCachedDB2.json");
+  boost::filesystem::remove(writtenFileName);
+  JPetParamSaverAscii saver;
+  saver.saveParamBank(paramManager.getParamBank(), 1, writtenFileName);
+
+  auto& cache = JPetParamAsciiCache::getInstance();
+  BOOST_REQUIRE(cache.getRun(writtenFileName, 1));
+  BOOST_REQUIRE(!cache.getRun(writtenFileName, 2));
+  saver.saveParamBank(paramManager.getParamBank(), 2, writtenFileName);
+  BOOST_REQUIRE(cache.getRun(writtenFileName, 2));
+  boost::filesystem::remove(writtenFileName);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
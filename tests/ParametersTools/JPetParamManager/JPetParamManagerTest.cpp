@@ -18,11 +18,14 @@
 
 #include "JPetParamManager/JPetParamManager.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamManager/JPetParamBankRegistry.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <cstddef>
 #include <string>
+#include <thread>
 
 const std::string dataDir = "unitTestData/JPetParamManagerTest/";
 const std::string dataFileName = dataDir + "data.json";
@@ -164,4 +167,119 @@ BOOST_AUTO_TEST_CASE(getParamBankTestWithScopeSettings)
   BOOST_REQUIRE_EQUAL(l_paramManagerInstance.getParamBank().getTOMBChannelsSize(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(managers_of_the_same_run_share_the_bank)
+{
+  auto& registry = JPetParamBankRegistry::getInstance();
+  registry.clear();
+  std::map<std::string, boost::any> opts;
+  opts["inputFileType_std::string"] = std::string("hld");
+  opts["localDB_std::string"] = dataFileName;
+  opts["runId_int"] = int(1);
+  auto buildsBefore = registry.getNumberOfBuilds();
+  auto paramMgr1 = JPetParamManager::generateParamManager(opts);
+  auto paramMgr2 = JPetParamManager::generateParamManager(opts);
+  BOOST_REQUIRE_EQUAL(paramMgr1->getDBSource(), dataFileName);
+  paramMgr1->fillParameterBank(1);
+  paramMgr2->fillParameterBank(1);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBuilds(), buildsBefore + 1);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 1);
+  BOOST_REQUIRE_EQUAL(&paramMgr1->getParamBank(), &paramMgr2->getParamBank());
+  BOOST_REQUIRE_EQUAL(paramMgr1->getSharedParamBank(), paramMgr2->getSharedParamBank());
+  checkContainersSize(paramMgr2->getParamBank());
+
+  auto sharedBank = paramMgr1->getSharedParamBank();
+  paramMgr1->clearParameters();
+  BOOST_REQUIRE_EQUAL(paramMgr1->getParamBank().getPMsSize(), 0);
+  checkContainersSize(paramMgr2->getParamBank());
+  paramMgr1.reset();
+  checkContainersSize(*sharedBank);
+  registry.clear();
+}
+
+BOOST_AUTO_TEST_CASE(other_run_or_source_builds_new_bank)
+{
+  auto& registry = JPetParamBankRegistry::getInstance();
+  registry.clear();
+  auto buildsBefore = registry.getNumberOfBuilds();
+  JPetParamManager paramMgr1(new JPetParamGetterAscii(dataFileName));
+  paramMgr1.setDBSource(dataFileName);
+  paramMgr1.fillParameterBank(1);
+  std::set<ParamObjectType> expectMissing = {ParamObjectType::kTOMBChannel};
+  JPetParamManager paramMgr2(new JPetParamGetterAscii(dataFileName), expectMissing);
+  paramMgr2.setDBSource(dataFileName);
+  paramMgr2.fillParameterBank(1);
+  JPetParamManager paramMgr3(new JPetParamGetterAscii(dataFileName));
+  paramMgr3.fillParameterBank(1);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBuilds(), buildsBefore + 2);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 2);
+  BOOST_REQUIRE(&paramMgr1.getParamBank() != &paramMgr2.getParamBank());
+  BOOST_REQUIRE(&paramMgr1.getParamBank() != &paramMgr3.getParamBank());
+  BOOST_REQUIRE_EQUAL(paramMgr2.getParamBank().getTOMBChannelsSize(), 0);
+  checkContainersSize(paramMgr3.getParamBank());
+  registry.clear();
+}
+
+BOOST_AUTO_TEST_CASE(bank_is_built_without_blocking_the_registry)
+{
+  auto& registry = JPetParamBankRegistry::getInstance();
+  registry.clear();
+  auto buildsBefore = registry.getNumberOfBuilds();
+  auto buildBank = []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return std::make_shared<JPetParamBank>();
+  };
+  std::shared_ptr<const JPetParamBank> bankInThread;
+  std::shared_ptr<const JPetParamBank> otherRunBank;
+  std::thread thread;
+  auto bank = registry.getBank(1, dataFileName, {}, [&]() {
+    thread = std::thread([&]() { bankInThread = registry.getBank(1, dataFileName, {}, buildBank); });
+    otherRunBank = registry.getBank(2, dataFileName, {}, buildBank);
+    return buildBank();
+  });
+  thread.join();
+  BOOST_REQUIRE(bank);
+  BOOST_REQUIRE(otherRunBank);
+  BOOST_REQUIRE_EQUAL(bank, bankInThread);
+  BOOST_REQUIRE(bank != otherRunBank);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBuilds(), buildsBefore + 2);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 2);
+  registry.clear();
+}
+
+BOOST_AUTO_TEST_CASE(failed_build_is_not_registered)
+{
+  auto& registry = JPetParamBankRegistry::getInstance();
+  registry.clear();
+  auto failingBuild = []() -> std::shared_ptr<JPetParamBank> { throw std::runtime_error("no bank"); };
+  BOOST_CHECK_THROW(registry.getBank(1, dataFileName, {}, failingBuild), std::runtime_error);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 0);
+  auto bank = registry.getBank(1, dataFileName, {}, []() { return std::make_shared<JPetParamBank>(); });
+  BOOST_REQUIRE(bank);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 1);
+  registry.clear();
+}
+
+BOOST_AUTO_TEST_CASE(banks_are_released)
+{
+  auto& registry = JPetParamBankRegistry::getInstance();
+  registry.clear();
+  auto buildBank = []() { return std::make_shared<JPetParamBank>(); };
+  auto usedBank = registry.getBank(1, dataFileName, {}, buildBank);
+  registry.getBank(2, dataFileName, {}, buildBank);
+  registry.getBank(3, dataFileName, {}, buildBank);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 3);
+  registry.release(3, dataFileName);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 2);
+  BOOST_REQUIRE_EQUAL(registry.releaseUnused(), 1u);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 1);
+  BOOST_REQUIRE_EQUAL(registry.getBank(1, dataFileName, {}, buildBank), usedBank);
+  usedBank.reset();
+  BOOST_REQUIRE_EQUAL(registry.releaseUnused(), 1u);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBanks(), 0);
+  auto buildsBefore = registry.getNumberOfBuilds();
+  registry.getBank(1, dataFileName, {}, buildBank);
+  BOOST_REQUIRE_EQUAL(registry.getNumberOfBuilds(), buildsBefore + 1);
+  registry.clear();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamSnapshotTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetParamSnapshotTest
+
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
+#include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamManager/JPetParamManager.h"
+#include "JPetParamSnapshot/JPetParamGetterBinary.h"
+#include "JPetParamSnapshot/JPetParamSnapshot.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <fstream>
+
+const std::string asciiDataDir = "unitTestData/JPetParamGetterAsciiTest/";
+const std::string largeBarrelFile = "unitTestData/JPetGeomMappingTest/large_barrel.json";
+
+void checkBanksEqual(const JPetParamBank& bank1, const JPetParamBank& bank2)
+{
+  BOOST_REQUIRE_EQUAL(bank1.getScintillatorsSize(), bank2.getScintillatorsSize());
+  BOOST_REQUIRE_EQUAL(bank1.getPMsSize(), bank2.getPMsSize());
+  BOOST_REQUIRE_EQUAL(bank1.getBarrelSlotsSize(), bank2.getBarrelSlotsSize());
+  BOOST_REQUIRE_EQUAL(bank1.getLayersSize(), bank2.getLayersSize());
+  BOOST_REQUIRE_EQUAL(bank1.getFramesSize(), bank2.getFramesSize());
+  BOOST_REQUIRE_EQUAL(bank1.getFEBsSize(), bank2.getFEBsSize());
+  BOOST_REQUIRE_EQUAL(bank1.getTRBsSize(), bank2.getTRBsSize());
+  BOOST_REQUIRE_EQUAL(bank1.getTOMBChannelsSize(), bank2.getTOMBChannelsSize());
+  for (const auto& el : bank1.getTOMBChannels())
+  {
+    const auto& channel = bank2.getTOMBChannel(el.first);
+    BOOST_REQUIRE_EQUAL(channel.getPM().getID(), el.second->getPM().getID());
+    BOOST_REQUIRE_EQUAL(channel.getFEB().getID(), el.second->getFEB().getID());
+    BOOST_REQUIRE_EQUAL(channel.getLocalChannelNumber(), el.second->getLocalChannelNumber());
+  }
+  for (const auto& el : bank1.getScintillators())
+  {
+    const auto& scin = bank2.getScintillator(el.first);
+    BOOST_REQUIRE_EQUAL(scin.getBarrelSlot().getID(), el.second->getBarrelSlot().getID());
+    BOOST_REQUIRE_EQUAL(scin.getBarrelSlot().getTheta(), el.second->getBarrelSlot().getTheta());
+    BOOST_REQUIRE_EQUAL(scin.getBarrelSlot().getLayer().getRadius(), el.second->getBarrelSlot().getLayer().getRadius());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(JPetParamSnapshotTestSuite)
+
+BOOST_AUTO_TEST_CASE(not_a_snapshot)
+{
+  JPetParamSnapshot snapshot;
+  BOOST_REQUIRE(!snapshot.isOpen());
+  BOOST_REQUIRE(!snapshot.open("noExisting.pbs"));
+  BOOST_REQUIRE(!snapshot.open(asciiDataDir + "DB2.json"));
+  BOOST_REQUIRE(!JPetParamSnapshot::isSnapshotFile(asciiDataDir + "DB2.json"));
+  BOOST_REQUIRE(!snapshot.hasType(ParamObjectType::kPM));
+  BOOST_REQUIRE_EQUAL(snapshot.getRunID(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(write_and_read)
+{
+  std::map<ParamObjectType, ParamObjectsDescriptions> descriptions;
+  descriptions[ParamObjectType::kPM][2] = {{"id", "2"}, {"description", "second"}, {"barrelSlots_id", "7"}};
+  descriptions[ParamObjectType::kPM][1] = {{"id", "1"}, {"description", "first"}};
+  descriptions[ParamObjectType::kLayer][4] = {{"id", "4"}, {"radius", "42.5"}};
+  std::string fileName = "paramSnapshotTest.pbs";
+  BOOST_REQUIRE(JPetParamSnapshot::write(fileName, 13, descriptions));
+  BOOST_REQUIRE(JPetParamSnapshot::isSnapshotFile(fileName));
+
+  JPetParamSnapshot snapshot(fileName);
+  BOOST_REQUIRE(snapshot.isOpen());
+  BOOST_REQUIRE_EQUAL(snapshot.getRunID(), 13);
+  BOOST_REQUIRE(snapshot.hasType(ParamObjectType::kPM));
+  BOOST_REQUIRE(!snapshot.hasType(ParamObjectType::kScintillator));
+  BOOST_REQUIRE_EQUAL(snapshot.getNumberOfObjects(ParamObjectType::kPM), 2u);
+  auto ids = snapshot.getIDs(ParamObjectType::kPM);
+  BOOST_REQUIRE_EQUAL(ids.size(), 2u);
+  BOOST_REQUIRE_EQUAL(ids[0], 1);
+  BOOST_REQUIRE_EQUAL(ids[1], 2);
+  BOOST_REQUIRE_EQUAL(std::string(snapshot.getField(ParamObjectType::kPM, 2, "description")), "second");
+  BOOST_REQUIRE_EQUAL(std::string(snapshot.getField(ParamObjectType::kLayer, 4, "radius")), "42.5");
+  BOOST_REQUIRE(!snapshot.getField(ParamObjectType::kPM, 1, "barrelSlots_id"));
+  BOOST_REQUIRE(!snapshot.getField(ParamObjectType::kPM, 3, "id"));
+  BOOST_REQUIRE(snapshot.getDescriptions(ParamObjectType::kPM) == descriptions[ParamObjectType::kPM]);
+  BOOST_REQUIRE(snapshot.getDescriptions(ParamObjectType::kLayer) == descriptions[ParamObjectType::kLayer]);
+
+  JPetParamGetterBinary getter(fileName);
+  auto relations = getter.getAllRelationalData(ParamObjectType::kPM, ParamObjectType::kBarrelSlot, 13);
+  BOOST_REQUIRE_EQUAL(relations.size(), 1u);
+  BOOST_REQUIRE_EQUAL(relations[2], 7);
+  BOOST_REQUIRE(getter.getAllBasicData(ParamObjectType::kPM, 12).empty());
+  BOOST_REQUIRE(getter.getAllBasicData(ParamObjectType::kScintillator, 13).empty());
+  snapshot.close();
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(truncated_file_is_rejected)
+{
+  std::map<ParamObjectType, ParamObjectsDescriptions> descriptions;
+  descriptions[ParamObjectType::kPM][1] = {{"id", "1"}, {"description", "first"}};
+  std::string fileName = "paramSnapshotTruncatedTest.pbs";
+  BOOST_REQUIRE(JPetParamSnapshot::write(fileName, 1, descriptions));
+  auto size = boost::filesystem::file_size(fileName);
+  boost::filesystem::resize_file(fileName, size - 10);
+  JPetParamSnapshot snapshot;
+  BOOST_REQUIRE(!snapshot.open(fileName));
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(convert_from_ascii)
+{
+  std::string fileName = "paramSnapshotDB2.pbs";
+  BOOST_REQUIRE(JPetParamSnapshot::convertFromAscii(asciiDataDir + "DB2.json", 1, fileName));
+  BOOST_REQUIRE(!JPetParamSnapshot::convertFromAscii(asciiDataDir + "DB2.json", 12345, fileName + ".wrong"));
+
+  JPetParamGetterAscii asciiGetter(asciiDataDir + "DB2.json");
+  JPetParamGetterBinary binaryGetter(fileName);
+  BOOST_REQUIRE(asciiGetter.getAllBasicData(ParamObjectType::kPM, 1) == binaryGetter.getAllBasicData(ParamObjectType::kPM, 1));
+  BOOST_REQUIRE(asciiGetter.getAllRelationalData(ParamObjectType::kPM, ParamObjectType::kBarrelSlot, 1) ==
+                binaryGetter.getAllRelationalData(ParamObjectType::kPM, ParamObjectType::kBarrelSlot, 1));
+
+  JPetParamManager asciiManager(new JPetParamGetterAscii(asciiDataDir + "DB2.json"));
+  asciiManager.fillParameterBank(1);
+  JPetParamManager binaryManager(new JPetParamGetterBinary(fileName));
+  binaryManager.fillParameterBank(1);
+  checkBanksEqual(asciiManager.getParamBank(), binaryManager.getParamBank());
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(convert_from_root_file)
+{
+  JPetParamManager asciiManager(new JPetParamGetterAscii(largeBarrelFile));
+  asciiManager.fillParameterBank(43);
+  std::string rootFileName = "paramSnapshotLargeBarrel.root";
+  boost::filesystem::remove(rootFileName);
+  BOOST_REQUIRE(asciiManager.saveParametersToFile(rootFileName));
+
+  std::string fileName = "paramSnapshotLargeBarrel.pbs";
+  BOOST_REQUIRE(JPetParamSnapshot::convertFromRootFile(rootFileName, 43, fileName));
+  JPetParamManager binaryManager(new JPetParamGetterBinary(fileName));
+  binaryManager.fillParameterBank(43);
+  checkBanksEqual(asciiManager.getParamBank(), binaryManager.getParamBank());
+  boost::filesystem::remove(rootFileName);
+  boost::filesystem::remove(fileName);
+}
+
+/// Compares the time needed to fill the param bank from the json DB (parsed
+/// anew, as for the first input file in a process) with the binary snapshot.
+BOOST_AUTO_TEST_CASE(startup_benchmark)
+{
+  const int kRepetitions = 5;
+  std::string fileName = "paramSnapshotBenchmark.pbs";
+  BOOST_REQUIRE(JPetParamSnapshot::convertFromAscii(largeBarrelFile, 43, fileName));
+
+  double asciiTime = 0.;
+  double binaryTime = 0.;
+  for (int i = 0; i < kRepetitions; i++)
+  {
+    JPetParamAsciiCache::getInstance().invalidate(largeBarrelFile);
+    auto start = std::chrono::steady_clock::now();
+    JPetParamManager asciiManager(new JPetParamGetterAscii(largeBarrelFile));
+    asciiManager.fillParameterBank(43);
+    auto middle = std::chrono::steady_clock::now();
+    JPetParamManager binaryManager(new JPetParamGetterBinary(fileName));
+    binaryManager.fillParameterBank(43);
+    auto stop = std::chrono::steady_clock::now();
+    asciiTime += std::chrono::duration<double, std::milli>(middle - start).count();
+    binaryTime += std::chrono::duration<double, std::milli>(stop - middle).count();
+    checkBanksEqual(asciiManager.getParamBank(), binaryManager.getParamBank());
+  }
+  BOOST_TEST_MESSAGE("Param bank from json DB: " << asciiTime / kRepetitions << " ms, from binary snapshot: " << binaryTime / kRepetitions
+                                                 << " ms");
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,313 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEventBuilderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetEventBuilderTest
+
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetData/JPetData.h"
+#include "JPetEventBuilderTask/JPetEventBuilder.h"
+#include "JPetEventBuilderTask/JPetEventBuilderTask.h"
+#include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetParamBank/JPetParamBank.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTaskStreamIO/JPetTaskStreamIO.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace
+{
+JPetTimeWindow createHits(const std::vector<float>& times)
+{
+  JPetTimeWindow hits("JPetHit");
+  for (auto time : times)
+  {
+    JPetHit hit;
+    hit.setTime(time);
+    hits.add<JPetHit>(hit);
+  }
+  return hits;
+}
+
+std::vector<std::size_t> getMultiplicities(const JPetTimeWindow& events)
+{
+  std::vector<std::size_t> multiplicities;
+  for (std::size_t i = 0; i < events.getNumberOfEvents(); i++)
+  {
+    multiplicities.push_back(events.getEvent<JPetEvent>(i).getHits().size());
+  }
+  return multiplicities;
+}
+
+/// Writes the time windows of hits crossing the window boundaries, with times given with respect to the window beginning
+void writeHitWindows(const std::string& fileName, int windows)
+{
+  JPetWriter writer(fileName.c_str());
+  JPetParamBank bank;
+  bank.addPM(JPetPM(1, "first"));
+  writer.writeObject(&bank, "ParamBank");
+  for (int i = 0; i < windows; i++)
+  {
+    writer.write(createHits({2.f, 40.f, 41.f, 95.f, 98.f}));
+  }
+  writer.closeFile();
+}
+
+/// Runs the event builder task in the stream with the given number of workers and returns the multiplicities of the saved events
+std::vector<std::size_t> runEventBuilderStream(const std::string& inputFile, int numberOfWorkers)
+{
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts["inputFile_std::string"] = inputFile;
+  opts["EventBuilder_CoincidenceWindow_double"] = 10.;
+  opts["EventBuilder_MinimalMultiplicity_int"] = 1;
+  opts["EventBuilder_CarryOver_bool"] = true;
+  opts["EventBuilder_TimeWindowLength_double"] = 100.;
+  opts[JPetTaskStreamIO::kNumberOfWorkersKey] = numberOfWorkers;
+  auto mgr = std::make_shared<JPetParamManager>(new JPetParamManager);
+  JPetParams params(opts, mgr);
+  JPetTaskStreamIO taskStreamIO("eventBuilderStream", "hits", "evt");
+  taskStreamIO.addSubTaskGenerator([]() { return jpet_common_tools::make_unique<JPetEventBuilderTask>("eventBuilder"); });
+  BOOST_REQUIRE(taskStreamIO.init(params));
+  JPetDataInterface pseudoData;
+  BOOST_REQUIRE(taskStreamIO.run(pseudoData));
+  BOOST_REQUIRE(taskStreamIO.terminate(params));
+
+  std::vector<std::size_t> multiplicities;
+  JPetReader reader(JPetCommonTools::replaceDataTypeInFileName(inputFile, "evt").c_str());
+  for (long long i = 0; i < reader.getNbOfAllEntries(); i++)
+  {
+    reader.nthEntry(i);
+    auto windowMultiplicities = getMultiplicities(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()));
+    multiplicities.insert(multiplicities.end(), windowMultiplicities.begin(), windowMultiplicities.end());
+  }
+  return multiplicities;
+}
+
+/// Task with the input and output accessible in the tests
+class TestEventBuilderTask : public JPetEventBuilderTask
+{
+public:
+  using JPetEventBuilderTask::JPetEventBuilderTask;
+  using JPetUserTask::init;
+  using JPetUserTask::terminate;
+  ~TestEventBuilderTask() { delete fOutputEvents; }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JPetEventBuilderTestSuite)
+
+BOOST_AUTO_TEST_CASE(radix_sort_orders_times)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-1.e6f, 1.e6f);
+  std::vector<float> times(1000);
+  for (auto& time : times)
+  {
+    time = distribution(generator);
+  }
+  times[10] = 0.f;
+  times[20] = -0.f;
+  times[30] = times[40];
+  std::vector<std::uint32_t> order, keys, buffer;
+  JPetEventBuilder::sortByTime(times, order, keys, buffer);
+  BOOST_REQUIRE_EQUAL(order.size(), times.size());
+  BOOST_REQUIRE(std::is_sorted(order.begin(), order.end(), [&times](std::uint32_t i, std::uint32_t j) { return times[i] < times[j]; }));
+  auto sortedOrder = order;
+  std::sort(sortedOrder.begin(), sortedOrder.end());
+  for (std::size_t i = 0; i < sortedOrder.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(sortedOrder[i], i);
+  }
+  /// the sort is stable
+  auto first = std::find(order.begin(), order.end(), 30u);
+  auto second = std::find(order.begin(), order.end(), 40u);
+  BOOST_REQUIRE(first < second);
+
+  std::vector<float> empty;
+  JPetEventBuilder::sortByTime(empty, order, keys, buffer);
+  BOOST_REQUIRE(order.empty());
+}
+
+BOOST_AUTO_TEST_CASE(hits_are_grouped_in_coincidence_window)
+{
+  JPetEventBuilder builder(10.);
+  builder.setCarryOver(false);
+  auto hits = createHits({105.f, 0.f, 30.f, 5.f, 100.f, 9.f, 101.f, 50.f});
+  JPetTimeWindow events("JPetEvent");
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(hits, events), 4u);
+  BOOST_REQUIRE(getMultiplicities(events) == std::vector<std::size_t>({3, 1, 1, 3}));
+  const auto& first = events.getEvent<JPetEvent>(0);
+  BOOST_REQUIRE_EQUAL(first.getHits()[0].getTime(), 0.f);
+  BOOST_REQUIRE_EQUAL(first.getHits()[2].getTime(), 9.f);
+  BOOST_REQUIRE(first.isOnlyTypeOf(JPetEventType::k3Gamma));
+  BOOST_REQUIRE(events.getEvent<JPetEvent>(1).isOnlyTypeOf(JPetEventType::kUnknown));
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(minimal_multiplicity_and_classifier)
+{
+  JPetEventBuilder builder(10.);
+  builder.setCarryOver(false);
+  builder.setMinimalMultiplicity(2);
+  builder.setClassifier([](const JPetEvent& event) {
+    return event.getHits().front().getTime() < 50.f ? JPetEventType::kPrompt : JPetEventType::k2Gamma;
+  });
+  std::vector<JPetHit> hits(5);
+  hits[0].setTime(0.f);
+  hits[1].setTime(1.f);
+  hits[2].setTime(30.f);
+  hits[3].setTime(60.f);
+  hits[4].setTime(61.f);
+  std::vector<JPetEvent> events;
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(hits, events), 2u);
+  BOOST_REQUIRE_EQUAL(events.size(), 2u);
+  BOOST_REQUIRE(events[0].isOnlyTypeOf(JPetEventType::kPrompt));
+  BOOST_REQUIRE(events[1].isOnlyTypeOf(JPetEventType::k2Gamma));
+  BOOST_REQUIRE_EQUAL(events[1].getHits()[1].getTime(), 61.f);
+}
+
+BOOST_AUTO_TEST_CASE(hits_are_carried_to_next_window)
+{
+  JPetEventBuilder builder(10.);
+  JPetTimeWindow events("JPetEvent");
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({0.f, 50.f, 95.f, 98.f}), events), 2u);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 2u);
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({102.f, 200.f}), events), 1u);
+  BOOST_REQUIRE(getMultiplicities(events) == std::vector<std::size_t>({1, 1, 3}));
+  BOOST_REQUIRE(events.getEvent<JPetEvent>(2).isOnlyTypeOf(JPetEventType::k3Gamma));
+  BOOST_REQUIRE_EQUAL(events.getEvent<JPetEvent>(2).getHits()[2].getTime(), 102.f);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 1u);
+  BOOST_REQUIRE_EQUAL(builder.flush(events), 1u);
+  BOOST_REQUIRE_EQUAL(events.getEvent<JPetEvent>(3).getHits()[0].getTime(), 200.f);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(carried_hits_are_shifted_by_window_length)
+{
+  JPetEventBuilder builder(10.);
+  builder.setTimeWindowLength(100.);
+  JPetTimeWindow events("JPetEvent");
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({50.f, 85.f, 95.f}), events), 2u);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 1u);
+  /// the last hit cannot be completed by the next window, so it is not carried
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({2.f, 40.f}), events), 2u);
+  BOOST_REQUIRE(getMultiplicities(events) == std::vector<std::size_t>({1, 1, 2, 1}));
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 0u);
+  BOOST_REQUIRE_EQUAL(events.getEvent<JPetEvent>(2).getHits()[0].getTime(), -5.f);
+  BOOST_REQUIRE_EQUAL(events.getEvent<JPetEvent>(2).getHits()[1].getTime(), 2.f);
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({99.f}), events), 0u);
+  builder.reset();
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(window_of_other_type_is_rejected)
+{
+  JPetEventBuilder builder;
+  JPetTimeWindow sigChs("JPetSigCh");
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  JPetTimeWindow events("JPetEvent");
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(sigChs, events), 0u);
+  BOOST_REQUIRE_EQUAL(events.getNumberOfEvents(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(window_of_other_type_does_not_shift_carried_hits)
+{
+  JPetEventBuilder builder(10.);
+  builder.setTimeWindowLength(100.);
+  JPetTimeWindow events("JPetEvent");
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({50.f, 95.f}), events), 1u);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 1u);
+  JPetTimeWindow sigChs("JPetSigCh");
+  sigChs.add<JPetSigCh>(JPetSigCh());
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(sigChs, events), 0u);
+  BOOST_REQUIRE_EQUAL(builder.getNumberOfCarriedHits(), 1u);
+  BOOST_REQUIRE_EQUAL(builder.buildEvents(createHits({2.f}), events), 1u);
+  BOOST_REQUIRE_EQUAL(events.getEvent<JPetEvent>(1).getHits()[0].getTime(), -5.f);
+}
+
+BOOST_AUTO_TEST_CASE(event_builder_task_requires_window_length_with_carry_over)
+{
+  jpet_options_tools::OptsStrAny options;
+  options["EventBuilder_CoincidenceWindow_double"] = 10.;
+  TestEventBuilderTask task("eventBuilder");
+  BOOST_REQUIRE(!task.init(JPetParams(options, nullptr)));
+  options["EventBuilder_CarryOver_bool"] = false;
+  TestEventBuilderTask taskWithoutCarryOver("eventBuilder");
+  BOOST_REQUIRE(taskWithoutCarryOver.init(JPetParams(options, nullptr)));
+  options["EventBuilder_CarryOver_bool"] = true;
+  options["EventBuilder_TimeWindowLength_double"] = 100.;
+  TestEventBuilderTask taskWithLength("eventBuilder");
+  BOOST_REQUIRE(taskWithLength.init(JPetParams(options, nullptr)));
+  BOOST_REQUIRE_EQUAL(taskWithLength.getEventBuilder().getTimeWindowLength(), 100.);
+}
+
+BOOST_AUTO_TEST_CASE(event_builder_task)
+{
+  jpet_options_tools::OptsStrAny options;
+  options["EventBuilder_CoincidenceWindow_double"] = 10.;
+  options["EventBuilder_MinimalMultiplicity_int"] = 2;
+  /// absolute hit times
+  options["EventBuilder_TimeWindowLength_double"] = 0.;
+  TestEventBuilderTask task("eventBuilder");
+  BOOST_REQUIRE(task.init(JPetParams(options, nullptr)));
+  BOOST_REQUIRE_EQUAL(task.getEventBuilder().getCoincidenceWindow(), 10.);
+
+  auto hits = createHits({0.f, 3.f, 50.f, 97.f});
+  BOOST_REQUIRE(task.run(JPetData(hits, 0)));
+  BOOST_REQUIRE_EQUAL(task.getOutputEvents()->getNumberOfEvents(), 1u);
+  BOOST_REQUIRE_EQUAL(task.getEventBuilder().getNumberOfCarriedHits(), 1u);
+
+  auto nextHits = createHits({99.f, 150.f});
+  BOOST_REQUIRE(task.run(JPetData(nextHits, 1)));
+  BOOST_REQUIRE_EQUAL(task.getOutputEvents()->getNumberOfEvents(), 1u);
+  BOOST_REQUIRE(task.getOutputEvents()->getEvent<JPetEvent>(0).isOnlyTypeOf(JPetEventType::k2Gamma));
+
+  /// not consecutive entry, the carried hit is not combined with the new ones
+  auto otherHits = createHits({152.f, 153.f});
+  BOOST_REQUIRE(task.run(JPetData(otherHits, 5)));
+  BOOST_REQUIRE_EQUAL(task.getOutputEvents()->getNumberOfEvents(), 0u);
+  BOOST_REQUIRE_EQUAL(task.getEventBuilder().getNumberOfCarriedHits(), 2u);
+
+  /// last entry, the carried hits are added to its output instead of being lost
+  auto lastHits = createHits({154.f, 200.f});
+  BOOST_REQUIRE(task.run(JPetData(lastHits, 6, true)));
+  BOOST_REQUIRE(task.isLastEntry());
+  BOOST_REQUIRE_EQUAL(task.getOutputEvents()->getNumberOfEvents(), 1u);
+  BOOST_REQUIRE_EQUAL(task.getOutputEvents()->getEvent<JPetEvent>(0).getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(task.getEventBuilder().getNumberOfCarriedHits(), 0u);
+  JPetParams outParams;
+  BOOST_REQUIRE(task.terminate(outParams));
+}
+
+BOOST_AUTO_TEST_CASE(event_builder_task_with_several_workers)
+{
+  /// more windows than taken by a worker at once, so the serial run would be split if the task were run in parallel
+  const int kWindows = 40;
+  const std::string inputFile = "eventBuilderStreamTest.hits.root";
+  writeHitWindows(inputFile, kWindows);
+  auto serial = runEventBuilderStream(inputFile, 1);
+  auto parallel = runEventBuilderStream(inputFile, 4);
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(serial.begin(), serial.end(), parallel.begin(), parallel.end());
+  /// the events crossing the windows are complete and no hit is lost
+  BOOST_REQUIRE_EQUAL(std::count(parallel.begin(), parallel.end(), 3u), kWindows - 1);
+  BOOST_REQUIRE_EQUAL(std::accumulate(parallel.begin(), parallel.end(), std::size_t(0)), 5u * kWindows);
+}
+
+BOOST_AUTO_TEST_SUITE_END()